@@ -0,0 +1,100 @@
+#ifndef __MOUSE_TRACKER_CORE_BENCHMARKFRAMEWORK__
+#define __MOUSE_TRACKER_CORE_BENCHMARKFRAMEWORK__
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+
+namespace Mt::Benchmarks
+{
+    struct BenchmarkSettings
+    {
+        size_t Samples = 1000000;
+        int Repetitions = 5;
+    };
+
+    struct BenchmarkCase
+    {
+        const char* Name;
+        std::function<void(const BenchmarkSettings&)> Body;
+    };
+
+    inline std::vector<BenchmarkCase>& GetBenchmarkCases()
+    {
+        static std::vector<BenchmarkCase> benchmarkCases;
+
+        return benchmarkCases;
+    }
+
+    struct BenchmarkRegistration
+    {
+        BenchmarkRegistration(const char* name, std::function<void(const BenchmarkSettings&)> body)
+        {
+            GetBenchmarkCases().push_back(BenchmarkCase { name, std::move(body) });
+        }
+    };
+
+    // Best wall time of several runs, in seconds. Best rather than mean keeps
+    // scheduler noise out of throughput numbers.
+    inline double MeasureBest(int repetitions, const std::function<void()>& body)
+    {
+        double best = 1e300;
+
+        for (int i = 0; i < repetitions; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            best = (std::min)(best, elapsed.count());
+        }
+
+        return best;
+    }
+
+    inline double ToMegabytesPerSecond(uint64_t bytes, double seconds)
+    {
+        return seconds > 0.0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+
+    // Scratch directory under the system temp dir, removed on destruction.
+    class ScratchDirectory
+    {
+        private:
+            std::filesystem::path m_path;
+
+        public:
+            explicit ScratchDirectory(const std::string& name)
+            {
+                m_path = std::filesystem::temp_directory_path() / ("mt_core_benchmarks_" + name);
+                std::filesystem::remove_all(m_path);
+                std::filesystem::create_directories(m_path);
+            }
+
+            ~ScratchDirectory()
+            {
+                std::error_code error;
+                std::filesystem::remove_all(m_path, error);
+            }
+
+            std::string File(const std::string& name) const
+            {
+                return (m_path / name).string();
+            }
+    };
+}
+
+#define MT_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define MT_BENCHMARK_CONCAT(a, b) MT_BENCHMARK_CONCAT_INNER(a, b)
+
+#define MT_BENCHMARK(name) \
+    static void name(const ::Mt::Benchmarks::BenchmarkSettings& settings); \
+    static ::Mt::Benchmarks::BenchmarkRegistration MT_BENCHMARK_CONCAT(s_registration_, name)(#name, name); \
+    static void name(const ::Mt::Benchmarks::BenchmarkSettings& settings)
+
+#endif
@@ -0,0 +1,27 @@
+#include "BenchmarkFramework.h"
+#include <cstring>
+
+// Usage: mt_core_benchmarks [name_filter] [samples] [repetitions]
+int main(int argc, char* argv[])
+{
+    Mt::Benchmarks::BenchmarkSettings settings;
+    const char* filter = argc > 1 ? argv[1] : "";
+
+    if (argc > 2)
+        settings.Samples = std::stoul(argv[2]);
+
+    if (argc > 3)
+        settings.Repetitions = std::stoi(argv[3]);
+
+    for (const auto& benchmarkCase : Mt::Benchmarks::GetBenchmarkCases())
+    {
+        if (std::strstr(benchmarkCase.Name, filter) == nullptr)
+            continue;
+
+        std::printf("== %s (%zu samples, best of %d)\n", benchmarkCase.Name, settings.Samples, settings.Repetitions);
+        benchmarkCase.Body(settings);
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "BenchmarkFramework.h"
+#include "SyntheticTrajectory.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Dataset/TrajectoryDataset.h"
+#include "MouseTrackerCore/Threading/ThreadPool.h"
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+
+using namespace Mt;
+using namespace Mt::Benchmarks;
+
+namespace
+{
+    double PathLength(const Point* points, size_t count)
+    {
+        double length = 0.0;
+
+        for (size_t i = 1; i < count; i++)
+        {
+            double dx = points[i].x - points[i - 1].x;
+            double dy = points[i].y - points[i - 1].y;
+            length += std::sqrt(dx * dx + dy * dy);
+        }
+
+        return length;
+    }
+}
+
+// A session of 2000-sample captures (settings.Samples in total, half text,
+// half fixed-width binary): loaded one file at a time into separate
+// trajectories versus the arena loader on 1 and all hardware threads, then
+// the same path length kernel over both layouts.
+MT_BENCHMARK(DatasetLoad)
+{
+    constexpr size_t SamplesPerFile = 2000;
+
+    ScratchDirectory directory("dataset_load");
+    Trajectory source = MakeSyntheticTrajectory(settings.Samples, false);
+    size_t files = (std::max)(size_t(1), settings.Samples / SamplesPerFile);
+    std::vector<std::string> filenames;
+    uint64_t bytes = 0;
+
+    for (size_t i = 0; i < files; i++)
+    {
+        size_t first = i * SamplesPerFile;
+        size_t count = (std::min)(SamplesPerFile, source.Size() - first);
+        Trajectory part(std::vector<Point>(source.GetPoints().begin() + first, source.GetPoints().begin() + first + count));
+
+        filenames.push_back(directory.File("capture_" + std::to_string(i) + (i % 2 ? ".crsbin" : ".crsdat")));
+        TrajectoryIo::Save(filenames.back(), part);
+        bytes += std::filesystem::file_size(filenames.back());
+    }
+
+    std::vector<Trajectory> separate;
+
+    double separateSeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        separate.assign(filenames.size(), Trajectory());
+
+        for (size_t i = 0; i < filenames.size(); i++)
+            TrajectoryIo::Load(filenames[i], separate[i]);
+    });
+
+    std::printf("%-24s %10s %12s %14s\n", "load", "ms", "MB/s", "M samples/s");
+    std::printf("%-24s %10.2f %12.1f %14.1f\n", "one file at a time", separateSeconds * 1000.0,
+        ToMegabytesPerSecond(bytes, separateSeconds), settings.Samples / separateSeconds / 1e6);
+
+    TrajectoryDataset dataset;
+
+    std::vector<size_t> threadCounts { 1 };
+
+    if (ThreadPool::ResolveThreadCount(0) > 1)
+        threadCounts.push_back(ThreadPool::ResolveThreadCount(0));
+
+    for (size_t threads : threadCounts)
+    {
+        DatasetLoadSettings loadSettings;
+        loadSettings.InputDirectory = directory.File("");
+        loadSettings.Threads = threads;
+
+        double arenaSeconds = MeasureBest(settings.Repetitions, [&]() { dataset.Load(loadSettings); });
+        std::string label = "arena, " + std::to_string(threads) + " thread" + (threads > 1 ? "s" : "");
+
+        std::printf("%-24s %10.2f %12.1f %14.1f\n", label.c_str(), arenaSeconds * 1000.0,
+            ToMegabytesPerSecond(bytes, arenaSeconds), settings.Samples / arenaSeconds / 1e6);
+    }
+
+    double separateLength = 0.0;
+    double arenaLength = 0.0;
+
+    double separateSweep = MeasureBest(settings.Repetitions, [&]()
+    {
+        separateLength = 0.0;
+
+        for (const auto& trajectory : separate)
+            separateLength += PathLength(trajectory.GetPoints().data(), trajectory.Size());
+    });
+
+    double arenaSweep = MeasureBest(settings.Repetitions, [&]()
+    {
+        arenaLength = 0.0;
+
+        for (size_t i = 0; i < dataset.GetCount(); i++)
+            arenaLength += PathLength(dataset.GetSpan(i).Points, dataset.GetSpan(i).Size());
+    });
+
+    std::printf("path length sweep: separate %.2f ms, arena %.2f ms%s\n", separateSweep * 1000.0, arenaSweep * 1000.0,
+        std::abs(separateLength - arenaLength) < 1e-6 * separateLength ? "" : ", CHECK FAILED");
+}
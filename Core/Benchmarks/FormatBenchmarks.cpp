@@ -0,0 +1,191 @@
+#include "BenchmarkFramework.h"
+#include "SyntheticTrajectory.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include <cstdlib>
+
+using namespace Mt;
+using namespace Mt::Benchmarks;
+
+// File size and save / load time of every registered codec on the same
+// synthetic capture. The text format cannot keep timestamps, so it is
+// measured on points only; binary rows are measured with and without them.
+MT_BENCHMARK(FileFormats)
+{
+    ScratchDirectory directory("file_formats");
+
+    std::printf("%-18s %-10s %12s %10s %10s %10s %12s\n", "codec", "columns", "bytes", "B/sample", "save ms", "load ms", "load MB/s");
+
+    for (bool withTimestamps : { false, true })
+    {
+        Trajectory trajectory = MakeSyntheticTrajectory(settings.Samples, withTimestamps);
+
+        for (const auto& codec : TrajectoryCodecRegistry::GetInstance().GetCodecs())
+        {
+            if (withTimestamps && std::string(codec->GetName()) == "text")
+                continue;
+
+            std::string filename = directory.File(std::string("trajectory_") + codec->GetName() + codec->GetExtension());
+            bool success = true;
+
+            double saveSeconds = MeasureBest(settings.Repetitions, [&]()
+            {
+                success = codec->Write(filename, trajectory).Success && success;
+            });
+
+            Trajectory loaded;
+
+            double loadSeconds = MeasureBest(settings.Repetitions, [&]()
+            {
+                success = codec->Read(filename, loaded).Success && success;
+            });
+
+            if (!success || loaded.GetPoints() != trajectory.GetPoints())
+            {
+                std::printf("%-18s round trip failed\n", codec->GetName());
+
+                continue;
+            }
+
+            uint64_t bytes = std::filesystem::file_size(filename);
+
+            std::printf("%-18s %-10s %12llu %10.2f %10.1f %10.1f %12.1f\n",
+                codec->GetName(), withTimestamps ? "x,y,t" : "x,y",
+                static_cast<unsigned long long>(bytes), static_cast<double>(bytes) / trajectory.Size(),
+                saveSeconds * 1000.0, loadSeconds * 1000.0, ToMegabytesPerSecond(bytes, loadSeconds));
+        }
+    }
+}
+
+// Time until every sample of a fixed-width .crsbin file has been read once:
+// codec Read into a Trajectory versus a memory-mapped span.
+MT_BENCHMARK(MappedLoad)
+{
+    ScratchDirectory directory("mapped_load");
+    std::string filename = directory.File("trajectory.crsbin");
+    Trajectory trajectory = MakeSyntheticTrajectory(settings.Samples);
+
+    TrajectoryCodecRegistry::GetInstance().GetCodec("binary")->Write(filename, trajectory);
+
+    auto sumColumns = [](const TrajectorySpan& span)
+    {
+        int64_t sum = 0;
+
+        for (size_t i = 0; i < span.Size(); i++)
+            sum += span[i].x + span[i].y + (span.HasTimestamps() ? span.Timestamps[i] : 0);
+
+        return sum;
+    };
+
+    int64_t expected = sumColumns(trajectory);
+    bool success = true;
+
+    double readSeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        Trajectory loaded;
+        success = TrajectoryIo::Load(filename, loaded).Success && sumColumns(loaded) == expected && success;
+    });
+
+    double openSeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        MappedTrajectory mapped;
+        success = mapped.Open(filename).Success && mapped.IsMapped() && success;
+    });
+
+    double mappedSeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        MappedTrajectory mapped;
+        success = mapped.Open(filename).Success && sumColumns(mapped.GetSpan()) == expected && success;
+    });
+
+    uint64_t bytes = std::filesystem::file_size(filename);
+
+    std::printf("%-22s %10s %12s\n", "path", "ms", "MB/s");
+    std::printf("%-22s %10.2f %12.1f\n", "read + scan", readSeconds * 1000.0, ToMegabytesPerSecond(bytes, readSeconds));
+    std::printf("%-22s %10.3f %12s\n", "map (open only)", openSeconds * 1000.0, "-");
+    std::printf("%-22s %10.2f %12.1f\n", "map + scan", mappedSeconds * 1000.0, ToMegabytesPerSecond(bytes, mappedSeconds));
+    std::printf("extra heap for mapped columns: 0 bytes (read path allocates %llu)%s\n",
+        static_cast<unsigned long long>(bytes - sizeof(BinaryTrajectoryHeader)), success ? "" : ", CHECK FAILED");
+}
+
+// Ratio and in-memory encode / decode speed of each binary payload encoding,
+// per capture, over a corpus: every trajectory file under the directory in
+// MT_BENCHMARK_CORPUS, or else synthetic captures of 20000 samples. Speeds
+// are in MB of fixed-width columns, so encodings compare directly.
+MT_BENCHMARK(PayloadEncodings)
+{
+    std::vector<Trajectory> corpus;
+    const char* corpusDirectory = std::getenv("MT_BENCHMARK_CORPUS");
+
+    if (corpusDirectory)
+    {
+        std::error_code error;
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(corpusDirectory, error))
+        {
+            Trajectory trajectory;
+
+            if (entry.is_regular_file() && TrajectoryIo::Load(entry.path().string(), trajectory).Success && !trajectory.Empty())
+                corpus.push_back(std::move(trajectory));
+        }
+
+        std::printf("corpus: %zu captures from %s\n", corpus.size(), corpusDirectory);
+    }
+    else
+    {
+        constexpr size_t SamplesPerCapture = 20000;
+        Trajectory source = MakeSyntheticTrajectory(settings.Samples);
+
+        for (size_t first = 0; first < source.Size(); first += SamplesPerCapture)
+        {
+            size_t count = (std::min)(SamplesPerCapture, source.Size() - first);
+            corpus.push_back(TrajectorySpan(source.GetPoints().data() + first, source.GetTimestamps().data() + first, count, source.GetMetadata()).ToTrajectory());
+        }
+
+        std::printf("corpus: %zu synthetic captures (set MT_BENCHMARK_CORPUS to a capture directory)\n", corpus.size());
+    }
+
+    uint64_t fixedBytes = 0;
+
+    for (const auto& trajectory : corpus)
+        fixedBytes += BinaryTrajectoryHeader::GetFixedPayloadBytes(trajectory.Size(), trajectory.HasTimestamps());
+
+    std::printf("%-18s %12s %8s %10s %12s %12s\n", "encoding", "bytes", "ratio", "B/sample", "encode MB/s", "decode MB/s");
+
+    for (BinaryEncoding encoding : { BinaryEncoding::Fixed, BinaryEncoding::DeltaVarint, BinaryEncoding::Predictive })
+    {
+        std::vector<std::vector<uint8_t>> payloads(corpus.size());
+        uint64_t bytes = 0;
+        uint64_t samples = 0;
+        bool success = true;
+
+        double encodeSeconds = MeasureBest(settings.Repetitions, [&]()
+        {
+            for (size_t i = 0; i < corpus.size(); i++)
+                payloads[i] = BinaryTrajectoryCodec::EncodePayload(corpus[i], encoding);
+        });
+
+        for (size_t i = 0; i < corpus.size(); i++)
+        {
+            bytes += payloads[i].size();
+            samples += corpus[i].Size();
+        }
+
+        double decodeSeconds = MeasureBest(settings.Repetitions, [&]()
+        {
+            Trajectory decoded;
+
+            for (size_t i = 0; i < corpus.size(); i++)
+            {
+                BinaryTrajectoryHeader header = BinaryTrajectoryCodec::MakeHeader(corpus[i], encoding);
+                success = BinaryTrajectoryCodec::DecodePayload(header, payloads[i].data(), payloads[i].size(), decoded).Success &&
+                    decoded.Size() == corpus[i].Size() && success;
+            }
+        });
+
+        std::printf("%-18s %12llu %8.2f %10.2f %12.1f %12.1f%s\n",
+            BinaryTrajectoryCodec(encoding).GetName(), static_cast<unsigned long long>(bytes),
+            bytes > 0 ? static_cast<double>(fixedBytes) / bytes : 0.0, samples > 0 ? static_cast<double>(bytes) / samples : 0.0,
+            ToMegabytesPerSecond(fixedBytes, encodeSeconds), ToMegabytesPerSecond(fixedBytes, decodeSeconds), success ? "" : "  ROUND TRIP FAILED");
+    }
+}
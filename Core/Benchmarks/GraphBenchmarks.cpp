@@ -0,0 +1,51 @@
+#include "BenchmarkFramework.h"
+#include "SyntheticTrajectory.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryLod.h"
+
+using namespace Mt;
+using namespace Mt::Benchmarks;
+
+// Level of detail the trajectory graph draws instead of one line and one
+// marker per sample, for a few canvas sizes over the padded 1920x1080 screen
+// the view shows, with its default 2 px markers: build time, and what is
+// left to draw. Both are redone only when the data or the canvas changes.
+MT_BENCHMARK(GraphLod)
+{
+    Trajectory trajectory = MakeSyntheticTrajectory(settings.Samples, false);
+
+    Point min;
+    Point max;
+
+    double boundsSeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        TrajectoryLod::GetBounds(trajectory, min, max);
+    });
+
+    std::printf("bounds %.2f ms\n", boundsSeconds * 1000.0);
+    std::printf("%-11s %10s %10s %10s %10s %14s\n", "canvas", "build ms", "strips", "vertices", "markers", "samples/vertex");
+
+    for (auto [width, height] : { std::pair(600, 400), std::pair(1200, 800), std::pair(2020, 1180) })
+    {
+        LodTransform transform;
+        transform.OriginX = -50.0f;
+        transform.OriginY = -50.0f;
+        transform.ScaleX = width / 2020.0f;
+        transform.ScaleY = height / 1180.0f;
+        transform.Width = width;
+        transform.Height = height;
+        transform.MarkerSpacing = 2.0f;
+
+        TrajectoryLod lod;
+
+        double buildSeconds = MeasureBest(settings.Repetitions, [&]()
+        {
+            lod.Build(trajectory, transform);
+        });
+
+        std::string canvas = std::to_string(width) + "x" + std::to_string(height);
+
+        std::printf("%-11s %10.1f %10zu %10zu %10zu %14.1f\n", canvas.c_str(), buildSeconds * 1000.0,
+            lod.GetStrips().size(), lod.GetPath().size(), lod.GetMarkers().size(),
+            lod.GetPath().empty() ? 0.0 : static_cast<double>(trajectory.Size()) / lod.GetPath().size());
+    }
+}
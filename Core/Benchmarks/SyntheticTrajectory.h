@@ -0,0 +1,64 @@
+#ifndef __MOUSE_TRACKER_CORE_SYNTHETICTRAJECTORY__
+#define __MOUSE_TRACKER_CORE_SYNTHETICTRAJECTORY__
+
+#include "MouseTrackerCore/Trajectory/Trajectory.h"
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+namespace Mt::Benchmarks
+{
+    // 1 ms cursor capture on a 1920x1080 screen: eased strokes between random
+    // targets with idle pauses in between, timestamps with a little jitter.
+    inline Trajectory MakeSyntheticTrajectory(size_t samples, bool withTimestamps = true)
+    {
+        std::mt19937 random(12345);
+        std::uniform_int_distribution<int> xDistribution(0, 1919);
+        std::uniform_int_distribution<int> yDistribution(0, 1079);
+        std::uniform_int_distribution<int> strokeDistribution(80, 900);
+        std::uniform_int_distribution<int> jitterDistribution(-40, 40);
+
+        Trajectory trajectory;
+        TrajectoryMetadata metadata;
+        metadata.PeriodUs = 1000;
+        metadata.StartTimeUs = 1700000000000000;
+        metadata.ScreenWidth = 1920;
+        metadata.ScreenHeight = 1080;
+        trajectory.SetMetadata(metadata);
+        trajectory.Reserve(samples, withTimestamps);
+
+        double x = 960.0;
+        double y = 540.0;
+
+        while (trajectory.Size() < samples)
+        {
+            double fromX = x;
+            double fromY = y;
+            double toX = xDistribution(random);
+            double toY = yDistribution(random);
+            int strokeLength = strokeDistribution(random);
+            int pauseLength = strokeDistribution(random) / 2;
+
+            for (int i = 0; i < strokeLength + pauseLength && trajectory.Size() < samples; i++)
+            {
+                double t = (std::min)(1.0, static_cast<double>(i) / strokeLength);
+                double eased = t * t * (3.0 - 2.0 * t);
+
+                x = fromX + (toX - fromX) * eased;
+                y = fromY + (toY - fromY) * eased;
+
+                Point point { static_cast<int32_t>(std::lround(x)), static_cast<int32_t>(std::lround(y)) };
+                int64_t timestampUs = static_cast<int64_t>(trajectory.Size()) * 1000 + jitterDistribution(random);
+
+                if (withTimestamps)
+                    trajectory.Add(point, timestampUs);
+                else
+                    trajectory.Add(point);
+            }
+        }
+
+        return trajectory;
+    }
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include "BenchmarkFramework.h"
+#include "SyntheticTrajectory.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include <fstream>
+#include <string>
+
+using namespace Mt;
+using namespace Mt::Benchmarks;
+
+namespace
+{
+    // The .crsdat reader as it was before the block parser, kept as the baseline.
+    bool LegacyTextRead(const std::string& filename, Trajectory& trajectory)
+    {
+        std::ifstream file(filename);
+
+        if (!file.is_open())
+            return false;
+
+        std::string line;
+
+        trajectory.Clear();
+
+        while (std::getline(file, line))
+        {
+            size_t delimiter = line.find(';');
+
+            if (delimiter == std::string::npos)
+                continue;
+
+            try
+            {
+                Point point;
+                point.x = std::stoi(line.substr(0, delimiter));
+                point.y = std::stoi(line.substr(delimiter + 1));
+                trajectory.Add(point);
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+
+        return true;
+    }
+}
+
+// .crsdat load throughput: legacy getline/substr/stoi reader versus the
+// block parser behind TextTrajectoryCodec.
+MT_BENCHMARK(TextParse)
+{
+    ScratchDirectory directory("text_parse");
+    std::string filename = directory.File("trajectory.crsdat");
+    Trajectory trajectory = MakeSyntheticTrajectory(settings.Samples, false);
+    const ITrajectoryCodec* codec = TrajectoryCodecRegistry::GetInstance().GetCodec("text");
+
+    codec->Write(filename, trajectory);
+
+    uint64_t bytes = std::filesystem::file_size(filename);
+    Trajectory loaded;
+    bool success = true;
+
+    double legacySeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        success = LegacyTextRead(filename, loaded) && loaded.GetPoints() == trajectory.GetPoints() && success;
+    });
+
+    double parserSeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        success = codec->Read(filename, loaded).Success && loaded.GetPoints() == trajectory.GetPoints() && success;
+    });
+
+    std::printf("%-22s %10s %12s %14s\n", "reader", "ms", "MB/s", "Mlines/s");
+    std::printf("%-22s %10.1f %12.1f %14.2f\n", "getline + stoi", legacySeconds * 1000.0,
+        ToMegabytesPerSecond(bytes, legacySeconds), trajectory.Size() / legacySeconds / 1e6);
+    std::printf("%-22s %10.1f %12.1f %14.2f\n", "block parser", parserSeconds * 1000.0,
+        ToMegabytesPerSecond(bytes, parserSeconds), trajectory.Size() / parserSeconds / 1e6);
+    std::printf("%s, %.1f MB file\n", success ? "results match" : "RESULTS DIFFER", bytes / (1024.0 * 1024.0));
+}
+
+// .crsdat save throughput: per-sample ofstream formatting versus the block writer.
+MT_BENCHMARK(TextWrite)
+{
+    ScratchDirectory directory("text_write");
+    std::string legacyFilename = directory.File("legacy.crsdat");
+    std::string writerFilename = directory.File("writer.crsdat");
+    Trajectory trajectory = MakeSyntheticTrajectory(settings.Samples, false);
+    const ITrajectoryCodec* codec = TrajectoryCodecRegistry::GetInstance().GetCodec("text");
+    bool success = true;
+
+    double legacySeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        std::ofstream file(legacyFilename);
+
+        for (const auto& point : trajectory)
+            file << point.x << ";" << point.y << "\n";
+
+        file.close();
+        success = !file.fail() && success;
+    });
+
+    double writerSeconds = MeasureBest(settings.Repetitions, [&]()
+    {
+        success = codec->Write(writerFilename, trajectory).Success && success;
+    });
+
+    std::ifstream legacyFile(legacyFilename, std::ios::binary);
+    std::ifstream writerFile(writerFilename, std::ios::binary);
+    std::string legacyText((std::istreambuf_iterator<char>(legacyFile)), std::istreambuf_iterator<char>());
+    std::string writerText((std::istreambuf_iterator<char>(writerFile)), std::istreambuf_iterator<char>());
+    uint64_t bytes = writerText.size();
+
+    std::printf("%-22s %10s %12s %14s\n", "writer", "ms", "MB/s", "Mlines/s");
+    std::printf("%-22s %10.1f %12.1f %14.2f\n", "ofstream <<", legacySeconds * 1000.0,
+        ToMegabytesPerSecond(bytes, legacySeconds), trajectory.Size() / legacySeconds / 1e6);
+    std::printf("%-22s %10.1f %12.1f %14.2f\n", "block writer", writerSeconds * 1000.0,
+        ToMegabytesPerSecond(bytes, writerSeconds), trajectory.Size() / writerSeconds / 1e6);
+    std::printf("%s, %.1f MB file\n", success && legacyText == writerText ? "outputs match" : "OUTPUTS DIFFER", bytes / (1024.0 * 1024.0));
+}
@@ -0,0 +1,254 @@
+#include "MtCore.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryResampler.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryStatistics.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+
+// The opaque handle is the C++ object itself.
+struct mt_trajectory
+{
+    Mt::MappedTrajectory Trajectory;
+
+    mt_trajectory() = default;
+
+    explicit mt_trajectory(Mt::Trajectory trajectory)
+        : Trajectory(std::move(trajectory))
+    {
+    }
+};
+
+namespace
+{
+    thread_local std::string LastError;
+
+    int Fail(std::string error)
+    {
+        LastError = std::move(error);
+
+        return MT_ERROR;
+    }
+
+    // Point is two int32s, so NumPy's (count, 2) int32 arrays are spans as they are.
+    static_assert(sizeof(Mt::Point) == 2 * sizeof(int32_t), "Point must match an int32 [count][2] array");
+
+    Mt::TrajectorySpan MakeSpan(const int32_t* points, const int64_t* timestamps, uint64_t count, uint32_t periodUs)
+    {
+        Mt::TrajectoryMetadata metadata;
+        metadata.PeriodUs = periodUs;
+
+        return Mt::TrajectorySpan(reinterpret_cast<const Mt::Point*>(points), timestamps, static_cast<size_t>(count), metadata);
+    }
+
+    // Exceptions must not cross the C boundary.
+    template<typename TCall>
+    int Guard(TCall&& call)
+    {
+        try
+        {
+            return call();
+        }
+        catch (const std::exception& e)
+        {
+            return Fail(e.what());
+        }
+        catch (...)
+        {
+            return Fail("Unknown error");
+        }
+    }
+
+    int Finish(const Mt::CodecResult& result, const char* path)
+    {
+        return result.Success ? MT_OK : Fail(result.Error.empty() ? std::string("Failed: ") + path : result.Error);
+    }
+}
+
+int mt_api_version(void)
+{
+    return MT_CORE_API_VERSION;
+}
+
+const char* mt_last_error(void)
+{
+    return LastError.c_str();
+}
+
+int mt_open(const char* path, mt_trajectory** trajectory)
+{
+    if (!path || !trajectory)
+        return Fail("Null argument");
+
+    *trajectory = nullptr;
+
+    return Guard([&]()
+    {
+        auto opened = std::make_unique<mt_trajectory>();
+        Mt::CodecResult result = opened->Trajectory.Open(path);
+
+        if (!result.Success)
+            return Finish(result, path);
+
+        *trajectory = opened.release();
+
+        return MT_OK;
+    });
+}
+
+int mt_open_archive_entry(const char* path, uint64_t entry, mt_trajectory** trajectory)
+{
+    if (!path || !trajectory)
+        return Fail("Null argument");
+
+    *trajectory = nullptr;
+
+    return Guard([&]()
+    {
+        Mt::TrajectoryArchive archive;
+        Mt::CodecResult result = archive.Open(path);
+
+        if (!result.Success)
+            return Finish(result, path);
+
+        if (entry >= archive.GetCount())
+            return Fail("No entry " + std::to_string(entry) + ", the archive has " + std::to_string(archive.GetCount()));
+
+        Mt::Trajectory decoded;
+        result = archive.Read(static_cast<size_t>(entry), decoded);
+
+        if (!result.Success)
+            return Finish(result, path);
+
+        *trajectory = new mt_trajectory(std::move(decoded));
+
+        return MT_OK;
+    });
+}
+
+void mt_close(mt_trajectory* trajectory)
+{
+    delete trajectory;
+}
+
+void mt_get_info(const mt_trajectory* trajectory, mt_trajectory_info* info)
+{
+    if (!info)
+        return;
+
+    *info = mt_trajectory_info();
+
+    if (!trajectory)
+        return;
+
+    const Mt::TrajectorySpan& span = trajectory->Trajectory.GetSpan();
+    const Mt::TrajectoryMetadata& metadata = span.GetMetadata();
+
+    info->samples = span.Size();
+    info->has_timestamps = span.HasTimestamps() ? 1 : 0;
+    info->period_us = metadata.PeriodUs;
+    info->start_time_us = metadata.StartTimeUs;
+    info->screen_width = metadata.ScreenWidth;
+    info->screen_height = metadata.ScreenHeight;
+}
+
+const int32_t* mt_get_points(const mt_trajectory* trajectory)
+{
+    return trajectory ? reinterpret_cast<const int32_t*>(trajectory->Trajectory.GetSpan().Points) : nullptr;
+}
+
+const int64_t* mt_get_timestamps(const mt_trajectory* trajectory)
+{
+    return trajectory && trajectory->Trajectory.GetSpan().HasTimestamps() ? trajectory->Trajectory.GetSpan().Timestamps : nullptr;
+}
+
+uint64_t mt_copy_samples(const mt_trajectory* trajectory, uint64_t first, uint64_t count, int32_t* points, int64_t* timestamps)
+{
+    if (!trajectory)
+        return 0;
+
+    const Mt::TrajectorySpan& span = trajectory->Trajectory.GetSpan();
+
+    if (first >= span.Size())
+        return 0;
+
+    size_t copied = static_cast<size_t>((std::min)(count, span.Size() - first));
+
+    if (points)
+        std::memcpy(points, span.Points + first, copied * sizeof(Mt::Point));
+
+    if (timestamps && span.HasTimestamps())
+        std::memcpy(timestamps, span.Timestamps + first, copied * sizeof(int64_t));
+
+    return copied;
+}
+
+int mt_write(const char* path, const char* codec, const int32_t* points, const int64_t* timestamps, uint64_t count, const mt_trajectory_info* info)
+{
+    if (!path || (!points && count > 0))
+        return Fail("Null argument");
+
+    return Guard([&]()
+    {
+        const auto& registry = Mt::TrajectoryCodecRegistry::GetInstance();
+        const Mt::ITrajectoryCodec* writer = codec ? registry.GetCodec(codec) : registry.GetCodecForFile(path);
+
+        if (!writer)
+            return Fail(std::string("Unknown codec: ") + codec);
+
+        Mt::TrajectorySpan span = MakeSpan(points, count > 0 ? timestamps : nullptr, count, info ? info->period_us : 0);
+
+        if (info)
+        {
+            span.Metadata.StartTimeUs = info->start_time_us;
+            span.Metadata.ScreenWidth = info->screen_width;
+            span.Metadata.ScreenHeight = info->screen_height;
+        }
+
+        return Finish(writer->Write(path, span), path);
+    });
+}
+
+uint64_t mt_resampled_size(const int64_t* timestamps, uint64_t count, uint32_t source_period_us, uint32_t period_us)
+{
+    // Only the clock is read, so no points are needed.
+    return Mt::TrajectoryResampler::GetResampledSize(MakeSpan(nullptr, timestamps, count, source_period_us), period_us);
+}
+
+uint64_t mt_resample(const int32_t* points, const int64_t* timestamps, uint64_t count, uint32_t source_period_us, uint32_t period_us,
+    int32_t* resampled_points, int64_t* resampled_timestamps, uint64_t capacity)
+{
+    if (!points)
+        return 0;
+
+    return Mt::TrajectoryResampler::Resample(MakeSpan(points, timestamps, count, source_period_us), period_us,
+        reinterpret_cast<Mt::Point*>(resampled_points), resampled_timestamps, static_cast<size_t>(capacity));
+}
+
+void mt_compute_statistics(const int32_t* points, const int64_t* timestamps, uint64_t count, uint32_t period_us, mt_statistics* statistics)
+{
+    if (!statistics)
+        return;
+
+    *statistics = mt_statistics();
+
+    if (!points)
+        return;
+
+    Mt::TrajectoryStatistics computed = Mt::TrajectoryStatistics::Compute(MakeSpan(points, timestamps, count, period_us));
+
+    statistics->samples = computed.Samples;
+    statistics->duration_us = computed.DurationUs;
+    statistics->min_x = computed.MinX;
+    statistics->min_y = computed.MinY;
+    statistics->max_x = computed.MaxX;
+    statistics->max_y = computed.MaxY;
+    statistics->path_length = computed.PathLength;
+    statistics->mean_speed = computed.MeanSpeed;
+    statistics->max_speed = computed.MaxSpeed;
+    statistics->max_interval_us = computed.MaxIntervalUs;
+}
@@ -0,0 +1,117 @@
+#ifndef __MOUSE_TRACKER_CORE_C_API__
+#define __MOUSE_TRACKER_CORE_C_API__
+
+/*
+ * C ABI of the core library, built as libmtcore.so / mtcore.dll for Python
+ * (ctypes) and other languages. Every reader, writer and kernel is the same
+ * code the C++ tools run.
+ *
+ * Points are int32 x, y pairs ([count][2], the layout of a NumPy int32
+ * array of shape (count, 2)) and timestamps int64 microseconds relative to
+ * start_time_us. Callers own every buffer passed in; nothing is retained
+ * after a call returns. Functions returning int give MT_OK or MT_ERROR, and
+ * mt_last_error describes the last failure on the calling thread.
+ *
+ * Only functions are exported and structs are only ever appended to, so a
+ * newer library keeps working with older bindings; MT_CORE_API_VERSION goes
+ * up whenever something is added.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+    #if defined(MT_CORE_C_API_EXPORTS)
+        #define MT_CORE_API __declspec(dllexport)
+    #else
+        #define MT_CORE_API __declspec(dllimport)
+    #endif
+#else
+    #define MT_CORE_API __attribute__((visibility("default")))
+#endif
+
+#define MT_CORE_API_VERSION 1
+
+#define MT_OK 0
+#define MT_ERROR (-1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A loaded trajectory. Fixed-width .crsbin files stay memory-mapped; other
+   codecs are decoded once into memory the handle owns. */
+typedef struct mt_trajectory mt_trajectory;
+
+typedef struct mt_trajectory_info
+{
+    uint64_t samples;
+    int32_t has_timestamps;
+
+    /* 0 when unknown, e.g. for text files. */
+    uint32_t period_us;
+    int64_t start_time_us;
+    int32_t screen_width;
+    int32_t screen_height;
+} mt_trajectory_info;
+
+typedef struct mt_statistics
+{
+    uint64_t samples;
+    int64_t duration_us;
+    int32_t min_x;
+    int32_t min_y;
+    int32_t max_x;
+    int32_t max_y;
+    double path_length;
+
+    /* Pixels per second: over the whole duration, and the fastest segment. */
+    double mean_speed;
+    double max_speed;
+    int64_t max_interval_us;
+} mt_statistics;
+
+MT_CORE_API int mt_api_version(void);
+
+/* Valid until the next failing call on the same thread. */
+MT_CORE_API const char* mt_last_error(void);
+
+/* Any trajectory file, codec picked from its contents and extension. */
+MT_CORE_API int mt_open(const char* path, mt_trajectory** trajectory);
+
+MT_CORE_API int mt_open_archive_entry(const char* path, uint64_t entry, mt_trajectory** trajectory);
+
+MT_CORE_API void mt_close(mt_trajectory* trajectory);
+
+MT_CORE_API void mt_get_info(const mt_trajectory* trajectory, mt_trajectory_info* info);
+
+/* The columns in place, valid until mt_close: wrap them (numpy.ctypeslib.
+   as_array) to read without any copy. Timestamps are null when absent. */
+MT_CORE_API const int32_t* mt_get_points(const mt_trajectory* trajectory);
+MT_CORE_API const int64_t* mt_get_timestamps(const mt_trajectory* trajectory);
+
+/* Copies samples [first, first + count) into caller buffers (either may be
+   null) and returns how many were copied. */
+MT_CORE_API uint64_t mt_copy_samples(const mt_trajectory* trajectory, uint64_t first, uint64_t count, int32_t* points, int64_t* timestamps);
+
+/* Writes the columns without copying them. The codec is a name such as
+   "text", "binary", "binary-delta" or "binary-predictive", or null to pick
+   it from the extension. timestamps and info may be null. */
+MT_CORE_API int mt_write(const char* path, const char* codec, const int32_t* points, const int64_t* timestamps, uint64_t count, const mt_trajectory_info* info);
+
+/* Resampling onto a uniform period_us clock by linear interpolation (see
+   TrajectoryResampler). Without timestamps the input is taken to be sampled
+   every source_period_us. mt_resample writes at most capacity samples and
+   returns how many it wrote. */
+MT_CORE_API uint64_t mt_resampled_size(const int64_t* timestamps, uint64_t count, uint32_t source_period_us, uint32_t period_us);
+
+MT_CORE_API uint64_t mt_resample(const int32_t* points, const int64_t* timestamps, uint64_t count, uint32_t source_period_us, uint32_t period_us,
+    int32_t* resampled_points, int64_t* resampled_timestamps, uint64_t capacity);
+
+MT_CORE_API void mt_compute_statistics(const int32_t* points, const int64_t* timestamps, uint64_t count, uint32_t period_us, mt_statistics* statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
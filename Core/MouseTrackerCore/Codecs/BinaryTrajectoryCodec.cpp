@@ -0,0 +1,565 @@
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/VarInt.h"
+#include "MouseTrackerCore/Codecs/Crc32.h"
+#include "MouseTrackerCore/Codecs/PredictiveCoder.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace Mt
+{
+    static_assert(sizeof(Point) == 2 * sizeof(int32_t), "Fixed columns are copied as raw Point arrays");
+
+    namespace
+    {
+        // Loads every intact chunk. Damage is reported, not treated as an
+        // error: one warning for a torn tail (a crash mid-chunk) and one for
+        // all corrupt chunks together, however many there are.
+        CodecResult DecodeChunks(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size, Trajectory& trajectory, const DecodeProgress& progress)
+        {
+            bool hasTimestamps = header.HasTimestamps();
+            bool cancelled = false;
+            auto& points = trajectory.GetPoints();
+            auto& timestamps = trajectory.GetTimestamps();
+
+            // Sizes the columns once when the file was closed cleanly.
+            if (header.SampleCount > 0 && header.SampleCount <= size / sizeof(Point))
+                trajectory.Reserve(static_cast<size_t>(header.SampleCount), hasTimestamps);
+
+            ChunkScanResult scan = BinaryTrajectoryCodec::ScanChunks(header, data, size, [&](const BinaryChunkHeader& chunk, const uint8_t* columns)
+            {
+                if (cancelled)
+                    return;
+
+                size_t count = chunk.SampleCount;
+                size_t offset = points.size();
+
+                points.resize(offset + count);
+                std::memcpy(points.data() + offset, columns, count * sizeof(Point));
+
+                if (hasTimestamps)
+                {
+                    timestamps.resize(offset + count);
+                    std::memcpy(timestamps.data() + offset, columns + count * sizeof(Point), count * sizeof(int64_t));
+                }
+
+                if (progress && !progress(points.size(), static_cast<uint64_t>(columns - data) + chunk.PayloadBytes))
+                    cancelled = true;
+            });
+
+            if (cancelled)
+                return CodecResult::Fail("Cancelled");
+
+            CodecResult result = CodecResult::Ok();
+
+            if (scan.CorruptChunks > 0 || scan.SkippedBytes > 0)
+            {
+                result.MalformedRecords += scan.CorruptChunks + (scan.SkippedBytes > 0 ? 1 : 0);
+                result.Warnings.push_back("Recording damaged: " + std::to_string(scan.CorruptChunks) + " corrupt chunks (" +
+                    std::to_string(scan.LostSamples) + " samples) and " + std::to_string(scan.SkippedBytes) + " unreadable bytes skipped, first at payload byte " +
+                    std::to_string(scan.FirstDamageOffset) + "; " + std::to_string(scan.Chunks) + " intact chunks loaded");
+            }
+
+            if (scan.TrailingBytes > 0)
+            {
+                result.MalformedRecords++;
+                result.Warnings.push_back("Recording truncated: " + std::to_string(scan.TrailingBytes) + " bytes after chunk " + std::to_string(scan.Chunks) + " ignored");
+            }
+            else if (header.SampleCount == 0 && scan.Chunks > 0)
+            {
+                result.Warnings.push_back("Recording was not closed; loaded " + std::to_string(points.size()) + " samples");
+            }
+
+            return result;
+        }
+
+        bool IsFramed(const BinaryChunkHeader& chunk, bool hasTimestamps, size_t available)
+        {
+            return chunk.Magic == BinaryChunkHeader::MagicValue &&
+                chunk.PayloadBytes == BinaryTrajectoryHeader::GetFixedPayloadBytes(chunk.SampleCount, hasTimestamps) &&
+                chunk.PayloadBytes <= available - sizeof(BinaryChunkHeader);
+        }
+
+        // Offset of the next chunk at or after from whose checksum holds, or
+        // size. Sample bytes that happen to spell the magic fail the checksum.
+        size_t FindIntactChunk(const uint8_t* data, size_t size, size_t from, bool hasTimestamps)
+        {
+            constexpr uint8_t FirstMagicByte = BinaryChunkHeader::MagicValue & 0xFF;
+
+            while (size - from >= sizeof(BinaryChunkHeader))
+            {
+                const void* found = std::memchr(data + from, FirstMagicByte, size - from - sizeof(BinaryChunkHeader) + 1);
+
+                if (!found)
+                    break;
+
+                size_t candidate = static_cast<size_t>(static_cast<const uint8_t*>(found) - data);
+                BinaryChunkHeader chunk;
+                std::memcpy(&chunk, data + candidate, sizeof(chunk));
+
+                if (IsFramed(chunk, hasTimestamps, size - candidate) && Crc32::Compute(data + candidate + sizeof(chunk), chunk.PayloadBytes) == chunk.Checksum)
+                    return candidate;
+
+                from = candidate + 1;
+            }
+
+            return size;
+        }
+
+        void WriteDeltaColumn(std::vector<uint8_t>& output, int64_t& previous, int64_t value)
+        {
+            VarInt::Write(output, VarInt::ZigZagEncode(value - previous));
+            previous = value;
+        }
+
+        bool ReadDeltaColumn(const uint8_t* data, size_t size, size_t& position, int64_t& previous)
+        {
+            uint64_t encoded = 0;
+
+            if (!VarInt::Read(data, size, position, encoded))
+                return false;
+
+            previous += VarInt::ZigZagDecode(encoded);
+
+            return true;
+        }
+    }
+
+    BinaryTrajectoryHeader BinaryTrajectoryCodec::MakeHeader(const TrajectorySpan& trajectory, BinaryEncoding encoding)
+    {
+        const TrajectoryMetadata& metadata = trajectory.GetMetadata();
+
+        BinaryTrajectoryHeader header;
+        header.Encoding = static_cast<uint8_t>(encoding);
+        header.Flags = trajectory.HasTimestamps() ? BinaryTrajectoryFlags::HasTimestamps : 0;
+
+        if (encoding == BinaryEncoding::Chunked)
+            header.Flags |= BinaryTrajectoryFlags::ChunkChecksums;
+
+        header.PeriodUs = metadata.PeriodUs;
+        header.StartTimeUs = metadata.StartTimeUs;
+        header.ScreenWidth = metadata.ScreenWidth;
+        header.ScreenHeight = metadata.ScreenHeight;
+        header.SampleCount = trajectory.Size();
+
+        return header;
+    }
+
+    std::vector<uint8_t> BinaryTrajectoryCodec::EncodePayload(const TrajectorySpan& trajectory, BinaryEncoding encoding)
+    {
+        std::vector<uint8_t> payload;
+        bool hasTimestamps = trajectory.HasTimestamps();
+
+        if (encoding == BinaryEncoding::Fixed)
+        {
+            size_t pointBytes = trajectory.Size() * sizeof(Point);
+            size_t timestampBytes = hasTimestamps ? trajectory.Size() * sizeof(int64_t) : 0;
+
+            payload.resize(pointBytes + timestampBytes);
+
+            if (pointBytes > 0)
+                std::memcpy(payload.data(), trajectory.Points, pointBytes);
+
+            if (timestampBytes > 0)
+                std::memcpy(payload.data() + pointBytes, trajectory.Timestamps, timestampBytes);
+
+            return payload;
+        }
+
+        if (encoding == BinaryEncoding::Chunked)
+        {
+            constexpr size_t ChunkSamples = 4096;
+
+            for (size_t offset = 0; offset < trajectory.Size(); offset += ChunkSamples)
+            {
+                size_t count = std::min(ChunkSamples, trajectory.Size() - offset);
+
+                AppendChunk(payload, trajectory.Points + offset, hasTimestamps ? trajectory.Timestamps + offset : nullptr, count);
+            }
+
+            return payload;
+        }
+
+        if (encoding == BinaryEncoding::Predictive)
+        {
+            PredictiveCoder::Encode(trajectory, payload);
+
+            return payload;
+        }
+
+        // Mostly one or two bytes per value for 1 ms cursor samples.
+        payload.reserve(trajectory.Size() * (hasTimestamps ? 5 : 3));
+
+        int64_t previousX = 0;
+        int64_t previousY = 0;
+
+        for (const auto& point : trajectory)
+        {
+            WriteDeltaColumn(payload, previousX, point.x);
+            WriteDeltaColumn(payload, previousY, point.y);
+        }
+
+        if (hasTimestamps)
+        {
+            int64_t previousTimestamp = 0;
+
+            for (size_t i = 0; i < trajectory.Size(); i++)
+                WriteDeltaColumn(payload, previousTimestamp, trajectory.Timestamps[i]);
+        }
+
+        return payload;
+    }
+
+    void BinaryTrajectoryCodec::AppendChunk(std::vector<uint8_t>& output, const Point* points, const int64_t* timestamps, size_t count)
+    {
+        BinaryChunkHeader chunk;
+        chunk.SampleCount = static_cast<uint32_t>(count);
+        chunk.PayloadBytes = static_cast<uint32_t>(BinaryTrajectoryHeader::GetFixedPayloadBytes(count, timestamps != nullptr));
+
+        size_t offset = output.size();
+        output.resize(offset + sizeof(chunk) + chunk.PayloadBytes);
+
+        uint8_t* cursor = output.data() + offset;
+        std::memcpy(cursor, &chunk, sizeof(chunk));
+        cursor += sizeof(chunk);
+
+        if (count > 0)
+            std::memcpy(cursor, points, count * sizeof(Point));
+
+        if (timestamps && count > 0)
+            std::memcpy(cursor + count * sizeof(Point), timestamps, count * sizeof(int64_t));
+
+        chunk.Checksum = Crc32::Compute(cursor, chunk.PayloadBytes);
+        std::memcpy(output.data() + offset, &chunk, sizeof(chunk));
+    }
+
+    ChunkScanResult BinaryTrajectoryCodec::ScanChunks(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size, const ChunkVisitor& visitor)
+    {
+        bool hasTimestamps = header.HasTimestamps();
+        bool checksums = header.HasChunkChecksums();
+        ChunkScanResult scan;
+        size_t position = 0;
+
+        auto markDamage = [&scan](size_t offset)
+        {
+            if (!scan.IsDamaged())
+                scan.FirstDamageOffset = offset;
+        };
+
+        while (size - position >= sizeof(BinaryChunkHeader))
+        {
+            BinaryChunkHeader chunk;
+            std::memcpy(&chunk, data + position, sizeof(chunk));
+
+            bool framed = IsFramed(chunk, hasTimestamps, size - position);
+            const uint8_t* columns = data + position + sizeof(chunk);
+
+            if (framed && (!checksums || Crc32::Compute(columns, chunk.PayloadBytes) == chunk.Checksum))
+            {
+                visitor(chunk, columns);
+
+                scan.Chunks++;
+                scan.Samples += chunk.SampleCount;
+                position += sizeof(chunk) + chunk.PayloadBytes;
+
+                continue;
+            }
+
+            // Without checksums nothing after a bad frame can be trusted.
+            if (!checksums)
+                break;
+
+            // A header that frames but fails its checksum may have a damaged
+            // length too, so the search for the next chunk starts right after it.
+            size_t next = FindIntactChunk(data, size, position + 1, hasTimestamps);
+
+            // Unframed bytes with nothing intact after them are a torn tail.
+            if (!framed && next == size)
+                break;
+
+            markDamage(position);
+
+            if (framed)
+            {
+                scan.CorruptChunks++;
+                scan.LostSamples += chunk.SampleCount;
+            }
+            else
+            {
+                scan.SkippedBytes += next - position;
+            }
+
+            position = next;
+        }
+
+        if (position < size)
+        {
+            markDamage(position);
+            scan.TrailingBytes = size - position;
+        }
+
+        return scan;
+    }
+
+    CodecResult BinaryTrajectoryCodec::DecodePayload(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size, Trajectory& trajectory, const DecodeProgress& progress)
+    {
+        size_t count = static_cast<size_t>(header.SampleCount);
+        bool hasTimestamps = header.HasTimestamps();
+
+        trajectory.Clear();
+        trajectory.SetMetadata(header.GetMetadata());
+
+        if (header.GetEncoding() == BinaryEncoding::Fixed)
+        {
+            if (header.SampleCount > size / BinaryTrajectoryHeader::GetSampleBytes(hasTimestamps))
+                return CodecResult::Fail("Truncated payload");
+
+            auto& points = trajectory.GetPoints();
+            points.resize(count);
+
+            if (count > 0)
+                std::memcpy(points.data(), data, count * sizeof(Point));
+
+            if (hasTimestamps && count > 0)
+            {
+                auto& timestamps = trajectory.GetTimestamps();
+                timestamps.resize(count);
+                std::memcpy(timestamps.data(), data + count * sizeof(Point), count * sizeof(int64_t));
+            }
+
+            return CodecResult::Ok();
+        }
+
+        if (header.GetEncoding() == BinaryEncoding::Chunked)
+            return DecodeChunks(header, data, size, trajectory, progress);
+
+        if (header.GetEncoding() == BinaryEncoding::Predictive)
+            return PredictiveCoder::Decode(data, size, count, hasTimestamps, trajectory, progress);
+
+        // Every varint takes at least one byte, which bounds the reservation
+        // even when the header lies about the sample count.
+        if (header.SampleCount > size)
+            return CodecResult::Fail("Truncated payload");
+
+        trajectory.Reserve(count, hasTimestamps);
+
+        auto& points = trajectory.GetPoints();
+        size_t position = 0;
+        int64_t x = 0;
+        int64_t y = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!ReadDeltaColumn(data, size, position, x) || !ReadDeltaColumn(data, size, position, y))
+                return CodecResult::Fail("Truncated payload at sample " + std::to_string(i));
+
+            points.push_back(Point { static_cast<int32_t>(x), static_cast<int32_t>(y) });
+
+            if (progress && (i + 1) % ProgressSamples == 0 && !progress(i + 1, position))
+                return CodecResult::Fail("Cancelled");
+        }
+
+        if (hasTimestamps)
+        {
+            auto& timestamps = trajectory.GetTimestamps();
+            int64_t timestamp = 0;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                if (!ReadDeltaColumn(data, size, position, timestamp))
+                    return CodecResult::Fail("Truncated timestamps at sample " + std::to_string(i));
+
+                timestamps.push_back(timestamp);
+
+                // Points are complete by now; only the bytes move on.
+                if (progress && (i + 1) % ProgressSamples == 0 && !progress(count, position))
+                    return CodecResult::Fail("Cancelled");
+            }
+        }
+
+        return CodecResult::Ok();
+    }
+
+    CodecResult BinaryTrajectoryCodec::CheckColumns(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size)
+    {
+        bool hasTimestamps = header.HasTimestamps();
+
+        switch (header.GetEncoding())
+        {
+            case BinaryEncoding::Fixed:
+                if (header.SampleCount > size / BinaryTrajectoryHeader::GetSampleBytes(hasTimestamps))
+                    return CodecResult::Fail("Truncated payload");
+
+                break;
+
+            case BinaryEncoding::DeltaVarint:
+                // Every varint takes at least one byte.
+                if (header.SampleCount > size)
+                    return CodecResult::Fail("Truncated payload");
+
+                break;
+
+            case BinaryEncoding::Predictive:
+                return PredictiveCoder::CheckPayload(data, size, static_cast<size_t>(header.SampleCount), hasTimestamps);
+
+            case BinaryEncoding::Chunked:
+                return CodecResult::Fail("Chunked payloads have no fixed sample count");
+        }
+
+        return CodecResult::Ok();
+    }
+
+    CodecResult BinaryTrajectoryCodec::DecodeColumns(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size, Point* points, int64_t* timestamps)
+    {
+        CodecResult result = CheckColumns(header, data, size);
+
+        if (!result.Success)
+            return result;
+
+        size_t count = static_cast<size_t>(header.SampleCount);
+        bool hasTimestamps = header.HasTimestamps();
+
+        if (!hasTimestamps)
+            timestamps = nullptr;
+
+        if (header.GetEncoding() == BinaryEncoding::Fixed)
+        {
+            if (count > 0)
+                std::memcpy(points, data, count * sizeof(Point));
+
+            if (timestamps && count > 0)
+                std::memcpy(timestamps, data + count * sizeof(Point), count * sizeof(int64_t));
+
+            return CodecResult::Ok();
+        }
+
+        if (header.GetEncoding() == BinaryEncoding::Predictive)
+            return PredictiveCoder::DecodeColumns(data, size, count, hasTimestamps, points, timestamps);
+
+        size_t position = 0;
+        int64_t x = 0;
+        int64_t y = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!ReadDeltaColumn(data, size, position, x) || !ReadDeltaColumn(data, size, position, y))
+                return CodecResult::Fail("Truncated payload at sample " + std::to_string(i));
+
+            points[i] = Point { static_cast<int32_t>(x), static_cast<int32_t>(y) };
+        }
+
+        if (timestamps)
+        {
+            int64_t timestamp = 0;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                if (!ReadDeltaColumn(data, size, position, timestamp))
+                    return CodecResult::Fail("Truncated timestamps at sample " + std::to_string(i));
+
+                timestamps[i] = timestamp;
+            }
+        }
+
+        return CodecResult::Ok();
+    }
+
+    CodecResult BinaryTrajectoryCodec::Read(const std::string& filename, Trajectory& trajectory) const
+    {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+
+        if (!file.is_open())
+            return CodecResult::Fail("Unable to open " + filename);
+
+        uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+
+        BinaryTrajectoryHeader header;
+
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return CodecResult::Fail("Truncated header in " + filename);
+
+        std::string error = header.Validate();
+
+        if (!error.empty())
+            return CodecResult::Fail(error + ": " + filename);
+
+        uint64_t payloadBytes = header.GetPayloadBytes(fileSize);
+
+        if (!header.FitsIn(fileSize))
+            return CodecResult::Fail("Truncated payload in " + filename);
+
+        file.seekg(header.HeaderSize);
+
+        // Fixed columns are read straight into the trajectory, no staging copy.
+        if (header.GetEncoding() == BinaryEncoding::Fixed)
+        {
+            size_t count = static_cast<size_t>(header.SampleCount);
+
+            trajectory.Clear();
+            trajectory.SetMetadata(header.GetMetadata());
+            trajectory.GetPoints().resize(count);
+
+            if (header.HasTimestamps())
+                trajectory.GetTimestamps().resize(count);
+
+            file.read(reinterpret_cast<char*>(trajectory.GetPoints().data()), static_cast<std::streamsize>(count * sizeof(Point)));
+
+            if (header.HasTimestamps())
+                file.read(reinterpret_cast<char*>(trajectory.GetTimestamps().data()), static_cast<std::streamsize>(count * sizeof(int64_t)));
+
+            if (!file)
+                return CodecResult::Fail("Read failed for " + filename);
+
+            return CodecResult::Ok();
+        }
+
+        std::vector<uint8_t> payload(static_cast<size_t>(payloadBytes));
+
+        if (!file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size())))
+            return CodecResult::Fail("Read failed for " + filename);
+
+        CodecResult result = DecodePayload(header, payload.data(), payload.size(), trajectory);
+
+        if (!result.Success)
+            result.Error += ": " + filename;
+
+        return result;
+    }
+
+    CodecResult BinaryTrajectoryCodec::Write(const std::string& filename, const TrajectorySpan& trajectory) const
+    {
+        std::ofstream file(filename, std::ios::binary);
+
+        if (!file.is_open())
+            return CodecResult::Fail("Unable to open " + filename);
+
+        BinaryTrajectoryHeader header = MakeHeader(trajectory, m_encoding);
+
+        if (m_encoding == BinaryEncoding::Fixed)
+        {
+            header.PayloadBytes = BinaryTrajectoryHeader::GetFixedPayloadBytes(header.SampleCount, header.HasTimestamps());
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(trajectory.Points), static_cast<std::streamsize>(trajectory.Size() * sizeof(Point)));
+
+            if (header.HasTimestamps())
+                file.write(reinterpret_cast<const char*>(trajectory.Timestamps), static_cast<std::streamsize>(trajectory.Size() * sizeof(int64_t)));
+        }
+        else
+        {
+            std::vector<uint8_t> payload = EncodePayload(trajectory, m_encoding);
+            header.PayloadBytes = payload.size();
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        }
+
+        file.close();
+
+        if (file.fail())
+            return CodecResult::Fail("Write failed for " + filename);
+
+        return CodecResult::Ok();
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef __MOUSE_TRACKER_CORE_BINARYTRAJECTORYCODEC__
+#define __MOUSE_TRACKER_CORE_BINARYTRAJECTORYCODEC__
+
+#include "MouseTrackerCore/Codecs/ITrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryFormat.h"
+#include <vector>
+#include <functional>
+
+namespace Mt
+{
+    // What a walk over a Chunked payload found. Damage is counted in
+    // regions: a chunk failing its checksum, garbage skipped to find the
+    // next chunk, or a torn tail.
+    struct ChunkScanResult
+    {
+        uint64_t Chunks = 0;
+        uint64_t Samples = 0;
+
+        // Chunks whose columns fail their checksum, and the samples their
+        // headers claim (a damaged header may claim anything).
+        uint64_t CorruptChunks = 0;
+        uint64_t LostSamples = 0;
+
+        // Bytes passed over to resynchronize on the next intact chunk.
+        uint64_t SkippedBytes = 0;
+
+        // Bytes after the last chunk, usually a chunk cut short by a crash.
+        uint64_t TrailingBytes = 0;
+
+        // Payload offset of the first damage; meaningful when IsDamaged().
+        uint64_t FirstDamageOffset = 0;
+
+        bool IsDamaged() const
+        {
+            return CorruptChunks > 0 || SkippedBytes > 0 || TrailingBytes > 0;
+        }
+    };
+
+    using ChunkVisitor = std::function<void(const BinaryChunkHeader& chunk, const uint8_t* columns)>;
+
+    // Versioned .crsbin format (see BinaryTrajectoryFormat.h). Keeps the
+    // metadata and timestamps that the text format drops. Reading accepts
+    // every encoding; the encoding only selects what Write produces.
+    class BinaryTrajectoryCodec : public ITrajectoryCodec
+    {
+        private:
+            BinaryEncoding m_encoding;
+
+        public:
+            explicit BinaryTrajectoryCodec(BinaryEncoding encoding = BinaryEncoding::Fixed)
+            {
+                m_encoding = encoding;
+            }
+
+            CodecResult Read(const std::string& filename, Trajectory& trajectory) const override;
+            CodecResult Write(const std::string& filename, const TrajectorySpan& trajectory) const override;
+
+            const char* GetName() const override
+            {
+                switch (m_encoding)
+                {
+                    case BinaryEncoding::DeltaVarint:
+                        return "binary-delta";
+
+                    case BinaryEncoding::Chunked:
+                        return "binary-chunked";
+
+                    case BinaryEncoding::Predictive:
+                        return "binary-predictive";
+
+                    default:
+                        return "binary";
+                }
+            }
+
+            const char* GetExtension() const override
+            {
+                return ".crsbin";
+            }
+
+            bool KeepsTimestamps() const override
+            {
+                return true;
+            }
+
+            static BinaryTrajectoryHeader MakeHeader(const TrajectorySpan& trajectory, BinaryEncoding encoding);
+
+            // Payload without the header; for Fixed this is the raw columns.
+            static std::vector<uint8_t> EncodePayload(const TrajectorySpan& trajectory, BinaryEncoding encoding);
+
+            // Appends one Chunked-encoding frame with its checksum; timestamps may be null.
+            static void AppendChunk(std::vector<uint8_t>& output, const Point* points, const int64_t* timestamps, size_t count);
+
+            // Calls visitor for every intact chunk, in file order. Without
+            // checksums (older files) the walk stops at the first frame that
+            // does not fit, as a torn tail.
+            static ChunkScanResult ScanChunks(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size, const ChunkVisitor& visitor);
+
+            // Samples between progress reports of the delta decoder; the
+            // chunked and predictive decoders report once per chunk or block.
+            static constexpr size_t ProgressSamples = 65536;
+
+            // Decodes a payload already validated against its header. With
+            // progress, reports as it goes and stops when asked to (not for
+            // Fixed payloads, which are a single copy).
+            static CodecResult DecodePayload(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size, Trajectory& trajectory, const DecodeProgress& progress = nullptr);
+
+            // Checks that a non-Chunked payload of size bytes can hold
+            // header.SampleCount samples, so callers can size storage from the
+            // header before trusting it. Reads no more than the first
+            // CheckBytes of data.
+            static constexpr size_t CheckBytes = 16;
+
+            static CodecResult CheckColumns(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size);
+
+            // Decodes a non-Chunked payload straight into header.SampleCount
+            // caller-owned slots, skipping the timestamps when they are null.
+            static CodecResult DecodeColumns(const BinaryTrajectoryHeader& header, const uint8_t* data, size_t size, Point* points, int64_t* timestamps);
+    };
+}
+
+#endif
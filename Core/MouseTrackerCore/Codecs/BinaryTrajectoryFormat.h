@@ -0,0 +1,198 @@
+#ifndef __MOUSE_TRACKER_CORE_BINARYTRAJECTORYFORMAT__
+#define __MOUSE_TRACKER_CORE_BINARYTRAJECTORYFORMAT__
+
+#include "MouseTrackerCore/Trajectory/TrajectoryMetadata.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace Mt
+{
+    // .crsbin layout, little endian:
+    //
+    //   BinaryTrajectoryHeader (HeaderSize bytes, 64 in version 1)
+    //   payload (PayloadBytes bytes), columns one after another:
+    //     points     - SampleCount x (int32 x, int32 y)
+    //     timestamps - SampleCount x int64 us, only with HasTimestamps
+    //
+    // With DeltaVarint encoding every value is stored as the zigzag LEB128
+    // varint of its difference to the previous value of the same column
+    // (x and y are separate columns interleaved per sample).
+    //
+    // Chunked files are appended to while recording: the payload is a run of
+    // BinaryChunkHeader + fixed columns for that chunk's samples, and extends
+    // to the end of the file. SampleCount and PayloadBytes stay 0 until the
+    // recording is closed, and a torn last chunk is ignored on load. With
+    // ChunkChecksums every chunk header carries the CRC-32 of its columns;
+    // a chunk that fails it is skipped and the reader resynchronizes on the
+    // next intact chunk, so damage costs only the chunks it touched.
+    //
+    // Predictive payloads are for archival: each column is extrapolated from
+    // its last samples and the residuals are rANS coded in blocks (layout in
+    // PredictiveCoder.h).
+    enum class BinaryEncoding : uint8_t
+    {
+        Fixed = 0,
+        DeltaVarint = 1,
+        Chunked = 2,
+        Predictive = 3
+    };
+
+    namespace BinaryTrajectoryFlags
+    {
+        constexpr uint32_t HasTimestamps = 1u << 0;
+
+        // Chunked encoding only; older readers ignore the flag and the checksums.
+        constexpr uint32_t ChunkChecksums = 1u << 1;
+    }
+
+    struct BinaryTrajectoryHeader
+    {
+        static constexpr uint32_t MagicValue = 0x4A52544D; // "MTRJ"
+        static constexpr uint16_t CurrentVersion = 1;
+
+        uint32_t Magic = MagicValue;
+        uint16_t Version = CurrentVersion;
+
+        // Readers skip to HeaderSize, so later versions can append fields.
+        uint16_t HeaderSize = sizeof(BinaryTrajectoryHeader);
+
+        uint32_t Flags = 0;
+        uint8_t Encoding = static_cast<uint8_t>(BinaryEncoding::Fixed);
+        uint8_t Reserved0[3] = {};
+        uint32_t PeriodUs = 0;
+        int32_t ScreenWidth = 0;
+        int32_t ScreenHeight = 0;
+        uint32_t Reserved1 = 0;
+        int64_t StartTimeUs = 0;
+        uint64_t SampleCount = 0;
+        uint64_t PayloadBytes = 0;
+        uint8_t Reserved2[8] = {};
+
+        bool HasTimestamps() const
+        {
+            return (Flags & BinaryTrajectoryFlags::HasTimestamps) != 0;
+        }
+
+        bool HasChunkChecksums() const
+        {
+            return (Flags & BinaryTrajectoryFlags::ChunkChecksums) != 0;
+        }
+
+        BinaryEncoding GetEncoding() const
+        {
+            return static_cast<BinaryEncoding>(Encoding);
+        }
+
+        TrajectoryMetadata GetMetadata() const
+        {
+            TrajectoryMetadata metadata;
+            metadata.PeriodUs = PeriodUs;
+            metadata.StartTimeUs = StartTimeUs;
+            metadata.ScreenWidth = ScreenWidth;
+            metadata.ScreenHeight = ScreenHeight;
+
+            return metadata;
+        }
+
+        // Empty when the header can be read by this version, otherwise the reason.
+        std::string Validate() const
+        {
+            if (Magic != MagicValue)
+                return "Not a binary trajectory file";
+
+            if (Version == 0 || Version > CurrentVersion)
+                return "Unsupported binary trajectory version " + std::to_string(Version);
+
+            if (HeaderSize < sizeof(BinaryTrajectoryHeader))
+                return "Invalid header size";
+
+            if (Encoding > static_cast<uint8_t>(BinaryEncoding::Predictive))
+                return "Unknown encoding " + std::to_string(Encoding);
+
+            // Divided rather than multiplied, so a huge SampleCount cannot wrap
+            // into a small, matching payload size.
+            uint64_t sampleBytes = GetSampleBytes(HasTimestamps());
+
+            if (GetEncoding() == BinaryEncoding::Fixed && (PayloadBytes % sampleBytes != 0 || SampleCount != PayloadBytes / sampleBytes))
+                return "Payload size does not match sample count";
+
+            return "";
+        }
+
+        // Bytes of payload to decode from a file of this size; a chunked file
+        // may still be growing, so everything after the header counts.
+        uint64_t GetPayloadBytes(uint64_t fileSize) const
+        {
+            if (GetEncoding() != BinaryEncoding::Chunked)
+                return PayloadBytes;
+
+            return fileSize > HeaderSize ? fileSize - HeaderSize : 0;
+        }
+
+        // True when header and payload lie within a file of this size. Every
+        // term is compared against what is left of the file, never summed, so
+        // a hostile PayloadBytes or SampleCount cannot wrap past the check.
+        bool FitsIn(uint64_t fileSize) const
+        {
+            if (HeaderSize > fileSize)
+                return false;
+
+            uint64_t available = fileSize - HeaderSize;
+
+            if (GetEncoding() == BinaryEncoding::Fixed && SampleCount > available / GetSampleBytes(HasTimestamps()))
+                return false;
+
+            return GetPayloadBytes(fileSize) <= available;
+        }
+
+        static uint64_t GetSampleBytes(bool hasTimestamps)
+        {
+            return 2 * sizeof(int32_t) + (hasTimestamps ? sizeof(int64_t) : 0);
+        }
+
+        // Saturates instead of wrapping for counts no file can hold.
+        static uint64_t GetFixedPayloadBytes(uint64_t sampleCount, bool hasTimestamps)
+        {
+            uint64_t sampleBytes = GetSampleBytes(hasTimestamps);
+
+            if (sampleCount > UINT64_MAX / sampleBytes)
+                return UINT64_MAX;
+
+            return sampleCount * sampleBytes;
+        }
+    };
+
+    static_assert(sizeof(BinaryTrajectoryHeader) == 64, "Binary trajectory header must stay 64 bytes");
+
+    // Frames one chunk of a Chunked payload. PayloadBytes covers the columns
+    // that follow, so a reader can tell a complete chunk from a torn one.
+    struct BinaryChunkHeader
+    {
+        static constexpr uint32_t MagicValue = 0x4B43544D; // "MTCK"
+
+        uint32_t Magic = MagicValue;
+        uint32_t SampleCount = 0;
+        uint32_t PayloadBytes = 0;
+
+        // CRC-32 of the columns when the file has ChunkChecksums, else 0.
+        uint32_t Checksum = 0;
+    };
+
+    static_assert(sizeof(BinaryChunkHeader) == 16, "Binary chunk header must stay 16 bytes");
+
+    // True when the buffer starts with the binary trajectory magic.
+    inline bool IsBinaryTrajectory(const void* data, size_t size)
+    {
+        uint32_t magic = 0;
+
+        if (size < sizeof(magic))
+            return false;
+
+        std::memcpy(&magic, data, sizeof(magic));
+
+        return magic == BinaryTrajectoryHeader::MagicValue;
+    }
+}
+
+#endif
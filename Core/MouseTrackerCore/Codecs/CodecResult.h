@@ -0,0 +1,50 @@
+#ifndef __MOUSE_TRACKER_CORE_CODECRESULT__
+#define __MOUSE_TRACKER_CORE_CODECRESULT__
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <cstdint>
+
+namespace Mt
+{
+    struct CodecResult
+    {
+        bool Success = false;
+        std::string Error;
+
+        // Records that were skipped while reading. Warnings describes the
+        // first few of them, so its size is not the total.
+        uint64_t MalformedRecords = 0;
+        std::vector<std::string> Warnings;
+
+        static CodecResult Ok()
+        {
+            CodecResult result;
+            result.Success = true;
+
+            return result;
+        }
+
+        static CodecResult Fail(std::string error)
+        {
+            CodecResult result;
+            result.Error = std::move(error);
+
+            return result;
+        }
+
+        explicit operator bool() const
+        {
+            return Success;
+        }
+    };
+
+    // Reports how far an incremental decode has got: the first samples of the
+    // trajectory being filled are final and bytes of the input are consumed.
+    // Returning false stops the decode, which then fails with "Cancelled".
+    using DecodeProgress = std::function<bool(size_t samples, uint64_t bytes)>;
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __MOUSE_TRACKER_CORE_CRC32__
+#define __MOUSE_TRACKER_CORE_CRC32__
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace Mt
+{
+    // CRC-32 as used by zip and zlib (reflected, polynomial 0xEDB88320),
+    // slicing by 8 bytes: eight table lookups per 8 input bytes instead of
+    // one per byte, a few GB/s on current cores.
+    namespace Crc32
+    {
+        using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+        inline const Tables& GetTables()
+        {
+            static const Tables tables = []()
+            {
+                Tables values {};
+
+                for (uint32_t i = 0; i < 256; i++)
+                {
+                    uint32_t value = i;
+
+                    for (int bit = 0; bit < 8; bit++)
+                        value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+
+                    values[0][i] = value;
+                }
+
+                for (size_t slice = 1; slice < 8; slice++)
+                    for (uint32_t i = 0; i < 256; i++)
+                        values[slice][i] = (values[slice - 1][i] >> 8) ^ values[0][values[slice - 1][i] & 0xFF];
+
+                return values;
+            }();
+
+            return tables;
+        }
+
+        // Continues a running checksum; start from 0 and feed the data in any
+        // number of pieces.
+        inline uint32_t Update(uint32_t crc, const void* data, size_t size)
+        {
+            const Tables& tables = GetTables();
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+            crc = ~crc;
+
+            // Words are read little endian, like every format in this library.
+            while (size >= 8)
+            {
+                uint32_t low;
+                uint32_t high;
+                std::memcpy(&low, bytes, sizeof(low));
+                std::memcpy(&high, bytes + 4, sizeof(high));
+                low ^= crc;
+
+                crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+                      tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+
+                bytes += 8;
+                size -= 8;
+            }
+
+            while (size-- > 0)
+                crc = tables[0][(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+
+            return ~crc;
+        }
+
+        inline uint32_t Compute(const void* data, size_t size)
+        {
+            return Update(0, data, size);
+        }
+    }
+}
+
+#endif
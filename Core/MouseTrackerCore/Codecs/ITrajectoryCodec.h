@@ -0,0 +1,31 @@
+#ifndef __MOUSE_TRACKER_CORE_ITRAJECTORYCODEC__
+#define __MOUSE_TRACKER_CORE_ITRAJECTORYCODEC__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include <string>
+
+namespace Mt
+{
+    class ITrajectoryCodec
+    {
+        public:
+            virtual ~ITrajectoryCodec() = default;
+
+            virtual CodecResult Read(const std::string& filename, Trajectory& trajectory) const = 0;
+            virtual CodecResult Write(const std::string& filename, const TrajectorySpan& trajectory) const = 0;
+
+            virtual const char* GetName() const = 0;
+
+            // Including the leading dot, e.g. ".crsdat".
+            virtual const char* GetExtension() const = 0;
+
+            // Whether per-sample timestamps and metadata survive a round trip.
+            virtual bool KeepsTimestamps() const
+            {
+                return false;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include <cstring>
+
+namespace Mt
+{
+    MappedTrajectory::MappedTrajectory(Trajectory trajectory)
+    {
+        m_decoded = std::move(trajectory);
+        m_span = TrajectorySpan(m_decoded);
+    }
+
+    CodecResult MappedTrajectory::Open(const std::string& filename)
+    {
+        m_file.Close();
+        m_decoded = Trajectory();
+        m_span = TrajectorySpan();
+        m_mapped = false;
+
+        std::string error;
+
+        if (!m_file.Open(filename, error))
+            return CodecResult::Fail(error);
+
+        // Files without the binary magic go through their regular codec.
+        if (!IsBinaryTrajectory(m_file.Data(), m_file.Size()))
+        {
+            m_file.Close();
+
+            CodecResult result = TrajectoryCodecRegistry::GetInstance().GetCodecForFile(filename)->Read(filename, m_decoded);
+            m_span = TrajectorySpan(m_decoded);
+
+            return result;
+        }
+
+        BinaryTrajectoryHeader header;
+
+        if (m_file.Size() < sizeof(header))
+            return CodecResult::Fail("Truncated header in " + filename);
+
+        std::memcpy(&header, m_file.Data(), sizeof(header));
+        error = header.Validate();
+
+        if (!error.empty())
+            return CodecResult::Fail(error + ": " + filename);
+
+        uint64_t payloadBytes = header.GetPayloadBytes(m_file.Size());
+
+        if (!header.FitsIn(m_file.Size()))
+            return CodecResult::Fail("Truncated payload in " + filename);
+
+        const uint8_t* payload = m_file.Data() + header.HeaderSize;
+        uint64_t mappedPayload = m_file.Size() - header.HeaderSize;
+        size_t count = static_cast<size_t>(header.SampleCount);
+
+        // Mappings are page aligned, so an 8-byte aligned header keeps both
+        // columns naturally aligned for direct access.
+        if (header.GetEncoding() == BinaryEncoding::Fixed && header.HeaderSize % alignof(int64_t) == 0)
+        {
+            // The span is read in place by every consumer, so its extent is
+            // bounded by the mapping here, whatever the header checks said.
+            if (header.SampleCount > mappedPayload / BinaryTrajectoryHeader::GetSampleBytes(header.HasTimestamps()))
+            {
+                m_file.Close();
+
+                return CodecResult::Fail("Sample count exceeds mapped payload in " + filename);
+            }
+
+            const Point* points = reinterpret_cast<const Point*>(payload);
+            const int64_t* timestamps = header.HasTimestamps()
+                ? reinterpret_cast<const int64_t*>(payload + count * sizeof(Point))
+                : nullptr;
+
+            m_span = TrajectorySpan(points, timestamps, count, header.GetMetadata());
+            m_mapped = true;
+
+            return CodecResult::Ok();
+        }
+
+        CodecResult result = BinaryTrajectoryCodec::DecodePayload(header, payload, static_cast<size_t>(payloadBytes), m_decoded);
+        m_file.Close();
+        m_span = TrajectorySpan(m_decoded);
+
+        if (!result.Success)
+            result.Error += ": " + filename;
+
+        return result;
+    }
+}
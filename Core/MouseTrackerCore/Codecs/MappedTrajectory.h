@@ -0,0 +1,48 @@
+#ifndef __MOUSE_TRACKER_CORE_MAPPEDTRAJECTORY__
+#define __MOUSE_TRACKER_CORE_MAPPEDTRAJECTORY__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include "MouseTrackerCore/Platform/MappedFile.h"
+#include <string>
+
+namespace Mt
+{
+    // Read-only trajectory for viewing and analysis. Fixed-width .crsbin files
+    // are memory-mapped and the span points straight at the file's columns;
+    // anything else (text, delta varint) is decoded once into owned storage.
+    // Either way the span stays valid for the lifetime of this object, so
+    // share it (e.g. through shared_ptr) instead of copying the samples.
+    class MappedTrajectory
+    {
+        private:
+            MappedFile m_file;
+            Trajectory m_decoded;
+            TrajectorySpan m_span;
+            bool m_mapped = false;
+
+        public:
+            MappedTrajectory() = default;
+
+            // Takes ownership of an in-memory trajectory (e.g. a fresh capture).
+            explicit MappedTrajectory(Trajectory trajectory);
+
+            MappedTrajectory(const MappedTrajectory&) = delete;
+            MappedTrajectory& operator=(const MappedTrajectory&) = delete;
+
+            CodecResult Open(const std::string& filename);
+
+            const TrajectorySpan& GetSpan() const
+            {
+                return m_span;
+            }
+
+            // True when the columns are read from the mapping without a copy.
+            bool IsMapped() const
+            {
+                return m_mapped;
+            }
+    };
+}
+
+#endif
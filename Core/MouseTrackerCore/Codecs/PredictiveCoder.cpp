@@ -0,0 +1,483 @@
+#include "MouseTrackerCore/Codecs/PredictiveCoder.h"
+#include "MouseTrackerCore/Codecs/Rans.h"
+#include "MouseTrackerCore/Codecs/VarInt.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Mt
+{
+    namespace
+    {
+        constexpr uint32_t EscapeBase = PredictiveCoder::DirectSymbols - 8;
+        constexpr uint32_t LastSymbol = EscapeBase + 64;
+
+        // Maximum block size a reader accepts; the writer uses BlockSamples.
+        constexpr uint64_t MaxBlockSamples = 1u << 24;
+
+        // Order byte, a one-symbol table, two length varints and the rANS state.
+        constexpr size_t MinColumnBytes = 10;
+
+        uint32_t BitWidth(uint64_t value)
+        {
+            uint32_t width = 0;
+
+            while (value != 0)
+            {
+                width++;
+                value >>= 1;
+            }
+
+            return width;
+        }
+
+        // Last three values of a column, newest first; all zero before the first sample.
+        struct ColumnHistory
+        {
+            uint64_t Values[3] = {};
+        };
+
+        template<unsigned Order>
+        uint64_t Predict(uint64_t a, uint64_t b, uint64_t c)
+        {
+            if (Order == 1)
+                return a;
+
+            if (Order == 2)
+                return 2 * a - b;
+
+            return 3 * a - 3 * b + c;
+        }
+
+        class BitWriter
+        {
+            private:
+                std::vector<uint8_t>& m_output;
+                uint64_t m_bits = 0;
+                uint32_t m_count = 0;
+
+                void Put(uint64_t value, uint32_t width)
+                {
+                    m_bits |= value << m_count;
+                    m_count += width;
+
+                    while (m_count >= 8)
+                    {
+                        m_output.push_back(static_cast<uint8_t>(m_bits));
+                        m_bits >>= 8;
+                        m_count -= 8;
+                    }
+                }
+
+            public:
+                explicit BitWriter(std::vector<uint8_t>& output)
+                    : m_output(output)
+                {
+                }
+
+                // The low width bits of value, width < 64.
+                void Write(uint64_t value, uint32_t width)
+                {
+                    if (width > 32)
+                    {
+                        Put(value & 0xFFFFFFFFu, 32);
+                        value >>= 32;
+                        width -= 32;
+                    }
+
+                    Put(value & ((uint64_t(1) << width) - 1), width);
+                }
+
+                void Flush()
+                {
+                    if (m_count > 0)
+                        m_output.push_back(static_cast<uint8_t>(m_bits));
+
+                    m_bits = 0;
+                    m_count = 0;
+                }
+        };
+
+        class BitReader
+        {
+            private:
+                const uint8_t* m_data;
+                const uint8_t* m_end;
+                uint64_t m_bits = 0;
+                uint32_t m_count = 0;
+                bool m_overrun = false;
+
+                uint64_t Take(uint32_t width)
+                {
+                    while (m_count < width)
+                    {
+                        if (m_data < m_end)
+                            m_bits |= static_cast<uint64_t>(*m_data++) << m_count;
+                        else
+                            m_overrun = true;
+
+                        m_count += 8;
+                    }
+
+                    uint64_t value = m_bits & ((uint64_t(1) << width) - 1);
+                    m_bits >>= width;
+                    m_count -= width;
+
+                    return value;
+                }
+
+            public:
+                BitReader(const uint8_t* data, size_t size)
+                    : m_data(data), m_end(data + size)
+                {
+                }
+
+                uint64_t Read(uint32_t width)
+                {
+                    if (width > 32)
+                    {
+                        uint64_t low = Take(32);
+
+                        return low | (Take(width - 32) << 32);
+                    }
+
+                    return Take(width);
+                }
+
+                bool IsComplete() const
+                {
+                    return !m_overrun && m_data == m_end;
+                }
+        };
+
+        // Buffers reused across blocks and columns.
+        struct EncodeScratch
+        {
+            std::vector<uint64_t> Values;
+            std::vector<uint8_t> Symbols;
+            std::vector<uint8_t> Coded;
+            std::vector<uint8_t> Raw;
+            Rans::Encoder Encoder;
+        };
+
+        // The order whose residuals have the smallest total magnitude, as
+        // FLAC picks its fixed predictors; cheap and close enough to the
+        // coded size to tell smooth motion from noise.
+        unsigned ChooseOrder(const std::vector<uint64_t>& values, const ColumnHistory& history)
+        {
+            double costs[3] = {};
+            uint64_t a = history.Values[0];
+            uint64_t b = history.Values[1];
+            uint64_t c = history.Values[2];
+
+            for (uint64_t value : values)
+            {
+                costs[0] += std::fabs(static_cast<double>(static_cast<int64_t>(value - Predict<1>(a, b, c))));
+                costs[1] += std::fabs(static_cast<double>(static_cast<int64_t>(value - Predict<2>(a, b, c))));
+                costs[2] += std::fabs(static_cast<double>(static_cast<int64_t>(value - Predict<3>(a, b, c))));
+
+                c = b;
+                b = a;
+                a = value;
+            }
+
+            return costs[0] <= costs[1] && costs[0] <= costs[2] ? 1 : (costs[1] <= costs[2] ? 2 : 3);
+        }
+
+        void EncodeColumn(std::vector<uint8_t>& output, ColumnHistory& history, EncodeScratch& scratch)
+        {
+            const std::vector<uint64_t>& values = scratch.Values;
+            unsigned order = ChooseOrder(values, history);
+            std::array<uint32_t, Rans::MaxSymbols> counts {};
+
+            scratch.Symbols.resize(values.size());
+            scratch.Raw.clear();
+
+            BitWriter raw(scratch.Raw);
+            uint64_t a = history.Values[0];
+            uint64_t b = history.Values[1];
+            uint64_t c = history.Values[2];
+
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                uint64_t prediction = order == 1 ? Predict<1>(a, b, c) : (order == 2 ? Predict<2>(a, b, c) : Predict<3>(a, b, c));
+                uint64_t residual = VarInt::ZigZagEncode(static_cast<int64_t>(values[i] - prediction));
+                uint8_t symbol = static_cast<uint8_t>(residual);
+
+                if (residual >= PredictiveCoder::DirectSymbols)
+                {
+                    uint32_t width = BitWidth(residual);
+
+                    symbol = static_cast<uint8_t>(EscapeBase + width);
+                    raw.Write(residual, width - 1);
+                }
+
+                scratch.Symbols[i] = symbol;
+                counts[symbol]++;
+
+                c = b;
+                b = a;
+                a = values[i];
+            }
+
+            raw.Flush();
+
+            history.Values[0] = a;
+            history.Values[1] = b;
+            history.Values[2] = c;
+
+            Rans::FrequencyTable table;
+            table.Build(counts);
+
+            for (size_t i = values.size(); i-- > 0;)
+                scratch.Encoder.Put(table, scratch.Symbols[i]);
+
+            scratch.Coded.clear();
+            scratch.Encoder.Finish(scratch.Coded);
+
+            output.push_back(static_cast<uint8_t>(order));
+            table.Write(output);
+            VarInt::Write(output, scratch.Coded.size());
+            output.insert(output.end(), scratch.Coded.begin(), scratch.Coded.end());
+            VarInt::Write(output, scratch.Raw.size());
+            output.insert(output.end(), scratch.Raw.begin(), scratch.Raw.end());
+        }
+
+        // One column of a block, handing sample i to store(i, value); the
+        // order is a template parameter so the loop carries no branch on it.
+        template<unsigned Order, typename Store>
+        bool DecodeColumn(const Rans::DecodeTable& table, Rans::Decoder& decoder, BitReader& raw, ColumnHistory& history, size_t count, Store store)
+        {
+            uint64_t a = history.Values[0];
+            uint64_t b = history.Values[1];
+            uint64_t c = history.Values[2];
+
+            for (size_t i = 0; i < count; i++)
+            {
+                uint32_t symbol = decoder.Get(table);
+                uint64_t residual = symbol;
+
+                if (symbol >= PredictiveCoder::DirectSymbols)
+                {
+                    uint32_t width = symbol - EscapeBase;
+                    residual = (uint64_t(1) << (width - 1)) | raw.Read(width - 1);
+                }
+
+                uint64_t value = Predict<Order>(a, b, c) + static_cast<uint64_t>(VarInt::ZigZagDecode(residual));
+
+                store(i, value);
+
+                c = b;
+                b = a;
+                a = value;
+            }
+
+            history.Values[0] = a;
+            history.Values[1] = b;
+            history.Values[2] = c;
+
+            return decoder.IsComplete() && raw.IsComplete();
+        }
+
+        // Parses one column header and decodes its samples; false on any
+        // inconsistency, leaving position wherever parsing stopped.
+        template<typename Store>
+        bool ReadColumn(const uint8_t* data, size_t size, size_t& position, ColumnHistory& history, Rans::DecodeTable& decodeTable, size_t count, Store store)
+        {
+            if (position >= size)
+                return false;
+
+            unsigned order = data[position++];
+            Rans::FrequencyTable table;
+            uint64_t codedBytes = 0;
+            uint64_t rawBytes = 0;
+
+            if (order < 1 || order > 3 || !table.Read(data, size, position))
+                return false;
+
+            for (size_t symbol = LastSymbol + 1; symbol < Rans::MaxSymbols; symbol++)
+                if (table.Frequencies[symbol] != 0)
+                    return false;
+
+            if (!VarInt::Read(data, size, position, codedBytes) || codedBytes > size - position)
+                return false;
+
+            const uint8_t* coded = data + position;
+            position += static_cast<size_t>(codedBytes);
+
+            if (!VarInt::Read(data, size, position, rawBytes) || rawBytes > size - position)
+                return false;
+
+            BitReader raw(data + position, static_cast<size_t>(rawBytes));
+            position += static_cast<size_t>(rawBytes);
+
+            Rans::BuildDecodeTable(table, decodeTable);
+            Rans::Decoder decoder(coded, static_cast<size_t>(codedBytes));
+
+            switch (order)
+            {
+                case 1:
+                    return DecodeColumn<1>(decodeTable, decoder, raw, history, count, store);
+
+                case 2:
+                    return DecodeColumn<2>(decodeTable, decoder, raw, history, count, store);
+
+                default:
+                    return DecodeColumn<3>(decodeTable, decoder, raw, history, count, store);
+            }
+        }
+
+        CodecResult ReadBlockSamples(const uint8_t* data, size_t size, size_t count, bool hasTimestamps, size_t& position, uint64_t& blockSamples)
+        {
+            if (!VarInt::Read(data, size, position, blockSamples) || blockSamples == 0 || blockSamples > MaxBlockSamples)
+                return CodecResult::Fail("Invalid predictive block size");
+
+            // Every block costs a few bytes per column however well it
+            // compresses, which bounds what a lying header can make us allocate.
+            size_t columns = hasTimestamps ? 3 : 2;
+            uint64_t blocks = count == 0 ? 0 : (count - 1) / blockSamples + 1;
+
+            if (blocks > (size - position) / (columns * MinColumnBytes))
+                return CodecResult::Fail("Truncated payload");
+
+            return CodecResult::Ok();
+        }
+
+        // Walks the blocks of a payload of count samples. block(first, samples)
+        // says where the block's points and timestamps go (timestamps null to
+        // skip the column); decoded ends as the samples before a damaged block.
+        template<typename Block>
+        CodecResult DecodeBlocks(const uint8_t* data, size_t size, size_t count, bool hasTimestamps, Block block, size_t& decoded, const DecodeProgress& progress)
+        {
+            size_t position = 0;
+            uint64_t blockSamples = 0;
+
+            decoded = 0;
+
+            CodecResult result = ReadBlockSamples(data, size, count, hasTimestamps, position, blockSamples);
+
+            if (!result.Success)
+                return result;
+
+            ColumnHistory histories[3];
+            Rans::DecodeTable decodeTable;
+
+            for (size_t first = 0; first < count; first += static_cast<size_t>(blockSamples))
+            {
+                size_t samples = static_cast<size_t>((std::min)(blockSamples, static_cast<uint64_t>(count - first)));
+                Point* blockPoints = nullptr;
+                int64_t* blockTimestamps = nullptr;
+
+                block(first, samples, blockPoints, blockTimestamps);
+
+                bool intact =
+                    ReadColumn(data, size, position, histories[0], decodeTable, samples, [blockPoints](size_t i, uint64_t value) { blockPoints[i].x = static_cast<int32_t>(value); }) &&
+                    ReadColumn(data, size, position, histories[1], decodeTable, samples, [blockPoints](size_t i, uint64_t value) { blockPoints[i].y = static_cast<int32_t>(value); });
+
+                if (intact && hasTimestamps)
+                {
+                    intact = blockTimestamps
+                        ? ReadColumn(data, size, position, histories[2], decodeTable, samples, [blockTimestamps](size_t i, uint64_t value) { blockTimestamps[i] = static_cast<int64_t>(value); })
+                        : ReadColumn(data, size, position, histories[2], decodeTable, samples, [](size_t, uint64_t) {});
+                }
+
+                if (!intact)
+                    return CodecResult::Fail("Corrupt predictive block at sample " + std::to_string(first));
+
+                decoded = first + samples;
+
+                if (progress && !progress(decoded, position))
+                    return CodecResult::Fail("Cancelled");
+            }
+
+            return CodecResult::Ok();
+        }
+    }
+
+    void PredictiveCoder::Encode(const TrajectorySpan& trajectory, std::vector<uint8_t>& output)
+    {
+        size_t count = trajectory.Size();
+        bool hasTimestamps = trajectory.HasTimestamps();
+        ColumnHistory histories[3];
+        EncodeScratch scratch;
+
+        VarInt::Write(output, BlockSamples);
+
+        for (size_t first = 0; first < count; first += BlockSamples)
+        {
+            size_t samples = (std::min)(BlockSamples, count - first);
+
+            scratch.Values.resize(samples);
+
+            for (size_t i = 0; i < samples; i++)
+                scratch.Values[i] = static_cast<uint64_t>(static_cast<int64_t>(trajectory.Points[first + i].x));
+
+            EncodeColumn(output, histories[0], scratch);
+
+            for (size_t i = 0; i < samples; i++)
+                scratch.Values[i] = static_cast<uint64_t>(static_cast<int64_t>(trajectory.Points[first + i].y));
+
+            EncodeColumn(output, histories[1], scratch);
+
+            if (!hasTimestamps)
+                continue;
+
+            for (size_t i = 0; i < samples; i++)
+                scratch.Values[i] = static_cast<uint64_t>(trajectory.Timestamps[first + i]);
+
+            EncodeColumn(output, histories[2], scratch);
+        }
+    }
+
+    CodecResult PredictiveCoder::Decode(const uint8_t* data, size_t size, size_t count, bool hasTimestamps, Trajectory& trajectory, const DecodeProgress& progress)
+    {
+        // Constant columns compress to almost nothing, so only part of a
+        // large claim is reserved up front.
+        trajectory.Reserve(static_cast<size_t>((std::min)(static_cast<uint64_t>(count), static_cast<uint64_t>(size) * 64)), hasTimestamps);
+
+        auto& points = trajectory.GetPoints();
+        auto& timestamps = trajectory.GetTimestamps();
+        size_t decoded = 0;
+
+        CodecResult result = DecodeBlocks(data, size, count, hasTimestamps, [&](size_t first, size_t samples, Point*& blockPoints, int64_t*& blockTimestamps)
+        {
+            points.resize(first + samples);
+            blockPoints = points.data() + first;
+
+            if (hasTimestamps)
+            {
+                timestamps.resize(first + samples);
+                blockTimestamps = timestamps.data() + first;
+            }
+        }, decoded, progress);
+
+        // A damaged block leaves every block decoded before it.
+        if (!result.Success && points.size() > decoded)
+        {
+            points.resize(decoded);
+
+            if (hasTimestamps)
+                timestamps.resize(decoded);
+        }
+
+        return result;
+    }
+
+    CodecResult PredictiveCoder::CheckPayload(const uint8_t* data, size_t size, size_t count, bool hasTimestamps)
+    {
+        size_t position = 0;
+        uint64_t blockSamples = 0;
+
+        return ReadBlockSamples(data, size, count, hasTimestamps, position, blockSamples);
+    }
+
+    CodecResult PredictiveCoder::DecodeColumns(const uint8_t* data, size_t size, size_t count, bool hasTimestamps, Point* points, int64_t* timestamps)
+    {
+        size_t decoded = 0;
+
+        return DecodeBlocks(data, size, count, hasTimestamps, [&](size_t first, size_t, Point*& blockPoints, int64_t*& blockTimestamps)
+        {
+            blockPoints = points + first;
+            blockTimestamps = timestamps ? timestamps + first : nullptr;
+        }, decoded, nullptr);
+    }
+}
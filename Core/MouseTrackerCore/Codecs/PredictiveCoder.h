@@ -0,0 +1,52 @@
+#ifndef __MOUSE_TRACKER_CORE_PREDICTIVECODER__
+#define __MOUSE_TRACKER_CORE_PREDICTIVECODER__
+
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Mt
+{
+    // Payload of the Predictive binary encoding, for archival where size
+    // matters more than encode time. Each column (x, y, then timestamps) is
+    // predicted from its own last samples and only the residuals are stored:
+    //
+    //   varint BlockSamples
+    //   per block of up to BlockSamples samples, per column:
+    //     uint8 order      - 1: previous value, 2: linear, 3: quadratic
+    //                        extrapolation, whichever is cheapest for the block
+    //     frequency table  - see Rans::FrequencyTable::Write
+    //     varint + bytes   - rANS-coded residual symbols
+    //     varint + bytes   - raw low bits of large residuals, LSB first
+    //
+    // A zigzagged residual below DirectSymbols is its own symbol; a larger
+    // one of bit width n is symbol DirectSymbols - 8 + n followed by its low
+    // n - 1 bits in the raw stream. History carries across blocks, so
+    // blocks only bound the model, not the prediction. Arithmetic wraps in 64
+    // bits, so any int64 timestamps round-trip.
+    class PredictiveCoder
+    {
+        public:
+            static constexpr size_t BlockSamples = 32768;
+            static constexpr uint32_t DirectSymbols = 192;
+
+            static void Encode(const TrajectorySpan& trajectory, std::vector<uint8_t>& output);
+
+            // Decodes count samples; on a damaged block the trajectory keeps
+            // every block decoded before it and the result says where it
+            // stopped. Progress is reported after every block.
+            static CodecResult Decode(const uint8_t* data, size_t size, size_t count, bool hasTimestamps, Trajectory& trajectory, const DecodeProgress& progress = nullptr);
+
+            // Checks the block size and that count samples could fit in size
+            // bytes, without decoding; Decode fails the same way.
+            static CodecResult CheckPayload(const uint8_t* data, size_t size, size_t count, bool hasTimestamps);
+
+            // Decodes count samples into caller-owned columns; timestamps may
+            // be null to skip a stored timestamp column.
+            static CodecResult DecodeColumns(const uint8_t* data, size_t size, size_t count, bool hasTimestamps, Point* points, int64_t* timestamps);
+    };
+}
+
+#endif
@@ -0,0 +1,309 @@
+#include "MouseTrackerCore/Codecs/ProgressiveTrajectoryLoader.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryParser.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include "MouseTrackerCore/Platform/MappedFile.h"
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+
+namespace Mt
+{
+    namespace
+    {
+        // The decoded prefix, with timestamps only once they have caught up
+        // (delta payloads store every point before the first timestamp).
+        Trajectory CopyPrefix(const Trajectory& trajectory, size_t samples)
+        {
+            const auto& points = trajectory.GetPoints();
+            const auto& timestamps = trajectory.GetTimestamps();
+
+            Trajectory prefix;
+            prefix.SetMetadata(trajectory.GetMetadata());
+            prefix.GetPoints().assign(points.begin(), points.begin() + samples);
+
+            if (timestamps.size() >= samples && !timestamps.empty())
+                prefix.GetTimestamps().assign(timestamps.begin(), timestamps.begin() + samples);
+
+            return prefix;
+        }
+    }
+
+    ProgressiveTrajectoryLoader::ProgressiveTrajectoryLoader(ProgressiveLoadSettings settings)
+        : m_settings(std::move(settings))
+    {
+        m_worker = std::thread(&ProgressiveTrajectoryLoader::WorkerLoop, this);
+    }
+
+    ProgressiveTrajectoryLoader::~ProgressiveTrajectoryLoader()
+    {
+        Cancel();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+
+        m_changed.notify_all();
+        m_worker.join();
+    }
+
+    void ProgressiveTrajectoryLoader::Load(const std::string& filename)
+    {
+        std::lock_guard<std::mutex> publishLock(m_publishMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_generation++;
+        m_pending = filename;
+        m_hasPending = true;
+        m_progress = TrajectoryLoadProgress();
+        m_progress.Filename = filename;
+        m_progress.Active = true;
+        m_changed.notify_all();
+    }
+
+    void ProgressiveTrajectoryLoader::Cancel()
+    {
+        std::lock_guard<std::mutex> publishLock(m_publishMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_generation++;
+        m_pending.clear();
+        m_hasPending = false;
+        m_progress.Active = false;
+        m_changed.notify_all();
+    }
+
+    void ProgressiveTrajectoryLoader::Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]() { return !m_hasPending && !m_busy; });
+    }
+
+    TrajectoryLoadProgress ProgressiveTrajectoryLoader::GetProgress() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_progress;
+    }
+
+    void ProgressiveTrajectoryLoader::WorkerLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true)
+        {
+            m_changed.wait(lock, [this]() { return m_stopping || m_hasPending; });
+
+            if (m_stopping)
+                return;
+
+            std::string filename = std::move(m_pending);
+            uint64_t generation = m_generation;
+
+            m_hasPending = false;
+            m_busy = true;
+            lock.unlock();
+
+            try
+            {
+                Run(filename, generation);
+            }
+            catch (const std::exception& e)
+            {
+                CodecResult result = CodecResult::Fail(std::string("Load failed: ") + e.what());
+
+                Publish(generation, [&]()
+                {
+                    if (m_settings.OnLoaded)
+                        m_settings.OnLoaded(filename, std::make_shared<const MappedTrajectory>(Trajectory()), result);
+                });
+            }
+
+            lock.lock();
+            m_busy = false;
+
+            if (generation == m_generation)
+                m_progress.Active = false;
+
+            m_changed.notify_all();
+        }
+    }
+
+    void ProgressiveTrajectoryLoader::Run(const std::string& filename, uint64_t generation)
+    {
+        std::error_code error;
+        uint64_t fileSize = std::filesystem::file_size(filename, error);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (generation == m_generation)
+                m_progress.BytesTotal = error ? 0 : fileSize;
+        }
+
+        Trajectory trajectory;
+        std::shared_ptr<const MappedTrajectory> mapped;
+        size_t published = 0;
+        auto lastPublish = std::chrono::steady_clock::now();
+
+        auto report = [&](size_t samples, uint64_t bytes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                if (generation != m_generation)
+                    return false;
+
+                m_progress.Samples = samples;
+                m_progress.BytesDone = bytes;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            bool due = published == 0
+                ? samples >= m_settings.FirstPublishSamples
+                : now - lastPublish >= m_settings.PublishInterval && samples >= published + published / 4;
+
+            if (due && m_settings.OnPartial)
+            {
+                auto partial = std::make_shared<const MappedTrajectory>(CopyPrefix(trajectory, samples));
+
+                Publish(generation, [&]() { m_settings.OnPartial(partial); });
+
+                published = samples;
+                lastPublish = now;
+            }
+
+            return IsCurrent(generation);
+        };
+
+        CodecResult result = Decode(filename, trajectory, mapped, report);
+
+        if (!IsCurrent(generation))
+            return;
+
+        if (!mapped)
+            mapped = std::make_shared<const MappedTrajectory>(std::move(trajectory));
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (generation == m_generation)
+            {
+                m_progress.Samples = mapped->GetSpan().Size();
+                m_progress.BytesDone = m_progress.BytesTotal;
+            }
+        }
+
+        Publish(generation, [&]()
+        {
+            if (m_settings.OnLoaded)
+                m_settings.OnLoaded(filename, mapped, result);
+        });
+    }
+
+    CodecResult ProgressiveTrajectoryLoader::Decode(const std::string& filename, Trajectory& trajectory, std::shared_ptr<const MappedTrajectory>& mapped, const DecodeProgress& progress)
+    {
+        // Whole-file path: fixed-width binary maps instantly, and files of
+        // other codecs have nothing to show before they are complete.
+        auto openMapped = [&]()
+        {
+            auto opened = std::make_shared<MappedTrajectory>();
+            CodecResult result = opened->Open(filename);
+
+            mapped = std::move(opened);
+
+            return result;
+        };
+
+        MappedFile file;
+        std::string error;
+
+        if (!file.Open(filename, error))
+            return CodecResult::Fail(error);
+
+        if (IsBinaryTrajectory(file.Data(), file.Size()))
+        {
+            BinaryTrajectoryHeader header;
+
+            if (file.Size() < sizeof(header))
+                return CodecResult::Fail("Truncated header in " + filename);
+
+            std::memcpy(&header, file.Data(), sizeof(header));
+            error = header.Validate();
+
+            if (!error.empty())
+                return CodecResult::Fail(error + ": " + filename);
+
+            if (header.GetEncoding() == BinaryEncoding::Fixed)
+                return openMapped();
+
+            uint64_t payloadBytes = header.GetPayloadBytes(file.Size());
+
+            if (!header.FitsIn(file.Size()))
+                return CodecResult::Fail("Truncated payload in " + filename);
+
+            CodecResult result = BinaryTrajectoryCodec::DecodePayload(header, file.Data() + header.HeaderSize, static_cast<size_t>(payloadBytes), trajectory,
+                [&](size_t samples, uint64_t bytes) { return progress(samples, header.HeaderSize + bytes); });
+
+            if (!result.Success)
+                result.Error += ": " + filename;
+
+            return result;
+        }
+
+        if (std::string(TrajectoryCodecRegistry::GetInstance().GetCodecForFile(filename)->GetName()) != "text")
+            return openMapped();
+
+        // Text is parsed straight from the mapping, a block at a time.
+        const char* data = reinterpret_cast<const char*>(file.Data());
+        size_t size = file.Size();
+        size_t position = 0;
+        size_t window = TextTrajectoryCodec::ReadBlockSize;
+
+        trajectory.Reserve(size / 8);
+
+        TextTrajectoryParser parser(trajectory);
+
+        while (true)
+        {
+            size_t available = (std::min)(window, size - position);
+            bool last = available == size - position;
+            size_t consumed = parser.Parse(data + position, available, last);
+
+            position += consumed;
+
+            if (last)
+                break;
+
+            // A line longer than the window widens it; real files never do this.
+            window = consumed == 0 ? window * 2 : TextTrajectoryCodec::ReadBlockSize;
+
+            if (!progress(trajectory.Size(), position))
+                return CodecResult::Fail("Cancelled");
+        }
+
+        CodecResult result = CodecResult::Ok();
+        parser.Finish(result);
+
+        return result;
+    }
+
+    bool ProgressiveTrajectoryLoader::IsCurrent(uint64_t generation) const
+    {
+        return m_generation.load() == generation;
+    }
+
+    bool ProgressiveTrajectoryLoader::Publish(uint64_t generation, const std::function<void()>& publish)
+    {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+
+        if (!IsCurrent(generation))
+            return false;
+
+        publish();
+
+        return true;
+    }
+}
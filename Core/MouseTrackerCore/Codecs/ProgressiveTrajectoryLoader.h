@@ -0,0 +1,109 @@
+#ifndef __MOUSE_TRACKER_CORE_PROGRESSIVETRAJECTORYLOADER__
+#define __MOUSE_TRACKER_CORE_PROGRESSIVETRAJECTORYLOADER__
+
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Mt
+{
+    struct TrajectoryLoadProgress
+    {
+        std::string Filename;
+        uint64_t BytesDone = 0;
+        uint64_t BytesTotal = 0;
+
+        // Samples decoded so far; the view may show fewer until the next publish.
+        size_t Samples = 0;
+
+        bool Active = false;
+
+        double GetFraction() const
+        {
+            return BytesTotal > 0 ? static_cast<double>(BytesDone) / BytesTotal : 0.0;
+        }
+    };
+
+    using TrajectoryPartialCallback = std::function<void(std::shared_ptr<const MappedTrajectory> trajectory)>;
+
+    // On failure the trajectory holds whatever decoded before the error.
+    using TrajectoryLoadedCallback = std::function<void(const std::string& filename, std::shared_ptr<const MappedTrajectory> trajectory, const CodecResult& result)>;
+
+    struct ProgressiveLoadSettings
+    {
+        // The first part of a file is published as soon as this many samples
+        // have decoded,
+        size_t FirstPublishSamples = 16384;
+
+        // then at most this often, and only once the decoded part has grown
+        // by a quarter since, so the copies made for display stay O(n) in total.
+        std::chrono::milliseconds PublishInterval = std::chrono::milliseconds(100);
+
+        // Both are called on the loader thread, never for a load that has
+        // been cancelled or replaced, even one that was mid-publish.
+        TrajectoryPartialCallback OnPartial;
+        TrajectoryLoadedCallback OnLoaded;
+    };
+
+    // Loads one file at a time on a background thread and publishes the
+    // samples decoded so far while it goes, so a huge text or packed file
+    // shows its first part within milliseconds. Text is parsed block by block
+    // from a mapping, delta / chunked / predictive .crsbin payloads report
+    // through DecodeProgress, and fixed-width .crsbin files are simply mapped
+    // (instant). Starting another load cancels the one in flight.
+    class ProgressiveTrajectoryLoader
+    {
+        private:
+            ProgressiveLoadSettings m_settings;
+
+            std::string m_pending;
+            bool m_hasPending = false;
+            bool m_busy = false;
+            bool m_stopping = false;
+            TrajectoryLoadProgress m_progress;
+            mutable std::mutex m_mutex;
+            std::condition_variable m_changed;
+
+            // Bumped by every Load / Cancel; a load runs while it still holds
+            // the value it started with. Changed and checked under
+            // m_publishMutex before publishing, so nothing stale gets out.
+            std::atomic<uint64_t> m_generation { 0 };
+            std::mutex m_publishMutex;
+
+            std::thread m_worker;
+
+        public:
+            explicit ProgressiveTrajectoryLoader(ProgressiveLoadSettings settings = ProgressiveLoadSettings());
+            ProgressiveTrajectoryLoader(const ProgressiveTrajectoryLoader&) = delete;
+            ProgressiveTrajectoryLoader& operator=(const ProgressiveTrajectoryLoader&) = delete;
+            ~ProgressiveTrajectoryLoader();
+
+            void Load(const std::string& filename);
+
+            // Once this returns, the cancelled load publishes nothing more.
+            void Cancel();
+
+            // Blocks until the requested load, if any, has finished or stopped.
+            void Wait();
+
+            TrajectoryLoadProgress GetProgress() const;
+
+        private:
+            void WorkerLoop();
+            void Run(const std::string& filename, uint64_t generation);
+            CodecResult Decode(const std::string& filename, Trajectory& trajectory, std::shared_ptr<const MappedTrajectory>& mapped, const DecodeProgress& progress);
+            bool IsCurrent(uint64_t generation) const;
+
+            // Runs publish under m_publishMutex if the load is still current.
+            bool Publish(uint64_t generation, const std::function<void()>& publish);
+    };
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef __MOUSE_TRACKER_CORE_RANS__
+#define __MOUSE_TRACKER_CORE_RANS__
+
+#include "MouseTrackerCore/Codecs/VarInt.h"
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace Mt
+{
+    // Byte-wise range asymmetric numeral systems (rANS) over an alphabet of
+    // up to 256 symbols with a static model: frequencies are counted once per
+    // block, normalized to Scale and stored in front of the coded bytes. A
+    // 32-bit state is kept in [LowerBound, LowerBound << 8) and renormalized a
+    // byte at a time, so decoding a symbol is one table lookup, a multiply
+    // and rarely a byte read.
+    namespace Rans
+    {
+        constexpr uint32_t ScaleBits = 12;
+        constexpr uint32_t Scale = 1u << ScaleBits;
+        constexpr uint32_t LowerBound = 1u << 23;
+        constexpr size_t MaxSymbols = 256;
+
+        struct FrequencyTable
+        {
+            std::array<uint32_t, MaxSymbols> Frequencies {};
+            std::array<uint32_t, MaxSymbols> Starts {};
+
+            // Scales counts to sum to Scale, keeping every symbol that occurs
+            // at least 1; false when nothing occurs.
+            bool Build(const std::array<uint32_t, MaxSymbols>& counts)
+            {
+                uint64_t total = 0;
+
+                for (uint32_t count : counts)
+                    total += count;
+
+                if (total == 0)
+                    return false;
+
+                int64_t assigned = 0;
+                size_t largest = 0;
+
+                for (size_t symbol = 0; symbol < MaxSymbols; symbol++)
+                {
+                    uint32_t count = counts[symbol];
+                    Frequencies[symbol] = count == 0 ? 0 : static_cast<uint32_t>((std::max)(uint64_t(1), count * uint64_t(Scale) / total));
+                    assigned += Frequencies[symbol];
+
+                    if (Frequencies[symbol] > Frequencies[largest])
+                        largest = symbol;
+                }
+
+                // Rounding leftovers go to the most frequent symbol; an excess
+                // (many rare symbols rounded up to 1) is taken from the largest ones.
+                int64_t missing = static_cast<int64_t>(Scale) - assigned;
+
+                if (missing >= 0)
+                {
+                    Frequencies[largest] += static_cast<uint32_t>(missing);
+                }
+                else
+                {
+                    std::array<uint16_t, MaxSymbols> order;
+
+                    for (size_t symbol = 0; symbol < MaxSymbols; symbol++)
+                        order[symbol] = static_cast<uint16_t>(symbol);
+
+                    std::sort(order.begin(), order.end(), [this](uint16_t left, uint16_t right) { return Frequencies[left] > Frequencies[right]; });
+
+                    for (size_t i = 0; missing < 0; i = (i + 1) % MaxSymbols)
+                    {
+                        uint32_t& frequency = Frequencies[order[i]];
+                        uint32_t taken = static_cast<uint32_t>((std::min)(static_cast<int64_t>(frequency > 1 ? frequency - 1 : 0), -missing));
+
+                        frequency -= taken;
+                        missing += taken;
+                    }
+                }
+
+                ComputeStarts();
+
+                return true;
+            }
+
+            void ComputeStarts()
+            {
+                uint32_t start = 0;
+
+                for (size_t symbol = 0; symbol < MaxSymbols; symbol++)
+                {
+                    Starts[symbol] = start;
+                    start += Frequencies[symbol];
+                }
+            }
+
+            // Symbols in use as (gap to the previous one, frequency - 1) varints.
+            void Write(std::vector<uint8_t>& output) const
+            {
+                uint64_t used = 0;
+
+                for (uint32_t frequency : Frequencies)
+                    used += frequency > 0 ? 1 : 0;
+
+                VarInt::Write(output, used);
+
+                size_t next = 0;
+
+                for (size_t symbol = 0; symbol < MaxSymbols; symbol++)
+                {
+                    if (Frequencies[symbol] == 0)
+                        continue;
+
+                    VarInt::Write(output, symbol - next);
+                    VarInt::Write(output, Frequencies[symbol] - 1);
+                    next = symbol + 1;
+                }
+            }
+
+            // False unless the stored frequencies are in range and sum to Scale.
+            bool Read(const uint8_t* data, size_t size, size_t& position)
+            {
+                uint64_t used = 0;
+
+                Frequencies.fill(0);
+
+                if (!VarInt::Read(data, size, position, used) || used == 0 || used > MaxSymbols)
+                    return false;
+
+                uint64_t symbol = 0;
+                uint64_t total = 0;
+
+                for (uint64_t i = 0; i < used; i++)
+                {
+                    uint64_t gap = 0;
+                    uint64_t frequency = 0;
+
+                    if (!VarInt::Read(data, size, position, gap) || !VarInt::Read(data, size, position, frequency))
+                        return false;
+
+                    symbol += gap;
+                    total += frequency + 1;
+
+                    if (symbol >= MaxSymbols || total > Scale)
+                        return false;
+
+                    Frequencies[static_cast<size_t>(symbol)] = static_cast<uint32_t>(frequency + 1);
+                    symbol++;
+                }
+
+                if (total != Scale)
+                    return false;
+
+                ComputeStarts();
+
+                return true;
+            }
+        };
+
+        // Slot -> (frequency - 1, slot - start, symbol), packed 12 | 12 | 8
+        // bits, so a decode step touches one 32-bit entry.
+        using DecodeTable = std::array<uint32_t, Scale>;
+
+        inline void BuildDecodeTable(const FrequencyTable& table, DecodeTable& decode)
+        {
+            for (size_t symbol = 0; symbol < MaxSymbols; symbol++)
+            {
+                uint32_t start = table.Starts[symbol];
+
+                for (uint32_t offset = 0; offset < table.Frequencies[symbol]; offset++)
+                    decode[start + offset] = (table.Frequencies[symbol] - 1) | (offset << 12) | (static_cast<uint32_t>(symbol) << 24);
+            }
+        }
+
+        // Symbols must be put in reverse order; Finish emits the bytes so
+        // that the decoder reads them front to back.
+        class Encoder
+        {
+            private:
+                uint32_t m_state = LowerBound;
+                std::vector<uint8_t> m_reversed;
+
+            public:
+                void Put(const FrequencyTable& table, uint8_t symbol)
+                {
+                    uint32_t frequency = table.Frequencies[symbol];
+                    uint32_t limit = ((LowerBound >> ScaleBits) << 8) * frequency;
+
+                    while (m_state >= limit)
+                    {
+                        m_reversed.push_back(static_cast<uint8_t>(m_state));
+                        m_state >>= 8;
+                    }
+
+                    m_state = ((m_state / frequency) << ScaleBits) + (m_state % frequency) + table.Starts[symbol];
+                }
+
+                void Finish(std::vector<uint8_t>& output)
+                {
+                    for (int shift = 0; shift < 32; shift += 8)
+                        m_reversed.push_back(static_cast<uint8_t>(m_state >> shift));
+
+                    output.insert(output.end(), m_reversed.rbegin(), m_reversed.rend());
+
+                    m_reversed.clear();
+                    m_state = LowerBound;
+                }
+        };
+
+        // Reads past the end as zeros and remembers it; a stream that ends
+        // exactly where it should leaves the state back at LowerBound. A
+        // corrupt stream can drive the state to 0, which no number of zero
+        // bytes renormalises, so after an overrun (or an initial state no
+        // encoder writes) Get stops consuming and the column fails.
+        class Decoder
+        {
+            private:
+                const uint8_t* m_data;
+                const uint8_t* m_end;
+                uint32_t m_state = 0;
+                bool m_overrun = false;
+
+                uint32_t NextByte()
+                {
+                    if (m_data < m_end)
+                        return *m_data++;
+
+                    m_overrun = true;
+
+                    return 0;
+                }
+
+            public:
+                Decoder(const uint8_t* data, size_t size)
+                    : m_data(data), m_end(data + size)
+                {
+                    for (int i = 0; i < 4; i++)
+                        m_state = (m_state << 8) | NextByte();
+
+                    if (m_state < LowerBound)
+                        m_overrun = true;
+                }
+
+                uint8_t Get(const DecodeTable& table)
+                {
+                    if (m_overrun)
+                        return 0;
+
+                    uint32_t entry = table[m_state & (Scale - 1)];
+
+                    m_state = ((entry & 0xFFF) + 1) * (m_state >> ScaleBits) + ((entry >> 12) & 0xFFF);
+
+                    while (m_state < LowerBound && !m_overrun)
+                        m_state = (m_state << 8) | NextByte();
+
+                    return static_cast<uint8_t>(entry >> 24);
+                }
+
+                // Every byte consumed, none missing, and the state where encoding began.
+                bool IsComplete() const
+                {
+                    return !m_overrun && m_data == m_end && m_state == LowerBound;
+                }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "MouseTrackerCore/Codecs/TextTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryParser.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryWriter.h"
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+namespace Mt
+{
+    CodecResult TextTrajectoryCodec::Read(const std::string& filename, Trajectory& trajectory) const
+    {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+
+        if (!file.is_open())
+            return CodecResult::Fail("Unable to open " + filename);
+
+        uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+
+        trajectory.Clear();
+
+        // Lines are at least 4 bytes ("x;y\n"), typically around 9.
+        trajectory.Reserve(static_cast<size_t>(fileSize / 8));
+
+        CodecResult result = CodecResult::Ok();
+        TextTrajectoryParser parser(trajectory);
+        std::vector<char> buffer(ReadBlockSize);
+        size_t pending = 0;
+
+        while (true)
+        {
+            // A line longer than the free space grows the buffer; real files never do this.
+            if (pending == buffer.size())
+                buffer.resize(buffer.size() * 2);
+
+            file.read(buffer.data() + pending, static_cast<std::streamsize>(buffer.size() - pending));
+
+            size_t available = pending + static_cast<size_t>(file.gcount());
+            bool last = !file;
+            size_t consumed = parser.Parse(buffer.data(), available, last);
+
+            pending = available - consumed;
+
+            if (last)
+                break;
+
+            std::memmove(buffer.data(), buffer.data() + consumed, pending);
+        }
+
+        if (file.bad())
+            return CodecResult::Fail("Read failed for " + filename);
+
+        parser.Finish(result);
+
+        return result;
+    }
+
+    CodecResult TextTrajectoryCodec::Write(const std::string& filename, const TrajectorySpan& trajectory) const
+    {
+        // Binary mode: "\n" line ends on every platform, no newline translation pass.
+        std::ofstream file(filename, std::ios::binary);
+
+        if (!file.is_open())
+            return CodecResult::Fail("Unable to open " + filename);
+
+        TextTrajectoryWriter writer;
+        writer.Write(file, trajectory);
+        file.close();
+
+        if (file.fail())
+            return CodecResult::Fail("Write failed for " + filename);
+
+        return CodecResult::Ok();
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef __MOUSE_TRACKER_CORE_TEXTTRAJECTORYCODEC__
+#define __MOUSE_TRACKER_CORE_TEXTTRAJECTORYCODEC__
+
+#include "MouseTrackerCore/Codecs/ITrajectoryCodec.h"
+
+namespace Mt
+{
+    // The original .crsdat format: one "x;y" pair per line, no metadata.
+    class TextTrajectoryCodec : public ITrajectoryCodec
+    {
+        public:
+            static constexpr size_t ReadBlockSize = 1 << 20;
+
+            CodecResult Read(const std::string& filename, Trajectory& trajectory) const override;
+            CodecResult Write(const std::string& filename, const TrajectorySpan& trajectory) const override;
+
+            const char* GetName() const override
+            {
+                return "text";
+            }
+
+            const char* GetExtension() const override
+            {
+                return ".crsdat";
+            }
+    };
+}
+
+#endif
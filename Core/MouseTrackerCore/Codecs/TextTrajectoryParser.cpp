@@ -0,0 +1,175 @@
+#include "MouseTrackerCore/Codecs/TextTrajectoryParser.h"
+#include <charconv>
+#include <cstring>
+
+namespace Mt
+{
+    namespace
+    {
+        bool IsBlank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        // Accepts surrounding blanks and a '+' sign. Unlike the old stoi parser,
+        // which stopped at the first non-digit, trailing text ("12;34abc") makes
+        // the line malformed instead of being dropped silently.
+        bool ParseCoordinate(const char* begin, const char* end, int32_t& value)
+        {
+            while (begin < end && IsBlank(*begin))
+                begin++;
+
+            while (end > begin && IsBlank(end[-1]))
+                end--;
+
+            if (begin < end && *begin == '+')
+                begin++;
+
+            if (begin == end)
+                return false;
+
+            std::from_chars_result result = std::from_chars(begin, end, value);
+
+            return result.ec == std::errc() && result.ptr == end;
+        }
+    }
+
+    namespace
+    {
+        // Plain "-123" with at most 9 digits, the shape of every written line;
+        // anything else is left to the general path.
+        inline bool ParseSimpleCoordinate(const char*& position, const char* end, int32_t& value)
+        {
+            const char* p = position;
+            bool negative = p < end && *p == '-';
+
+            if (negative)
+                p++;
+
+            const char* digits = p;
+            int32_t result = 0;
+
+            while (p < end && static_cast<unsigned char>(*p - '0') < 10 && p - digits < 9)
+                result = result * 10 + (*p++ - '0');
+
+            if (p == digits)
+                return false;
+
+            value = negative ? -result : result;
+            position = p;
+
+            return true;
+        }
+    }
+
+    bool TextTrajectoryParser::ParseLine(const char* begin, const char* end, Point& point)
+    {
+        const char* delimiter = static_cast<const char*>(std::memchr(begin, ';', static_cast<size_t>(end - begin)));
+
+        return delimiter
+            && ParseCoordinate(begin, delimiter, point.x)
+            && ParseCoordinate(delimiter + 1, end, point.y);
+    }
+
+    void TextTrajectoryParser::ParseSingle(const char* begin, const char* end)
+    {
+        m_line++;
+
+        Point point;
+
+        if (ParseLine(begin, end, point))
+        {
+            m_trajectory.Add(point);
+
+            return;
+        }
+
+        if (std::memchr(begin, ';', static_cast<size_t>(end - begin)) == nullptr)
+            return;
+
+        m_malformed++;
+        m_lastMalformedLine = m_line;
+
+        if (m_malformedLines.size() < MaxDescribedLines)
+            m_malformedLines.push_back(m_line);
+
+        if (m_malformed == 1)
+        {
+            while (end > begin && IsBlank(end[-1]))
+                end--;
+
+            m_firstMalformed.assign(begin, end);
+        }
+    }
+
+    size_t TextTrajectoryParser::Parse(const char* data, size_t size, bool last)
+    {
+        const char* position = data;
+        const char* end = data + size;
+
+        while (position < end)
+        {
+            // Fast path: one pass over "x;y\n" / "x;y\r\n" without searching ahead.
+            const char* p = position;
+            Point point;
+
+            if (ParseSimpleCoordinate(p, end, point.x) && p < end && *p == ';')
+            {
+                p++;
+
+                if (ParseSimpleCoordinate(p, end, point.y))
+                {
+                    if (p < end && *p == '\r')
+                        p++;
+
+                    if (p < end && *p == '\n')
+                    {
+                        m_line++;
+                        m_trajectory.Add(point);
+                        position = p + 1;
+
+                        continue;
+                    }
+                }
+            }
+
+            const char* newline = static_cast<const char*>(std::memchr(position, '\n', static_cast<size_t>(end - position)));
+
+            if (!newline)
+                break;
+
+            ParseSingle(position, newline);
+            position = newline + 1;
+        }
+
+        if (last && position < end)
+        {
+            ParseSingle(position, end);
+            position = end;
+        }
+
+        return static_cast<size_t>(position - data);
+    }
+
+    void TextTrajectoryParser::Finish(CodecResult& result)
+    {
+        result.MalformedRecords += m_malformed;
+
+        if (m_malformed > 0)
+        {
+            std::string lines;
+
+            for (size_t i = 0; i < m_malformedLines.size(); i++)
+                lines += (i > 0 ? ", " : "") + std::to_string(m_malformedLines[i]);
+
+            if (m_malformed > m_malformedLines.size())
+                lines += ", ... " + std::to_string(m_lastMalformedLine);
+
+            result.Warnings.push_back(std::to_string(m_malformed) + " invalid lines in trajectory file skipped (" + (m_malformed > 1 ? "lines " : "line ") + lines + "); first: " + m_firstMalformed);
+        }
+
+        m_malformedLines.clear();
+        m_firstMalformed.clear();
+        m_malformed = 0;
+    }
+}
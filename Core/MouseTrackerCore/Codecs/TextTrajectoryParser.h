@@ -0,0 +1,58 @@
+#ifndef __MOUSE_TRACKER_CORE_TEXTTRAJECTORYPARSER__
+#define __MOUSE_TRACKER_CORE_TEXTTRAJECTORYPARSER__
+
+#include "MouseTrackerCore/Trajectory/Trajectory.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Mt
+{
+    // Incremental "x;y" line parser. Feed it blocks of any size; nothing is
+    // allocated per line. Lines in the shape the writer produces are decoded
+    // in a single pass; anything else is located with memchr and converted
+    // with from_chars. Lines without ';' are skipped like before; lines with
+    // one that do not hold two integers are counted as malformed and
+    // reported together in one warning (count, first few line numbers, the
+    // last one and the first line's text), however many there are.
+    class TextTrajectoryParser
+    {
+        public:
+            static constexpr size_t MaxDescribedLines = 10;
+
+        private:
+            Trajectory& m_trajectory;
+            uint64_t m_line = 0;
+            uint64_t m_malformed = 0;
+            std::vector<uint64_t> m_malformedLines;
+            uint64_t m_lastMalformedLine = 0;
+            std::string m_firstMalformed;
+
+        public:
+            explicit TextTrajectoryParser(Trajectory& trajectory)
+                : m_trajectory(trajectory)
+            {
+            }
+
+            // Parses every complete line in the block and returns the number of
+            // bytes consumed; the caller passes the unconsumed tail again with
+            // the next block. With last set the trailing partial line is parsed too.
+            size_t Parse(const char* data, size_t size, bool last);
+
+            // Moves the malformed line count and its summary into the result.
+            void Finish(CodecResult& result);
+
+            uint64_t GetMalformedCount() const
+            {
+                return m_malformed;
+            }
+
+            // Parses one line without its terminator; false when malformed.
+            static bool ParseLine(const char* begin, const char* end, Point& point);
+
+        private:
+            void ParseSingle(const char* begin, const char* end);
+    };
+}
+
+#endif
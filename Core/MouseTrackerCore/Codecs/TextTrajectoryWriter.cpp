@@ -0,0 +1,43 @@
+#include "MouseTrackerCore/Codecs/TextTrajectoryWriter.h"
+#include <algorithm>
+
+namespace Mt
+{
+    char* TextTrajectoryWriter::FormatLines(const Point* points, size_t count, char* output)
+    {
+        size_t i = 0;
+
+        // Four lines per iteration: the room check is hoisted out entirely,
+        // and the independent conversions overlap better than one at a time.
+        for (; i + 4 <= count; i += 4)
+        {
+            output = FormatLine(output, points[i].x, points[i].y);
+            output = FormatLine(output, points[i + 1].x, points[i + 1].y);
+            output = FormatLine(output, points[i + 2].x, points[i + 2].y);
+            output = FormatLine(output, points[i + 3].x, points[i + 3].y);
+        }
+
+        for (; i < count; i++)
+            output = FormatLine(output, points[i].x, points[i].y);
+
+        return output;
+    }
+
+    bool TextTrajectoryWriter::Write(std::ostream& output, const TrajectorySpan& trajectory)
+    {
+        constexpr size_t LinesPerBlock = BlockSize / MaxLineBytes;
+
+        for (size_t first = 0; first < trajectory.Size(); first += LinesPerBlock)
+        {
+            size_t count = (std::min)(LinesPerBlock, trajectory.Size() - first);
+            char* end = FormatLines(trajectory.Points + first, count, m_block.data());
+
+            output.write(m_block.data(), end - m_block.data());
+
+            if (!output)
+                return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef __MOUSE_TRACKER_CORE_TEXTTRAJECTORYWRITER__
+#define __MOUSE_TRACKER_CORE_TEXTTRAJECTORYWRITER__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace Mt
+{
+    // "x;y\n" formatter shared by every text output. Lines are formatted with
+    // to_chars (no locale, no per-sample stream calls) into a reusable block
+    // that is written with one call per BlockSize bytes.
+    class TextTrajectoryWriter
+    {
+        public:
+            // "-2147483648;-2147483648\n"
+            static constexpr size_t MaxLineBytes = 24;
+            static constexpr size_t BlockSize = 1 << 20;
+
+        private:
+            std::vector<char> m_block;
+
+        public:
+            TextTrajectoryWriter()
+                : m_block(BlockSize)
+            {
+            }
+
+            // False when the stream reports a write error.
+            bool Write(std::ostream& output, const TrajectorySpan& trajectory);
+
+            // Caller guarantees MaxLineBytes of room at output.
+            static char* FormatLine(char* output, int32_t x, int32_t y)
+            {
+                output = std::to_chars(output, output + 11, x).ptr;
+                *output++ = ';';
+                output = std::to_chars(output, output + 11, y).ptr;
+                *output++ = '\n';
+
+                return output;
+            }
+
+            // Caller guarantees count * MaxLineBytes of room at output.
+            static char* FormatLines(const Point* points, size_t count, char* output);
+    };
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYCODECREGISTRY__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYCODECREGISTRY__
+
+#include "MouseTrackerCore/Codecs/ITrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include <memory>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cctype>
+
+namespace Mt
+{
+    class TrajectoryCodecRegistry
+    {
+        private:
+            std::vector<std::unique_ptr<ITrajectoryCodec>> m_codecs;
+
+            TrajectoryCodecRegistry()
+            {
+                RegisterCodec<TextTrajectoryCodec>();
+                RegisterCodec<BinaryTrajectoryCodec>(BinaryEncoding::Fixed);
+                RegisterCodec<BinaryTrajectoryCodec>(BinaryEncoding::DeltaVarint);
+                RegisterCodec<BinaryTrajectoryCodec>(BinaryEncoding::Predictive);
+            }
+
+            TrajectoryCodecRegistry(const TrajectoryCodecRegistry&) = delete;
+            TrajectoryCodecRegistry& operator=(const TrajectoryCodecRegistry&) = delete;
+
+        public:
+            static TrajectoryCodecRegistry& GetInstance()
+            {
+                static TrajectoryCodecRegistry instance;
+
+                return instance;
+            }
+
+            template<typename TCodec, typename... Args>
+            void RegisterCodec(Args&&... args)
+            {
+                m_codecs.push_back(std::make_unique<TCodec>(std::forward<Args>(args)...));
+            }
+
+            const ITrajectoryCodec* GetCodec(const std::string& name) const
+            {
+                for (const auto& codec : m_codecs)
+                    if (name == codec->GetName())
+                        return codec.get();
+
+                return nullptr;
+            }
+
+            // Picks the codec by file extension, falling back to the text codec.
+            const ITrajectoryCodec* GetCodecForFile(const std::string& filename) const
+            {
+                std::string extension = GetExtension(filename);
+
+                for (const auto& codec : m_codecs)
+                    if (extension == codec->GetExtension())
+                        return codec.get();
+
+                return m_codecs.front().get();
+            }
+
+            const std::vector<std::unique_ptr<ITrajectoryCodec>>& GetCodecs() const
+            {
+                return m_codecs;
+            }
+
+            static std::string GetExtension(const std::string& filename)
+            {
+                size_t dot = filename.find_last_of('.');
+                size_t separator = filename.find_last_of("/\\");
+
+                if (dot == std::string::npos || (separator != std::string::npos && dot < separator))
+                    return "";
+
+                std::string extension = filename.substr(dot);
+
+                std::transform(extension.begin(), extension.end(), extension.begin(),
+                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+                return extension;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYIO__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYIO__
+
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+
+namespace Mt
+{
+    // Extension-dispatched load/save used by every front end.
+    class TrajectoryIo
+    {
+        public:
+            static CodecResult Load(const std::string& filename, Trajectory& trajectory)
+            {
+                return TrajectoryCodecRegistry::GetInstance().GetCodecForFile(filename)->Read(filename, trajectory);
+            }
+
+            static CodecResult Save(const std::string& filename, const TrajectorySpan& trajectory)
+            {
+                return TrajectoryCodecRegistry::GetInstance().GetCodecForFile(filename)->Write(filename, trajectory);
+            }
+
+            // Lets recorders skip timestamp capture when the target format drops it anyway.
+            static bool KeepsTimestamps(const std::string& filename)
+            {
+                return TrajectoryCodecRegistry::GetInstance().GetCodecForFile(filename)->KeepsTimestamps();
+            }
+    };
+}
+
+#endif
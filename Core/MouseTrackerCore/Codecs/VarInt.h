@@ -0,0 +1,53 @@
+#ifndef __MOUSE_TRACKER_CORE_VARINT__
+#define __MOUSE_TRACKER_CORE_VARINT__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Mt
+{
+    namespace VarInt
+    {
+        inline uint64_t ZigZagEncode(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t ZigZagDecode(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        inline void Write(std::vector<uint8_t>& output, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                output.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+
+            output.push_back(static_cast<uint8_t>(value));
+        }
+
+        // Advances position past one varint; false if the buffer ends first
+        // or the value does not fit in 64 bits.
+        inline bool Read(const uint8_t* data, size_t size, size_t& position, uint64_t& value)
+        {
+            value = 0;
+
+            for (int shift = 0; shift < 64 && position < size; shift += 7)
+            {
+                uint8_t byte = data[position++];
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                    return true;
+            }
+
+            return false;
+        }
+    }
+}
+
+#endif
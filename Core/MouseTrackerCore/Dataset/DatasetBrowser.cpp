@@ -0,0 +1,392 @@
+#include "MouseTrackerCore/Dataset/DatasetBrowser.h"
+#include <filesystem>
+#include <unordered_map>
+#include <algorithm>
+
+namespace Mt
+{
+    namespace
+    {
+        constexpr const char* EntryPrefix = "entry_";
+
+        std::string MakeQueueKey(bool thumbnail, const std::string& key)
+        {
+            return (thumbnail ? "t:" : "d:") + key;
+        }
+    }
+
+    DatasetBrowser::DatasetBrowser(DatasetBrowserSettings settings)
+        : m_settings(settings),
+          m_trajectories(settings.TrajectoryCacheBytes),
+          m_thumbnails(settings.ThumbnailCacheBytes)
+    {
+        for (size_t i = 0; i < (std::max)(size_t(1), m_settings.LoaderThreads); i++)
+            m_loaders.emplace_back([this]() { this->LoaderLoop(); });
+    }
+
+    DatasetBrowser::~DatasetBrowser()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+            m_stopping = true;
+        }
+
+        m_requestAdded.notify_all();
+
+        for (auto& loader : m_loaders)
+            loader.join();
+    }
+
+    CodecResult DatasetBrowser::Open(const std::string& path)
+    {
+        Close();
+
+        std::vector<DatasetItem> items;
+        std::shared_ptr<TrajectoryArchive> archive;
+
+        if (TrajectoryArchive::IsArchive(path))
+        {
+            archive = std::make_shared<TrajectoryArchive>();
+            CodecResult result = archive->Open(path);
+
+            if (!result.Success)
+                return result;
+
+            items.resize(archive->GetCount());
+
+            for (size_t id = 0; id < items.size(); id++)
+            {
+                items[id].Name = EntryPrefix + std::to_string(id);
+                items[id].HasSummary = true;
+                items[id].Summary = archive->GetEntry(id);
+            }
+        }
+        else
+        {
+            std::error_code error;
+
+            if (!std::filesystem::is_directory(path, error))
+                return CodecResult::Fail("Not a directory or archive: " + path);
+
+            if (!m_manifest.Open(path))
+                return CodecResult::Fail("Unable to read the manifest of " + path);
+
+            m_manifest.Watch();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+            m_path = path;
+            m_archive = std::move(archive);
+            m_items = std::move(items);
+            m_manifestRevision = 0;
+        }
+
+        Refresh();
+
+        return CodecResult::Ok();
+    }
+
+    void DatasetBrowser::Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+
+            m_requests.clear();
+            m_queued.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+            // Loads still running for the old dataset are discarded on completion.
+            m_generation++;
+            m_path.clear();
+            m_archive.reset();
+            m_items.clear();
+        }
+
+        m_manifest.Close();
+        m_trajectories.Clear();
+        m_thumbnails.Clear();
+    }
+
+    bool DatasetBrowser::Refresh()
+    {
+        uint64_t revision = m_manifest.GetRevision();
+        std::string path;
+
+        {
+            std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+            if (m_archive || m_path.empty() || revision == m_manifestRevision)
+                return false;
+
+            path = m_path;
+        }
+
+        std::vector<std::string> names = m_manifest.GetNames();
+        std::unordered_map<std::string, ManifestEntry> summaries;
+
+        // Saves append their summary to the manifest, so most rows show their
+        // size and extent before anything is decoded.
+        for (auto& entry : DatasetManifest::ReadEntries(path))
+            if (entry.SampleCount > 0)
+                summaries[entry.Name] = std::move(entry);
+
+        std::vector<DatasetItem> items(names.size());
+
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            items[i].Name = std::move(names[i]);
+
+            auto it = summaries.find(items[i].Name);
+
+            if (it == summaries.end())
+                continue;
+
+            items[i].HasSummary = true;
+            items[i].Summary.SampleCount = it->second.SampleCount;
+            items[i].Summary.DurationUs = it->second.DurationUs;
+            items[i].Summary.MinX = it->second.MinX;
+            items[i].Summary.MinY = it->second.MinY;
+            items[i].Summary.MaxX = it->second.MaxX;
+            items[i].Summary.MaxY = it->second.MaxY;
+        }
+
+        std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+        if (m_path != path)
+            return false;
+
+        m_items = std::move(items);
+        m_manifestRevision = revision;
+
+        return true;
+    }
+
+    size_t DatasetBrowser::GetCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+        return m_items.size();
+    }
+
+    DatasetItem DatasetBrowser::GetItem(size_t index) const
+    {
+        std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+        return index < m_items.size() ? m_items[index] : DatasetItem();
+    }
+
+    std::string DatasetBrowser::GetItemPath(size_t index) const
+    {
+        std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+        if (index >= m_items.size())
+            return "";
+
+        if (m_archive)
+            return m_path + "#" + std::to_string(index);
+
+        return (std::filesystem::path(m_path) / m_items[index].Name).string();
+    }
+
+    std::shared_ptr<const DatasetThumbnail> DatasetBrowser::GetThumbnail(size_t index)
+    {
+        std::string name = GetItem(index).Name;
+
+        if (name.empty())
+            return nullptr;
+
+        if (auto thumbnail = m_thumbnails.Get(name))
+            return thumbnail;
+
+        Request(LoadKind::Thumbnail, index);
+
+        return nullptr;
+    }
+
+    std::shared_ptr<const MappedTrajectory> DatasetBrowser::GetTrajectory(size_t index)
+    {
+        std::string name = GetItem(index).Name;
+
+        if (name.empty())
+            return nullptr;
+
+        if (auto trajectory = m_trajectories.Get(name))
+            return trajectory;
+
+        Request(LoadKind::Trajectory, index);
+
+        return nullptr;
+    }
+
+    DatasetBrowserStats DatasetBrowser::GetStats() const
+    {
+        DatasetBrowserStats stats;
+        stats.Items = GetCount();
+        stats.Trajectories = m_trajectories.GetStats();
+        stats.Thumbnails = m_thumbnails.GetStats();
+
+        std::lock_guard<std::mutex> lock(m_requestsMutex);
+
+        stats.Pending = m_requests.size();
+        stats.Loaded = m_loaded;
+        stats.Failed = m_failed;
+        stats.Dropped = m_dropped;
+
+        return stats;
+    }
+
+    DatasetThumbnail DatasetBrowser::MakeThumbnail(const TrajectorySpan& trajectory, size_t maxPoints)
+    {
+        DatasetThumbnail thumbnail;
+        thumbnail.Summary = TrajectoryArchive::Summarize(trajectory);
+
+        size_t count = (std::min)(trajectory.Size(), (std::max)(maxPoints, size_t(2)));
+
+        if (count == 0)
+            return thumbnail;
+
+        thumbnail.Points.reserve(count);
+
+        // Evenly spaced samples, always ending on the last point.
+        for (size_t i = 0; i < count; i++)
+            thumbnail.Points.push_back(trajectory[count > 1 ? i * (trajectory.Size() - 1) / (count - 1) : 0]);
+
+        return thumbnail;
+    }
+
+    void DatasetBrowser::Request(LoadKind kind, size_t index)
+    {
+        LoadRequest request;
+        request.Kind = kind;
+
+        {
+            std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+            if (index >= m_items.size())
+                return;
+
+            request.Name = m_items[index].Name;
+            request.Generation = m_generation;
+        }
+
+        request.Key = MakeQueueKey(kind == LoadKind::Thumbnail, request.Name);
+
+        {
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+
+            if (!m_queued.insert(request.Key).second)
+                return;
+
+            m_requests.push_back(std::move(request));
+
+            while (m_requests.size() > (std::max)(size_t(1), m_settings.MaxPendingLoads))
+            {
+                m_queued.erase(m_requests.front().Key);
+                m_requests.pop_front();
+                m_dropped++;
+            }
+        }
+
+        m_requestAdded.notify_one();
+    }
+
+    void DatasetBrowser::LoaderLoop()
+    {
+        while (true)
+        {
+            LoadRequest request;
+
+            {
+                std::unique_lock<std::mutex> lock(m_requestsMutex);
+
+                m_requestAdded.wait(lock, [this]() { return m_stopping || !m_requests.empty(); });
+
+                if (m_stopping)
+                    return;
+
+                // Newest first: it is the row the user is looking at now.
+                request = std::move(m_requests.back());
+                m_requests.pop_back();
+            }
+
+            Load(request);
+
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+            m_queued.erase(request.Key);
+        }
+    }
+
+    void DatasetBrowser::Load(const LoadRequest& request)
+    {
+        std::string path;
+        std::shared_ptr<const TrajectoryArchive> archive;
+
+        {
+            std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+            if (request.Generation != m_generation)
+                return;
+
+            path = m_path;
+            archive = m_archive;
+        }
+
+        // A thumbnail load keeps the decoded trajectory too: the row is likely to be opened next.
+        auto trajectory = request.Kind == LoadKind::Thumbnail ? m_trajectories.Get(request.Name) : nullptr;
+        CodecResult result = CodecResult::Ok();
+
+        if (!trajectory)
+        {
+            if (archive)
+            {
+                Trajectory decoded;
+                result = archive->Read(std::stoull(request.Name.substr(std::char_traits<char>::length(EntryPrefix))), decoded);
+                trajectory = std::make_shared<const MappedTrajectory>(std::move(decoded));
+            }
+            else
+            {
+                auto mapped = std::make_shared<MappedTrajectory>();
+                result = mapped->Open((std::filesystem::path(path) / request.Name).string());
+                trajectory = std::move(mapped);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_itemsMutex);
+
+            if (request.Generation != m_generation)
+                return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_requestsMutex);
+
+            if (result.Success)
+                m_loaded++;
+            else
+                m_failed++;
+        }
+
+        // Cached before the thumbnail, so a row that shows its thumbnail can also be opened at once.
+        if (result.Success)
+            m_trajectories.Put(request.Name, trajectory, GetCost(*trajectory));
+
+        auto thumbnail = std::make_shared<DatasetThumbnail>(result.Success ? MakeThumbnail(trajectory->GetSpan(), m_settings.ThumbnailPoints) : DatasetThumbnail());
+        thumbnail->Error = result.Error;
+
+        // Failures are cached as an empty thumbnail with the error, so they are not retried every frame.
+        m_thumbnails.Put(request.Name, thumbnail, sizeof(DatasetThumbnail) + thumbnail->Points.size() * sizeof(Point) + thumbnail->Error.size());
+    }
+
+    size_t DatasetBrowser::GetCost(const MappedTrajectory& trajectory)
+    {
+        const TrajectorySpan& span = trajectory.GetSpan();
+
+        return sizeof(MappedTrajectory) + span.Size() * (sizeof(Point) + (span.HasTimestamps() ? sizeof(int64_t) : 0));
+    }
+}
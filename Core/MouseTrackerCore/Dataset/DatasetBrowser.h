@@ -0,0 +1,151 @@
+#ifndef __MOUSE_TRACKER_CORE_DATASETBROWSER__
+#define __MOUSE_TRACKER_CORE_DATASETBROWSER__
+
+#include "MouseTrackerCore/Dataset/DatasetManifest.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Threading/LruCache.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_set>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Mt
+{
+    struct DatasetItem
+    {
+        std::string Name;
+
+        // Known without loading for archive entries and manifest lines that
+        // carry a summary; otherwise filled in once the thumbnail has loaded.
+        bool HasSummary = false;
+        ArchiveIndexEntry Summary = {};
+    };
+
+    // A few hundred points spread evenly over the trajectory, for list rows.
+    struct DatasetThumbnail
+    {
+        std::vector<Point> Points;
+        ArchiveIndexEntry Summary = {};
+        std::string Error;
+    };
+
+    struct DatasetBrowserSettings
+    {
+        size_t TrajectoryCacheBytes = 256u << 20;
+        size_t ThumbnailCacheBytes = 16u << 20;
+        size_t ThumbnailPoints = 96;
+        size_t LoaderThreads = 2;
+
+        // Requests beyond this are dropped oldest first: rows scrolled past
+        // long ago are no longer on screen.
+        size_t MaxPendingLoads = 256;
+    };
+
+    struct DatasetBrowserStats
+    {
+        size_t Items = 0;
+        size_t Pending = 0;
+        uint64_t Loaded = 0;
+        uint64_t Failed = 0;
+        uint64_t Dropped = 0;
+        LruCacheStats Trajectories;
+        LruCacheStats Thumbnails;
+    };
+
+    // Model behind the GUI dataset browser: the trajectories of a directory
+    // (listed from its watched DatasetManifest) or of a .crsarc archive (its
+    // index). Nothing is decoded until asked for; Get* calls never block, they
+    // return what is cached and queue the rest for the loader threads, most
+    // recently requested first, so the rows on screen load before those
+    // scrolled past.
+    class DatasetBrowser
+    {
+        private:
+            enum class LoadKind
+            {
+                Thumbnail,
+                Trajectory
+            };
+
+            struct LoadRequest
+            {
+                LoadKind Kind;
+                std::string Key;
+                std::string Name;
+                uint64_t Generation;
+            };
+
+            DatasetBrowserSettings m_settings;
+            std::string m_path;
+            DatasetManifest m_manifest;
+            std::shared_ptr<const TrajectoryArchive> m_archive;
+            std::vector<DatasetItem> m_items;
+            uint64_t m_manifestRevision = 0;
+            uint64_t m_generation = 0;
+            mutable std::mutex m_itemsMutex;
+
+            LruCache<MappedTrajectory> m_trajectories;
+            LruCache<DatasetThumbnail> m_thumbnails;
+
+            std::deque<LoadRequest> m_requests;
+            std::unordered_set<std::string> m_queued;
+            uint64_t m_loaded = 0;
+            uint64_t m_failed = 0;
+            uint64_t m_dropped = 0;
+            bool m_stopping = false;
+            mutable std::mutex m_requestsMutex;
+            std::condition_variable m_requestAdded;
+            std::vector<std::thread> m_loaders;
+
+        public:
+            explicit DatasetBrowser(DatasetBrowserSettings settings = DatasetBrowserSettings());
+            DatasetBrowser(const DatasetBrowser&) = delete;
+            DatasetBrowser& operator=(const DatasetBrowser&) = delete;
+            ~DatasetBrowser();
+
+            // A directory is listed from its manifest and watched for changes;
+            // a .crsarc file is listed from its index.
+            CodecResult Open(const std::string& path);
+            void Close();
+
+            // Picks up files added or removed since the last call (directories
+            // only). Cheap when nothing changed; returns true if the list did.
+            bool Refresh();
+
+            const std::string& GetPath() const
+            {
+                return m_path;
+            }
+
+            bool IsArchive() const
+            {
+                return m_archive != nullptr;
+            }
+
+            size_t GetCount() const;
+            DatasetItem GetItem(size_t index) const;
+
+            // Full path of a directory item, or "<archive>#<entry>".
+            std::string GetItemPath(size_t index) const;
+
+            std::shared_ptr<const DatasetThumbnail> GetThumbnail(size_t index);
+            std::shared_ptr<const MappedTrajectory> GetTrajectory(size_t index);
+
+            DatasetBrowserStats GetStats() const;
+
+            static DatasetThumbnail MakeThumbnail(const TrajectorySpan& trajectory, size_t maxPoints);
+
+        private:
+            void Request(LoadKind kind, size_t index);
+            void LoaderLoop();
+            void Load(const LoadRequest& request);
+            static size_t GetCost(const MappedTrajectory& trajectory);
+    };
+}
+
+#endif
@@ -0,0 +1,344 @@
+#include "MouseTrackerCore/Dataset/DatasetManifest.h"
+#include "MouseTrackerCore/Dataset/DirectoryProcessor.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <charconv>
+
+namespace Mt
+{
+    namespace
+    {
+        constexpr const char* ManifestHeader = "# name;samples;duration_us;min_x;min_y;max_x;max_y";
+
+        std::filesystem::path GetManifestPath(const std::string& directory)
+        {
+            return std::filesystem::path(directory) / DatasetManifest::Filename;
+        }
+
+        template<typename T>
+        void ParseField(const std::string& line, size_t& position, T& value)
+        {
+            size_t end = line.find(';', position);
+
+            if (end == std::string::npos)
+                end = line.size();
+
+            std::from_chars(line.data() + position, line.data() + end, value);
+            position = end < line.size() ? end + 1 : end;
+        }
+
+        std::filesystem::file_time_type GetWriteTime(const std::filesystem::path& path)
+        {
+            std::error_code error;
+            std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+
+            return error ? std::filesystem::file_time_type::min() : time;
+        }
+    }
+
+    DatasetManifest::~DatasetManifest()
+    {
+        m_watcher.Stop();
+    }
+
+    bool DatasetManifest::Open(const std::string& directory)
+    {
+        // Stopped outside the lock: the watcher thread may be waiting for it.
+        m_watcher.Stop();
+        m_watching = false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_directory = directory;
+        m_nextIndex.clear();
+        m_names.clear();
+        m_revision++;
+
+        std::error_code error;
+        std::filesystem::path manifestPath = GetManifestPath(directory);
+
+        // Taken first, so a change made while reading shows up in Watch.
+        m_openedTime = GetWriteTime(directory);
+
+        if (std::filesystem::exists(manifestPath, error))
+        {
+            std::ifstream file(manifestPath);
+            std::string line;
+
+            while (std::getline(file, line))
+                if (!line.empty() && line[0] != '#')
+                    Track(line.substr(0, line.find(';')));
+
+            if (file.bad())
+                return false;
+
+            // Saves append to the manifest after their file is in place, so a
+            // directory changed later than the manifest had files added or
+            // removed behind its back.
+            if (m_openedTime > GetWriteTime(manifestPath))
+            {
+                std::vector<std::string> names = ScanDirectory(directory, error);
+
+                if (!error)
+                    Reconcile(names);
+            }
+
+            return true;
+        }
+
+        if (!std::filesystem::is_directory(directory, error))
+            return true;
+
+        // First use of an existing directory: one scan, then never again.
+        std::vector<std::string> names = ScanDirectory(directory, error);
+        std::ofstream file(manifestPath);
+        file << ManifestHeader << "\n";
+
+        for (const auto& name : names)
+        {
+            Track(name);
+            file << name << ";;;;;;\n";
+        }
+
+        file.close();
+
+        // Creating the manifest changed the directory itself.
+        m_openedTime = GetWriteTime(directory);
+
+        return !error && file.good();
+    }
+
+    void DatasetManifest::Close()
+    {
+        m_watcher.Stop();
+        m_watching = false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_directory.clear();
+        m_nextIndex.clear();
+        m_names.clear();
+        m_revision++;
+    }
+
+    bool DatasetManifest::Watch()
+    {
+        if (!m_watcher.Start(GetDirectory(), [this](const DirectoryEvent& event) { Apply(event); }))
+            return false;
+
+        m_watching = true;
+
+        // Files that arrived between Open and Start would otherwise be
+        // missed; only then is the directory listed again.
+        std::filesystem::file_time_type openedTime;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            openedTime = m_openedTime;
+        }
+
+        if (GetWriteTime(GetDirectory()) != openedTime)
+            Apply({ DirectoryChange::Overflow, "" });
+
+        return true;
+    }
+
+    int DatasetManifest::ReserveIndex(const std::string& baseFilename, const std::string& extension)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        int& next = m_nextIndex.try_emplace(baseFilename, 1).first->second;
+        std::error_code error;
+
+        while (std::filesystem::exists(std::filesystem::path(m_directory) / (baseFilename + "_" + std::to_string(next) + extension), error))
+            next++;
+
+        return next++;
+    }
+
+    int DatasetManifest::PeekIndex(const std::string& baseFilename) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_nextIndex.find(baseFilename);
+
+        return it != m_nextIndex.end() ? it->second : 1;
+    }
+
+    size_t DatasetManifest::GetCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_names.size();
+    }
+
+    std::vector<std::string> DatasetManifest::GetNames() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return std::vector<std::string>(m_names.begin(), m_names.end());
+    }
+
+    uint64_t DatasetManifest::GetRevision() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_revision;
+    }
+
+    bool DatasetManifest::Append(const std::string& filename, const TrajectorySpan& trajectory)
+    {
+        std::filesystem::path path(filename);
+        std::filesystem::path manifestPath = GetManifestPath(path.parent_path().string());
+        std::error_code error;
+        bool created = !std::filesystem::exists(manifestPath, error);
+
+        ArchiveIndexEntry summary = TrajectoryArchive::Summarize(trajectory);
+
+        // Built in full first so the line goes out in one append.
+        std::string line = created ? std::string(ManifestHeader) + "\n" : std::string();
+        line += path.filename().string() + ";" + std::to_string(summary.SampleCount) + ";" + std::to_string(summary.DurationUs) + ";" +
+            std::to_string(summary.MinX) + ";" + std::to_string(summary.MinY) + ";" +
+            std::to_string(summary.MaxX) + ";" + std::to_string(summary.MaxY) + "\n";
+
+        std::ofstream file(manifestPath, std::ios::app | std::ios::binary);
+        file.write(line.data(), static_cast<std::streamsize>(line.size()));
+
+        return file.good();
+    }
+
+    std::vector<ManifestEntry> DatasetManifest::ReadEntries(const std::string& directory)
+    {
+        std::vector<ManifestEntry> entries;
+        std::ifstream file(GetManifestPath(directory));
+        std::string line;
+
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            ManifestEntry entry;
+            size_t position = std::min(line.find(';'), line.size());
+            entry.Name = line.substr(0, position);
+            position = position < line.size() ? position + 1 : position;
+
+            ParseField(line, position, entry.SampleCount);
+            ParseField(line, position, entry.DurationUs);
+            ParseField(line, position, entry.MinX);
+            ParseField(line, position, entry.MinY);
+            ParseField(line, position, entry.MaxX);
+            ParseField(line, position, entry.MaxY);
+
+            entries.push_back(std::move(entry));
+        }
+
+        return entries;
+    }
+
+    bool DatasetManifest::ParseIndexedName(const std::string& name, std::string& baseFilename, int& index)
+    {
+        size_t dot = name.find_last_of('.');
+        std::string stem = name.substr(0, dot);
+        size_t separator = stem.find_last_of('_');
+
+        if (separator == std::string::npos || separator + 1 >= stem.size())
+            return false;
+
+        const char* first = stem.data() + separator + 1;
+        const char* last = stem.data() + stem.size();
+        auto parsed = std::from_chars(first, last, index);
+
+        if (parsed.ec != std::errc() || parsed.ptr != last || index < 0)
+            return false;
+
+        baseFilename = stem.substr(0, separator);
+
+        return true;
+    }
+
+    void DatasetManifest::Track(const std::string& name)
+    {
+        std::string baseFilename;
+        int index = 0;
+
+        if (m_names.insert(name).second)
+            m_revision++;
+
+        if (!ParseIndexedName(name, baseFilename, index))
+            return;
+
+        int& next = m_nextIndex.try_emplace(baseFilename, 1).first->second;
+        next = std::max(next, index + 1);
+    }
+
+    void DatasetManifest::Apply(const DirectoryEvent& event)
+    {
+        if (event.Change == DirectoryChange::Gone)
+        {
+            m_watching = false;
+
+            return;
+        }
+
+        if (event.Change == DirectoryChange::Overflow)
+        {
+            // Events were lost: the one case that still needs a full scan.
+            std::error_code error;
+            std::vector<std::string> names = ScanDirectory(GetDirectory(), error);
+
+            if (error)
+                return;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Reconcile(names);
+
+            return;
+        }
+
+        // Ignores the manifest itself, .part temp files and anything else that is not a trajectory.
+        if (!DirectoryProcessor::IsTrajectoryFile(event.Name))
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (event.Change == DirectoryChange::Added)
+            Track(event.Name);
+        else if (m_names.erase(event.Name) > 0)
+            m_revision++;
+    }
+
+    // Replaces the known names with a sorted directory listing; the caller
+    // holds the lock. Next indices only ever grow.
+    void DatasetManifest::Reconcile(const std::vector<std::string>& names)
+    {
+        if (names.size() != m_names.size() || !std::equal(names.begin(), names.end(), m_names.begin()))
+        {
+            m_names.clear();
+            m_revision++;
+        }
+
+        for (const auto& name : names)
+            Track(name);
+    }
+
+    std::vector<std::string> DatasetManifest::ScanDirectory(const std::string& directory, std::error_code& error)
+    {
+        std::vector<std::string> names;
+
+        for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+        {
+            std::string name = it->path().filename().string();
+
+            if (it->is_regular_file(error) && DirectoryProcessor::IsTrajectoryFile(name))
+                names.push_back(name);
+        }
+
+        std::sort(names.begin(), names.end());
+
+        return names;
+    }
+}
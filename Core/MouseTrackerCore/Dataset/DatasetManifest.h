@@ -0,0 +1,125 @@
+#ifndef __MOUSE_TRACKER_CORE_DATASETMANIFEST__
+#define __MOUSE_TRACKER_CORE_DATASETMANIFEST__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include "MouseTrackerCore/Platform/DirectoryWatcher.h"
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <system_error>
+#include <filesystem>
+#include <cstdint>
+
+namespace Mt
+{
+    struct ManifestEntry
+    {
+        std::string Name;
+
+        // Summary of the saved trajectory; zero for files found by a rebuild scan.
+        uint64_t SampleCount = 0;
+        int64_t DurationUs = 0;
+        int32_t MinX = 0;
+        int32_t MinY = 0;
+        int32_t MaxX = 0;
+        int32_t MaxY = 0;
+    };
+
+    // Per-directory record of saved trajectories, kept in a text file next to
+    // them with one "name;samples;duration_us;min_x;min_y;max_x;max_y" line per
+    // file. Saves append a line, so the file is never rewritten. Opening reads
+    // it once and keeps the highest index of every "<base>_<N>.<ext>" name, so
+    // the next free number is a map lookup instead of a directory walk. With
+    // Watch, files other tools add, move or delete update the loaded state as
+    // they happen; removals never lower the next index, so numbers are not
+    // reused while older saves may still be in flight. The directory is only
+    // listed when there is no manifest yet, when it changed after the
+    // manifest was last written (files added or removed while nobody was
+    // watching), when it changed between Open and Watch, or when the watcher
+    // loses events.
+    class DatasetManifest
+    {
+        private:
+            std::string m_directory;
+            std::unordered_map<std::string, int> m_nextIndex;
+            std::set<std::string> m_names;
+            uint64_t m_revision = 0;
+            mutable std::mutex m_mutex;
+            std::atomic<bool> m_watching { false };
+
+            // Directory modification time seen by Open; Watch lists the
+            // directory again only if it moved on since.
+            std::filesystem::file_time_type m_openedTime;
+            DirectoryWatcher m_watcher;
+
+        public:
+            static constexpr const char* Filename = "trajectories.manifest";
+
+            DatasetManifest() = default;
+            DatasetManifest(const DatasetManifest&) = delete;
+            DatasetManifest& operator=(const DatasetManifest&) = delete;
+            ~DatasetManifest();
+
+            // Loads the manifest of `directory`, stopping any previous watch.
+            // Without one, the directory is scanned once and the manifest
+            // written from what it holds; a manifest older than the last
+            // change to the directory is completed by a scan.
+            bool Open(const std::string& directory);
+
+            // Stops watching and forgets the loaded state.
+            void Close();
+
+            // Follows changes to the opened directory until the next Open,
+            // without listing it unless it changed since Open. Fails
+            // if the directory does not exist (yet) or the platform has no
+            // change notifications; the loaded state then stays as opened.
+            bool Watch();
+
+            bool IsWatching() const
+            {
+                return m_watching;
+            }
+
+            // Next free index for `base`, reserved so saves still in flight
+            // never get the same number. Skips names that exist on disk but
+            // were never recorded (e.g. copied in by hand).
+            int ReserveIndex(const std::string& baseFilename, const std::string& extension);
+
+            int PeekIndex(const std::string& baseFilename) const;
+
+            size_t GetCount() const;
+
+            // Trajectory files currently known in the directory, sorted by name.
+            std::vector<std::string> GetNames() const;
+
+            // Changes on every added or removed name, so views can refresh lazily.
+            uint64_t GetRevision() const;
+
+            std::string GetDirectory() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                return m_directory;
+            }
+
+            // Records a saved file in its directory's manifest. Safe from any
+            // thread; the line goes out as a single append.
+            static bool Append(const std::string& filename, const TrajectorySpan& trajectory);
+
+            static std::vector<ManifestEntry> ReadEntries(const std::string& directory);
+
+            // Splits "trajectory_12.crsdat" into "trajectory" and 12.
+            static bool ParseIndexedName(const std::string& name, std::string& baseFilename, int& index);
+
+        private:
+            void Track(const std::string& name);
+            void Apply(const DirectoryEvent& event);
+            void Reconcile(const std::vector<std::string>& names);
+            static std::vector<std::string> ScanDirectory(const std::string& directory, std::error_code& error);
+    };
+}
+
+#endif
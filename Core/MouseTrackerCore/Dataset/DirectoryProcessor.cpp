@@ -0,0 +1,482 @@
+#include "MouseTrackerCore/Dataset/DirectoryProcessor.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryFormat.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Threading/ThreadPool.h"
+#include "MouseTrackerCore/Threading/ByteBudget.h"
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+namespace Mt
+{
+    namespace
+    {
+        constexpr size_t MaxReportedErrors = 20;
+
+        struct SharedCounters
+        {
+            std::atomic<uint64_t> FilesDone { 0 };
+            std::atomic<uint64_t> FilesFailed { 0 };
+            std::atomic<uint64_t> FilesWithWarnings { 0 };
+            std::atomic<uint64_t> MalformedRecords { 0 };
+            std::atomic<uint64_t> Samples { 0 };
+            std::atomic<uint64_t> SamplesWritten { 0 };
+            std::atomic<uint64_t> BytesRead { 0 };
+            std::atomic<uint64_t> BytesWritten { 0 };
+            std::mutex ErrorsMutex;
+            std::vector<std::string> Errors;
+
+            void Fail(const std::string& filename, const std::string& reason)
+            {
+                FilesFailed++;
+                AddError(filename, reason);
+            }
+
+            void AddError(const std::string& filename, const std::string& reason)
+            {
+                std::lock_guard<std::mutex> lock(ErrorsMutex);
+
+                if (Errors.size() < MaxReportedErrors)
+                    Errors.push_back(filename + ": " + reason);
+            }
+        };
+
+        // Memory a file takes while it is worked on, for the in-flight budget:
+        // its decoded columns, which delta and predictive files (sample count
+        // from the header) and text files (up to 8 bytes of point per 4-byte
+        // "x;y" line) take several times their size for. Archives are decoded
+        // one entry at a time and charged their size.
+        uint64_t EstimateInFlightBytes(const std::filesystem::path& path, uint64_t size)
+        {
+            std::string extension = TrajectoryCodecRegistry::GetExtension(path.string());
+
+            if (extension == ".crsdat")
+                return 2 * size;
+
+            if (extension != ".crsbin")
+                return size;
+
+            BinaryTrajectoryHeader header;
+            std::ifstream file(path, std::ios::binary);
+
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !header.Validate().empty() ||
+                header.GetEncoding() == BinaryEncoding::Chunked)
+                return size;
+
+            return (std::max)(size, BinaryTrajectoryHeader::GetFixedPayloadBytes(header.SampleCount, header.HasTimestamps()));
+        }
+
+        // Where convert writes a file: its path under the output directory
+        // with the target extension, so "a.crsdat" and "a.crsbin" would both
+        // become "a.<target>". The second one found keeps its own extension
+        // in the name ("a.crsbin.<target>"); empty if even that is taken.
+        std::filesystem::path ClaimOutputPath
+        (
+            const DirectoryProcessSettings& settings,
+            const ITrajectoryCodec* targetCodec,
+            const std::filesystem::path& input,
+            std::set<std::filesystem::path>& claimed
+        )
+        {
+            std::error_code error;
+            std::filesystem::path output = std::filesystem::path(settings.OutputDirectory) / std::filesystem::relative(input, settings.InputDirectory, error);
+            std::filesystem::path withSourceExtension = output;
+            output.replace_extension(targetCodec->GetExtension());
+            withSourceExtension += targetCodec->GetExtension();
+
+            for (const auto& candidate : { output, withSourceExtension })
+                if (claimed.insert(candidate.lexically_normal()).second)
+                    return candidate;
+
+            return {};
+        }
+
+        // Convert writes archive entry N to <archive stem>/entry_N.<ext>. The
+        // entries are claimed together or not at all, so a clash with another
+        // input fails the archive before anything is written.
+        bool ClaimArchiveOutputs
+        (
+            const DirectoryProcessSettings& settings,
+            const ITrajectoryCodec* targetCodec,
+            const std::filesystem::path& input,
+            size_t count,
+            std::set<std::filesystem::path>& claimed,
+            std::vector<std::filesystem::path>& outputs
+        )
+        {
+            std::error_code error;
+            std::filesystem::path directory = std::filesystem::path(settings.OutputDirectory) / std::filesystem::relative(input, settings.InputDirectory, error);
+            directory.replace_extension("");
+
+            outputs.clear();
+
+            for (size_t id = 0; id < count; id++)
+            {
+                outputs.push_back(directory / ("entry_" + std::to_string(id) + targetCodec->GetExtension()));
+
+                if (claimed.count(outputs.back().lexically_normal()) > 0)
+                    return false;
+            }
+
+            for (const auto& output : outputs)
+                claimed.insert(output.lexically_normal());
+
+            return true;
+        }
+
+        // One input as handed to a worker, with its outputs already claimed.
+        // Convert opens archives while scanning, to claim an output per entry.
+        struct FileJob
+        {
+            std::filesystem::path Input;
+            std::filesystem::path Output;
+            uint64_t Size = 0;
+            std::shared_ptr<TrajectoryArchive> Archive;
+            std::vector<std::filesystem::path> EntryOutputs;
+        };
+
+        // Writes one converted trajectory, simplified first when asked to.
+        CodecResult WriteConverted
+        (
+            const DirectoryProcessSettings& settings,
+            const ITrajectoryCodec* targetCodec,
+            const std::filesystem::path& output,
+            const TrajectorySpan& trajectory,
+            SharedCounters& counters
+        )
+        {
+            Trajectory simplified;
+            TrajectorySpan span = trajectory;
+
+            if (settings.Simplify.IsEnabled())
+            {
+                simplified = TrajectorySimplifier::Simplify(trajectory, settings.Simplify);
+                span = simplified;
+            }
+
+            CodecResult result = targetCodec->Write(output.string(), span);
+
+            if (result.Success)
+            {
+                std::error_code error;
+
+                counters.SamplesWritten += span.Size();
+                counters.BytesWritten += std::filesystem::file_size(output, error);
+            }
+
+            return result;
+        }
+
+        // Every entry is decoded; convert writes each to its claimed output.
+        void ProcessArchive
+        (
+            const DirectoryProcessSettings& settings,
+            const ITrajectoryCodec* targetCodec,
+            const FileJob& job,
+            SharedCounters& counters
+        )
+        {
+            const std::string inputName = job.Input.string();
+            std::shared_ptr<TrajectoryArchive> opened = job.Archive;
+
+            if (!opened)
+            {
+                opened = std::make_shared<TrajectoryArchive>();
+                CodecResult openResult = opened->Open(inputName);
+
+                if (!openResult.Success)
+                {
+                    counters.Fail(inputName, openResult.Error);
+
+                    return;
+                }
+            }
+
+            const TrajectoryArchive& archive = *opened;
+
+            if (settings.Action == ProcessAction::Convert && !job.EntryOutputs.empty())
+            {
+                std::error_code error;
+                std::filesystem::create_directories(job.EntryOutputs.front().parent_path(), error);
+            }
+
+            uint64_t malformed = archive.IsRecovered() ? 1 : 0;
+            Trajectory trajectory;
+
+            for (size_t id = 0; id < archive.GetCount(); id++)
+            {
+                CodecResult readResult = archive.Read(id, trajectory);
+
+                if (!readResult.Success)
+                {
+                    malformed++;
+                    counters.AddError(inputName, readResult.Error);
+
+                    continue;
+                }
+
+                counters.Samples += trajectory.Size();
+
+                if (settings.Action != ProcessAction::Convert)
+                    continue;
+
+                CodecResult writeResult = WriteConverted(settings, targetCodec, job.EntryOutputs[id], trajectory, counters);
+
+                if (!writeResult.Success)
+                {
+                    counters.Fail(inputName, writeResult.Error);
+
+                    return;
+                }
+            }
+
+            if (malformed > 0)
+            {
+                counters.FilesWithWarnings++;
+                counters.MalformedRecords += malformed;
+            }
+
+            counters.FilesDone++;
+        }
+
+        void ProcessFile
+        (
+            const DirectoryProcessSettings& settings,
+            const ITrajectoryCodec* targetCodec,
+            const FileJob& job,
+            SharedCounters& counters
+        )
+        {
+            const std::string inputName = job.Input.string();
+            const std::filesystem::path& output = job.Output;
+
+            if (TrajectoryArchive::IsArchive(inputName))
+            {
+                counters.BytesRead += job.Size;
+                ProcessArchive(settings, targetCodec, job, counters);
+
+                return;
+            }
+
+            // Fixed-width binary inputs are processed straight from the mapping.
+            MappedTrajectory source;
+            CodecResult readResult = source.Open(inputName);
+            const TrajectorySpan& trajectory = source.GetSpan();
+
+            counters.BytesRead += job.Size;
+
+            if (!readResult.Success)
+            {
+                counters.Fail(inputName, readResult.Error);
+
+                return;
+            }
+
+            if (readResult.MalformedRecords > 0)
+            {
+                counters.FilesWithWarnings++;
+                counters.MalformedRecords += readResult.MalformedRecords;
+            }
+
+            counters.Samples += trajectory.Size();
+
+            if (settings.Action == ProcessAction::Convert)
+            {
+                std::error_code error;
+                std::filesystem::create_directories(output.parent_path(), error);
+
+                CodecResult writeResult = WriteConverted(settings, targetCodec, output, trajectory, counters);
+
+                if (!writeResult.Success)
+                {
+                    counters.Fail(inputName, writeResult.Error);
+
+                    return;
+                }
+            }
+
+            counters.FilesDone++;
+        }
+    }
+
+    bool DirectoryProcessor::IsTrajectoryFile(const std::string& filename)
+    {
+        std::string extension = TrajectoryCodecRegistry::GetExtension(filename);
+
+        if (extension == TrajectoryArchive::Extension)
+            return true;
+
+        for (const auto& codec : TrajectoryCodecRegistry::GetInstance().GetCodecs())
+            if (extension == codec->GetExtension())
+                return true;
+
+        return false;
+    }
+
+    DirectoryProcessSummary DirectoryProcessor::Run(const DirectoryProcessSettings& settings, const DirectoryProgressCallback& progress)
+    {
+        DirectoryProcessSummary summary;
+        const ITrajectoryCodec* targetCodec = TrajectoryCodecRegistry::GetInstance().GetCodec(settings.TargetCodec);
+
+        if (settings.Action == ProcessAction::Convert && (!targetCodec || settings.OutputDirectory.empty()))
+        {
+            summary.Errors.push_back(targetCodec ? "No output directory" : "Unknown codec: " + settings.TargetCodec);
+
+            return summary;
+        }
+
+        SharedCounters counters;
+        ByteBudget budget(settings.MaxInFlightBytes);
+        uint64_t filesFound = 0;
+        std::set<std::filesystem::path> claimedOutputs;
+
+        auto start = std::chrono::steady_clock::now();
+        auto lastReport = start;
+        auto interval = std::chrono::milliseconds(settings.ProgressIntervalMs);
+
+        auto report = [&](bool scanning, bool force)
+        {
+            auto now = std::chrono::steady_clock::now();
+
+            if (!progress || (!force && now - lastReport < interval))
+                return;
+
+            lastReport = now;
+
+            DirectoryProcessProgress state;
+            state.FilesFound = filesFound;
+            state.FilesDone = counters.FilesDone + counters.FilesFailed;
+            state.BytesRead = counters.BytesRead;
+            state.Scanning = scanning;
+            state.ElapsedSeconds = std::chrono::duration<double>(now - start).count();
+
+            progress(state);
+        };
+
+        {
+            ThreadPool pool(settings.Threads);
+            summary.Threads = pool.GetThreadCount();
+
+            std::error_code error;
+            auto options = std::filesystem::directory_options::skip_permission_denied;
+
+            // An output directory inside the input is not read back.
+            std::error_code outputError;
+            std::filesystem::path outputRoot;
+
+            if (settings.Action == ProcessAction::Convert)
+                outputRoot = std::filesystem::weakly_canonical(settings.OutputDirectory, outputError);
+
+            for (std::filesystem::recursive_directory_iterator it(settings.InputDirectory, options, error), end; !error && it != end; it.increment(error))
+            {
+                std::error_code entryError;
+
+                if (!outputRoot.empty() && it->is_directory(entryError) && std::filesystem::weakly_canonical(it->path(), entryError) == outputRoot)
+                {
+                    it.disable_recursion_pending();
+
+                    continue;
+                }
+
+                if (!it->is_regular_file(error) || !IsTrajectoryFile(it->path().string()))
+                    continue;
+
+                FileJob job;
+                job.Input = it->path();
+                job.Size = it->file_size(error);
+
+                const std::string inputName = job.Input.string();
+
+                filesFound++;
+
+                // Claimed here, on the one scanning thread, so no two workers
+                // ever write the same file.
+                if (settings.Action == ProcessAction::Convert && TrajectoryArchive::IsArchive(inputName))
+                {
+                    job.Archive = std::make_shared<TrajectoryArchive>();
+                    CodecResult openResult = job.Archive->Open(inputName);
+
+                    if (!openResult.Success)
+                    {
+                        counters.BytesRead += job.Size;
+                        counters.Fail(inputName, openResult.Error);
+
+                        continue;
+                    }
+
+                    if (!ClaimArchiveOutputs(settings, targetCodec, job.Input, job.Archive->GetCount(), claimedOutputs, job.EntryOutputs))
+                    {
+                        counters.Fail(inputName, "Output name already used by another input");
+
+                        continue;
+                    }
+                }
+                else if (settings.Action == ProcessAction::Convert)
+                {
+                    job.Output = ClaimOutputPath(settings, targetCodec, job.Input, claimedOutputs);
+
+                    if (job.Output.empty())
+                    {
+                        counters.Fail(inputName, "Output name already used by another input");
+
+                        continue;
+                    }
+                }
+
+                // Blocks here, not in the workers, once the in-flight budget is used up.
+                uint64_t charge = EstimateInFlightBytes(job.Input, job.Size);
+                budget.Acquire(charge);
+
+                pool.Submit([&settings, targetCodec, job, charge, &counters, &budget]()
+                {
+                    try
+                    {
+                        ProcessFile(settings, targetCodec, job, counters);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        counters.Fail(job.Input.string(), e.what());
+                    }
+
+                    budget.Release(charge);
+                });
+
+                report(true, false);
+            }
+
+            if (error)
+                counters.AddError(settings.InputDirectory, error.message());
+
+            while (counters.FilesDone + counters.FilesFailed < filesFound)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                report(false, false);
+            }
+
+            pool.WaitIdle();
+        }
+
+        report(false, true);
+
+        summary.FilesProcessed = counters.FilesDone;
+        summary.FilesFailed = counters.FilesFailed;
+        summary.FilesWithWarnings = counters.FilesWithWarnings;
+        summary.MalformedRecords = counters.MalformedRecords;
+        summary.Samples = counters.Samples;
+        summary.SamplesWritten = counters.SamplesWritten;
+        summary.BytesRead = counters.BytesRead;
+        summary.BytesWritten = counters.BytesWritten;
+        summary.PeakInFlightBytes = budget.GetPeak();
+        summary.ElapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        summary.Errors = std::move(counters.Errors);
+
+        return summary;
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef __MOUSE_TRACKER_CORE_DIRECTORYPROCESSOR__
+#define __MOUSE_TRACKER_CORE_DIRECTORYPROCESSOR__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySimplifier.h"
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace Mt
+{
+    enum class ProcessAction
+    {
+        // Load every file and report failures and malformed records.
+        Validate,
+
+        // Load every file and write it under OutputDirectory with TargetCodec,
+        // mirroring the input tree. Same codec re-encodes; with Simplify
+        // enabled only the samples the simplifier keeps are written. Inputs
+        // that differ only by extension keep it in the output name, e.g.
+        // "a.crsbin" next to "a.crsdat" becomes "a.crsbin.crsdat".
+        Convert
+    };
+
+    struct DirectoryProcessSettings
+    {
+        ProcessAction Action = ProcessAction::Validate;
+        std::string InputDirectory;
+        std::string OutputDirectory;
+        std::string TargetCodec = "text";
+        SimplifySettings Simplify;
+
+        // 0 = one per hardware thread.
+        size_t Threads = 0;
+
+        // Upper bound on the decoded size of files being worked on at the
+        // same time (estimated from binary headers and text file sizes).
+        uint64_t MaxInFlightBytes = 256ull << 20;
+
+        int64_t ProgressIntervalMs = 500;
+    };
+
+    struct DirectoryProcessProgress
+    {
+        uint64_t FilesFound = 0;
+        uint64_t FilesDone = 0;
+        uint64_t BytesRead = 0;
+        bool Scanning = true;
+        double ElapsedSeconds = 0.0;
+    };
+
+    struct DirectoryProcessSummary
+    {
+        uint64_t FilesProcessed = 0;
+        uint64_t FilesFailed = 0;
+        uint64_t FilesWithWarnings = 0;
+        uint64_t MalformedRecords = 0;
+        uint64_t Samples = 0;
+        uint64_t SamplesWritten = 0;
+        uint64_t BytesRead = 0;
+        uint64_t BytesWritten = 0;
+        uint64_t PeakInFlightBytes = 0;
+        size_t Threads = 0;
+        double ElapsedSeconds = 0.0;
+
+        // First few failures, "path: reason".
+        std::vector<std::string> Errors;
+
+        double GetFilesPerSecond() const
+        {
+            return ElapsedSeconds > 0.0 ? (FilesProcessed + FilesFailed) / ElapsedSeconds : 0.0;
+        }
+
+        // Samples read per sample written, for simplifying conversions.
+        double GetCompressionRatio() const
+        {
+            return SamplesWritten > 0 ? static_cast<double>(Samples) / SamplesWritten : 0.0;
+        }
+
+        double GetMegabytesPerSecond() const
+        {
+            return ElapsedSeconds > 0.0 ? BytesRead / (1024.0 * 1024.0) / ElapsedSeconds : 0.0;
+        }
+    };
+
+    using DirectoryProgressCallback = std::function<void(const DirectoryProcessProgress&)>;
+
+    // Walks a directory tree and runs an action on every trajectory file (any
+    // extension with a registered codec) across a thread pool. Loading and
+    // writing go through the regular codecs, so results match single-file I/O.
+    class DirectoryProcessor
+    {
+        public:
+            static DirectoryProcessSummary Run(const DirectoryProcessSettings& settings, const DirectoryProgressCallback& progress = nullptr);
+
+            static bool IsTrajectoryFile(const std::string& filename);
+    };
+}
+
+#endif
@@ -0,0 +1,190 @@
+#include "MouseTrackerCore/Dataset/NumpyExporter.h"
+#include "MouseTrackerCore/Dataset/NumpyWriter.h"
+#include "MouseTrackerCore/Threading/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace Mt
+{
+    namespace
+    {
+        // Trajectories per resampling task; small enough to balance skewed lengths.
+        constexpr size_t ResampleBatch = 64;
+
+        CodecResult WriteCommonArrays(NumpyWriter& writer, const TrajectoryDataset& dataset)
+        {
+            size_t count = dataset.GetCount();
+            size_t width = 1;
+
+            for (size_t i = 0; i < count; i++)
+                width = (std::max)(width, dataset.GetName(i).size());
+
+            // Fixed-width, zero-padded byte strings; NumPy strips the padding.
+            std::vector<char> names(count * width, '\0');
+
+            for (size_t i = 0; i < count; i++)
+                std::memcpy(names.data() + i * width, dataset.GetName(i).data(), dataset.GetName(i).size());
+
+            CodecResult result = writer.Write("names", "|S" + std::to_string(width), { count }, names.data(), names.size());
+
+            if (!result.Success)
+                return result;
+
+            std::vector<int64_t> metadata;
+            metadata.reserve(count * 4);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const TrajectoryMetadata& values = dataset.GetSpan(i).Metadata;
+
+                metadata.push_back(values.PeriodUs);
+                metadata.push_back(values.StartTimeUs);
+                metadata.push_back(values.ScreenWidth);
+                metadata.push_back(values.ScreenHeight);
+            }
+
+            return writer.Write("metadata", "<i8", { count, 4 }, metadata.data(), metadata.size() * sizeof(int64_t));
+        }
+
+        CodecResult WriteRagged(NumpyWriter& writer, const TrajectoryDataset& dataset)
+        {
+            const auto& points = dataset.GetPoints();
+            const auto& offsets = dataset.GetOffsets();
+
+            static_assert(sizeof(Point) == 2 * sizeof(int32_t), "Points must be packed int32 pairs");
+
+            // The arena columns are already the arrays NumPy expects.
+            CodecResult result = writer.Write("points", "<i4", { points.size(), 2 }, points.data(), points.size() * sizeof(Point));
+
+            if (result.Success)
+                result = writer.Write("offsets", "<i8", { offsets.size() }, offsets.data(), offsets.size() * sizeof(uint64_t));
+
+            if (result.Success && dataset.HasTimestamps())
+                result = writer.Write("timestamps", "<i8", { dataset.GetTimestamps().size() }, dataset.GetTimestamps().data(), dataset.GetTimestamps().size() * sizeof(int64_t));
+
+            return result;
+        }
+
+        CodecResult WriteResampled(NumpyWriter& writer, const TrajectoryDataset& dataset, const NumpyExportSettings& settings)
+        {
+            size_t count = dataset.GetCount();
+            size_t length = (std::max)(size_t(1), settings.Length);
+            std::vector<float> points(count * length * 2);
+            std::vector<int64_t> lengths(count);
+
+            ThreadPool pool(settings.Threads);
+
+            for (size_t first = 0; first < count; first += ResampleBatch)
+            {
+                pool.Submit([&, first]()
+                {
+                    for (size_t i = first; i < (std::min)(count, first + ResampleBatch); i++)
+                    {
+                        TrajectorySpan trajectory = dataset.GetSpan(i);
+
+                        NumpyExporter::Resample(trajectory, length, points.data() + i * length * 2);
+                        lengths[i] = static_cast<int64_t>(trajectory.Size());
+                    }
+                });
+            }
+
+            pool.WaitIdle();
+
+            CodecResult result = writer.Write("points", "<f4", { count, length, 2 }, points.data(), points.size() * sizeof(float));
+
+            if (result.Success)
+                result = writer.Write("lengths", "<i8", { count }, lengths.data(), lengths.size() * sizeof(int64_t));
+
+            return result;
+        }
+    }
+
+    CodecResult NumpyExporter::Export(const TrajectoryDataset& dataset, const NumpyExportSettings& settings, NumpyExportSummary* summary)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        NumpyWriter writer;
+        CodecResult result = writer.Open(settings.OutputPath);
+
+        if (result.Success)
+            result = settings.Layout == NumpyLayout::Ragged ? WriteRagged(writer, dataset) : WriteResampled(writer, dataset, settings);
+
+        if (result.Success)
+            result = WriteCommonArrays(writer, dataset);
+
+        CodecResult closed = writer.Close();
+
+        if (result.Success)
+            result = closed;
+
+        if (summary)
+        {
+            summary->Trajectories = dataset.GetCount();
+            summary->Samples = dataset.GetSampleCount();
+            summary->BytesWritten = writer.GetBytesWritten();
+            summary->ElapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        return result;
+    }
+
+    void NumpyExporter::Resample(const TrajectorySpan& trajectory, size_t length, float* output)
+    {
+        size_t count = trajectory.Size();
+
+        if (count == 0)
+        {
+            std::fill(output, output + length * 2, 0.0f);
+
+            return;
+        }
+
+        bool byTime = trajectory.HasTimestamps() && trajectory.Timestamps[count - 1] > trajectory.Timestamps[0];
+        double first = byTime ? static_cast<double>(trajectory.Timestamps[0]) : 0.0;
+        double last = byTime ? static_cast<double>(trajectory.Timestamps[count - 1]) : static_cast<double>(count - 1);
+        size_t segment = 0;
+
+        for (size_t k = 0; k < length; k++)
+        {
+            double target = length > 1 ? first + (last - first) * k / (length - 1) : first;
+            double fraction = 0.0;
+
+            // Targets only grow, so the segment search resumes where it stopped.
+            if (byTime)
+            {
+                while (segment + 2 < count && trajectory.Timestamps[segment + 1] <= target)
+                    segment++;
+
+                double left = static_cast<double>(trajectory.Timestamps[segment]);
+                double right = static_cast<double>(trajectory.Timestamps[(std::min)(segment + 1, count - 1)]);
+                fraction = right > left ? (target - left) / (right - left) : 0.0;
+            }
+            else
+            {
+                segment = (std::min)(static_cast<size_t>(target), count > 1 ? count - 2 : 0);
+                fraction = target - segment;
+            }
+
+            fraction = (std::min)(1.0, (std::max)(0.0, fraction));
+
+            const Point& from = trajectory[segment];
+            const Point& to = trajectory[(std::min)(segment + 1, count - 1)];
+
+            output[2 * k] = static_cast<float>(from.x + (to.x - from.x) * fraction);
+            output[2 * k + 1] = static_cast<float>(from.y + (to.y - from.y) * fraction);
+        }
+    }
+
+    bool NumpyExporter::ParseLayout(const std::string& name, NumpyLayout& layout)
+    {
+        if (name == "ragged")
+            layout = NumpyLayout::Ragged;
+        else if (name == "resampled")
+            layout = NumpyLayout::Resampled;
+        else
+            return false;
+
+        return true;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef __MOUSE_TRACKER_CORE_NUMPYEXPORTER__
+#define __MOUSE_TRACKER_CORE_NUMPYEXPORTER__
+
+#include "MouseTrackerCore/Dataset/TrajectoryDataset.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include <string>
+#include <cstdint>
+
+namespace Mt
+{
+    enum class NumpyLayout
+    {
+        // points (S, 2) int32 straight from the arena, offsets (N + 1) int64
+        // (trajectory i is points[offsets[i]:offsets[i + 1]]) and, when the
+        // dataset keeps them, timestamps (S) int64.
+        Ragged,
+
+        // points (N, L, 2) float32, every trajectory resampled to Length
+        // samples (evenly in time when it has timestamps, else by index),
+        // plus lengths (N) int64 with the original sample counts.
+        Resampled
+    };
+
+    struct NumpyExportSettings
+    {
+        // A .npz archive, or a directory that receives one .npy per array.
+        std::string OutputPath;
+
+        NumpyLayout Layout = NumpyLayout::Ragged;
+
+        // Samples per trajectory for the resampled layout.
+        size_t Length = 128;
+
+        // Resampling threads; 0 = one per hardware thread.
+        size_t Threads = 0;
+    };
+
+    struct NumpyExportSummary
+    {
+        uint64_t Trajectories = 0;
+        uint64_t Samples = 0;
+        uint64_t BytesWritten = 0;
+        double ElapsedSeconds = 0.0;
+    };
+
+    // Writes a TrajectoryDataset as NumPy arrays, so Python reads it with one
+    // np.load instead of parsing "x;y" lines. Both layouts also write names
+    // (N) |S bytes (GetName of each trajectory) and metadata (N, 4) int64
+    // (period_us, start_time_us, screen_width, screen_height).
+    class NumpyExporter
+    {
+        public:
+            static CodecResult Export(const TrajectoryDataset& dataset, const NumpyExportSettings& settings, NumpyExportSummary* summary = nullptr);
+
+            // Writes length (x, y) pairs to output. An empty trajectory gives zeros.
+            static void Resample(const TrajectorySpan& trajectory, size_t length, float* output);
+
+            static bool ParseLayout(const std::string& name, NumpyLayout& layout);
+    };
+}
+
+#endif
@@ -0,0 +1,287 @@
+#include "MouseTrackerCore/Dataset/NumpyWriter.h"
+#include "MouseTrackerCore/Codecs/Crc32.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include <filesystem>
+
+namespace Mt
+{
+    namespace
+    {
+        constexpr uint32_t LocalHeaderSignature = 0x04034B50;
+        constexpr uint32_t CentralHeaderSignature = 0x02014B50;
+        constexpr uint32_t Zip64EndSignature = 0x06064B50;
+        constexpr uint32_t Zip64LocatorSignature = 0x07064B50;
+        constexpr uint32_t EndSignature = 0x06054B50;
+        constexpr uint16_t Zip64ExtraId = 0x0001;
+        constexpr uint16_t VersionStored = 20;
+        constexpr uint16_t VersionZip64 = 45;
+        constexpr uint32_t Max32 = 0xFFFFFFFF;
+        constexpr uint16_t Max16 = 0xFFFF;
+
+        // 1980-01-01 00:00, the earliest DOS date; the exports carry no file times.
+        constexpr uint16_t DosTime = 0;
+        constexpr uint16_t DosDate = (1 << 5) | 1;
+
+        void Put16(std::vector<uint8_t>& output, uint16_t value)
+        {
+            output.push_back(static_cast<uint8_t>(value));
+            output.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        void Put32(std::vector<uint8_t>& output, uint32_t value)
+        {
+            Put16(output, static_cast<uint16_t>(value));
+            Put16(output, static_cast<uint16_t>(value >> 16));
+        }
+
+        void Put64(std::vector<uint8_t>& output, uint64_t value)
+        {
+            Put32(output, static_cast<uint32_t>(value));
+            Put32(output, static_cast<uint32_t>(value >> 32));
+        }
+
+        void PutString(std::vector<uint8_t>& output, const std::string& value)
+        {
+            output.insert(output.end(), value.begin(), value.end());
+        }
+    }
+
+    NumpyWriter::~NumpyWriter()
+    {
+        Close();
+    }
+
+    CodecResult NumpyWriter::Open(const std::string& path)
+    {
+        Close();
+
+        m_path = path;
+        m_archive = IsArchivePath(path);
+        m_entries.clear();
+        m_bytesWritten = 0;
+
+        std::error_code error;
+        std::filesystem::path target(path);
+
+        if (m_archive)
+        {
+            if (target.has_parent_path())
+                std::filesystem::create_directories(target.parent_path(), error);
+
+            m_file = std::fopen(path.c_str(), "wb");
+
+            if (!m_file)
+                return CodecResult::Fail("Unable to open " + path);
+        }
+        else
+        {
+            std::filesystem::create_directories(target, error);
+
+            if (!std::filesystem::is_directory(target, error))
+                return CodecResult::Fail("Unable to create directory " + path);
+        }
+
+        m_open = true;
+
+        return CodecResult::Ok();
+    }
+
+    CodecResult NumpyWriter::Write(const std::string& name, const std::string& descr, const std::vector<uint64_t>& shape, const void* data, uint64_t bytes)
+    {
+        if (!m_open)
+            return CodecResult::Fail("Output not open");
+
+        std::string header = MakeHeader(descr, shape);
+        std::string member = name + ".npy";
+
+        if (!m_archive)
+        {
+            std::string filename = (std::filesystem::path(m_path) / member).string();
+            m_file = std::fopen(filename.c_str(), "wb");
+
+            if (!m_file)
+                return CodecResult::Fail("Unable to open " + filename);
+
+            bool written = WriteBytes(header.data(), header.size()) && WriteBytes(data, bytes);
+            bool closed = std::fclose(m_file) == 0;
+            m_file = nullptr;
+
+            return written && closed ? CodecResult::Ok() : CodecResult::Fail("Write failed for " + filename);
+        }
+
+        ZipEntry entry;
+        entry.Name = member;
+        entry.Size = header.size() + bytes;
+        entry.Offset = m_bytesWritten;
+        entry.Crc = Crc32::Update(Crc32::Compute(header.data(), header.size()), data, static_cast<size_t>(bytes));
+
+        bool zip64 = entry.Size >= Max32;
+        std::vector<uint8_t> local;
+
+        Put32(local, LocalHeaderSignature);
+        Put16(local, zip64 ? VersionZip64 : VersionStored);
+        Put16(local, 0);
+        Put16(local, 0);
+        Put16(local, DosTime);
+        Put16(local, DosDate);
+        Put32(local, entry.Crc);
+        Put32(local, zip64 ? Max32 : static_cast<uint32_t>(entry.Size));
+        Put32(local, zip64 ? Max32 : static_cast<uint32_t>(entry.Size));
+        Put16(local, static_cast<uint16_t>(member.size()));
+        Put16(local, zip64 ? 20 : 0);
+        PutString(local, member);
+
+        if (zip64)
+        {
+            Put16(local, Zip64ExtraId);
+            Put16(local, 16);
+            Put64(local, entry.Size);
+            Put64(local, entry.Size);
+        }
+
+        if (!WriteBytes(local.data(), local.size()) || !WriteBytes(header.data(), header.size()) || !WriteBytes(data, bytes))
+            return CodecResult::Fail("Write failed for " + m_path);
+
+        m_entries.push_back(std::move(entry));
+
+        return CodecResult::Ok();
+    }
+
+    CodecResult NumpyWriter::Close()
+    {
+        if (!m_open)
+            return CodecResult::Ok();
+
+        m_open = false;
+
+        if (!m_archive)
+            return CodecResult::Ok();
+
+        std::vector<uint8_t> directory;
+        uint64_t directoryOffset = m_bytesWritten;
+        bool zip64Archive = m_entries.size() >= Max16;
+
+        for (const auto& entry : m_entries)
+        {
+            bool zip64 = entry.Size >= Max32 || entry.Offset >= Max32;
+            zip64Archive = zip64Archive || zip64;
+
+            Put32(directory, CentralHeaderSignature);
+            Put16(directory, VersionZip64);
+            Put16(directory, zip64 ? VersionZip64 : VersionStored);
+            Put16(directory, 0);
+            Put16(directory, 0);
+            Put16(directory, DosTime);
+            Put16(directory, DosDate);
+            Put32(directory, entry.Crc);
+            Put32(directory, zip64 ? Max32 : static_cast<uint32_t>(entry.Size));
+            Put32(directory, zip64 ? Max32 : static_cast<uint32_t>(entry.Size));
+            Put16(directory, static_cast<uint16_t>(entry.Name.size()));
+            Put16(directory, zip64 ? 28 : 0);
+            Put16(directory, 0);
+            Put16(directory, 0);
+            Put16(directory, 0);
+            Put32(directory, 0);
+            Put32(directory, zip64 ? Max32 : static_cast<uint32_t>(entry.Offset));
+            PutString(directory, entry.Name);
+
+            // Every 32-bit field set to Max32 above, in order.
+            if (zip64)
+            {
+                Put16(directory, Zip64ExtraId);
+                Put16(directory, 24);
+                Put64(directory, entry.Size);
+                Put64(directory, entry.Size);
+                Put64(directory, entry.Offset);
+            }
+        }
+
+        uint64_t directoryBytes = directory.size();
+        zip64Archive = zip64Archive || directoryOffset >= Max32 || directoryOffset + directoryBytes >= Max32;
+
+        if (zip64Archive)
+        {
+            uint64_t zip64EndOffset = directoryOffset + directoryBytes;
+
+            Put32(directory, Zip64EndSignature);
+            Put64(directory, 44);
+            Put16(directory, VersionZip64);
+            Put16(directory, VersionZip64);
+            Put32(directory, 0);
+            Put32(directory, 0);
+            Put64(directory, m_entries.size());
+            Put64(directory, m_entries.size());
+            Put64(directory, directoryBytes);
+            Put64(directory, directoryOffset);
+
+            Put32(directory, Zip64LocatorSignature);
+            Put32(directory, 0);
+            Put64(directory, zip64EndOffset);
+            Put32(directory, 1);
+        }
+
+        uint16_t entries = m_entries.size() >= Max16 ? Max16 : static_cast<uint16_t>(m_entries.size());
+
+        Put32(directory, EndSignature);
+        Put16(directory, 0);
+        Put16(directory, 0);
+        Put16(directory, entries);
+        Put16(directory, entries);
+        Put32(directory, directoryBytes >= Max32 ? Max32 : static_cast<uint32_t>(directoryBytes));
+        Put32(directory, zip64Archive ? Max32 : static_cast<uint32_t>(directoryOffset));
+        Put16(directory, 0);
+
+        bool written = WriteBytes(directory.data(), directory.size());
+        bool closed = std::fclose(m_file) == 0;
+        m_file = nullptr;
+
+        return written && closed ? CodecResult::Ok() : CodecResult::Fail("Write failed for " + m_path);
+    }
+
+    std::string NumpyWriter::MakeHeader(const std::string& descr, const std::vector<uint64_t>& shape)
+    {
+        std::string dims;
+
+        for (size_t i = 0; i < shape.size(); i++)
+            dims += (i > 0 ? ", " : "") + std::to_string(shape[i]);
+
+        // A one-element tuple needs its trailing comma.
+        if (shape.size() == 1)
+            dims += ",";
+
+        std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (" + dims + "), }";
+
+        // Magic (6) + version (2) + length (2), then the dict padded with
+        // spaces and ended by a newline so the data starts 64-byte aligned.
+        constexpr size_t Preamble = 10;
+        size_t total = (Preamble + dict.size() + 1 + 63) / 64 * 64;
+        dict.append(total - Preamble - dict.size() - 1, ' ');
+        dict += '\n';
+
+        std::string header = "\x93NUMPY";
+        header += static_cast<char>(1);
+        header += static_cast<char>(0);
+        header += static_cast<char>(dict.size() & 0xFF);
+        header += static_cast<char>(dict.size() >> 8);
+
+        return header + dict;
+    }
+
+    bool NumpyWriter::IsArchivePath(const std::string& path)
+    {
+        return TrajectoryCodecRegistry::GetExtension(path) == ".npz";
+    }
+
+    bool NumpyWriter::WriteBytes(const void* data, uint64_t size)
+    {
+        if (size == 0)
+            return true;
+
+        if (std::fwrite(data, 1, static_cast<size_t>(size), m_file) != size)
+            return false;
+
+        m_bytesWritten += size;
+
+        return true;
+    }
+}
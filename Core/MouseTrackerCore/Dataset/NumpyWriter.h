@@ -0,0 +1,68 @@
+#ifndef __MOUSE_TRACKER_CORE_NUMPYWRITER__
+#define __MOUSE_TRACKER_CORE_NUMPYWRITER__
+
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+namespace Mt
+{
+    // Writes named arrays in NumPy's .npy format, either into one .npz file
+    // (a zip with stored, uncompressed members, zip64 when a member or the
+    // archive passes 4 GiB) or as one <name>.npy per array into a directory.
+    // Both load with np.load and no parsing; the directory form can also be
+    // opened with mmap_mode='r'. Data is written as given, so descr must
+    // match the host (little endian) layout.
+    class NumpyWriter
+    {
+        private:
+            struct ZipEntry
+            {
+                std::string Name;
+                uint32_t Crc;
+                uint64_t Size;
+                uint64_t Offset;
+            };
+
+            std::string m_path;
+            bool m_archive = false;
+            bool m_open = false;
+            std::FILE* m_file = nullptr;
+            std::vector<ZipEntry> m_entries;
+            uint64_t m_bytesWritten = 0;
+
+        public:
+            NumpyWriter() = default;
+            NumpyWriter(const NumpyWriter&) = delete;
+            NumpyWriter& operator=(const NumpyWriter&) = delete;
+            ~NumpyWriter();
+
+            // A path ending in .npz is written as one archive; any other path
+            // is created as a directory.
+            CodecResult Open(const std::string& path);
+
+            // One C-order array; descr is a NumPy type string such as "<i4"
+            // and bytes must equal the product of shape times the item size.
+            CodecResult Write(const std::string& name, const std::string& descr, const std::vector<uint64_t>& shape, const void* data, uint64_t bytes);
+
+            // Writes the .npz central directory. Called by the destructor.
+            CodecResult Close();
+
+            uint64_t GetBytesWritten() const
+            {
+                return m_bytesWritten;
+            }
+
+            // Magic, version and the header dict, padded to 64 bytes.
+            static std::string MakeHeader(const std::string& descr, const std::vector<uint64_t>& shape);
+
+            static bool IsArchivePath(const std::string& path);
+
+        private:
+            bool WriteBytes(const void* data, uint64_t size);
+    };
+}
+
+#endif
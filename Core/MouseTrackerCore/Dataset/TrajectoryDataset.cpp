@@ -0,0 +1,424 @@
+#include "MouseTrackerCore/Dataset/TrajectoryDataset.h"
+#include "MouseTrackerCore/Dataset/DirectoryProcessor.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Threading/ThreadPool.h"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+namespace Mt
+{
+    namespace
+    {
+        constexpr size_t MaxReportedErrors = 20;
+
+        struct DatasetFile
+        {
+            std::filesystem::path Path;
+            std::string Name;
+            uint64_t Size;
+        };
+
+        // One trajectory's slice of the arena, sized from its header (binary
+        // images, decoded straight into it) or from a first-pass parse (text
+        // and Chunked files, copied in once).
+        struct DatasetEntry
+        {
+            size_t Id = 0;
+            bool HasTimestamps = false;
+            uint64_t Count = 0;
+            uint64_t Offset = 0;
+            bool Loaded = false;
+            TrajectoryMetadata Metadata;
+        };
+
+        struct SurveyedFile
+        {
+            std::unique_ptr<TrajectoryArchive> Archive;
+            BinaryTrajectoryHeader Header;
+            bool Direct = false;
+            Trajectory Parsed;
+            std::vector<DatasetEntry> Entries;
+            std::string Error;
+        };
+
+        DatasetEntry MakeEntry(size_t id, const BinaryTrajectoryHeader& header)
+        {
+            DatasetEntry entry;
+            entry.Id = id;
+            entry.HasTimestamps = header.HasTimestamps();
+            entry.Count = header.SampleCount;
+            entry.Metadata = header.GetMetadata();
+
+            return entry;
+        }
+
+        // Reads the header of a binary file that can be decoded in place. False
+        // sends the file through its codec instead, which also words the error
+        // for anything malformed.
+        bool ReadDirectHeader(const std::string& path, uint64_t fileSize, BinaryTrajectoryHeader& header, std::string& error)
+        {
+            std::ifstream stream(path, std::ios::binary);
+
+            if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+                return false;
+
+            if (!header.Validate().empty() || !header.FitsIn(fileSize) || header.GetEncoding() == BinaryEncoding::Chunked)
+                return false;
+
+            uint8_t prefix[BinaryTrajectoryCodec::CheckBytes] = {};
+            stream.seekg(header.HeaderSize);
+            stream.read(reinterpret_cast<char*>(prefix), static_cast<std::streamsize>((std::min)(header.PayloadBytes, static_cast<uint64_t>(sizeof(prefix)))));
+
+            CodecResult result = BinaryTrajectoryCodec::CheckColumns(header, prefix, static_cast<size_t>(header.PayloadBytes));
+
+            if (!result.Success)
+                error = result.Error;
+
+            return true;
+        }
+
+        void SurveyFile(const DatasetFile& file, SurveyedFile& surveyed)
+        {
+            const std::string path = file.Path.string();
+
+            if (TrajectoryArchive::IsArchive(path))
+            {
+                surveyed.Archive = std::make_unique<TrajectoryArchive>();
+                CodecResult result = surveyed.Archive->Open(path);
+
+                if (!result.Success)
+                {
+                    surveyed.Error = result.Error;
+
+                    return;
+                }
+
+                for (size_t id = 0; id < surveyed.Archive->GetCount(); id++)
+                {
+                    BinaryTrajectoryHeader header;
+                    const uint8_t* payload = nullptr;
+
+                    result = surveyed.Archive->GetImage(id, header, payload);
+
+                    if (result.Success)
+                        result = BinaryTrajectoryCodec::CheckColumns(header, payload, static_cast<size_t>(header.PayloadBytes));
+
+                    // A damaged entry fails the file but keeps the others.
+                    if (result.Success)
+                        surveyed.Entries.push_back(MakeEntry(id, header));
+                    else
+                        surveyed.Error = "entry " + std::to_string(id) + ": " + result.Error;
+                }
+
+                return;
+            }
+
+            std::string error;
+
+            // Binary codecs are the ones that keep timestamps.
+            if (TrajectoryIo::KeepsTimestamps(path) && ReadDirectHeader(path, file.Size, surveyed.Header, error))
+            {
+                if (error.empty())
+                {
+                    surveyed.Direct = true;
+                    surveyed.Entries.push_back(MakeEntry(0, surveyed.Header));
+                }
+                else
+                {
+                    surveyed.Error = error;
+                }
+
+                return;
+            }
+
+            CodecResult result = TrajectoryIo::Load(path, surveyed.Parsed);
+
+            if (!result.Success)
+            {
+                surveyed.Error = result.Error;
+
+                return;
+            }
+
+            DatasetEntry entry;
+            entry.HasTimestamps = surveyed.Parsed.HasTimestamps();
+            entry.Count = surveyed.Parsed.Size();
+            entry.Metadata = surveyed.Parsed.GetMetadata();
+
+            surveyed.Entries.push_back(entry);
+        }
+
+        CodecResult FillDirect(const std::string& path, const BinaryTrajectoryHeader& expected, Point* points, int64_t* timestamps, std::vector<uint8_t>& buffer)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            BinaryTrajectoryHeader header;
+
+            if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(&header, &expected, sizeof(header)) != 0)
+                return CodecResult::Fail("Changed while loading");
+
+            stream.seekg(header.HeaderSize);
+
+            // Fixed columns are read straight into the arena.
+            if (header.GetEncoding() == BinaryEncoding::Fixed)
+            {
+                if (!stream.read(reinterpret_cast<char*>(points), static_cast<std::streamsize>(header.SampleCount * sizeof(Point))))
+                    return CodecResult::Fail("Truncated payload");
+
+                if (timestamps && header.HasTimestamps() && !stream.read(reinterpret_cast<char*>(timestamps), static_cast<std::streamsize>(header.SampleCount * sizeof(int64_t))))
+                    return CodecResult::Fail("Truncated payload");
+
+                return CodecResult::Ok();
+            }
+
+            buffer.resize(static_cast<size_t>(header.PayloadBytes));
+
+            if (!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+                return CodecResult::Fail("Truncated payload");
+
+            return BinaryTrajectoryCodec::DecodeColumns(header, buffer.data(), buffer.size(), points, timestamps);
+        }
+
+        void FillFile(const DatasetFile& file, SurveyedFile& surveyed, Point* points, int64_t* timestamps, std::vector<uint8_t>& buffer)
+        {
+            for (DatasetEntry& entry : surveyed.Entries)
+            {
+                Point* slotPoints = points + entry.Offset;
+                int64_t* slotTimestamps = timestamps ? timestamps + entry.Offset : nullptr;
+                CodecResult result = CodecResult::Ok();
+
+                if (surveyed.Archive)
+                {
+                    BinaryTrajectoryHeader header;
+                    const uint8_t* payload = nullptr;
+
+                    result = surveyed.Archive->GetImage(entry.Id, header, payload);
+
+                    if (result.Success)
+                        result = BinaryTrajectoryCodec::DecodeColumns(header, payload, static_cast<size_t>(header.PayloadBytes), slotPoints, slotTimestamps);
+                }
+                else if (surveyed.Direct)
+                {
+                    result = FillDirect(file.Path.string(), surveyed.Header, slotPoints, slotTimestamps, buffer);
+                }
+                else
+                {
+                    const Trajectory& parsed = surveyed.Parsed;
+
+                    std::copy(parsed.GetPoints().begin(), parsed.GetPoints().end(), slotPoints);
+
+                    if (slotTimestamps)
+                        std::copy(parsed.GetTimestamps().begin(), parsed.GetTimestamps().end(), slotTimestamps);
+
+                    surveyed.Parsed = Trajectory();
+                }
+
+                if (result.Success)
+                    entry.Loaded = true;
+                else
+                    surveyed.Error = surveyed.Archive ? "entry " + std::to_string(entry.Id) + ": " + result.Error : result.Error;
+            }
+        }
+
+        // Runs work(run, i) over every file on the pool, one contiguous run of
+        // files per worker, balanced by bytes.
+        template<typename Work>
+        void ForEachFile(ThreadPool& pool, const std::vector<DatasetFile>& files, uint64_t totalBytes, Work work)
+        {
+            size_t workers = pool.GetThreadCount();
+            std::vector<size_t> runStarts { 0 };
+            uint64_t runBytes = 0;
+
+            for (size_t i = 0; i < files.size(); i++)
+            {
+                runBytes += files[i].Size;
+
+                if (runStarts.size() < workers && i + 1 < files.size() && runBytes * workers >= totalBytes * runStarts.size())
+                    runStarts.push_back(i + 1);
+            }
+
+            runStarts.push_back(files.size());
+
+            for (size_t run = 0; run + 1 < runStarts.size(); run++)
+            {
+                pool.Submit([&, run]()
+                {
+                    for (size_t i = runStarts[run]; i < runStarts[run + 1]; i++)
+                        work(run, i);
+                });
+            }
+
+            pool.WaitIdle();
+        }
+    }
+
+    DatasetLoadSummary TrajectoryDataset::Load(const DatasetLoadSettings& settings)
+    {
+        Clear();
+
+        DatasetLoadSummary summary;
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<DatasetFile> files;
+        std::error_code error;
+        auto options = std::filesystem::directory_options::skip_permission_denied;
+
+        // A single file (typically an archive) is a dataset of its own.
+        if (std::filesystem::is_regular_file(settings.InputDirectory, error))
+        {
+            std::filesystem::path path(settings.InputDirectory);
+            files.push_back({ path, path.filename().generic_string(), std::filesystem::file_size(path, error) });
+        }
+        else
+        {
+            for (std::filesystem::recursive_directory_iterator it(settings.InputDirectory, options, error), end; !error && it != end; it.increment(error))
+            {
+                if (!it->is_regular_file(error) || !DirectoryProcessor::IsTrajectoryFile(it->path().string()))
+                    continue;
+
+                std::string name = it->path().lexically_relative(settings.InputDirectory).generic_string();
+                files.push_back({ it->path(), name, it->file_size(error) });
+            }
+        }
+
+        if (error)
+            summary.Errors.push_back(settings.InputDirectory + ": " + error.message());
+
+        std::sort(files.begin(), files.end(), [](const DatasetFile& left, const DatasetFile& right) { return left.Name < right.Name; });
+
+        for (const auto& file : files)
+            summary.BytesRead += file.Size;
+
+        ThreadPool pool(settings.Threads);
+        std::vector<SurveyedFile> surveyed(files.size());
+        summary.Threads = pool.GetThreadCount();
+
+        // First pass: sample counts from the binary headers (text and Chunked
+        // files are parsed here), so the arena is allocated once and every
+        // trajectory lands directly in its own slice.
+        ForEachFile(pool, files, summary.BytesRead, [&](size_t, size_t i)
+        {
+            try
+            {
+                SurveyFile(files[i], surveyed[i]);
+            }
+            catch (const std::exception& e)
+            {
+                surveyed[i].Entries.clear();
+                surveyed[i].Error = e.what();
+            }
+        });
+
+        uint64_t samples = 0;
+        bool keepTimestamps = settings.KeepTimestamps;
+
+        for (auto& file : surveyed)
+        {
+            for (auto& entry : file.Entries)
+            {
+                entry.Offset = samples;
+                samples += entry.Count;
+
+                if (entry.Count > 0 && !entry.HasTimestamps)
+                    keepTimestamps = false;
+            }
+        }
+
+        m_points.resize(static_cast<size_t>(samples));
+
+        if (keepTimestamps)
+            m_timestamps.resize(static_cast<size_t>(samples));
+
+        std::vector<std::vector<uint8_t>> buffers(pool.GetThreadCount());
+
+        ForEachFile(pool, files, summary.BytesRead, [&](size_t run, size_t i)
+        {
+            try
+            {
+                FillFile(files[i], surveyed[i], m_points.data(), keepTimestamps ? m_timestamps.data() : nullptr, buffers[run]);
+            }
+            catch (const std::exception& e)
+            {
+                for (auto& entry : surveyed[i].Entries)
+                    entry.Loaded = false;
+
+                surveyed[i].Error = e.what();
+            }
+        });
+
+        // Entries that failed to decode leave a gap, closed up here; in the
+        // usual case nothing moves.
+        uint64_t end = 0;
+
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            if (surveyed[i].Error.empty())
+            {
+                summary.Files++;
+            }
+            else
+            {
+                summary.FilesFailed++;
+
+                if (summary.Errors.size() < MaxReportedErrors)
+                    summary.Errors.push_back(files[i].Name + ": " + surveyed[i].Error);
+            }
+
+            for (const auto& entry : surveyed[i].Entries)
+            {
+                if (!entry.Loaded)
+                    continue;
+
+                if (entry.Offset != end && entry.Count > 0)
+                {
+                    size_t count = static_cast<size_t>(entry.Count);
+
+                    std::memmove(m_points.data() + end, m_points.data() + entry.Offset, count * sizeof(Point));
+
+                    if (keepTimestamps)
+                        std::memmove(m_timestamps.data() + end, m_timestamps.data() + entry.Offset, count * sizeof(int64_t));
+                }
+
+                end += entry.Count;
+                m_offsets.push_back(end);
+                m_names.push_back(surveyed[i].Archive ? files[i].Name + "#" + std::to_string(entry.Id) : files[i].Name);
+                m_metadata.push_back(entry.Metadata);
+            }
+        }
+
+        m_points.resize(static_cast<size_t>(end));
+        m_hasTimestamps = keepTimestamps;
+
+        if (keepTimestamps)
+            m_timestamps.resize(static_cast<size_t>(end));
+
+        summary.Trajectories = m_names.size();
+        summary.Samples = m_points.size();
+        summary.ArenaBytes = m_points.size() * sizeof(Point) + m_timestamps.size() * sizeof(int64_t) + m_offsets.size() * sizeof(uint64_t);
+        summary.ElapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return summary;
+    }
+
+    void TrajectoryDataset::Clear()
+    {
+        m_points.clear();
+        m_timestamps.clear();
+        m_offsets.assign(1, 0);
+        m_names.clear();
+        m_metadata.clear();
+        m_hasTimestamps = true;
+    }
+
+    TrajectorySpan TrajectoryDataset::GetSpan(size_t index) const
+    {
+        uint64_t offset = m_offsets[index];
+        size_t count = static_cast<size_t>(m_offsets[index + 1] - offset);
+
+        return TrajectorySpan(m_points.data() + offset, HasTimestamps() ? m_timestamps.data() + offset : nullptr, count, m_metadata[index]);
+    }
+}
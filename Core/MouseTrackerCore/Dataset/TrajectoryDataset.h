@@ -0,0 +1,115 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYDATASET__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYDATASET__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Mt
+{
+    struct DatasetLoadSettings
+    {
+        // Searched recursively, like DirectoryProcessor; archives contribute
+        // every entry. A single file or archive is loaded on its own.
+        std::string InputDirectory;
+
+        // 0 = one per hardware thread.
+        size_t Threads = 0;
+
+        // Kept only if every trajectory has them; one without drops the column.
+        bool KeepTimestamps = true;
+    };
+
+    struct DatasetLoadSummary
+    {
+        uint64_t Files = 0;
+        uint64_t FilesFailed = 0;
+        uint64_t Trajectories = 0;
+        uint64_t Samples = 0;
+        uint64_t BytesRead = 0;
+        uint64_t ArenaBytes = 0;
+        size_t Threads = 0;
+        double ElapsedSeconds = 0.0;
+
+        // First few failures, "path: reason".
+        std::vector<std::string> Errors;
+
+        double GetMegabytesPerSecond() const
+        {
+            return ElapsedSeconds > 0.0 ? BytesRead / (1024.0 * 1024.0) / ElapsedSeconds : 0.0;
+        }
+
+        double GetSamplesPerSecond() const
+        {
+            return ElapsedSeconds > 0.0 ? Samples / ElapsedSeconds : 0.0;
+        }
+    };
+
+    // Many trajectories in one contiguous arena, CSR style: trajectory i owns
+    // samples [offsets[i], offsets[i + 1]) of the point (and timestamp)
+    // columns. Kernels over a whole session sweep GetPoints() front to back
+    // instead of chasing one heap block per file.
+    class TrajectoryDataset
+    {
+        private:
+            std::vector<Point> m_points;
+            std::vector<int64_t> m_timestamps;
+            std::vector<uint64_t> m_offsets { 0 };
+            std::vector<std::string> m_names;
+            std::vector<TrajectoryMetadata> m_metadata;
+            bool m_hasTimestamps = true;
+
+        public:
+            // Loads every trajectory under settings.InputDirectory across a
+            // thread pool, sorted by path so the layout does not depend on
+            // scheduling. Sample counts come from the headers first, so the
+            // arena is allocated once and binary files decode straight into
+            // it. Replaces the current contents.
+            DatasetLoadSummary Load(const DatasetLoadSettings& settings);
+
+            void Clear();
+
+            size_t GetCount() const
+            {
+                return m_names.size();
+            }
+
+            uint64_t GetSampleCount() const
+            {
+                return m_points.size();
+            }
+
+            bool HasTimestamps() const
+            {
+                return m_hasTimestamps && !m_points.empty();
+            }
+
+            // Relative path; archive entries are "<archive>#<id>".
+            const std::string& GetName(size_t index) const
+            {
+                return m_names[index];
+            }
+
+            TrajectorySpan GetSpan(size_t index) const;
+
+            const std::vector<Point>& GetPoints() const
+            {
+                return m_points;
+            }
+
+            // Empty unless HasTimestamps().
+            const std::vector<int64_t>& GetTimestamps() const
+            {
+                return m_timestamps;
+            }
+
+            // GetCount() + 1 entries, starting at 0.
+            const std::vector<uint64_t>& GetOffsets() const
+            {
+                return m_offsets;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,22 @@
+#include "MouseTrackerCore/Platform/CursorSourceFactory.h"
+#include "MouseTrackerCore/Platform/WinApiCursorSource.h"
+#include "MouseTrackerCore/Platform/X11CursorSource.h"
+
+namespace Mt
+{
+    std::unique_ptr<ICursorSource> CursorSourceFactory::CreateDefault()
+    {
+#if defined(_WIN32)
+        return std::make_unique<WinApiCursorSource>();
+#elif defined(MT_CORE_HAS_X11)
+        auto source = std::make_unique<X11CursorSource>();
+
+        if (source->IsOpen())
+            return source;
+
+        return nullptr;
+#else
+        return nullptr;
+#endif
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef __MOUSE_TRACKER_CORE_CURSORSOURCEFACTORY__
+#define __MOUSE_TRACKER_CORE_CURSORSOURCEFACTORY__
+
+#include "MouseTrackerCore/Recording/ICursorSource.h"
+#include <memory>
+
+namespace Mt
+{
+    class CursorSourceFactory
+    {
+        public:
+            // WinApi on Windows, X11 when built with it and a display is reachable,
+            // otherwise nullptr.
+            static std::unique_ptr<ICursorSource> CreateDefault();
+    };
+}
+
+#endif
@@ -0,0 +1,292 @@
+#include "MouseTrackerCore/Platform/DirectoryWatcher.h"
+#include <vector>
+#include <cstdint>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Mt
+{
+    DirectoryWatcher::~DirectoryWatcher()
+    {
+        Stop();
+    }
+
+#ifdef _WIN32
+    bool DirectoryWatcher::IsSupported()
+    {
+        return true;
+    }
+
+    bool DirectoryWatcher::Start(const std::string& directory, DirectoryEventCallback callback)
+    {
+        Stop();
+
+        HANDLE handle = CreateFileA(directory.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+
+        m_handle = handle;
+        m_stopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+        if (!m_stopEvent)
+        {
+            Release();
+
+            return false;
+        }
+
+        m_directory = directory;
+        m_stopRequested = false;
+        m_thread = std::thread(&DirectoryWatcher::Run, this, std::move(callback));
+
+        return true;
+    }
+
+    void DirectoryWatcher::Stop()
+    {
+        if (m_thread.joinable())
+        {
+            m_stopRequested = true;
+            SetEvent(static_cast<HANDLE>(m_stopEvent));
+            m_thread.join();
+        }
+
+        Release();
+    }
+
+    void DirectoryWatcher::Release()
+    {
+        if (m_handle)
+            CloseHandle(static_cast<HANDLE>(m_handle));
+
+        if (m_stopEvent)
+            CloseHandle(static_cast<HANDLE>(m_stopEvent));
+
+        m_handle = nullptr;
+        m_stopEvent = nullptr;
+    }
+
+    void DirectoryWatcher::Run(DirectoryEventCallback callback)
+    {
+        HANDLE handle = static_cast<HANDLE>(m_handle);
+        HANDLE readEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+        // FILE_NOTIFY_INFORMATION records must be DWORD aligned.
+        std::vector<DWORD> buffer(16 * 1024);
+
+        while (readEvent && !m_stopRequested)
+        {
+            OVERLAPPED overlapped = {};
+            overlapped.hEvent = readEvent;
+            ResetEvent(readEvent);
+
+            if (!ReadDirectoryChangesW(handle, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)), FALSE,
+                FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &overlapped, nullptr))
+            {
+                callback({ DirectoryChange::Gone, "" });
+
+                break;
+            }
+
+            HANDLE handles[2] = { readEvent, static_cast<HANDLE>(m_stopEvent) };
+
+            if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+            {
+                CancelIoEx(handle, &overlapped);
+
+                DWORD ignored = 0;
+                GetOverlappedResult(handle, &overlapped, &ignored, TRUE);
+
+                break;
+            }
+
+            DWORD bytes = 0;
+
+            if (!GetOverlappedResult(handle, &overlapped, &bytes, FALSE))
+            {
+                callback({ DirectoryChange::Gone, "" });
+
+                break;
+            }
+
+            // Zero bytes: the system buffer overflowed and the changes were dropped.
+            if (bytes == 0)
+            {
+                callback({ DirectoryChange::Overflow, "" });
+
+                continue;
+            }
+
+            const uint8_t* record = reinterpret_cast<const uint8_t*>(buffer.data());
+
+            while (true)
+            {
+                const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(record);
+                int length = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+                int size = WideCharToMultiByte(CP_ACP, 0, info->FileName, length, nullptr, 0, nullptr, nullptr);
+                std::string name(static_cast<size_t>(size), '\0');
+
+                WideCharToMultiByte(CP_ACP, 0, info->FileName, length, name.data(), size, nullptr, nullptr);
+
+                switch (info->Action)
+                {
+                    case FILE_ACTION_ADDED:
+                    case FILE_ACTION_RENAMED_NEW_NAME:
+                        callback({ DirectoryChange::Added, name });
+                        break;
+
+                    case FILE_ACTION_REMOVED:
+                    case FILE_ACTION_RENAMED_OLD_NAME:
+                        callback({ DirectoryChange::Removed, name });
+                        break;
+
+                    default:
+                        break;
+                }
+
+                if (info->NextEntryOffset == 0)
+                    break;
+
+                record += info->NextEntryOffset;
+            }
+        }
+
+        if (readEvent)
+            CloseHandle(readEvent);
+    }
+#elif defined(__linux__)
+    bool DirectoryWatcher::IsSupported()
+    {
+        return true;
+    }
+
+    bool DirectoryWatcher::Start(const std::string& directory, DirectoryEventCallback callback)
+    {
+        Stop();
+
+        m_descriptor = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+
+        if (m_descriptor < 0)
+            return false;
+
+        uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+        if (inotify_add_watch(m_descriptor, directory.c_str(), mask) < 0 || pipe2(m_stopPipe, O_CLOEXEC) != 0)
+        {
+            Release();
+
+            return false;
+        }
+
+        m_directory = directory;
+        m_stopRequested = false;
+        m_thread = std::thread(&DirectoryWatcher::Run, this, std::move(callback));
+
+        return true;
+    }
+
+    void DirectoryWatcher::Stop()
+    {
+        if (m_thread.joinable())
+        {
+            m_stopRequested = true;
+
+            char wake = 0;
+            (void)!write(m_stopPipe[1], &wake, 1);
+
+            m_thread.join();
+        }
+
+        Release();
+    }
+
+    void DirectoryWatcher::Release()
+    {
+        for (int* descriptor : { &m_descriptor, &m_stopPipe[0], &m_stopPipe[1] })
+        {
+            if (*descriptor >= 0)
+                close(*descriptor);
+
+            *descriptor = -1;
+        }
+    }
+
+    void DirectoryWatcher::Run(DirectoryEventCallback callback)
+    {
+        alignas(inotify_event) char buffer[64 * 1024];
+
+        while (!m_stopRequested)
+        {
+            pollfd descriptors[2] = { { m_descriptor, POLLIN, 0 }, { m_stopPipe[0], POLLIN, 0 } };
+
+            if (poll(descriptors, 2, -1) < 0 || (descriptors[1].revents & POLLIN))
+                continue;
+
+            ssize_t bytes = read(m_descriptor, buffer, sizeof(buffer));
+
+            if (bytes <= 0)
+                continue;
+
+            for (char* record = buffer; record < buffer + bytes; )
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(record);
+                record += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    callback({ DirectoryChange::Overflow, "" });
+
+                    continue;
+                }
+
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+                {
+                    callback({ DirectoryChange::Gone, "" });
+
+                    return;
+                }
+
+                if ((event->mask & IN_ISDIR) || event->len == 0)
+                    continue;
+
+                if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                    callback({ DirectoryChange::Added, event->name });
+                else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                    callback({ DirectoryChange::Removed, event->name });
+            }
+        }
+    }
+#else
+    bool DirectoryWatcher::IsSupported()
+    {
+        return false;
+    }
+
+    bool DirectoryWatcher::Start(const std::string&, DirectoryEventCallback)
+    {
+        return false;
+    }
+
+    void DirectoryWatcher::Stop()
+    {
+    }
+
+    void DirectoryWatcher::Release()
+    {
+    }
+
+    void DirectoryWatcher::Run(DirectoryEventCallback)
+    {
+    }
+#endif
+}
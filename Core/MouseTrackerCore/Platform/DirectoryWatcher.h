@@ -0,0 +1,83 @@
+#ifndef __MOUSE_TRACKER_CORE_DIRECTORYWATCHER__
+#define __MOUSE_TRACKER_CORE_DIRECTORYWATCHER__
+
+#include <string>
+#include <functional>
+#include <thread>
+#include <atomic>
+
+namespace Mt
+{
+    enum class DirectoryChange
+    {
+        Added,
+        Removed,
+        // Events were lost (kernel queue overflow); the state must be rebuilt by a scan.
+        Overflow,
+        // The watched directory itself was deleted or moved; no further events follow.
+        Gone
+    };
+
+    struct DirectoryEvent
+    {
+        DirectoryChange Change = DirectoryChange::Added;
+
+        // File name relative to the watched directory; empty for Overflow and Gone.
+        std::string Name;
+    };
+
+    using DirectoryEventCallback = std::function<void(const DirectoryEvent&)>;
+
+    // Reports files appearing in and disappearing from one directory (not its
+    // subdirectories) through inotify on Linux and ReadDirectoryChangesW on
+    // Windows. On Linux a file counts as added once closed after writing or
+    // renamed in; Windows reports it when created or renamed in. Either way a
+    // temp file + rename save surfaces under its final name. A rename within the
+    // directory is a Removed followed by an Added, and the same name may be
+    // reported as Added more than once. The callback runs on the watcher thread.
+    class DirectoryWatcher
+    {
+        private:
+            std::string m_directory;
+            std::thread m_thread;
+            std::atomic<bool> m_stopRequested { false };
+
+#ifdef _WIN32
+            void* m_handle = nullptr;
+            void* m_stopEvent = nullptr;
+#else
+            int m_descriptor = -1;
+            int m_stopPipe[2] = { -1, -1 };
+#endif
+
+        public:
+            DirectoryWatcher() = default;
+            DirectoryWatcher(const DirectoryWatcher&) = delete;
+            DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+            ~DirectoryWatcher();
+
+            // Watches `directory` until Stop; a previous watch is stopped first.
+            // Fails if the directory does not exist or the platform has no
+            // change notifications.
+            bool Start(const std::string& directory, DirectoryEventCallback callback);
+            void Stop();
+
+            bool IsRunning() const
+            {
+                return m_thread.joinable();
+            }
+
+            const std::string& GetDirectory() const
+            {
+                return m_directory;
+            }
+
+            static bool IsSupported();
+
+        private:
+            void Run(DirectoryEventCallback callback);
+            void Release();
+    };
+}
+
+#endif
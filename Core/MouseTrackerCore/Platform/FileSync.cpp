@@ -0,0 +1,69 @@
+#include "MouseTrackerCore/Platform/FileSync.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Mt
+{
+#ifdef _WIN32
+    bool FileSync::FlushFile(const std::string& filename)
+    {
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        bool flushed = FlushFileBuffers(file) != 0;
+        CloseHandle(file);
+
+        return flushed;
+    }
+
+    bool FileSync::FlushStream(std::FILE* file)
+    {
+        return std::fflush(file) == 0 && _commit(_fileno(file)) == 0;
+    }
+
+    bool FileSync::FlushDirectory(const std::string&)
+    {
+        return true;
+    }
+#else
+    namespace
+    {
+        bool FlushPath(const std::string& path, int flags)
+        {
+            int descriptor = open(path.c_str(), flags);
+
+            if (descriptor < 0)
+                return false;
+
+            bool flushed = fsync(descriptor) == 0;
+            close(descriptor);
+
+            return flushed;
+        }
+    }
+
+    bool FileSync::FlushFile(const std::string& filename)
+    {
+        return FlushPath(filename, O_WRONLY);
+    }
+
+    bool FileSync::FlushStream(std::FILE* file)
+    {
+        return std::fflush(file) == 0 && fsync(fileno(file)) == 0;
+    }
+
+    bool FileSync::FlushDirectory(const std::string& directory)
+    {
+        return FlushPath(directory.empty() ? "." : directory, O_RDONLY);
+    }
+#endif
+}
@@ -0,0 +1,24 @@
+#ifndef __MOUSE_TRACKER_CORE_FILESYNC__
+#define __MOUSE_TRACKER_CORE_FILESYNC__
+
+#include <string>
+#include <cstdio>
+
+namespace Mt
+{
+    // Forces written data to the storage device (FlushFileBuffers / fsync).
+    class FileSync
+    {
+        public:
+            static bool FlushFile(const std::string& filename);
+
+            // Flushes the stdio buffer of an open file, then the file itself.
+            static bool FlushStream(std::FILE* file);
+
+            // Makes a rename or new entry in the directory durable. No-op on
+            // Windows, where the file flush already covers the metadata.
+            static bool FlushDirectory(const std::string& directory);
+    };
+}
+
+#endif
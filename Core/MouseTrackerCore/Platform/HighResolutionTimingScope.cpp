@@ -0,0 +1,39 @@
+#include "MouseTrackerCore/Platform/HighResolutionTimingScope.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#include <algorithm>
+#endif
+
+namespace Mt
+{
+#ifdef _WIN32
+    HighResolutionTimingScope::HighResolutionTimingScope()
+    {
+        m_previousPriority = GetThreadPriority(GetCurrentThread());
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+
+        TIMECAPS tc;
+
+        if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) == MMSYSERR_NOERROR)
+        {
+            m_timerResolution = (std::min)((std::max)(tc.wPeriodMin, 1u), tc.wPeriodMax);
+            timeBeginPeriod(m_timerResolution);
+        }
+    }
+
+    HighResolutionTimingScope::~HighResolutionTimingScope()
+    {
+        if (m_timerResolution != 0)
+            timeEndPeriod(m_timerResolution);
+
+        SetThreadPriority(GetCurrentThread(), m_previousPriority);
+    }
+#else
+    HighResolutionTimingScope::HighResolutionTimingScope() {  }
+
+    HighResolutionTimingScope::~HighResolutionTimingScope() {  }
+#endif
+}
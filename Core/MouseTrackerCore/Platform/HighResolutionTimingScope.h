@@ -0,0 +1,23 @@
+#ifndef __MOUSE_TRACKER_CORE_HIGHRESOLUTIONTIMINGSCOPE__
+#define __MOUSE_TRACKER_CORE_HIGHRESOLUTIONTIMINGSCOPE__
+
+namespace Mt
+{
+    // Raises the system timer resolution and the calling thread's priority for the
+    // lifetime of the scope. On Windows this is timeBeginPeriod + TIME_CRITICAL;
+    // elsewhere it is a no-op (hrtimers are already fine grained).
+    class HighResolutionTimingScope
+    {
+        private:
+            unsigned int m_timerResolution = 0;
+            int m_previousPriority = 0;
+
+        public:
+            HighResolutionTimingScope();
+            HighResolutionTimingScope(const HighResolutionTimingScope&) = delete;
+            HighResolutionTimingScope& operator=(const HighResolutionTimingScope&) = delete;
+            ~HighResolutionTimingScope();
+    };
+}
+
+#endif
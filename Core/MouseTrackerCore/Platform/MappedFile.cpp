@@ -0,0 +1,165 @@
+#include "MouseTrackerCore/Platform/MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace Mt
+{
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+
+#ifdef _WIN32
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+
+        return *this;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(const std::string& filename, std::string& error)
+    {
+        Close();
+
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            error = "Unable to open " + filename;
+
+            return false;
+        }
+
+        LARGE_INTEGER size;
+
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            error = "Unable to get size of " + filename;
+
+            return false;
+        }
+
+        m_file = file;
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        if (m_size == 0)
+            return true;
+
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (m_mapping)
+            m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (!m_data)
+        {
+            Close();
+            error = "Unable to map " + filename;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data)
+            UnmapViewOfFile(m_data);
+
+        if (m_mapping)
+            CloseHandle(m_mapping);
+
+        if (m_file)
+            CloseHandle(m_file);
+
+        m_data = nullptr;
+        m_size = 0;
+        m_mapping = nullptr;
+        m_file = nullptr;
+    }
+#else
+    bool MappedFile::Open(const std::string& filename, std::string& error)
+    {
+        Close();
+
+        int descriptor = open(filename.c_str(), O_RDONLY);
+
+        if (descriptor < 0)
+        {
+            error = "Unable to open " + filename + ": " + std::strerror(errno);
+
+            return false;
+        }
+
+        struct stat status;
+
+        if (fstat(descriptor, &status) != 0)
+        {
+            close(descriptor);
+            error = "Unable to get size of " + filename;
+
+            return false;
+        }
+
+        m_size = static_cast<size_t>(status.st_size);
+
+        if (m_size > 0)
+        {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+            if (data == MAP_FAILED)
+            {
+                close(descriptor);
+                m_size = 0;
+                error = "Unable to map " + filename + ": " + std::strerror(errno);
+
+                return false;
+            }
+
+            m_data = static_cast<const uint8_t*>(data);
+        }
+
+        // The mapping keeps its own reference to the file.
+        close(descriptor);
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data)
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+#endif
+}
@@ -0,0 +1,48 @@
+#ifndef __MOUSE_TRACKER_CORE_MAPPEDFILE__
+#define __MOUSE_TRACKER_CORE_MAPPEDFILE__
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace Mt
+{
+    // Read-only memory mapping of a whole file (CreateFileMapping on Windows,
+    // mmap elsewhere). Pages are loaded on first touch, so opening is O(1) in
+    // the file size. On POSIX the file must not be truncated while mapped.
+    class MappedFile
+    {
+        private:
+            const uint8_t* m_data = nullptr;
+            size_t m_size = 0;
+
+#ifdef _WIN32
+            void* m_file = nullptr;
+            void* m_mapping = nullptr;
+#endif
+
+        public:
+            MappedFile() = default;
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile(MappedFile&& other) noexcept;
+            MappedFile& operator=(MappedFile&& other) noexcept;
+            ~MappedFile();
+
+            // An empty file opens successfully with a null Data().
+            bool Open(const std::string& filename, std::string& error);
+            void Close();
+
+            const uint8_t* Data() const
+            {
+                return m_data;
+            }
+
+            size_t Size() const
+            {
+                return m_size;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "MouseTrackerCore/Platform/ThreadCpuTime.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+namespace Mt
+{
+#ifdef _WIN32
+    namespace
+    {
+        int64_t FileTimeToUs(const FILETIME& fileTime)
+        {
+            ULARGE_INTEGER value;
+            value.LowPart = fileTime.dwLowDateTime;
+            value.HighPart = fileTime.dwHighDateTime;
+
+            return static_cast<int64_t>(value.QuadPart / 10);
+        }
+    }
+
+    CpuTimes ThreadCpuTime::Now()
+    {
+        CpuTimes times;
+        FILETIME creation, exit, kernel, user;
+
+        if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        {
+            times.UserUs = FileTimeToUs(user);
+            times.SystemUs = FileTimeToUs(kernel);
+        }
+
+        return times;
+    }
+#else
+    CpuTimes ThreadCpuTime::Now()
+    {
+        CpuTimes times;
+
+#ifdef RUSAGE_THREAD
+        struct rusage usage;
+
+        if (getrusage(RUSAGE_THREAD, &usage) == 0)
+        {
+            times.UserUs = static_cast<int64_t>(usage.ru_utime.tv_sec) * 1000000 + usage.ru_utime.tv_usec;
+            times.SystemUs = static_cast<int64_t>(usage.ru_stime.tv_sec) * 1000000 + usage.ru_stime.tv_usec;
+        }
+#else
+        struct timespec value;
+
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &value) == 0)
+            times.UserUs = static_cast<int64_t>(value.tv_sec) * 1000000 + value.tv_nsec / 1000;
+#endif
+
+        return times;
+    }
+#endif
+}
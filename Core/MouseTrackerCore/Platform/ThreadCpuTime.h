@@ -0,0 +1,22 @@
+#ifndef __MOUSE_TRACKER_CORE_THREADCPUTIME__
+#define __MOUSE_TRACKER_CORE_THREADCPUTIME__
+
+#include <cstdint>
+
+namespace Mt
+{
+    struct CpuTimes
+    {
+        int64_t UserUs = 0;
+        int64_t SystemUs = 0;
+    };
+
+    class ThreadCpuTime
+    {
+        public:
+            // CPU time consumed by the calling thread so far.
+            static CpuTimes Now();
+    };
+}
+
+#endif
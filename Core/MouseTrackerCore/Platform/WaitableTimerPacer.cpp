@@ -0,0 +1,68 @@
+#ifdef _WIN32
+
+#define NOMINMAX
+#include <windows.h>
+#include "MouseTrackerCore/Platform/WaitableTimerPacer.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+
+namespace Mt
+{
+    WaitableTimerPacer::~WaitableTimerPacer()
+    {
+        Stop();
+    }
+
+    void WaitableTimerPacer::Start(int64_t periodNs)
+    {
+        Stop();
+
+        m_timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+        if (!m_timer)
+            m_timer = CreateWaitableTimerW(NULL, TRUE, NULL);
+
+        m_periodNs = periodNs;
+        m_startNs = MonotonicClock::NowNs();
+        m_nextNs = m_startNs;
+    }
+
+    int64_t WaitableTimerPacer::WaitNext()
+    {
+        int64_t now = MonotonicClock::NowNs();
+
+        if (m_timer && now < m_nextNs)
+        {
+            // Timer dt is 100ns, negative means relative.
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -static_cast<LONGLONG>((m_nextNs - now) / 100);
+
+            if (dueTime.QuadPart < 0)
+            {
+                SetWaitableTimer(m_timer, &dueTime, 0, NULL, NULL, FALSE);
+                WaitForSingleObject(m_timer, INFINITE);
+            }
+
+            now = MonotonicClock::NowNs();
+        }
+
+        int64_t tick = now - m_startNs;
+
+        m_nextNs += m_periodNs;
+
+        if (now - m_nextNs >= m_periodNs)
+            m_nextNs = now + m_periodNs;
+
+        return tick;
+    }
+
+    void WaitableTimerPacer::Stop()
+    {
+        if (m_timer)
+        {
+            CloseHandle(m_timer);
+            m_timer = nullptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef __MOUSE_TRACKER_CORE_WAITABLETIMERPACER__
+#define __MOUSE_TRACKER_CORE_WAITABLETIMERPACER__
+
+#include "MouseTrackerCore/Recording/ISamplePacer.h"
+
+namespace Mt
+{
+    // Windows only: sleeps on a high resolution waitable timer between samples.
+    class WaitableTimerPacer : public ISamplePacer
+    {
+        private:
+            void* m_timer = nullptr;
+            int64_t m_periodNs = 0;
+            int64_t m_startNs = 0;
+            int64_t m_nextNs = 0;
+
+        public:
+            WaitableTimerPacer() = default;
+            WaitableTimerPacer(const WaitableTimerPacer&) = delete;
+            WaitableTimerPacer& operator=(const WaitableTimerPacer&) = delete;
+            ~WaitableTimerPacer() override;
+
+            void Start(int64_t periodNs) override;
+            int64_t WaitNext() override;
+            void Stop() override;
+
+            const char* GetName() const override
+            {
+                return "timer";
+            }
+    };
+}
+
+#endif
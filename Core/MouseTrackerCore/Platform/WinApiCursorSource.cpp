@@ -0,0 +1,31 @@
+#ifdef _WIN32
+
+#define NOMINMAX
+#include <windows.h>
+#include "MouseTrackerCore/Platform/WinApiCursorSource.h"
+
+namespace Mt
+{
+    bool WinApiCursorSource::Read(Point& point)
+    {
+        POINT cursor;
+
+        if (!GetCursorPos(&cursor))
+            return false;
+
+        point.x = static_cast<int32_t>(cursor.x);
+        point.y = static_cast<int32_t>(cursor.y);
+
+        return true;
+    }
+
+    bool WinApiCursorSource::GetScreenSize(int32_t& width, int32_t& height) const
+    {
+        width = GetSystemMetrics(SM_CXSCREEN);
+        height = GetSystemMetrics(SM_CYSCREEN);
+
+        return width > 0 && height > 0;
+    }
+}
+
+#endif
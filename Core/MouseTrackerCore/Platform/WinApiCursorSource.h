@@ -0,0 +1,21 @@
+#ifndef __MOUSE_TRACKER_CORE_WINAPICURSORSOURCE__
+#define __MOUSE_TRACKER_CORE_WINAPICURSORSOURCE__
+
+#include "MouseTrackerCore/Recording/ICursorSource.h"
+
+namespace Mt
+{
+    class WinApiCursorSource : public ICursorSource
+    {
+        public:
+            bool Read(Point& point) override;
+            bool GetScreenSize(int32_t& width, int32_t& height) const override;
+
+            const char* GetName() const override
+            {
+                return "winapi";
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifdef MT_CORE_HAS_X11
+
+#include "MouseTrackerCore/Platform/X11CursorSource.h"
+#include <X11/Xlib.h>
+
+namespace Mt
+{
+    X11CursorSource::X11CursorSource()
+    {
+        Display* display = XOpenDisplay(nullptr);
+
+        if (display)
+        {
+            m_display = display;
+            m_root = DefaultRootWindow(display);
+        }
+    }
+
+    X11CursorSource::~X11CursorSource()
+    {
+        if (m_display)
+            XCloseDisplay(static_cast<Display*>(m_display));
+    }
+
+    bool X11CursorSource::Read(Point& point)
+    {
+        if (!m_display)
+            return false;
+
+        Window rootReturn;
+        Window childReturn;
+        int rootX, rootY, windowX, windowY;
+        unsigned int mask;
+
+        if (!XQueryPointer(static_cast<Display*>(m_display), m_root, &rootReturn, &childReturn,
+            &rootX, &rootY, &windowX, &windowY, &mask))
+        {
+            return false;
+        }
+
+        point.x = rootX;
+        point.y = rootY;
+
+        return true;
+    }
+
+    bool X11CursorSource::GetScreenSize(int32_t& width, int32_t& height) const
+    {
+        if (!m_display)
+            return false;
+
+        Display* display = static_cast<Display*>(m_display);
+        width = DisplayWidth(display, DefaultScreen(display));
+        height = DisplayHeight(display, DefaultScreen(display));
+
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __MOUSE_TRACKER_CORE_X11CURSORSOURCE__
+#define __MOUSE_TRACKER_CORE_X11CURSORSOURCE__
+
+#include "MouseTrackerCore/Recording/ICursorSource.h"
+
+namespace Mt
+{
+    class X11CursorSource : public ICursorSource
+    {
+        private:
+            void* m_display = nullptr;
+            unsigned long m_root = 0;
+
+        public:
+            X11CursorSource();
+            X11CursorSource(const X11CursorSource&) = delete;
+            X11CursorSource& operator=(const X11CursorSource&) = delete;
+            ~X11CursorSource() override;
+
+            bool IsOpen() const
+            {
+                return m_display != nullptr;
+            }
+
+            bool Read(Point& point) override;
+            bool GetScreenSize(int32_t& width, int32_t& height) const override;
+
+            const char* GetName() const override
+            {
+                return "x11";
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef __MOUSE_TRACKER_CORE_BUSYWAITPACER__
+#define __MOUSE_TRACKER_CORE_BUSYWAITPACER__
+
+#include "MouseTrackerCore/Recording/ISamplePacer.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+
+namespace Mt
+{
+    // Spins on the monotonic clock. Deadlines are absolute (start + n * period), so the
+    // sampling overhead does not accumulate into drift the way "wait delta after each
+    // sample" does. If the thread falls more than a period behind it resynchronises
+    // instead of bursting to catch up.
+    class BusyWaitPacer : public ISamplePacer
+    {
+        private:
+            int64_t m_periodNs = 0;
+            int64_t m_startNs = 0;
+            int64_t m_nextNs = 0;
+
+        public:
+            void Start(int64_t periodNs) override
+            {
+                m_periodNs = periodNs;
+                m_startNs = MonotonicClock::NowNs();
+                m_nextNs = m_startNs;
+            }
+
+            int64_t WaitNext() override
+            {
+                int64_t now = MonotonicClock::NowNs();
+
+                while (now < m_nextNs)
+                    now = MonotonicClock::NowNs();
+
+                int64_t tick = now - m_startNs;
+
+                m_nextNs += m_periodNs;
+
+                if (now - m_nextNs >= m_periodNs)
+                    m_nextNs = now + m_periodNs;
+
+                return tick;
+            }
+
+            void Stop() override {  }
+
+            const char* GetName() const override
+            {
+                return "busy";
+            }
+    };
+}
+
+#endif
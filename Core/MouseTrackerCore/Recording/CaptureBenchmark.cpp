@@ -0,0 +1,191 @@
+#include "MouseTrackerCore/Recording/CaptureBenchmark.h"
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+#include "MouseTrackerCore/Platform/ThreadCpuTime.h"
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+
+namespace Mt
+{
+    namespace
+    {
+        // Borrows the caller's source so every strategy samples the same device.
+        class BorrowedCursorSource : public ICursorSource
+        {
+            private:
+                ICursorSource& m_source;
+
+            public:
+                explicit BorrowedCursorSource(ICursorSource& source) : m_source(source) {  }
+
+                bool Read(Point& point) override
+                {
+                    return m_source.Read(point);
+                }
+
+                bool GetScreenSize(int32_t& width, int32_t& height) const override
+                {
+                    return m_source.GetScreenSize(width, height);
+                }
+
+                const char* GetName() const override
+                {
+                    return m_source.GetName();
+                }
+        };
+
+        class TimestampSink : public ISampleSink
+        {
+            private:
+                std::vector<int64_t>& m_timestamps;
+
+            public:
+                explicit TimestampSink(std::vector<int64_t>& timestamps) : m_timestamps(timestamps) {  }
+
+                void OnSample(const Point&, int64_t timestampUs) override
+                {
+                    m_timestamps.push_back(timestampUs);
+                }
+        };
+
+        double Percentile(const std::vector<double>& sorted, double fraction)
+        {
+            if (sorted.empty())
+                return 0.0;
+
+            size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+
+            return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+        }
+    }
+
+    CaptureBenchmarkResult CaptureBenchmark::Run(PacingStrategy strategy, ICursorSource& source, int64_t count, int delta)
+    {
+        CaptureBenchmarkResult result;
+        result.Strategy = SamplePacerFactory::ToString(strategy);
+        result.Count = count;
+        result.Delta = delta;
+
+        auto pacer = SamplePacerFactory::Create(strategy);
+
+        if (!pacer || count <= 0)
+            return result;
+
+        std::vector<int64_t> timestamps;
+        timestamps.reserve(static_cast<size_t>(count));
+
+        TrajectoryRecorder recorder(std::make_unique<BorrowedCursorSource>(source), std::move(pacer));
+        TimestampSink sink(timestamps);
+
+        CpuTimes cpuBefore = ThreadCpuTime::Now();
+        int64_t startNs = MonotonicClock::NowNs();
+
+        recorder.Stream(sink, count, delta);
+
+        int64_t endNs = MonotonicClock::NowNs();
+        CpuTimes cpuAfter = ThreadCpuTime::Now();
+
+        const double periodUs = delta * 1000.0;
+
+        result.ElapsedUs = (endNs - startNs) / 1000.0;
+        result.CpuUserUs = static_cast<double>(cpuAfter.UserUs - cpuBefore.UserUs);
+        result.CpuSystemUs = static_cast<double>(cpuAfter.SystemUs - cpuBefore.SystemUs);
+        result.CpuLoad = result.ElapsedUs > 0.0 ? (result.CpuUserUs + result.CpuSystemUs) / result.ElapsedUs : 0.0;
+
+        if (timestamps.size() < 2)
+            return result;
+
+        double spanUs = static_cast<double>(timestamps.back() - timestamps.front());
+        size_t intervals = timestamps.size() - 1;
+
+        result.AchievedRateHz = spanUs > 0.0 ? intervals * 1000000.0 / spanUs : 0.0;
+        result.DriftUs = spanUs - intervals * periodUs;
+        result.MeanIntervalUs = spanUs / intervals;
+
+        std::vector<double> deviations(intervals);
+
+        for (size_t i = 0; i < intervals; i++)
+            deviations[i] = std::fabs(static_cast<double>(timestamps[i + 1] - timestamps[i]) - periodUs);
+
+        std::sort(deviations.begin(), deviations.end());
+
+        result.JitterP50Us = Percentile(deviations, 0.50);
+        result.JitterP90Us = Percentile(deviations, 0.90);
+        result.JitterP99Us = Percentile(deviations, 0.99);
+        result.JitterP999Us = Percentile(deviations, 0.999);
+        result.JitterMaxUs = deviations.back();
+
+        return result;
+    }
+
+    std::string CaptureBenchmark::ToJson(const std::vector<CaptureBenchmarkResult>& results, const std::string& sourceName)
+    {
+        std::string json = "{\n  \"source\": \"" + sourceName + "\",\n  \"results\": [\n";
+        char row[1024];
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const auto& r = results[i];
+
+            std::snprintf(row, sizeof(row),
+                "    {\"strategy\": \"%s\", \"count\": %lld, \"delta_ms\": %d, \"elapsed_us\": %.3f, "
+                "\"rate_hz\": %.3f, \"drift_us\": %.3f, \"mean_interval_us\": %.3f, "
+                "\"jitter_p50_us\": %.3f, \"jitter_p90_us\": %.3f, \"jitter_p99_us\": %.3f, "
+                "\"jitter_p999_us\": %.3f, \"jitter_max_us\": %.3f, "
+                "\"cpu_user_us\": %.3f, \"cpu_system_us\": %.3f, \"cpu_load\": %.4f}%s\n",
+                r.Strategy.c_str(), static_cast<long long>(r.Count), r.Delta, r.ElapsedUs,
+                r.AchievedRateHz, r.DriftUs, r.MeanIntervalUs,
+                r.JitterP50Us, r.JitterP90Us, r.JitterP99Us, r.JitterP999Us, r.JitterMaxUs,
+                r.CpuUserUs, r.CpuSystemUs, r.CpuLoad,
+                i + 1 < results.size() ? "," : "");
+
+            json += row;
+        }
+
+        json += "  ]\n}\n";
+
+        return json;
+    }
+
+    std::string CaptureBenchmark::ToCsv(const std::vector<CaptureBenchmarkResult>& results)
+    {
+        std::string csv = "strategy,count,delta_ms,elapsed_us,rate_hz,drift_us,mean_interval_us,"
+            "jitter_p50_us,jitter_p90_us,jitter_p99_us,jitter_p999_us,jitter_max_us,"
+            "cpu_user_us,cpu_system_us,cpu_load\n";
+        char row[512];
+
+        for (const auto& r : results)
+        {
+            std::snprintf(row, sizeof(row), "%s,%lld,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.4f\n",
+                r.Strategy.c_str(), static_cast<long long>(r.Count), r.Delta, r.ElapsedUs,
+                r.AchievedRateHz, r.DriftUs, r.MeanIntervalUs,
+                r.JitterP50Us, r.JitterP90Us, r.JitterP99Us, r.JitterP999Us, r.JitterMaxUs,
+                r.CpuUserUs, r.CpuSystemUs, r.CpuLoad);
+
+            csv += row;
+        }
+
+        return csv;
+    }
+
+    std::string CaptureBenchmark::ToTable(const std::vector<CaptureBenchmarkResult>& results)
+    {
+        std::string table;
+        char row[512];
+
+        std::snprintf(row, sizeof(row), "%-8s %14s %12s %12s %10s %10s %10s %10s %8s\n",
+            "strategy", "elapsed_us", "rate_hz", "drift_us", "p50_us", "p99_us", "p999_us", "max_us", "cpu");
+        table += row;
+
+        for (const auto& r : results)
+        {
+            std::snprintf(row, sizeof(row), "%-8s %14.3f %12.3f %12.3f %10.3f %10.3f %10.3f %10.3f %7.1f%%\n",
+                r.Strategy.c_str(), r.ElapsedUs, r.AchievedRateHz, r.DriftUs,
+                r.JitterP50Us, r.JitterP99Us, r.JitterP999Us, r.JitterMaxUs, r.CpuLoad * 100.0);
+            table += row;
+        }
+
+        return table;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef __MOUSE_TRACKER_CORE_CAPTUREBENCHMARK__
+#define __MOUSE_TRACKER_CORE_CAPTUREBENCHMARK__
+
+#include "MouseTrackerCore/Recording/PacingStrategy.h"
+#include "MouseTrackerCore/Recording/ICursorSource.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Mt
+{
+    struct CaptureBenchmarkResult
+    {
+        std::string Strategy;
+        int64_t Count = 0;
+        int Delta = 0;
+
+        // Wall time of the whole capture call.
+        double ElapsedUs = 0.0;
+
+        // Samples per second over the first-to-last tick span.
+        double AchievedRateHz = 0.0;
+
+        // Last tick minus its ideal time (count - 1) * delta; positive means late.
+        double DriftUs = 0.0;
+
+        // Absolute deviation of each sample interval from delta.
+        double MeanIntervalUs = 0.0;
+        double JitterP50Us = 0.0;
+        double JitterP90Us = 0.0;
+        double JitterP99Us = 0.0;
+        double JitterP999Us = 0.0;
+        double JitterMaxUs = 0.0;
+
+        // Sampling thread CPU time, and its share of the elapsed wall time.
+        double CpuUserUs = 0.0;
+        double CpuSystemUs = 0.0;
+        double CpuLoad = 0.0;
+    };
+
+    class CaptureBenchmark
+    {
+        public:
+            // Runs TrajectoryRecorder::Stream with the given strategy and source.
+            static CaptureBenchmarkResult Run(PacingStrategy strategy, ICursorSource& source, int64_t count, int delta);
+
+            static std::string ToJson(const std::vector<CaptureBenchmarkResult>& results, const std::string& sourceName);
+            static std::string ToCsv(const std::vector<CaptureBenchmarkResult>& results);
+            static std::string ToTable(const std::vector<CaptureBenchmarkResult>& results);
+    };
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef __MOUSE_TRACKER_CORE_HYBRIDPACER__
+#define __MOUSE_TRACKER_CORE_HYBRIDPACER__
+
+#include "MouseTrackerCore/Recording/ISamplePacer.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+#include <thread>
+#include <chrono>
+
+namespace Mt
+{
+    // Sleeps until shortly before the deadline, then spins the rest. Close to
+    // busy-wait precision for a fraction of its CPU time when delta is large
+    // compared to the scheduler's wake-up error.
+    class HybridPacer : public ISamplePacer
+    {
+        private:
+#ifdef _WIN32
+            static constexpr int64_t DefaultSpinMarginNs = 2000000;
+#else
+            static constexpr int64_t DefaultSpinMarginNs = 150000;
+#endif
+            int64_t m_spinMarginNs;
+            int64_t m_periodNs = 0;
+            int64_t m_startNs = 0;
+            int64_t m_nextNs = 0;
+
+        public:
+            explicit HybridPacer(int64_t spinMarginNs = DefaultSpinMarginNs)
+            {
+                m_spinMarginNs = spinMarginNs;
+            }
+
+            void Start(int64_t periodNs) override
+            {
+                m_periodNs = periodNs;
+                m_startNs = MonotonicClock::NowNs();
+                m_nextNs = m_startNs;
+            }
+
+            int64_t WaitNext() override
+            {
+                int64_t now = MonotonicClock::NowNs();
+
+                if (m_nextNs - now > m_spinMarginNs)
+                {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(m_nextNs - now - m_spinMarginNs));
+                    now = MonotonicClock::NowNs();
+                }
+
+                while (now < m_nextNs)
+                    now = MonotonicClock::NowNs();
+
+                int64_t tick = now - m_startNs;
+
+                m_nextNs += m_periodNs;
+
+                if (now - m_nextNs >= m_periodNs)
+                    m_nextNs = now + m_periodNs;
+
+                return tick;
+            }
+
+            void Stop() override {  }
+
+            const char* GetName() const override
+            {
+                return "hybrid";
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef __MOUSE_TRACKER_CORE_ICURSORSOURCE__
+#define __MOUSE_TRACKER_CORE_ICURSORSOURCE__
+
+#include "MouseTrackerCore/Trajectory/Point.h"
+
+namespace Mt
+{
+    class ICursorSource
+    {
+        public:
+            virtual ~ICursorSource() = default;
+
+            // Called on the sampling hot path once per tick; must not allocate.
+            virtual bool Read(Point& point) = 0;
+
+            virtual bool GetScreenSize(int32_t& width, int32_t& height) const = 0;
+            virtual const char* GetName() const = 0;
+    };
+}
+
+#endif
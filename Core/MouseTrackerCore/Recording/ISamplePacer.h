@@ -0,0 +1,24 @@
+#ifndef __MOUSE_TRACKER_CORE_ISAMPLEPACER__
+#define __MOUSE_TRACKER_CORE_ISAMPLEPACER__
+
+#include <cstdint>
+
+namespace Mt
+{
+    class ISamplePacer
+    {
+        public:
+            virtual ~ISamplePacer() = default;
+
+            // Arms the pacer; the first WaitNext() returns immediately.
+            virtual void Start(int64_t periodNs) = 0;
+
+            // Blocks until the next tick and returns its time in nanoseconds since Start().
+            virtual int64_t WaitNext() = 0;
+
+            virtual void Stop() = 0;
+            virtual const char* GetName() const = 0;
+    };
+}
+
+#endif
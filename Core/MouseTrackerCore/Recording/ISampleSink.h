@@ -0,0 +1,19 @@
+#ifndef __MOUSE_TRACKER_CORE_ISAMPLESINK__
+#define __MOUSE_TRACKER_CORE_ISAMPLESINK__
+
+#include "MouseTrackerCore/Trajectory/Point.h"
+#include <cstdint>
+
+namespace Mt
+{
+    // Receives samples as they are captured. OnSample runs on the sampling thread
+    // and must return quickly without blocking.
+    class ISampleSink
+    {
+        public:
+            virtual ~ISampleSink() = default;
+            virtual void OnSample(const Point& point, int64_t timestampUs) = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef __MOUSE_TRACKER_CORE_MONOTONICCLOCK__
+#define __MOUSE_TRACKER_CORE_MONOTONICCLOCK__
+
+#include <chrono>
+#include <cstdint>
+
+namespace Mt
+{
+    // steady_clock is QueryPerformanceCounter on MSVC and CLOCK_MONOTONIC on glibc.
+    class MonotonicClock
+    {
+        public:
+            static int64_t NowNs()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>
+                (
+                    std::chrono::steady_clock::now().time_since_epoch()
+                ).count();
+            }
+
+            static int64_t WallClockUs()
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>
+                (
+                    std::chrono::system_clock::now().time_since_epoch()
+                ).count();
+            }
+    };
+}
+
+#endif
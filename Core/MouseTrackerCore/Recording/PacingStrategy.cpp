@@ -0,0 +1,71 @@
+#include "MouseTrackerCore/Recording/PacingStrategy.h"
+#include "MouseTrackerCore/Recording/BusyWaitPacer.h"
+#include "MouseTrackerCore/Recording/SleepPacer.h"
+#include "MouseTrackerCore/Recording/HybridPacer.h"
+#include "MouseTrackerCore/Platform/WaitableTimerPacer.h"
+
+namespace Mt
+{
+    std::unique_ptr<ISamplePacer> SamplePacerFactory::Create(PacingStrategy strategy)
+    {
+        switch (strategy)
+        {
+            case PacingStrategy::BusyWait:
+                return std::make_unique<BusyWaitPacer>();
+
+            case PacingStrategy::Sleep:
+                return std::make_unique<SleepPacer>();
+
+            case PacingStrategy::Hybrid:
+                return std::make_unique<HybridPacer>();
+
+            case PacingStrategy::WaitableTimer:
+#ifdef _WIN32
+                return std::make_unique<WaitableTimerPacer>();
+#else
+                return nullptr;
+#endif
+        }
+
+        return nullptr;
+    }
+
+    std::vector<PacingStrategy> SamplePacerFactory::GetAvailableStrategies()
+    {
+        std::vector<PacingStrategy> strategies = { PacingStrategy::BusyWait, PacingStrategy::Sleep, PacingStrategy::Hybrid };
+
+#ifdef _WIN32
+        strategies.push_back(PacingStrategy::WaitableTimer);
+#endif
+
+        return strategies;
+    }
+
+    const char* SamplePacerFactory::ToString(PacingStrategy strategy)
+    {
+        switch (strategy)
+        {
+            case PacingStrategy::BusyWait: return "busy";
+            case PacingStrategy::Sleep: return "sleep";
+            case PacingStrategy::Hybrid: return "hybrid";
+            case PacingStrategy::WaitableTimer: return "timer";
+            default: return "unknown";
+        }
+    }
+
+    bool SamplePacerFactory::Parse(const std::string& name, PacingStrategy& strategy)
+    {
+        if (name == "busy")
+            strategy = PacingStrategy::BusyWait;
+        else if (name == "sleep")
+            strategy = PacingStrategy::Sleep;
+        else if (name == "hybrid")
+            strategy = PacingStrategy::Hybrid;
+        else if (name == "timer")
+            strategy = PacingStrategy::WaitableTimer;
+        else
+            return false;
+
+        return true;
+    }
+}
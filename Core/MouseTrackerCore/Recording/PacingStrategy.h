@@ -0,0 +1,31 @@
+#ifndef __MOUSE_TRACKER_CORE_PACINGSTRATEGY__
+#define __MOUSE_TRACKER_CORE_PACINGSTRATEGY__
+
+#include "MouseTrackerCore/Recording/ISamplePacer.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mt
+{
+    enum class PacingStrategy
+    {
+        BusyWait,
+        Sleep,
+        Hybrid,
+        WaitableTimer
+    };
+
+    class SamplePacerFactory
+    {
+        public:
+            // Returns nullptr when the strategy is not available on this platform.
+            static std::unique_ptr<ISamplePacer> Create(PacingStrategy strategy);
+            static std::vector<PacingStrategy> GetAvailableStrategies();
+
+            static const char* ToString(PacingStrategy strategy);
+            static bool Parse(const std::string& name, PacingStrategy& strategy);
+    };
+}
+
+#endif
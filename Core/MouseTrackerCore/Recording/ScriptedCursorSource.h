@@ -0,0 +1,59 @@
+#ifndef __MOUSE_TRACKER_CORE_SCRIPTEDCURSORSOURCE__
+#define __MOUSE_TRACKER_CORE_SCRIPTEDCURSORSOURCE__
+
+#include "MouseTrackerCore/Recording/ICursorSource.h"
+#include <vector>
+#include <utility>
+
+namespace Mt
+{
+    // Replays a fixed path, then holds the last position. Used by tests, benchmarks
+    // and headless machines without a pointer device.
+    class ScriptedCursorSource : public ICursorSource
+    {
+        private:
+            std::vector<Point> m_path;
+            size_t m_position = 0;
+            int32_t m_screenWidth = 1920;
+            int32_t m_screenHeight = 1080;
+
+        public:
+            explicit ScriptedCursorSource(std::vector<Point> path)
+            {
+                m_path = std::move(path);
+            }
+
+            bool Read(Point& point) override
+            {
+                if (m_path.empty())
+                    return false;
+
+                point = m_path[m_position];
+
+                if (m_position + 1 < m_path.size())
+                    m_position++;
+
+                return true;
+            }
+
+            bool GetScreenSize(int32_t& width, int32_t& height) const override
+            {
+                width = m_screenWidth;
+                height = m_screenHeight;
+
+                return true;
+            }
+
+            const char* GetName() const override
+            {
+                return "scripted";
+            }
+
+            void Rewind()
+            {
+                m_position = 0;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef __MOUSE_TRACKER_CORE_SLEEPPACER__
+#define __MOUSE_TRACKER_CORE_SLEEPPACER__
+
+#include "MouseTrackerCore/Recording/ISamplePacer.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+#include <thread>
+#include <chrono>
+
+namespace Mt
+{
+    // Yields the core between samples. Accuracy depends on the scheduler tick
+    // (timeBeginPeriod on Windows, hrtimers on Linux).
+    class SleepPacer : public ISamplePacer
+    {
+        private:
+            int64_t m_periodNs = 0;
+            int64_t m_startNs = 0;
+            int64_t m_nextNs = 0;
+
+        public:
+            void Start(int64_t periodNs) override
+            {
+                m_periodNs = periodNs;
+                m_startNs = MonotonicClock::NowNs();
+                m_nextNs = m_startNs;
+            }
+
+            int64_t WaitNext() override
+            {
+                int64_t now = MonotonicClock::NowNs();
+
+                if (now < m_nextNs)
+                {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(m_nextNs - now));
+                    now = MonotonicClock::NowNs();
+                }
+
+                int64_t tick = now - m_startNs;
+
+                m_nextNs += m_periodNs;
+
+                if (now - m_nextNs >= m_periodNs)
+                    m_nextNs = now + m_periodNs;
+
+                return tick;
+            }
+
+            void Stop() override {  }
+
+            const char* GetName() const override
+            {
+                return "sleep";
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,195 @@
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Recording/BusyWaitPacer.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+#include "MouseTrackerCore/Platform/CursorSourceFactory.h"
+#include "MouseTrackerCore/Platform/HighResolutionTimingScope.h"
+
+namespace Mt
+{
+    TrajectoryRecorder::TrajectoryRecorder()
+        : TrajectoryRecorder(CursorSourceFactory::CreateDefault(), std::make_unique<BusyWaitPacer>())
+    {
+    }
+
+    TrajectoryRecorder::TrajectoryRecorder(std::unique_ptr<ICursorSource> source, std::unique_ptr<ISamplePacer> pacer)
+    {
+        m_source = std::move(source);
+        m_pacer = pacer ? std::move(pacer) : std::make_unique<BusyWaitPacer>();
+        m_stopRequested = false;
+        m_recordTimestamps = false;
+    }
+
+    TrajectoryMetadata TrajectoryRecorder::DescribeCapture(int delta) const
+    {
+        TrajectoryMetadata metadata;
+        metadata.PeriodUs = static_cast<uint32_t>(delta) * 1000u;
+        metadata.StartTimeUs = MonotonicClock::WallClockUs();
+
+        if (m_source)
+            m_source->GetScreenSize(metadata.ScreenWidth, metadata.ScreenHeight);
+
+        return metadata;
+    }
+
+    void TrajectoryRecorder::Begin(Trajectory& trajectory, int delta)
+    {
+        trajectory.SetMetadata(DescribeCapture(delta));
+    }
+
+    Trajectory TrajectoryRecorder::RecordPoints(int count, int delta)
+    {
+        Trajectory trajectory;
+
+        if (!m_source || count <= 0)
+            return trajectory;
+
+        trajectory.Reserve(static_cast<size_t>(count), m_recordTimestamps);
+        Begin(trajectory, delta);
+
+        HighResolutionTimingScope timingScope;
+        m_pacer->Start(static_cast<int64_t>(delta) * 1000000);
+
+        Point point = { 0, 0 };
+
+        for (int i = 0; i < count && !IsStopRequested(); i++)
+        {
+            int64_t tick = m_pacer->WaitNext();
+
+            m_source->Read(point);
+            Append(trajectory, point, tick);
+        }
+
+        m_pacer->Stop();
+
+        return trajectory;
+    }
+
+    Trajectory TrajectoryRecorder::RecordTrajectory(int delay, int delta)
+    {
+        Trajectory trajectory;
+
+        if (!m_source)
+            return trajectory;
+
+        Begin(trajectory, delta);
+
+        HighResolutionTimingScope timingScope;
+        m_pacer->Start(static_cast<int64_t>(delta) * 1000000);
+
+        int64_t tick = m_pacer->WaitNext();
+        Point point = { 0, 0 };
+
+        m_source->Read(point);
+        Append(trajectory, point, tick);
+
+        const Point initialPoint = point;
+
+        while (!IsStopRequested())
+        {
+            tick = m_pacer->WaitNext();
+            m_source->Read(point);
+
+            if (point != initialPoint)
+            {
+                Append(trajectory, point, tick);
+
+                break;
+            }
+        }
+
+        const int64_t delayNs = static_cast<int64_t>(delay) * 1000000;
+        Point lastPoint = point;
+        int64_t lastMoveTick = tick;
+
+        while (!IsStopRequested())
+        {
+            tick = m_pacer->WaitNext();
+            m_source->Read(point);
+            Append(trajectory, point, tick);
+
+            if (point == lastPoint)
+            {
+                if (tick - lastMoveTick >= delayNs)
+                    break;
+            }
+            else
+            {
+                lastPoint = point;
+                lastMoveTick = tick;
+            }
+        }
+
+        m_pacer->Stop();
+
+        return trajectory;
+    }
+
+    Trajectory TrajectoryRecorder::RecordContinuous(int endDelay, int delta)
+    {
+        Trajectory trajectory;
+
+        if (!m_source)
+            return trajectory;
+
+        Begin(trajectory, delta);
+
+        HighResolutionTimingScope timingScope;
+        m_pacer->Start(static_cast<int64_t>(delta) * 1000000);
+
+        int64_t tick = m_pacer->WaitNext();
+        Point point = { 0, 0 };
+
+        m_source->Read(point);
+        Append(trajectory, point, tick);
+
+        const int64_t endDelayNs = static_cast<int64_t>(endDelay) * 1000000;
+        Point lastPoint = point;
+        int64_t lastMoveTick = tick;
+
+        while (!IsStopRequested())
+        {
+            tick = m_pacer->WaitNext();
+            m_source->Read(point);
+            Append(trajectory, point, tick);
+
+            if (point != lastPoint)
+            {
+                lastPoint = point;
+                lastMoveTick = tick;
+            }
+            else if (tick - lastMoveTick >= endDelayNs)
+            {
+                break;
+            }
+        }
+
+        m_pacer->Stop();
+
+        return trajectory;
+    }
+
+    int64_t TrajectoryRecorder::Stream(ISampleSink& sink, int64_t count, int delta)
+    {
+        if (!m_source)
+            return 0;
+
+        HighResolutionTimingScope timingScope;
+        m_pacer->Start(static_cast<int64_t>(delta) * 1000000);
+
+        Point point = { 0, 0 };
+        int64_t samples = 0;
+
+        while ((count <= 0 || samples < count) && !IsStopRequested())
+        {
+            int64_t tick = m_pacer->WaitNext();
+
+            m_source->Read(point);
+            sink.OnSample(point, tick / 1000);
+            samples++;
+        }
+
+        m_pacer->Stop();
+
+        return samples;
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYRECORDER__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYRECORDER__
+
+#include "MouseTrackerCore/Trajectory/Trajectory.h"
+#include "MouseTrackerCore/Recording/ICursorSource.h"
+#include "MouseTrackerCore/Recording/ISamplePacer.h"
+#include "MouseTrackerCore/Recording/ISampleSink.h"
+#include "MouseTrackerCore/Recording/PacingStrategy.h"
+#include <memory>
+#include <atomic>
+
+namespace Mt
+{
+    class TrajectoryRecorder
+    {
+        private:
+            std::unique_ptr<ICursorSource> m_source;
+            std::unique_ptr<ISamplePacer> m_pacer;
+            std::atomic<bool> m_stopRequested;
+            bool m_recordTimestamps;
+
+        public:
+            // Platform cursor source with busy-wait pacing.
+            TrajectoryRecorder();
+            TrajectoryRecorder(std::unique_ptr<ICursorSource> source, std::unique_ptr<ISamplePacer> pacer);
+
+            // Records exactly `count` samples `delta` ms apart.
+            Trajectory RecordPoints(int count, int delta = 1);
+
+            // Waits for the cursor to move, then records until it has been still for `delay` ms.
+            Trajectory RecordTrajectory(int delay, int delta = 1);
+
+            // Records immediately until the cursor has been still for `endDelay` ms.
+            Trajectory RecordContinuous(int endDelay, int delta = 1);
+
+            // Hands every sample to `sink` as it is captured instead of collecting it.
+            // Runs until `count` samples (0 = unlimited) or RequestStop(); returns the sample count.
+            int64_t Stream(ISampleSink& sink, int64_t count, int delta = 1);
+
+            // Period, start time and screen size for a capture starting now, for
+            // sinks that write their own header.
+            TrajectoryMetadata DescribeCapture(int delta = 1) const;
+
+            // Makes the running (or next) Record* call return what it has so far.
+            void RequestStop()
+            {
+                m_stopRequested.store(true, std::memory_order_relaxed);
+            }
+
+            void ResetStop()
+            {
+                m_stopRequested.store(false, std::memory_order_relaxed);
+            }
+
+            bool IsStopRequested() const
+            {
+                return m_stopRequested.load(std::memory_order_relaxed);
+            }
+
+            bool HasSource() const
+            {
+                return m_source != nullptr;
+            }
+
+            ICursorSource* GetSource() const
+            {
+                return m_source.get();
+            }
+
+            void SetSource(std::unique_ptr<ICursorSource> source)
+            {
+                m_source = std::move(source);
+            }
+
+            void SetPacer(std::unique_ptr<ISamplePacer> pacer)
+            {
+                m_pacer = std::move(pacer);
+            }
+
+            ISamplePacer* GetPacer() const
+            {
+                return m_pacer.get();
+            }
+
+            void SetRecordTimestamps(bool recordTimestamps)
+            {
+                m_recordTimestamps = recordTimestamps;
+            }
+
+        private:
+            void Begin(Trajectory& trajectory, int delta);
+
+            void Append(Trajectory& trajectory, const Point& point, int64_t tickNs)
+            {
+                if (m_recordTimestamps)
+                    trajectory.Add(point, tickNs / 1000);
+                else
+                    trajectory.Add(point);
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include "MouseTrackerCore/Storage/ChunkedTrajectoryWriter.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+#include "MouseTrackerCore/Platform/FileSync.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Mt
+{
+    ChunkedTrajectoryWriter::ChunkedTrajectoryWriter(const ChunkedRecordingSettings& settings)
+        : m_queue(settings.QueueCapacity)
+    {
+        m_settings = settings;
+        m_settings.ChunkSamples = std::max<size_t>(m_settings.ChunkSamples, 1);
+        m_file = nullptr;
+        m_stopRequested = false;
+        m_captured = 0;
+        m_dropped = 0;
+        m_written = 0;
+        m_chunks = 0;
+        m_bytesWritten = 0;
+        m_writeFailed = false;
+    }
+
+    ChunkedTrajectoryWriter::~ChunkedTrajectoryWriter()
+    {
+        Stop();
+    }
+
+    CodecResult ChunkedTrajectoryWriter::Open(const std::string& filename, const TrajectoryMetadata& metadata)
+    {
+        if (m_file)
+            return CodecResult::Fail("Recording already open: " + m_filename);
+
+        m_file = std::fopen(filename.c_str(), "wb");
+
+        if (!m_file)
+            return CodecResult::Fail("Unable to open " + filename);
+
+        m_filename = filename;
+        m_captured = 0;
+        m_dropped = 0;
+        m_written = 0;
+        m_chunks = 0;
+        m_bytesWritten = 0;
+        m_writeFailed = false;
+        m_header = BinaryTrajectoryHeader();
+        m_header.Encoding = static_cast<uint8_t>(BinaryEncoding::Chunked);
+        m_header.Flags = BinaryTrajectoryFlags::ChunkChecksums | (m_settings.RecordTimestamps ? BinaryTrajectoryFlags::HasTimestamps : 0);
+        m_header.PeriodUs = metadata.PeriodUs;
+        m_header.StartTimeUs = metadata.StartTimeUs;
+        m_header.ScreenWidth = metadata.ScreenWidth;
+        m_header.ScreenHeight = metadata.ScreenHeight;
+
+        if (!WriteBytes(&m_header, sizeof(m_header)) || std::fflush(m_file) != 0)
+        {
+            std::fclose(m_file);
+            m_file = nullptr;
+
+            return CodecResult::Fail("Write failed for " + filename);
+        }
+
+        m_points.reserve(m_settings.ChunkSamples);
+
+        if (m_settings.RecordTimestamps)
+            m_timestamps.reserve(m_settings.ChunkSamples);
+
+        m_stopRequested = false;
+        m_thread = std::thread([this]() { this->WriterLoop(); });
+
+        return CodecResult::Ok();
+    }
+
+    void ChunkedTrajectoryWriter::Stop()
+    {
+        m_stopRequested.store(true, std::memory_order_release);
+
+        if (m_thread.joinable())
+            m_thread.join();
+
+        if (!m_file)
+            return;
+
+        // Only a closed recording carries totals; readers treat 0 as "cut short".
+        if (!m_writeFailed)
+        {
+            m_header.SampleCount = m_written;
+            m_header.PayloadBytes = m_bytesWritten - sizeof(m_header);
+
+            if (std::fseek(m_file, 0, SEEK_SET) != 0 || std::fwrite(&m_header, sizeof(m_header), 1, m_file) != 1)
+                m_writeFailed = true;
+            else if (m_settings.SyncToDisk ? !FileSync::FlushStream(m_file) : std::fflush(m_file) != 0)
+                m_writeFailed = true;
+        }
+
+        if (std::fclose(m_file) != 0)
+            m_writeFailed = true;
+
+        m_file = nullptr;
+    }
+
+    ChunkedRecordingStats ChunkedTrajectoryWriter::GetStats() const
+    {
+        ChunkedRecordingStats stats;
+        stats.Captured = m_captured.load(std::memory_order_relaxed);
+        stats.Written = m_written.load(std::memory_order_relaxed);
+        stats.Dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.Chunks = m_chunks.load(std::memory_order_relaxed);
+        stats.BytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+        stats.WriteFailed = m_writeFailed.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    void ChunkedTrajectoryWriter::WriterLoop()
+    {
+        std::vector<StreamSample> batch(4096);
+        const int64_t maxLatencyNs = m_settings.MaxLatencyUs * 1000;
+        const auto idleSleep = std::chrono::microseconds(std::clamp<int64_t>(m_settings.MaxLatencyUs / 8, 100, 5000));
+        int64_t oldestPendingNs = 0;
+
+        while (true)
+        {
+            bool stopping = m_stopRequested.load(std::memory_order_acquire);
+            size_t room = m_settings.ChunkSamples - m_points.size();
+            size_t count = m_queue.PopBatch(batch.data(), std::min(room, batch.size()));
+            int64_t now = MonotonicClock::NowNs();
+
+            if (count > 0 && m_points.empty())
+                oldestPendingNs = now;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                m_points.push_back(Point { batch[i].X, batch[i].Y });
+
+                if (m_settings.RecordTimestamps)
+                    m_timestamps.push_back(batch[i].TimestampUs);
+            }
+
+            bool pending = !m_points.empty();
+            bool full = m_points.size() >= m_settings.ChunkSamples;
+            bool latencyExpired = pending && now - oldestPendingNs >= maxLatencyNs;
+            bool draining = stopping && count == 0;
+
+            if (pending && (full || latencyExpired || draining))
+                WriteChunk();
+
+            if (count == 0)
+            {
+                if (stopping)
+                    break;
+
+                std::this_thread::sleep_for(idleSleep);
+            }
+        }
+    }
+
+    void ChunkedTrajectoryWriter::WriteChunk()
+    {
+        m_chunk.clear();
+        BinaryTrajectoryCodec::AppendChunk(m_chunk, m_points.data(), m_settings.RecordTimestamps ? m_timestamps.data() : nullptr, m_points.size());
+
+        // After a failure the samples are counted as captured but not written.
+        if (!m_writeFailed.load(std::memory_order_relaxed))
+        {
+            bool flushed = WriteBytes(m_chunk.data(), m_chunk.size()) &&
+                (m_settings.SyncToDisk ? FileSync::FlushStream(m_file) : std::fflush(m_file) == 0);
+
+            if (flushed)
+            {
+                m_written.fetch_add(m_points.size(), std::memory_order_relaxed);
+                m_chunks.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                m_writeFailed.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        m_points.clear();
+        m_timestamps.clear();
+    }
+
+    bool ChunkedTrajectoryWriter::WriteBytes(const void* data, size_t size)
+    {
+        if (std::fwrite(data, 1, size, m_file) != size)
+            return false;
+
+        m_bytesWritten.fetch_add(size, std::memory_order_relaxed);
+
+        return true;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef __MOUSE_TRACKER_CORE_CHUNKEDTRAJECTORYWRITER__
+#define __MOUSE_TRACKER_CORE_CHUNKEDTRAJECTORYWRITER__
+
+#include "MouseTrackerCore/Recording/ISampleSink.h"
+#include "MouseTrackerCore/Streaming/SampleStreamWriter.h"
+#include "MouseTrackerCore/Threading/SpscRingBuffer.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryFormat.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+
+namespace Mt
+{
+    struct ChunkedRecordingSettings
+    {
+        bool RecordTimestamps = true;
+
+        // Samples buffered between the sampler and the writer before drops start.
+        size_t QueueCapacity = 1 << 16;
+
+        // A chunk is appended when this many samples are pending...
+        size_t ChunkSamples = 4096;
+
+        // ...or when the oldest pending sample is this old. Bounds what a crash can lose.
+        int64_t MaxLatencyUs = 250000;
+
+        // Flush every chunk to the device, not just to the OS cache.
+        bool SyncToDisk = true;
+    };
+
+    struct ChunkedRecordingStats
+    {
+        uint64_t Captured = 0;
+        uint64_t Written = 0;
+        uint64_t Dropped = 0;
+        uint64_t Chunks = 0;
+        uint64_t BytesWritten = 0;
+        bool WriteFailed = false;
+    };
+
+    // Records straight into a Chunked .crsbin file while the capture runs.
+    // Samples go through a wait-free ring to a writer thread that appends a
+    // framed chunk every ChunkSamples samples or MaxLatencyUs; Stop() writes
+    // the last chunk and fills in the header totals. Memory stays at the ring
+    // plus one chunk however long the session, and a file cut off by a crash
+    // loads up to its last complete chunk.
+    class ChunkedTrajectoryWriter : public ISampleSink
+    {
+        private:
+            ChunkedRecordingSettings m_settings;
+            SpscRingBuffer<StreamSample> m_queue;
+            std::FILE* m_file;
+            std::string m_filename;
+            BinaryTrajectoryHeader m_header;
+            std::thread m_thread;
+            std::atomic<bool> m_stopRequested;
+            std::atomic<uint64_t> m_captured;
+            std::atomic<uint64_t> m_dropped;
+            std::atomic<uint64_t> m_written;
+            std::atomic<uint64_t> m_chunks;
+            std::atomic<uint64_t> m_bytesWritten;
+            std::atomic<bool> m_writeFailed;
+            std::vector<Point> m_points;
+            std::vector<int64_t> m_timestamps;
+            std::vector<uint8_t> m_chunk;
+
+        public:
+            explicit ChunkedTrajectoryWriter(const ChunkedRecordingSettings& settings = ChunkedRecordingSettings());
+            ChunkedTrajectoryWriter(const ChunkedTrajectoryWriter&) = delete;
+            ChunkedTrajectoryWriter& operator=(const ChunkedTrajectoryWriter&) = delete;
+            ~ChunkedTrajectoryWriter() override;
+
+            // Creates the file and writes its header; the writer thread starts here.
+            CodecResult Open(const std::string& filename, const TrajectoryMetadata& metadata);
+
+            // Drains the ring, appends the final chunk, records the totals in
+            // the header and closes the file.
+            void Stop();
+
+            void OnSample(const Point& point, int64_t timestampUs) override
+            {
+                m_captured.fetch_add(1, std::memory_order_relaxed);
+
+                if (!m_queue.TryPush(StreamSample { timestampUs, point.x, point.y }))
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            ChunkedRecordingStats GetStats() const;
+
+        private:
+            void WriterLoop();
+            void WriteChunk();
+            bool WriteBytes(const void* data, size_t size);
+    };
+}
+
+#endif
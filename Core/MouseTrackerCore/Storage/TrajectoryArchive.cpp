@@ -0,0 +1,188 @@
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Mt
+{
+    namespace
+    {
+        // Validates the .crsbin image at `offset` and returns its length, or 0.
+        uint64_t GetImageLength(const uint8_t* data, uint64_t size, uint64_t offset, BinaryTrajectoryHeader& header)
+        {
+            if (size - offset < sizeof(header))
+                return 0;
+
+            std::memcpy(&header, data + offset, sizeof(header));
+
+            // Chunked images run to the end of their file, so they cannot be entries.
+            if (!header.Validate().empty() || header.GetEncoding() == BinaryEncoding::Chunked)
+                return 0;
+
+            // Checked against the bytes left before summing, so a huge
+            // PayloadBytes cannot wrap into a short, plausible length.
+            if (!header.FitsIn(size - offset))
+                return 0;
+
+            return header.HeaderSize + header.PayloadBytes;
+        }
+    }
+
+    CodecResult TrajectoryArchive::Open(const std::string& filename)
+    {
+        Close();
+
+        std::string error;
+
+        if (!m_file.Open(filename, error))
+            return CodecResult::Fail(error);
+
+        const uint8_t* data = m_file.Data();
+        uint64_t size = m_file.Size();
+        ArchiveHeader header;
+
+        if (size < sizeof(header))
+            return CodecResult::Fail("Truncated archive header in " + filename);
+
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.Magic != ArchiveHeader::MagicValue)
+            return CodecResult::Fail("Not a trajectory archive: " + filename);
+
+        if (header.Version == 0 || header.Version > ArchiveHeader::CurrentVersion || header.HeaderSize < sizeof(header) || header.HeaderSize > size)
+            return CodecResult::Fail("Unsupported trajectory archive: " + filename);
+
+        m_headerSize = header.HeaderSize;
+
+        ArchiveFooter footer;
+
+        if (size >= header.HeaderSize + sizeof(footer))
+        {
+            std::memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+
+            uint64_t indexBytes = size - sizeof(footer) - footer.IndexOffset;
+            bool valid = footer.Magic == ArchiveFooter::MagicValue &&
+                footer.IndexOffset >= header.HeaderSize &&
+                footer.IndexOffset <= size - sizeof(footer) &&
+                indexBytes / sizeof(ArchiveIndexEntry) == footer.EntryCount &&
+                indexBytes % sizeof(ArchiveIndexEntry) == 0;
+
+            if (valid)
+            {
+                m_index.resize(static_cast<size_t>(footer.EntryCount));
+
+                if (!m_index.empty())
+                    std::memcpy(m_index.data(), data + footer.IndexOffset, m_index.size() * sizeof(ArchiveIndexEntry));
+
+                return CodecResult::Ok();
+            }
+        }
+
+        return ScanEntries();
+    }
+
+    void TrajectoryArchive::Close()
+    {
+        m_file.Close();
+        m_index.clear();
+        m_headerSize = sizeof(ArchiveHeader);
+        m_recovered = false;
+    }
+
+    CodecResult TrajectoryArchive::ScanEntries()
+    {
+        const uint8_t* data = m_file.Data();
+        uint64_t size = m_file.Size();
+        uint64_t offset = m_headerSize;
+        BinaryTrajectoryHeader image;
+        Trajectory trajectory;
+
+        while (uint64_t length = GetImageLength(data, size, offset, image))
+        {
+            if (!BinaryTrajectoryCodec::DecodePayload(image, data + offset + image.HeaderSize, static_cast<size_t>(image.PayloadBytes), trajectory).Success)
+                break;
+
+            ArchiveIndexEntry entry = Summarize(trajectory);
+            entry.Offset = offset;
+            entry.Length = length;
+
+            m_index.push_back(entry);
+            offset += length;
+        }
+
+        m_recovered = true;
+
+        CodecResult result = CodecResult::Ok();
+        result.Warnings.push_back("Archive index missing, recovered " + std::to_string(m_index.size()) + " entries by scanning");
+
+        return result;
+    }
+
+    CodecResult TrajectoryArchive::Read(size_t id, Trajectory& trajectory) const
+    {
+        BinaryTrajectoryHeader header;
+        const uint8_t* payload = nullptr;
+        CodecResult result = GetImage(id, header, payload);
+
+        if (!result.Success)
+            return result;
+
+        return BinaryTrajectoryCodec::DecodePayload(header, payload, static_cast<size_t>(header.PayloadBytes), trajectory);
+    }
+
+    CodecResult TrajectoryArchive::GetImage(size_t id, BinaryTrajectoryHeader& header, const uint8_t*& payload) const
+    {
+        if (id >= m_index.size())
+            return CodecResult::Fail("No archive entry " + std::to_string(id));
+
+        const ArchiveIndexEntry& entry = m_index[id];
+
+        if (entry.Offset > m_file.Size() || GetImageLength(m_file.Data(), m_file.Size(), entry.Offset, header) != entry.Length)
+            return CodecResult::Fail("Corrupt archive entry " + std::to_string(id));
+
+        payload = m_file.Data() + entry.Offset + header.HeaderSize;
+
+        return CodecResult::Ok();
+    }
+
+    uint64_t TrajectoryArchive::GetEntriesEnd() const
+    {
+        if (m_index.empty())
+            return m_headerSize;
+
+        return m_index.back().Offset + m_index.back().Length;
+    }
+
+    bool TrajectoryArchive::IsArchive(const std::string& filename)
+    {
+        return TrajectoryCodecRegistry::GetExtension(filename) == Extension;
+    }
+
+    ArchiveIndexEntry TrajectoryArchive::Summarize(const TrajectorySpan& trajectory)
+    {
+        ArchiveIndexEntry entry;
+        entry.SampleCount = trajectory.Size();
+
+        if (trajectory.Empty())
+            return entry;
+
+        entry.MinX = entry.MaxX = trajectory.Front().x;
+        entry.MinY = entry.MaxY = trajectory.Front().y;
+
+        for (const auto& point : trajectory)
+        {
+            entry.MinX = std::min(entry.MinX, point.x);
+            entry.MaxX = std::max(entry.MaxX, point.x);
+            entry.MinY = std::min(entry.MinY, point.y);
+            entry.MaxY = std::max(entry.MaxY, point.y);
+        }
+
+        if (trajectory.HasTimestamps())
+            entry.DurationUs = trajectory.Timestamps[trajectory.Size() - 1] - trajectory.Timestamps[0];
+        else
+            entry.DurationUs = static_cast<int64_t>(trajectory.Size() - 1) * trajectory.GetMetadata().PeriodUs;
+
+        return entry;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYARCHIVE__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYARCHIVE__
+
+#include "MouseTrackerCore/Storage/TrajectoryArchiveFormat.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryFormat.h"
+#include "MouseTrackerCore/Platform/MappedFile.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include "MouseTrackerCore/Trajectory/Trajectory.h"
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <string>
+#include <vector>
+
+namespace Mt
+{
+    // Read access to a .crsarc archive (see TrajectoryArchiveFormat.h). The
+    // file is memory-mapped and its index loaded once; after that any entry is
+    // located and decoded by id without touching the others. Const methods are
+    // safe to call from several threads.
+    class TrajectoryArchive
+    {
+        private:
+            MappedFile m_file;
+            std::vector<ArchiveIndexEntry> m_index;
+            uint64_t m_headerSize = sizeof(ArchiveHeader);
+            bool m_recovered = false;
+
+        public:
+            static constexpr const char* Extension = ".crsarc";
+
+            TrajectoryArchive() = default;
+            TrajectoryArchive(const TrajectoryArchive&) = delete;
+            TrajectoryArchive& operator=(const TrajectoryArchive&) = delete;
+
+            // Fails only when the file is not an archive; a missing footer is
+            // rebuilt by scanning and reported as a warning.
+            CodecResult Open(const std::string& filename);
+            void Close();
+
+            size_t GetCount() const
+            {
+                return m_index.size();
+            }
+
+            const ArchiveIndexEntry& GetEntry(size_t id) const
+            {
+                return m_index[id];
+            }
+
+            const std::vector<ArchiveIndexEntry>& GetIndex() const
+            {
+                return m_index;
+            }
+
+            // True when the index came from a scan rather than the footer.
+            bool IsRecovered() const
+            {
+                return m_recovered;
+            }
+
+            CodecResult Read(size_t id, Trajectory& trajectory) const;
+
+            // Locates an entry's header and mapped payload without decoding
+            // it, for callers that decode into storage of their own.
+            CodecResult GetImage(size_t id, BinaryTrajectoryHeader& header, const uint8_t*& payload) const;
+
+            // Offset just past the last entry, where a writer resumes appending.
+            uint64_t GetEntriesEnd() const;
+
+            static bool IsArchive(const std::string& filename);
+
+            static ArchiveIndexEntry Summarize(const TrajectorySpan& trajectory);
+
+        private:
+            CodecResult ScanEntries();
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYARCHIVEFORMAT__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYARCHIVEFORMAT__
+
+#include <cstdint>
+
+namespace Mt
+{
+    // .crsarc layout, little endian:
+    //
+    //   ArchiveHeader (HeaderSize bytes, 32 in version 1)
+    //   entries, back to back, each a complete .crsbin image (header + payload)
+    //   index   - EntryCount x ArchiveIndexEntry, entry id = position
+    //   ArchiveFooter (last 32 bytes of the file)
+    //
+    // The index and footer are rewritten when a writer closes. A file without
+    // a valid footer (writer killed mid-session) is recovered by walking the
+    // entries from the header, each of which carries its own size.
+    struct ArchiveHeader
+    {
+        static constexpr uint32_t MagicValue = 0x5241544D; // "MTAR"
+        static constexpr uint16_t CurrentVersion = 1;
+
+        uint32_t Magic = MagicValue;
+        uint16_t Version = CurrentVersion;
+        uint16_t HeaderSize = sizeof(ArchiveHeader);
+        uint32_t Flags = 0;
+        uint32_t Reserved0 = 0;
+        int64_t CreatedUs = 0;
+        uint64_t Reserved1 = 0;
+    };
+
+    // Summary kept per entry so listings and filters never decode samples.
+    struct ArchiveIndexEntry
+    {
+        uint64_t Offset = 0;
+        uint64_t Length = 0;
+        uint64_t SampleCount = 0;
+
+        // Last minus first timestamp, or (count - 1) periods without timestamps.
+        int64_t DurationUs = 0;
+
+        int32_t MinX = 0;
+        int32_t MinY = 0;
+        int32_t MaxX = 0;
+        int32_t MaxY = 0;
+    };
+
+    struct ArchiveFooter
+    {
+        static constexpr uint32_t MagicValue = 0x5841544D; // "MTAX"
+
+        uint32_t Magic = MagicValue;
+        uint32_t Reserved0 = 0;
+        uint64_t IndexOffset = 0;
+        uint64_t EntryCount = 0;
+        uint64_t Reserved1 = 0;
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 32, "Archive header must stay 32 bytes");
+    static_assert(sizeof(ArchiveIndexEntry) == 48, "Archive index entry must stay 48 bytes");
+    static_assert(sizeof(ArchiveFooter) == 32, "Archive footer must stay 32 bytes");
+}
+
+#endif
@@ -0,0 +1,204 @@
+#include "MouseTrackerCore/Storage/TrajectoryArchiveWriter.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+#include "MouseTrackerCore/Platform/FileSync.h"
+#include <filesystem>
+#include <cstring>
+
+namespace Mt
+{
+    namespace
+    {
+        // fseek takes a long, which is 32 bits on Windows.
+        bool SeekTo(std::FILE* file, uint64_t offset)
+        {
+#ifdef _WIN32
+            return _fseeki64(file, static_cast<int64_t>(offset), SEEK_SET) == 0;
+#else
+            return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+    }
+
+    TrajectoryArchiveWriter::TrajectoryArchiveWriter(BinaryEncoding encoding, bool syncToDisk)
+    {
+        // Entries must carry their own length for recovery scans.
+        m_encoding = encoding == BinaryEncoding::Chunked ? BinaryEncoding::DeltaVarint : encoding;
+        m_syncToDisk = syncToDisk;
+    }
+
+    TrajectoryArchiveWriter::~TrajectoryArchiveWriter()
+    {
+        Close();
+    }
+
+    CodecResult TrajectoryArchiveWriter::Open(const std::string& filename)
+    {
+        Close();
+
+        std::error_code error;
+        CodecResult result = CodecResult::Ok();
+
+        if (std::filesystem::exists(filename, error))
+        {
+            TrajectoryArchive archive;
+            result = archive.Open(filename);
+
+            if (!result.Success)
+                return result;
+
+            m_index = archive.GetIndex();
+            m_end = archive.GetEntriesEnd();
+            archive.Close();
+
+            // The old index and footer are not truncated away: Windows refuses
+            // that while a viewer has the archive mapped. New entries overwrite
+            // them; the footer magic is cleared first, so until Close() readers
+            // scan the entries instead of trusting an index that is going away.
+            uint64_t size = std::filesystem::file_size(filename, error);
+
+            m_file = std::fopen(filename.c_str(), "r+b");
+
+            if (!m_file)
+                return FailOpen("Unable to open " + filename);
+
+            if (!error && size >= m_end + sizeof(ArchiveFooter))
+            {
+                uint32_t cleared = 0;
+
+                if (!SeekTo(m_file, size - sizeof(ArchiveFooter)) || std::fwrite(&cleared, sizeof(cleared), 1, m_file) != 1 || std::fflush(m_file) != 0)
+                    return FailOpen("Write failed for " + filename);
+            }
+
+            if (!SeekTo(m_file, m_end))
+                return FailOpen("Unable to open " + filename);
+        }
+        else
+        {
+            m_file = std::fopen(filename.c_str(), "wb");
+
+            if (!m_file)
+                return FailOpen("Unable to open " + filename);
+
+            ArchiveHeader header;
+            header.CreatedUs = MonotonicClock::WallClockUs();
+
+            if (std::fwrite(&header, sizeof(header), 1, m_file) != 1 || std::fflush(m_file) != 0)
+                return FailOpen("Write failed for " + filename);
+
+            m_end = sizeof(header);
+        }
+
+        m_filename = filename;
+
+        return result;
+    }
+
+    CodecResult TrajectoryArchiveWriter::Append(const TrajectorySpan& trajectory, uint64_t* id)
+    {
+        if (!m_file)
+            return CodecResult::Fail("Archive not open");
+
+        BinaryTrajectoryHeader header = BinaryTrajectoryCodec::MakeHeader(trajectory, m_encoding);
+        std::vector<uint8_t> payload = BinaryTrajectoryCodec::EncodePayload(trajectory, m_encoding);
+        header.PayloadBytes = payload.size();
+
+        m_buffer.resize(sizeof(header) + payload.size());
+        std::memcpy(m_buffer.data(), &header, sizeof(header));
+
+        if (!payload.empty())
+            std::memcpy(m_buffer.data() + sizeof(header), payload.data(), payload.size());
+
+        if (std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size())
+            return DiscardPartialEntry("Write failed for " + m_filename);
+
+        bool flushed = m_syncToDisk ? FileSync::FlushStream(m_file) : std::fflush(m_file) == 0;
+
+        if (!flushed)
+            return DiscardPartialEntry("Flush failed for " + m_filename);
+
+        ArchiveIndexEntry entry = TrajectoryArchive::Summarize(trajectory);
+        entry.Offset = m_end;
+        entry.Length = m_buffer.size();
+
+        if (id)
+            *id = m_index.size();
+
+        m_index.push_back(entry);
+        m_end += entry.Length;
+
+        return CodecResult::Ok();
+    }
+
+    // Leaves the writer closed, so IsOpen() is false and Close() writes no
+    // index into a file that was never set up.
+    CodecResult TrajectoryArchiveWriter::FailOpen(const std::string& error)
+    {
+        if (m_file)
+            std::fclose(m_file);
+
+        m_file = nullptr;
+        m_index.clear();
+        m_end = 0;
+
+        return CodecResult::Fail(error);
+    }
+
+    // A short write leaves part of an entry past m_end. Going back to m_end
+    // lets the next entry overwrite it, and Close() deals with any tail; if
+    // even the seek fails, writing stops and the archive is left for a scan.
+    CodecResult TrajectoryArchiveWriter::DiscardPartialEntry(const std::string& error)
+    {
+        if (SeekTo(m_file, m_end))
+            return CodecResult::Fail(error);
+
+        std::fclose(m_file);
+        m_file = nullptr;
+        m_index.clear();
+
+        return CodecResult::Fail(error + "; archive left without an index");
+    }
+
+    CodecResult TrajectoryArchiveWriter::Close()
+    {
+        if (!m_file)
+            return CodecResult::Ok();
+
+        // Bytes past the last entry are what is left of the index this
+        // session started from, or of a failed entry. They are cut off where
+        // the file allows it; where it does not (mapped by a viewer on
+        // Windows), the index goes after them, which readers accept.
+        uint64_t indexOffset = m_end;
+        bool written = std::fflush(m_file) == 0;
+
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(m_filename, error);
+
+        if (!error && size > m_end)
+        {
+            std::filesystem::resize_file(m_filename, m_end, error);
+
+            if (error)
+                indexOffset = size;
+        }
+
+        ArchiveFooter footer;
+        footer.IndexOffset = indexOffset;
+        footer.EntryCount = m_index.size();
+
+        written = written && SeekTo(m_file, indexOffset);
+        written = written && (m_index.empty() || std::fwrite(m_index.data(), sizeof(ArchiveIndexEntry), m_index.size(), m_file) == m_index.size());
+        written = written && std::fwrite(&footer, sizeof(footer), 1, m_file) == 1;
+        written = written && (m_syncToDisk ? FileSync::FlushStream(m_file) : std::fflush(m_file) == 0);
+        written = std::fclose(m_file) == 0 && written;
+
+        m_file = nullptr;
+        m_index.clear();
+
+        if (!written)
+            return CodecResult::Fail("Unable to write archive index to " + m_filename);
+
+        return CodecResult::Ok();
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYARCHIVEWRITER__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYARCHIVEWRITER__
+
+#include "MouseTrackerCore/Storage/TrajectoryArchiveFormat.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryFormat.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <string>
+#include <vector>
+#include <cstdio>
+
+namespace Mt
+{
+    // Appends trajectories to a .crsarc archive, creating it or continuing an
+    // existing one. Each Append writes one entry and costs O(entry); the index
+    // and footer are written once, by Close(). Until then readers recover the
+    // entries by scanning, so a killed writer loses nothing already appended.
+    class TrajectoryArchiveWriter
+    {
+        private:
+            std::FILE* m_file = nullptr;
+            std::string m_filename;
+            std::vector<ArchiveIndexEntry> m_index;
+            std::vector<uint8_t> m_buffer;
+            uint64_t m_end = 0;
+            BinaryEncoding m_encoding;
+            bool m_syncToDisk;
+
+        public:
+            explicit TrajectoryArchiveWriter(BinaryEncoding encoding = BinaryEncoding::DeltaVarint, bool syncToDisk = false);
+            TrajectoryArchiveWriter(const TrajectoryArchiveWriter&) = delete;
+            TrajectoryArchiveWriter& operator=(const TrajectoryArchiveWriter&) = delete;
+            ~TrajectoryArchiveWriter();
+
+            CodecResult Open(const std::string& filename);
+
+            // Writes the entry and returns its id through `id` when given. A failed
+            // append leaves the archive as it was before it.
+            CodecResult Append(const TrajectorySpan& trajectory, uint64_t* id = nullptr);
+
+            // Writes the index and footer and closes the file.
+            CodecResult Close();
+
+            bool IsOpen() const
+            {
+                return m_file != nullptr;
+            }
+
+            size_t GetCount() const
+            {
+                return m_index.size();
+            }
+
+            // Bytes in the file so far, excluding the index written by Close.
+            uint64_t GetSize() const
+            {
+                return m_end;
+            }
+
+            const std::string& GetFilename() const
+            {
+                return m_filename;
+            }
+
+        private:
+            CodecResult FailOpen(const std::string& error);
+            CodecResult DiscardPartialEntry(const std::string& error);
+    };
+}
+
+#endif
@@ -0,0 +1,300 @@
+#include "MouseTrackerCore/Storage/TrajectoryRecovery.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchiveWriter.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Platform/MappedFile.h"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+namespace Mt
+{
+    namespace
+    {
+        // Fills the report from a mapped binary file; with salvage set, also
+        // decodes every intact sample into it.
+        void InspectBinary(const MappedFile& file, TrajectoryVerifyReport& report, Trajectory* salvage)
+        {
+            BinaryTrajectoryHeader header;
+
+            if (file.Size() < sizeof(header))
+            {
+                report.Error = "Truncated header";
+
+                return;
+            }
+
+            std::memcpy(&header, file.Data(), sizeof(header));
+            report.Error = header.Validate();
+
+            if (!report.Error.empty())
+                return;
+
+            if (header.HeaderSize > file.Size())
+            {
+                report.Error = "Truncated header";
+
+                return;
+            }
+
+            const uint8_t* payload = file.Data() + header.HeaderSize;
+            size_t available = file.Size() - header.HeaderSize;
+            Trajectory scratch;
+            Trajectory& decoded = salvage ? *salvage : scratch;
+
+            report.Format = BinaryTrajectoryCodec(header.GetEncoding()).GetName();
+            report.ExpectedSamples = header.SampleCount;
+
+            if (header.GetEncoding() == BinaryEncoding::Chunked)
+            {
+                report.Checksummed = header.HasChunkChecksums();
+                report.Closed = header.PayloadBytes > 0 || available == 0;
+                report.Chunks = BinaryTrajectoryCodec::ScanChunks(header, payload, available, [](const BinaryChunkHeader&, const uint8_t*) {});
+                report.Samples = report.Chunks.Samples;
+
+                // Decoding walks the chunks again; recovery is rare, verification is not.
+                if (salvage)
+                    BinaryTrajectoryCodec::DecodePayload(header, payload, available, decoded);
+
+                return;
+            }
+
+            if (header.GetEncoding() == BinaryEncoding::Fixed)
+            {
+                size_t count = static_cast<size_t>(header.SampleCount);
+                uint64_t expected = header.PayloadBytes;
+
+                report.MissingBytes = expected > available ? expected - available : 0;
+                report.Samples = (std::min)(static_cast<uint64_t>(count), static_cast<uint64_t>(available / sizeof(Point)));
+
+                // Points come first, so a cut-off file keeps a prefix of them;
+                // timestamps survive only when complete.
+                if (salvage)
+                {
+                    decoded.Clear();
+                    decoded.SetMetadata(header.GetMetadata());
+                    decoded.GetPoints().resize(static_cast<size_t>(report.Samples));
+
+                    if (report.Samples > 0)
+                        std::memcpy(decoded.GetPoints().data(), payload, static_cast<size_t>(report.Samples) * sizeof(Point));
+
+                    if (header.HasTimestamps() && report.MissingBytes == 0 && count > 0)
+                    {
+                        decoded.GetTimestamps().resize(count);
+                        std::memcpy(decoded.GetTimestamps().data(), payload + count * sizeof(Point), count * sizeof(int64_t));
+                    }
+                }
+
+                return;
+            }
+
+            // Delta and predictive payloads decode front to back; a failure keeps the prefix.
+            report.MissingBytes = header.PayloadBytes > available ? header.PayloadBytes - available : 0;
+            BinaryTrajectoryCodec::DecodePayload(header, payload, static_cast<size_t>((std::min)(static_cast<uint64_t>(available), header.PayloadBytes)), decoded);
+
+            if (!decoded.HasTimestamps())
+                decoded.GetTimestamps().clear();
+
+            report.Samples = decoded.Size();
+        }
+
+        void InspectText(const std::string& filename, TrajectoryVerifyReport& report, Trajectory& decoded)
+        {
+            report.Format = "text";
+
+            CodecResult result = TextTrajectoryCodec().Read(filename, decoded);
+
+            if (!result.Success)
+            {
+                report.Error = result.Error;
+
+                return;
+            }
+
+            report.Samples = decoded.Size();
+            report.MalformedLines = result.MalformedRecords;
+
+            std::ifstream file(filename, std::ios::binary | std::ios::ate);
+            std::streamoff size = file.tellg();
+            char last = '\n';
+
+            if (size > 0)
+            {
+                file.seekg(size - 1);
+                file.get(last);
+            }
+
+            report.UnterminatedLastLine = last != '\n';
+        }
+
+        // Text or binary, told apart by the binary magic like every loader.
+        void Inspect(const std::string& filename, TrajectoryVerifyReport& report, Trajectory* salvage)
+        {
+            MappedFile file;
+            std::string error;
+
+            if (!file.Open(filename, error))
+            {
+                report.Error = error;
+
+                return;
+            }
+
+            if (IsBinaryTrajectory(file.Data(), file.Size()))
+            {
+                InspectBinary(file, report, salvage);
+
+                return;
+            }
+
+            file.Close();
+
+            Trajectory scratch;
+            InspectText(filename, report, salvage ? *salvage : scratch);
+        }
+
+        void InspectArchive(const std::string& filename, TrajectoryVerifyReport& report, TrajectoryArchiveWriter* salvage)
+        {
+            report.Format = "archive";
+
+            TrajectoryArchive archive;
+            CodecResult result = archive.Open(filename);
+
+            if (!result.Success)
+            {
+                report.Error = result.Error;
+
+                return;
+            }
+
+            // Warnings mean the index was missing and rebuilt by scanning.
+            report.Closed = result.Warnings.empty();
+            report.Entries = archive.GetCount();
+
+            Trajectory entry;
+
+            for (size_t id = 0; id < archive.GetCount(); id++)
+            {
+                if (!archive.Read(id, entry).Success)
+                {
+                    report.DamagedEntries++;
+
+                    continue;
+                }
+
+                report.Samples += entry.Size();
+
+                if (salvage)
+                    salvage->Append(entry);
+            }
+        }
+    }
+
+    std::string TrajectoryVerifyReport::Describe() const
+    {
+        if (!Error.empty())
+            return "unreadable: " + Error;
+
+        if (IsIntact())
+            return "ok, " + std::to_string(Samples) + " samples";
+
+        std::vector<std::string> problems;
+
+        if (!Closed)
+            problems.push_back(Format == "archive" ? "index missing" : "recording not closed");
+
+        if (Chunks.CorruptChunks > 0)
+            problems.push_back(std::to_string(Chunks.CorruptChunks) + " corrupt chunks (" + std::to_string(Chunks.LostSamples) + " samples)");
+
+        if (Chunks.SkippedBytes > 0)
+            problems.push_back(std::to_string(Chunks.SkippedBytes) + " unreadable bytes");
+
+        if (Chunks.TrailingBytes > 0)
+            problems.push_back("torn tail of " + std::to_string(Chunks.TrailingBytes) + " bytes");
+
+        if (Chunks.IsDamaged())
+            problems.push_back("first damage at payload byte " + std::to_string(Chunks.FirstDamageOffset));
+
+        if (MissingBytes > 0)
+            problems.push_back(std::to_string(MissingBytes) + " payload bytes missing");
+
+        if (MalformedLines > 0)
+            problems.push_back(std::to_string(MalformedLines) + " malformed lines");
+
+        if (UnterminatedLastLine)
+            problems.push_back("last line unterminated (file cut off?)");
+
+        if (DamagedEntries > 0)
+            problems.push_back(std::to_string(DamagedEntries) + " of " + std::to_string(Entries) + " entries damaged");
+
+        if (ExpectedSamples > 0 && Samples != ExpectedSamples)
+            problems.push_back("header promises " + std::to_string(ExpectedSamples) + " samples");
+
+        std::string description;
+
+        for (const auto& problem : problems)
+            description += problem + "; ";
+
+        return description + std::to_string(Samples) + " samples recoverable";
+    }
+
+    TrajectoryVerifyReport TrajectoryRecovery::Verify(const std::string& filename)
+    {
+        TrajectoryVerifyReport report;
+
+        if (TrajectoryArchive::IsArchive(filename))
+            InspectArchive(filename, report, nullptr);
+        else
+            Inspect(filename, report, nullptr);
+
+        return report;
+    }
+
+    CodecResult TrajectoryRecovery::Recover(const std::string& input, const std::string& output, TrajectoryVerifyReport* report)
+    {
+        TrajectoryVerifyReport local;
+        TrajectoryVerifyReport& target = report ? *report : local;
+        std::error_code error;
+
+        // The input stays mapped while the output is written.
+        if (std::filesystem::equivalent(input, output, error))
+            return CodecResult::Fail("Recover into a new file, not over " + input);
+
+        if (TrajectoryArchive::IsArchive(input))
+        {
+            if (!TrajectoryArchive::IsArchive(output))
+                return CodecResult::Fail("An archive is recovered into another .crsarc file");
+
+            std::filesystem::remove(output, error);
+
+            TrajectoryArchiveWriter writer;
+            CodecResult result = writer.Open(output);
+
+            if (!result.Success)
+                return result;
+
+            InspectArchive(input, target, &writer);
+
+            CodecResult closed = writer.Close();
+
+            if (!target.Error.empty())
+            {
+                std::filesystem::remove(output, error);
+
+                return CodecResult::Fail(target.Error + ": " + input);
+            }
+
+            return closed;
+        }
+
+        Trajectory salvaged;
+        Inspect(input, target, &salvaged);
+
+        if (!target.Error.empty())
+            return CodecResult::Fail(target.Error + ": " + input);
+
+        return TrajectoryIo::Save(output, salvaged);
+    }
+}
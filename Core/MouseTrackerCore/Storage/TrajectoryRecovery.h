@@ -0,0 +1,74 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYRECOVERY__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYRECOVERY__
+
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include <string>
+#include <cstdint>
+
+namespace Mt
+{
+    struct TrajectoryVerifyReport
+    {
+        // Codec name ("text", "binary", "binary-delta", "binary-chunked", "binary-predictive") or "archive".
+        std::string Format;
+
+        // Set when nothing could be read at all (missing file, bad header).
+        std::string Error;
+
+        // Chunked files written with per-chunk CRC-32s.
+        bool Checksummed = false;
+
+        // False for a chunked recording whose writer never finished, or an
+        // archive without its index.
+        bool Closed = true;
+
+        // Samples that are intact, i.e. what Recover keeps.
+        uint64_t Samples = 0;
+
+        // Sample count stored in a binary header; 0 when unknown.
+        uint64_t ExpectedSamples = 0;
+
+        // Chunked files: the chunk walk.
+        ChunkScanResult Chunks;
+
+        // Fixed and delta files: payload bytes the header promises but the file lacks.
+        uint64_t MissingBytes = 0;
+
+        // Text files: lines that are not "x;y", and a last line without its
+        // newline, which the writer never leaves (the file was likely cut off).
+        uint64_t MalformedLines = 0;
+        bool UnterminatedLastLine = false;
+
+        // Archives.
+        uint64_t Entries = 0;
+        uint64_t DamagedEntries = 0;
+
+        bool IsIntact() const
+        {
+            return Error.empty() && Closed && !Chunks.IsDamaged() && MissingBytes == 0 &&
+                MalformedLines == 0 && !UnterminatedLastLine && DamagedEntries == 0 &&
+                (ExpectedSamples == 0 || Samples == ExpectedSamples);
+        }
+
+        // One line: "ok" or what is wrong and how many samples survive.
+        std::string Describe() const;
+    };
+
+    // Integrity checks beyond what a load reports, and salvage of damaged
+    // files. Binary files are memory-mapped and walked in place, so verifying
+    // a large recording copies nothing.
+    class TrajectoryRecovery
+    {
+        public:
+            static TrajectoryVerifyReport Verify(const std::string& filename);
+
+            // Writes every intact sample of input to output, encoded by the
+            // output's extension (an archive is rewritten with its readable
+            // entries, so its output must be a .crsarc). Fails only when
+            // nothing could be read.
+            static CodecResult Recover(const std::string& input, const std::string& output, TrajectoryVerifyReport* report = nullptr);
+    };
+}
+
+#endif
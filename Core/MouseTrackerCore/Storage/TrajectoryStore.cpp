@@ -0,0 +1,481 @@
+#include "MouseTrackerCore/Storage/TrajectoryStore.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryCodec.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Codecs/XxHash64.h"
+#include "MouseTrackerCore/Dataset/DirectoryProcessor.h"
+#include "MouseTrackerCore/Platform/FileSync.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Threading/ThreadPool.h"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+namespace Mt
+{
+    namespace
+    {
+        constexpr size_t MaxReportedErrors = 20;
+
+        // Splits "a;b;c" in place; false when the line has a different field count.
+        bool SplitFields(const std::string& line, std::vector<std::string>& fields, size_t count)
+        {
+            fields.clear();
+            size_t start = 0;
+
+            while (true)
+            {
+                size_t end = line.find(';', start);
+                fields.push_back(line.substr(start, end - start));
+
+                if (end == std::string::npos)
+                    break;
+
+                start = end + 1;
+            }
+
+            return fields.size() == count && !fields[0].empty();
+        }
+
+        bool ParseUnsigned(const std::string& text, uint64_t& value)
+        {
+            auto parsed = std::from_chars(text.data(), text.data() + text.size(), value);
+
+            return parsed.ec == std::errc() && parsed.ptr == text.data() + text.size();
+        }
+
+        bool IsValidName(const std::string& name)
+        {
+            return !name.empty() && name.find_first_of(";\r\n") == std::string::npos;
+        }
+    }
+
+    TrajectoryStore::TrajectoryStore(TrajectoryStoreSettings settings)
+        : m_settings(settings)
+    {
+    }
+
+    CodecResult TrajectoryStore::Open(const std::string& directory)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::error_code error;
+
+        std::filesystem::create_directories(std::filesystem::path(directory) / "objects", error);
+
+        if (error)
+            return CodecResult::Fail("Unable to create store " + directory + ": " + error.message());
+
+        m_directory = directory;
+        m_objects.clear();
+        m_references.clear();
+        m_stats = TrajectoryStoreStats();
+
+        CodecResult result = CodecResult::Ok();
+        std::vector<std::string> fields;
+        std::string line;
+
+        std::ifstream objects(std::filesystem::path(directory) / ObjectsLog);
+
+        while (std::getline(objects, line))
+        {
+            ObjectInfo info;
+
+            if (line.empty())
+                continue;
+
+            if (!SplitFields(line, fields, 3) || !ParseUnsigned(fields[1], info.Samples) || !ParseUnsigned(fields[2], info.Bytes))
+            {
+                result.MalformedRecords++;
+
+                continue;
+            }
+
+            if (m_objects.emplace(fields[0], info).second)
+            {
+                m_stats.Objects++;
+                m_stats.StoredSamples += info.Samples;
+                m_stats.StoredBytes += info.Bytes;
+            }
+        }
+
+        std::ifstream references(std::filesystem::path(directory) / ReferencesLog);
+
+        while (std::getline(references, line))
+        {
+            if (line.empty())
+                continue;
+
+            if (!SplitFields(line, fields, 2) || m_objects.find(fields[1]) == m_objects.end())
+            {
+                result.MalformedRecords++;
+
+                continue;
+            }
+
+            Reference(fields[0], fields[1]);
+        }
+
+        if (result.MalformedRecords > 0)
+            result.Warnings.push_back("Skipped " + std::to_string(result.MalformedRecords) + " malformed log lines in " + directory);
+
+        return result;
+    }
+
+    CodecResult TrajectoryStore::Put(const std::string& name, const TrajectorySpan& trajectory, bool* duplicate)
+    {
+        return PutHashed(name, trajectory, Hash(trajectory), duplicate);
+    }
+
+    CodecResult TrajectoryStore::PutHashed(const std::string& name, const TrajectorySpan& trajectory, uint64_t hash, bool* duplicate)
+    {
+        if (!IsValidName(name))
+            return CodecResult::Fail("Invalid name \"" + name + "\"");
+
+        bool shared = false;
+        std::string id;
+
+        for (size_t collision = 0; ; collision++)
+        {
+            id = MakeObjectId(hash, collision);
+
+            bool stored = false;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                // A second thread putting the same samples waits for the
+                // first to publish (or give up on) the object.
+                m_written.wait(lock, [this, &id]() { return m_writing.find(id) == m_writing.end(); });
+
+                stored = m_objects.find(id) != m_objects.end();
+
+                if (!stored)
+                    m_writing.insert(id);
+            }
+
+            if (!stored)
+            {
+                // Encoding, writing and syncing run unlocked, so distinct
+                // trajectories are stored in parallel.
+                ObjectInfo info;
+                info.Samples = trajectory.Size();
+
+                CodecResult result = CodecResult::Ok();
+
+                // The reservation must be released whatever happens, or
+                // every later Put of this id would wait forever.
+                try
+                {
+                    result = WriteObject(id, trajectory, info.Bytes);
+                }
+                catch (const std::exception& e)
+                {
+                    result = CodecResult::Fail(e.what());
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                m_writing.erase(id);
+                m_written.notify_all();
+
+                if (!result.Success)
+                    return result;
+
+                if (!AppendLine(ObjectsLog, id + ";" + std::to_string(info.Samples) + ";" + std::to_string(info.Bytes)))
+                    return CodecResult::Fail("Unable to append to " + std::string(ObjectsLog) + " in " + m_directory);
+
+                m_objects.emplace(id, info);
+                m_stats.Objects++;
+                m_stats.StoredSamples += info.Samples;
+                m_stats.StoredBytes += info.Bytes;
+
+                break;
+            }
+
+            // Stored objects never change, so the comparison runs unlocked.
+            if (!m_settings.VerifyDuplicates || Matches(id, trajectory))
+            {
+                shared = true;
+
+                break;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!AppendLine(ReferencesLog, name + ";" + id))
+            return CodecResult::Fail("Unable to append to " + std::string(ReferencesLog) + " in " + m_directory);
+
+        Reference(name, id);
+
+        if (duplicate)
+            *duplicate = shared;
+
+        return CodecResult::Ok();
+    }
+
+    CodecResult TrajectoryStore::Get(const std::string& name, Trajectory& trajectory) const
+    {
+        std::string id = GetObjectId(name);
+
+        if (id.empty())
+            return CodecResult::Fail("No trajectory named " + name);
+
+        return BinaryTrajectoryCodec().Read(GetObjectPath(id), trajectory);
+    }
+
+    StoreIngestSummary TrajectoryStore::Ingest(const std::string& directory, size_t threads)
+    {
+        StoreIngestSummary summary;
+        auto start = std::chrono::steady_clock::now();
+
+        std::filesystem::path root(directory);
+        std::error_code storeError;
+        std::filesystem::path store = std::filesystem::weakly_canonical(m_directory, storeError);
+        std::vector<std::filesystem::path> files;
+        std::error_code error;
+
+        for (std::filesystem::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error))
+        {
+            std::error_code entryError;
+
+            // Never feed the store its own objects.
+            if (it->is_directory(entryError) && std::filesystem::weakly_canonical(it->path(), entryError) == store)
+            {
+                it.disable_recursion_pending();
+
+                continue;
+            }
+
+            std::string path = it->path().string();
+
+            if (it->is_regular_file(entryError) && !TrajectoryArchive::IsArchive(path) && DirectoryProcessor::IsTrajectoryFile(path))
+                files.push_back(it->path());
+        }
+
+        if (error)
+            summary.Errors.push_back(directory + ": " + error.message());
+
+        std::sort(files.begin(), files.end());
+
+        std::mutex summaryMutex;
+
+        {
+            ThreadPool pool(threads);
+            summary.Threads = pool.GetThreadCount();
+
+            for (const auto& file : files)
+            {
+                pool.Submit([&, file]()
+                {
+                    std::string name = file.lexically_relative(root).generic_string();
+                    MappedTrajectory trajectory;
+                    CodecResult result = trajectory.Open(file.string());
+                    const TrajectorySpan& span = trajectory.GetSpan();
+
+                    uint64_t bytesHashed = span.Size() * (sizeof(Point) + (span.HasTimestamps() ? sizeof(int64_t) : 0));
+                    auto hashStart = std::chrono::steady_clock::now();
+                    uint64_t hash = result.Success ? Hash(span) : 0;
+                    double hashSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - hashStart).count();
+
+                    bool duplicate = false;
+
+                    if (result.Success)
+                        result = PutHashed(name, span, hash, &duplicate);
+
+                    std::error_code sizeError;
+                    uint64_t size = std::filesystem::file_size(file, sizeError);
+
+                    std::lock_guard<std::mutex> lock(summaryMutex);
+
+                    summary.Files++;
+                    summary.BytesRead += sizeError ? 0 : size;
+
+                    if (!result.Success)
+                    {
+                        summary.Failed++;
+
+                        if (summary.Errors.size() < MaxReportedErrors)
+                            summary.Errors.push_back(file.string() + ": " + result.Error);
+
+                        return;
+                    }
+
+                    summary.Samples += span.Size();
+                    summary.Duplicates += duplicate ? 1 : 0;
+                    summary.BytesHashed += bytesHashed;
+                    summary.HashSeconds += hashSeconds;
+                });
+            }
+
+            pool.WaitIdle();
+        }
+
+        summary.ElapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return summary;
+    }
+
+    bool TrajectoryStore::Contains(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_references.find(name) != m_references.end();
+    }
+
+    std::string TrajectoryStore::GetObjectId(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_references.find(name);
+
+        return it != m_references.end() ? it->second : std::string();
+    }
+
+    std::vector<std::string> TrajectoryStore::GetNames() const
+    {
+        std::vector<std::string> names;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            names.reserve(m_references.size());
+
+            for (const auto& reference : m_references)
+                names.push_back(reference.first);
+        }
+
+        std::sort(names.begin(), names.end());
+
+        return names;
+    }
+
+    TrajectoryStoreStats TrajectoryStore::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_stats;
+    }
+
+    uint64_t TrajectoryStore::Hash(const TrajectorySpan& trajectory)
+    {
+        const TrajectoryMetadata& metadata = trajectory.GetMetadata();
+        uint64_t count = trajectory.Size();
+        uint32_t hasTimestamps = trajectory.HasTimestamps() ? 1 : 0;
+
+        // Fixed layout, so the hash does not depend on struct padding.
+        uint8_t header[32];
+        std::memcpy(header, &count, 8);
+        std::memcpy(header + 8, &hasTimestamps, 4);
+        std::memcpy(header + 12, &metadata.PeriodUs, 4);
+        std::memcpy(header + 16, &metadata.StartTimeUs, 8);
+        std::memcpy(header + 24, &metadata.ScreenWidth, 4);
+        std::memcpy(header + 28, &metadata.ScreenHeight, 4);
+
+        XxHash64 hash;
+        hash.Update(header, sizeof(header));
+        hash.Update(trajectory.Points, trajectory.Size() * sizeof(Point));
+
+        if (hasTimestamps)
+            hash.Update(trajectory.Timestamps, trajectory.Size() * sizeof(int64_t));
+
+        return hash.Digest();
+    }
+
+    CodecResult TrajectoryStore::WriteObject(const std::string& id, const TrajectorySpan& trajectory, uint64_t& bytes) const
+    {
+        std::filesystem::path path(GetObjectPath(id));
+        std::string temporary = path.string() + ".part";
+        std::error_code error;
+
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        CodecResult result = BinaryTrajectoryCodec(m_settings.Encoding).Write(temporary, trajectory);
+
+        if (result.Success && m_settings.SyncToDisk && !FileSync::FlushFile(temporary))
+            result = CodecResult::Fail("Sync failed for " + path.string());
+
+        if (result.Success)
+        {
+            bytes = std::filesystem::file_size(temporary, error);
+            std::filesystem::rename(temporary, path, error);
+
+            if (error)
+                result = CodecResult::Fail("Unable to move " + temporary + " to " + path.string() + ": " + error.message());
+            else if (m_settings.SyncToDisk)
+                FileSync::FlushDirectory(path.parent_path().string());
+        }
+
+        if (!result.Success)
+            std::filesystem::remove(temporary, error);
+
+        return result;
+    }
+
+    bool TrajectoryStore::Matches(const std::string& id, const TrajectorySpan& trajectory) const
+    {
+        MappedTrajectory stored;
+
+        if (!stored.Open(GetObjectPath(id)).Success)
+            return false;
+
+        const TrajectorySpan& span = stored.GetSpan();
+        const TrajectoryMetadata& left = span.GetMetadata();
+        const TrajectoryMetadata& right = trajectory.GetMetadata();
+
+        if (span.Size() != trajectory.Size() || span.HasTimestamps() != trajectory.HasTimestamps() ||
+            left.PeriodUs != right.PeriodUs || left.StartTimeUs != right.StartTimeUs ||
+            left.ScreenWidth != right.ScreenWidth || left.ScreenHeight != right.ScreenHeight)
+            return false;
+
+        if (span.Empty())
+            return true;
+
+        if (std::memcmp(span.Points, trajectory.Points, span.Size() * sizeof(Point)) != 0)
+            return false;
+
+        return !span.HasTimestamps() || std::memcmp(span.Timestamps, trajectory.Timestamps, span.Size() * sizeof(int64_t)) == 0;
+    }
+
+    std::string TrajectoryStore::GetObjectPath(const std::string& id) const
+    {
+        return (std::filesystem::path(m_directory) / "objects" / id.substr(0, 2) / (id + BinaryTrajectoryCodec().GetExtension())).string();
+    }
+
+    bool TrajectoryStore::AppendLine(const char* log, const std::string& line) const
+    {
+        // Built in full first so the line goes out in one append.
+        std::string record = line + "\n";
+
+        std::ofstream file(std::filesystem::path(m_directory) / log, std::ios::app | std::ios::binary);
+        file.write(record.data(), static_cast<std::streamsize>(record.size()));
+
+        return file.good();
+    }
+
+    void TrajectoryStore::Reference(const std::string& name, const std::string& id)
+    {
+        auto inserted = m_references.emplace(name, id);
+
+        if (!inserted.second)
+        {
+            m_stats.ReferencedSamples -= m_objects[inserted.first->second].Samples;
+            inserted.first->second = id;
+        }
+        else
+        {
+            m_stats.References++;
+        }
+
+        m_stats.ReferencedSamples += m_objects[id].Samples;
+    }
+
+    std::string TrajectoryStore::MakeObjectId(uint64_t hash, size_t collision)
+    {
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+
+        return collision == 0 ? std::string(text) : std::string(text) + "-" + std::to_string(collision);
+    }
+}
@@ -0,0 +1,161 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYSTORE__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYSTORE__
+
+#include "MouseTrackerCore/Codecs/CodecResult.h"
+#include "MouseTrackerCore/Codecs/BinaryTrajectoryFormat.h"
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace Mt
+{
+    struct TrajectoryStoreSettings
+    {
+        // Encoding of the stored copies.
+        BinaryEncoding Encoding = BinaryEncoding::DeltaVarint;
+
+        // Compares a trajectory whose hash is already stored with the stored
+        // copy before sharing it, so a 64-bit hash collision can never merge
+        // two different trajectories. Costs one read of the stored copy per
+        // duplicate.
+        bool VerifyDuplicates = true;
+
+        bool SyncToDisk = false;
+    };
+
+    struct TrajectoryStoreStats
+    {
+        uint64_t References = 0;
+        uint64_t Objects = 0;
+
+        // Samples over every name, and over the unique trajectories stored.
+        uint64_t ReferencedSamples = 0;
+        uint64_t StoredSamples = 0;
+
+        uint64_t StoredBytes = 0;
+
+        // Samples referenced per sample stored; 1 without duplicates.
+        double GetDedupRatio() const
+        {
+            return StoredSamples > 0 ? static_cast<double>(ReferencedSamples) / StoredSamples : 0.0;
+        }
+    };
+
+    struct StoreIngestSummary
+    {
+        uint64_t Files = 0;
+        uint64_t Failed = 0;
+        uint64_t Duplicates = 0;
+        uint64_t BytesRead = 0;
+        uint64_t Samples = 0;
+        size_t Threads = 0;
+        double ElapsedSeconds = 0.0;
+
+        // Column bytes hashed and the time spent hashing, summed over threads.
+        uint64_t BytesHashed = 0;
+        double HashSeconds = 0.0;
+
+        // First few failures, "path: reason".
+        std::vector<std::string> Errors;
+
+        double GetMegabytesPerSecond() const
+        {
+            return ElapsedSeconds > 0.0 ? BytesRead / (1024.0 * 1024.0) / ElapsedSeconds : 0.0;
+        }
+
+        // Hash throughput of one thread.
+        double GetHashMegabytesPerSecond() const
+        {
+            return HashSeconds > 0.0 ? BytesHashed / (1024.0 * 1024.0) / HashSeconds : 0.0;
+        }
+    };
+
+    // Content-addressed store: every distinct trajectory is kept once, under
+    // the XXH64 hash of its samples and metadata, and any number of names
+    // refer to it. Re-ingesting a copied folder adds names, not data.
+    //
+    //   <directory>/objects/<2 hex>/<16 hex>[-n].crsbin - one per distinct trajectory
+    //   <directory>/objects.log - "id;samples;bytes" per stored trajectory
+    //   <directory>/references.log - "name;id" per Put, the last line of a name wins
+    //
+    // Both logs are only appended to, one whole line per write, so a killed
+    // ingest leaves at most an object file nobody refers to yet. Ids differ
+    // from the hash only after a verified collision (suffix -1, -2, ...).
+    class TrajectoryStore
+    {
+        private:
+            struct ObjectInfo
+            {
+                uint64_t Samples = 0;
+                uint64_t Bytes = 0;
+            };
+
+            TrajectoryStoreSettings m_settings;
+            std::string m_directory;
+            std::unordered_map<std::string, ObjectInfo> m_objects;
+            std::unordered_map<std::string, std::string> m_references;
+            TrajectoryStoreStats m_stats;
+            mutable std::mutex m_mutex;
+
+            // Ids reserved by a Put that is still writing the object; others
+            // putting the same id wait on m_written instead of writing it too.
+            std::unordered_set<std::string> m_writing;
+            std::condition_variable m_written;
+
+        public:
+            static constexpr const char* ObjectsLog = "objects.log";
+            static constexpr const char* ReferencesLog = "references.log";
+
+            explicit TrajectoryStore(TrajectoryStoreSettings settings = TrajectoryStoreSettings());
+            TrajectoryStore(const TrajectoryStore&) = delete;
+            TrajectoryStore& operator=(const TrajectoryStore&) = delete;
+
+            // Opens the store in `directory`, creating it if needed.
+            CodecResult Open(const std::string& directory);
+
+            // Stores the trajectory under `name` unless an identical one is
+            // stored already, replacing what the name referred to. Names must
+            // not contain ';' or line breaks. Safe from any thread.
+            CodecResult Put(const std::string& name, const TrajectorySpan& trajectory, bool* duplicate = nullptr);
+
+            CodecResult Get(const std::string& name, Trajectory& trajectory) const;
+
+            // Puts every trajectory file under `directory` across a thread
+            // pool, named by its path relative to the directory.
+            StoreIngestSummary Ingest(const std::string& directory, size_t threads = 0);
+
+            bool Contains(const std::string& name) const;
+
+            // Id of the stored trajectory `name` refers to, or empty.
+            std::string GetObjectId(const std::string& name) const;
+
+            // Sorted.
+            std::vector<std::string> GetNames() const;
+
+            TrajectoryStoreStats GetStats() const;
+
+            std::string GetDirectory() const
+            {
+                return m_directory;
+            }
+
+            // XXH64 over the sample count, metadata, points and timestamps.
+            static uint64_t Hash(const TrajectorySpan& trajectory);
+
+        private:
+            CodecResult PutHashed(const std::string& name, const TrajectorySpan& trajectory, uint64_t hash, bool* duplicate);
+            CodecResult WriteObject(const std::string& id, const TrajectorySpan& trajectory, uint64_t& bytes) const;
+            bool Matches(const std::string& id, const TrajectorySpan& trajectory) const;
+            std::string GetObjectPath(const std::string& id) const;
+            bool AppendLine(const char* log, const std::string& line) const;
+            void Reference(const std::string& name, const std::string& id);
+            static std::string MakeObjectId(uint64_t hash, size_t collision);
+    };
+}
+
+#endif
@@ -0,0 +1,242 @@
+#include "MouseTrackerCore/Storage/TrajectoryWriteService.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Dataset/DatasetManifest.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include "MouseTrackerCore/Platform/FileSync.h"
+#include <filesystem>
+#include <chrono>
+
+namespace Mt
+{
+    TrajectoryWriteService::TrajectoryWriteService(TrajectoryWriteSettings settings)
+        : m_settings(std::move(settings)), m_queue(m_settings.QueueCapacity)
+    {
+        m_worker = std::thread([this]() { this->WorkerLoop(); });
+    }
+
+    TrajectoryWriteService::~TrajectoryWriteService()
+    {
+        Shutdown();
+    }
+
+    bool TrajectoryWriteService::Submit(TrajectoryWriteJob&& job)
+    {
+        if (!job.Trajectory)
+            return false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_idleMutex);
+            m_pending++;
+        }
+
+        bool accepted = m_queue.TryPush(std::move(job));
+
+        if (!accepted && !m_queue.IsClosed())
+        {
+            // TryPush leaves the job intact when it fails, so it can be pushed again.
+            auto start = std::chrono::steady_clock::now();
+
+            accepted = m_queue.Push(std::move(job));
+
+            m_blockedSubmits++;
+            m_blockedUs += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        if (!accepted)
+        {
+            m_rejected++;
+
+            std::lock_guard<std::mutex> lock(m_idleMutex);
+            m_pending--;
+            m_idle.notify_all();
+
+            return false;
+        }
+
+        m_submitted++;
+
+        return true;
+    }
+
+    void TrajectoryWriteService::Drain()
+    {
+        std::unique_lock<std::mutex> lock(m_idleMutex);
+
+        m_idle.wait(lock, [this]() { return m_pending == 0; });
+    }
+
+    void TrajectoryWriteService::Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(m_shutdownMutex);
+
+        m_queue.Close();
+
+        if (m_worker.joinable())
+            m_worker.join();
+    }
+
+    TrajectoryWriteStats TrajectoryWriteService::GetStats() const
+    {
+        TrajectoryWriteStats stats;
+        stats.Submitted = m_submitted;
+        stats.Written = m_written;
+        stats.Failed = m_failed;
+        stats.Rejected = m_rejected;
+        stats.BlockedSubmits = m_blockedSubmits;
+        stats.BlockedUs = m_blockedUs;
+        stats.BytesWritten = m_bytesWritten;
+        stats.SamplesSubmitted = m_samplesSubmitted;
+        stats.SamplesWritten = m_samplesWritten;
+        stats.QueueHighWatermark = m_queue.GetHighWatermark();
+        stats.QueueCapacity = m_queue.GetCapacity();
+
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        stats.Pending = m_pending;
+
+        return stats;
+    }
+
+    CodecResult TrajectoryWriteService::WriteFile(const std::string& filename, const TrajectorySpan& trajectory, bool syncToDisk, bool createDirectories)
+    {
+        std::filesystem::path path(filename);
+        std::filesystem::path directory = path.parent_path();
+        std::error_code error;
+
+        if (createDirectories && !directory.empty())
+            std::filesystem::create_directories(directory, error);
+
+        // The codec is chosen by the final name, not the temporary one.
+        const ITrajectoryCodec* codec = TrajectoryCodecRegistry::GetInstance().GetCodecForFile(filename);
+        std::string temporary = filename + ".part";
+
+        CodecResult result = codec->Write(temporary, trajectory);
+
+        if (result.Success && syncToDisk && !FileSync::FlushFile(temporary))
+            result = CodecResult::Fail("Sync failed for " + filename);
+
+        if (result.Success)
+        {
+            std::filesystem::rename(temporary, path, error);
+
+            if (error)
+                result = CodecResult::Fail("Unable to move " + temporary + " to " + filename + ": " + error.message());
+            else if (syncToDisk)
+                FileSync::FlushDirectory(directory.string());
+        }
+
+        if (!result.Success)
+            std::filesystem::remove(temporary, error);
+
+        return result;
+    }
+
+    void TrajectoryWriteService::WorkerLoop()
+    {
+        TrajectoryWriteJob job;
+
+        while (m_queue.Pop(job))
+        {
+            TrajectorySpan span = job.Trajectory->GetSpan();
+            Trajectory simplified;
+
+            if (job.Simplify.IsEnabled())
+            {
+                simplified = TrajectorySimplifier::Simplify(span, job.Simplify);
+                span = simplified;
+            }
+
+            bool archive = TrajectoryArchive::IsArchive(job.Filename);
+            CodecResult result = archive
+                ? AppendToArchive(job.Filename, span)
+                : WriteFile(job.Filename, span, m_settings.SyncToDisk, m_settings.CreateDirectories);
+
+            TrajectoryJobResult jobResult;
+            jobResult.SamplesSubmitted = job.Trajectory->GetSpan().Size();
+
+            if (result.Success)
+            {
+                jobResult.SamplesWritten = span.Size();
+
+                m_written++;
+                m_samplesSubmitted += jobResult.SamplesSubmitted;
+                m_samplesWritten += jobResult.SamplesWritten;
+
+                std::error_code error;
+
+                if (!archive)
+                {
+                    m_bytesWritten += std::filesystem::file_size(job.Filename, error);
+
+                    if (m_settings.UpdateManifest)
+                        DatasetManifest::Append(job.Filename, span);
+                }
+            }
+            else
+            {
+                m_failed++;
+            }
+
+            if (m_settings.OnCompleted)
+                m_settings.OnCompleted(job.Filename, result);
+
+            if (job.OnCompleted)
+            {
+                jobResult.Result = std::move(result);
+                job.OnCompleted(jobResult);
+            }
+
+            // Release the samples before reporting idle.
+            job = TrajectoryWriteJob();
+            simplified = Trajectory();
+
+            std::lock_guard<std::mutex> lock(m_idleMutex);
+            m_pending--;
+            m_idle.notify_all();
+        }
+
+        for (auto& archive : m_archives)
+        {
+            CodecResult result = archive.second->Close();
+
+            if (!result.Success && m_settings.OnCompleted)
+                m_settings.OnCompleted(archive.first, result);
+        }
+
+        m_archives.clear();
+    }
+
+    CodecResult TrajectoryWriteService::AppendToArchive(const std::string& filename, const TrajectorySpan& trajectory)
+    {
+        auto& writer = m_archives[filename];
+
+        if (!writer)
+        {
+            std::error_code error;
+            std::filesystem::path directory = std::filesystem::path(filename).parent_path();
+
+            if (m_settings.CreateDirectories && !directory.empty())
+                std::filesystem::create_directories(directory, error);
+
+            writer = std::make_unique<TrajectoryArchiveWriter>(BinaryEncoding::DeltaVarint, m_settings.SyncToDisk);
+            CodecResult result = writer->Open(filename);
+
+            if (!result.Success)
+            {
+                m_archives.erase(filename);
+
+                return result;
+            }
+        }
+
+        uint64_t size = writer->GetSize();
+        CodecResult result = writer->Append(trajectory);
+
+        m_bytesWritten += writer->GetSize() - size;
+
+        // The next job opens the archive again rather than failing for good.
+        if (!writer->IsOpen())
+            m_archives.erase(filename);
+
+        return result;
+    }
+}
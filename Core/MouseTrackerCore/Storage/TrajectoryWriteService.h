@@ -0,0 +1,165 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYWRITESERVICE__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYWRITESERVICE__
+
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchiveWriter.h"
+#include "MouseTrackerCore/Threading/BoundedQueue.h"
+#include "MouseTrackerCore/Trajectory/TrajectorySimplifier.h"
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <map>
+#include <cstdint>
+
+namespace Mt
+{
+    // What became of one job; the samples differ when it was simplified.
+    struct TrajectoryJobResult
+    {
+        CodecResult Result;
+        uint64_t SamplesSubmitted = 0;
+        uint64_t SamplesWritten = 0;
+    };
+
+    using TrajectoryJobCallback = std::function<void(const TrajectoryJobResult& result)>;
+
+    // One pending save. Move-only: the trajectory is handed over, never copied.
+    struct TrajectoryWriteJob
+    {
+        std::string Filename;
+        std::shared_ptr<const MappedTrajectory> Trajectory;
+
+        // Applied on the writer thread; the shared trajectory is left as is.
+        SimplifySettings Simplify;
+
+        // Called on the writer thread when this job is written or has failed,
+        // so a caller can wait for its own save rather than the whole queue.
+        TrajectoryJobCallback OnCompleted;
+
+        TrajectoryWriteJob() = default;
+        TrajectoryWriteJob(std::string filename, std::shared_ptr<const MappedTrajectory> trajectory, SimplifySettings simplify = SimplifySettings(),
+            TrajectoryJobCallback onCompleted = TrajectoryJobCallback())
+            : Filename(std::move(filename)), Trajectory(std::move(trajectory)), Simplify(simplify), OnCompleted(std::move(onCompleted))
+        {
+        }
+
+        TrajectoryWriteJob(TrajectoryWriteJob&&) = default;
+        TrajectoryWriteJob& operator=(TrajectoryWriteJob&&) = default;
+        TrajectoryWriteJob(const TrajectoryWriteJob&) = delete;
+        TrajectoryWriteJob& operator=(const TrajectoryWriteJob&) = delete;
+    };
+
+    using TrajectoryWriteCallback = std::function<void(const std::string& filename, const CodecResult& result)>;
+
+    struct TrajectoryWriteSettings
+    {
+        // Saves waiting beyond this block the submitter (backpressure).
+        size_t QueueCapacity = 16;
+
+        // Flush file and directory to the device before reporting success.
+        bool SyncToDisk = true;
+
+        bool CreateDirectories = true;
+
+        // Append every saved file to its directory's DatasetManifest.
+        bool UpdateManifest = true;
+
+        // Called on the writer thread after every job.
+        TrajectoryWriteCallback OnCompleted;
+    };
+
+    struct TrajectoryWriteStats
+    {
+        uint64_t Submitted = 0;
+        uint64_t Written = 0;
+        uint64_t Failed = 0;
+
+        // Submits refused because the service was already shut down.
+        uint64_t Rejected = 0;
+
+        // Submits that found the queue full, and how long they waited in total.
+        uint64_t BlockedSubmits = 0;
+        uint64_t BlockedUs = 0;
+
+        uint64_t BytesWritten = 0;
+
+        // Samples handed in and samples stored; they differ when jobs are simplified.
+        uint64_t SamplesSubmitted = 0;
+        uint64_t SamplesWritten = 0;
+
+        size_t Pending = 0;
+        size_t QueueHighWatermark = 0;
+        size_t QueueCapacity = 0;
+    };
+
+    // Single background writer for trajectory files. Jobs are written in
+    // submission order through a bounded queue; each file is written to a
+    // temporary name, optionally synced, then renamed into place, so a file
+    // either appears complete or not at all and is written exactly once.
+    // Jobs targeting a .crsarc file are appended to that archive instead; the
+    // archive stays open between jobs and gets its index on Shutdown().
+    // Shutdown() (also run by the destructor) drains every accepted job.
+    class TrajectoryWriteService
+    {
+        private:
+            TrajectoryWriteSettings m_settings;
+            BoundedQueue<TrajectoryWriteJob> m_queue;
+            std::thread m_worker;
+
+            mutable std::mutex m_idleMutex;
+            std::condition_variable m_idle;
+            size_t m_pending = 0;
+
+            std::atomic<uint64_t> m_submitted { 0 };
+            std::atomic<uint64_t> m_written { 0 };
+            std::atomic<uint64_t> m_failed { 0 };
+            std::atomic<uint64_t> m_rejected { 0 };
+            std::atomic<uint64_t> m_blockedSubmits { 0 };
+            std::atomic<uint64_t> m_blockedUs { 0 };
+            std::atomic<uint64_t> m_bytesWritten { 0 };
+            std::atomic<uint64_t> m_samplesSubmitted { 0 };
+            std::atomic<uint64_t> m_samplesWritten { 0 };
+
+            std::mutex m_shutdownMutex;
+
+            // Only touched by the writer thread.
+            std::map<std::string, std::unique_ptr<TrajectoryArchiveWriter>> m_archives;
+
+        public:
+            explicit TrajectoryWriteService(TrajectoryWriteSettings settings = TrajectoryWriteSettings());
+            TrajectoryWriteService(const TrajectoryWriteService&) = delete;
+            TrajectoryWriteService& operator=(const TrajectoryWriteService&) = delete;
+            ~TrajectoryWriteService();
+
+            // Blocks while the queue is full; false once shut down.
+            bool Submit(TrajectoryWriteJob&& job);
+
+            bool Submit(std::string filename, Trajectory&& trajectory)
+            {
+                return Submit(TrajectoryWriteJob(std::move(filename), std::make_shared<const MappedTrajectory>(std::move(trajectory))));
+            }
+
+            // Waits until every job submitted so far has been written or failed.
+            void Drain();
+
+            // Stops accepting jobs, writes everything already queued and joins
+            // the writer. Safe to call more than once.
+            void Shutdown();
+
+            TrajectoryWriteStats GetStats() const;
+
+            // Writes one job synchronously with the same temp-file + rename
+            // protocol; used by the worker and by callers that need it inline.
+            static CodecResult WriteFile(const std::string& filename, const TrajectorySpan& trajectory, bool syncToDisk, bool createDirectories);
+
+        private:
+            void WorkerLoop();
+            CodecResult AppendToArchive(const std::string& filename, const TrajectorySpan& trajectory);
+    };
+}
+
+#endif
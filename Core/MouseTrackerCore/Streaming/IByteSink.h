@@ -0,0 +1,17 @@
+#ifndef __MOUSE_TRACKER_CORE_IBYTESINK__
+#define __MOUSE_TRACKER_CORE_IBYTESINK__
+
+#include <cstddef>
+
+namespace Mt
+{
+    class IByteSink
+    {
+        public:
+            virtual ~IByteSink() = default;
+            virtual bool Write(const void* data, size_t size) = 0;
+            virtual bool Flush() = 0;
+    };
+}
+
+#endif
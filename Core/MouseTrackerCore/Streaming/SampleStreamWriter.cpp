@@ -0,0 +1,160 @@
+#include "MouseTrackerCore/Streaming/SampleStreamWriter.h"
+#include "MouseTrackerCore/Recording/MonotonicClock.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryWriter.h"
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+namespace Mt
+{
+    SampleStreamWriter::SampleStreamWriter(std::unique_ptr<IByteSink> output, const SampleStreamSettings& settings)
+        : m_queue(settings.QueueCapacity)
+    {
+        m_output = std::move(output);
+        m_settings = settings;
+        m_stopRequested = false;
+        m_captured = 0;
+        m_dropped = 0;
+        m_written = 0;
+        m_flushes = 0;
+        m_writeFailed = false;
+        m_pendingSamples = 0;
+        m_buffer.reserve(m_settings.BatchBytes + 4096 * sizeof(StreamSample) + sizeof(StreamFrameHeader));
+    }
+
+    SampleStreamWriter::~SampleStreamWriter()
+    {
+        Stop();
+    }
+
+    void SampleStreamWriter::Start()
+    {
+        if (m_thread.joinable())
+            return;
+
+        m_stopRequested = false;
+        ResetBuffer();
+        m_thread = std::thread([this]() { this->WriterLoop(); });
+    }
+
+    void SampleStreamWriter::Stop()
+    {
+        m_stopRequested.store(true, std::memory_order_release);
+
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    SampleStreamStats SampleStreamWriter::GetStats() const
+    {
+        SampleStreamStats stats;
+        stats.Captured = m_captured.load(std::memory_order_relaxed);
+        stats.Written = m_written.load(std::memory_order_relaxed);
+        stats.Dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.Flushes = m_flushes.load(std::memory_order_relaxed);
+        stats.WriteFailed = m_writeFailed.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    void SampleStreamWriter::WriterLoop()
+    {
+        std::vector<StreamSample> batch(4096);
+        const int64_t maxLatencyNs = m_settings.MaxLatencyUs * 1000;
+        const auto idleSleep = std::chrono::microseconds(std::clamp<int64_t>(m_settings.MaxLatencyUs / 4, 100, 1000));
+        int64_t oldestPendingNs = 0;
+
+        while (true)
+        {
+            bool stopping = m_stopRequested.load(std::memory_order_acquire);
+            size_t count = m_queue.PopBatch(batch.data(), batch.size());
+            int64_t now = MonotonicClock::NowNs();
+
+            if (count > 0)
+            {
+                if (m_pendingSamples == 0)
+                    oldestPendingNs = now;
+
+                Append(batch.data(), count);
+            }
+
+            bool pending = m_pendingSamples > 0;
+            bool latencyExpired = pending && now - oldestPendingNs >= maxLatencyNs;
+            bool draining = stopping && count == 0;
+
+            if (pending && (m_buffer.size() >= m_settings.BatchBytes || latencyExpired || draining))
+                FlushBuffer();
+
+            if (count == 0)
+            {
+                if (stopping)
+                    break;
+
+                std::this_thread::sleep_for(idleSleep);
+            }
+        }
+
+        m_output->Flush();
+    }
+
+    void SampleStreamWriter::Append(const StreamSample* samples, size_t count)
+    {
+        if (m_settings.Framing == StreamFraming::Binary)
+        {
+            size_t offset = m_buffer.size();
+            m_buffer.resize(offset + count * sizeof(StreamSample));
+            std::memcpy(m_buffer.data() + offset, samples, count * sizeof(StreamSample));
+        }
+        else
+        {
+            size_t offset = m_buffer.size();
+            m_buffer.resize(offset + count * TextTrajectoryWriter::MaxLineBytes);
+
+            char* cursor = m_buffer.data() + offset;
+
+            for (size_t i = 0; i < count; i++)
+                cursor = TextTrajectoryWriter::FormatLine(cursor, samples[i].X, samples[i].Y);
+
+            m_buffer.resize(static_cast<size_t>(cursor - m_buffer.data()));
+        }
+
+        m_pendingSamples += count;
+    }
+
+    void SampleStreamWriter::FlushBuffer()
+    {
+        if (m_settings.Framing == StreamFraming::Binary)
+        {
+            StreamFrameHeader header;
+            header.Magic = StreamFrameMagic;
+            header.SampleCount = static_cast<uint32_t>(m_pendingSamples);
+            header.DroppedTotal = m_dropped.load(std::memory_order_relaxed);
+            std::memcpy(m_buffer.data(), &header, sizeof(header));
+        }
+
+        if (!m_writeFailed.load(std::memory_order_relaxed))
+        {
+            if (m_output->Write(m_buffer.data(), m_buffer.size()) && m_output->Flush())
+                m_written.fetch_add(m_pendingSamples, std::memory_order_relaxed);
+            else
+            {
+                m_writeFailed.store(true, std::memory_order_relaxed);
+
+                if (m_settings.OnWriteFailed)
+                    m_settings.OnWriteFailed();
+            }
+        }
+
+        m_flushes.fetch_add(1, std::memory_order_relaxed);
+        ResetBuffer();
+    }
+
+    void SampleStreamWriter::ResetBuffer()
+    {
+        m_buffer.clear();
+        m_pendingSamples = 0;
+
+        if (m_settings.Framing == StreamFraming::Binary)
+            m_buffer.resize(sizeof(StreamFrameHeader));
+    }
+}
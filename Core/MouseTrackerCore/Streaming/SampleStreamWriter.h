@@ -0,0 +1,120 @@
+#ifndef __MOUSE_TRACKER_CORE_SAMPLESTREAMWRITER__
+#define __MOUSE_TRACKER_CORE_SAMPLESTREAMWRITER__
+
+#include "MouseTrackerCore/Recording/ISampleSink.h"
+#include "MouseTrackerCore/Streaming/IByteSink.h"
+#include "MouseTrackerCore/Threading/SpscRingBuffer.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace Mt
+{
+    enum class StreamFraming
+    {
+        // "x;y\n" lines, byte compatible with .crsdat.
+        Text,
+
+        // Frames of StreamFrameHeader followed by SampleCount StreamSample records,
+        // little endian, one frame per flush.
+        Binary
+    };
+
+    constexpr uint32_t StreamFrameMagic = 0x4653544D; // "MTSF"
+
+    struct StreamFrameHeader
+    {
+        uint32_t Magic;
+        uint32_t SampleCount;
+        uint64_t DroppedTotal;
+    };
+
+    struct StreamSample
+    {
+        int64_t TimestampUs;
+        int32_t X;
+        int32_t Y;
+    };
+
+    static_assert(sizeof(StreamFrameHeader) == 16, "StreamFrameHeader must stay 16 bytes");
+    static_assert(sizeof(StreamSample) == 16, "StreamSample must stay 16 bytes");
+
+    struct SampleStreamSettings
+    {
+        StreamFraming Framing = StreamFraming::Text;
+
+        // Samples buffered between the sampler and the writer before drops start.
+        size_t QueueCapacity = 1 << 16;
+
+        // A flush happens when this many bytes are pending...
+        size_t BatchBytes = 1 << 16;
+
+        // ...or when the oldest pending sample is this old.
+        int64_t MaxLatencyUs = 10000;
+
+        // Called once, from the writer thread, when the output first fails
+        // (typically the consumer went away); the caller stops sampling here.
+        std::function<void()> OnWriteFailed;
+    };
+
+    struct SampleStreamStats
+    {
+        uint64_t Captured = 0;
+        uint64_t Written = 0;
+        uint64_t Dropped = 0;
+        uint64_t Flushes = 0;
+        bool WriteFailed = false;
+    };
+
+    // Decouples the sampling thread from a possibly slow consumer. OnSample only
+    // touches a wait-free ring; when the ring is full the sample is dropped and
+    // counted rather than stalling the sampler.
+    class SampleStreamWriter : public ISampleSink
+    {
+        private:
+            std::unique_ptr<IByteSink> m_output;
+            SampleStreamSettings m_settings;
+            SpscRingBuffer<StreamSample> m_queue;
+            std::thread m_thread;
+            std::atomic<bool> m_stopRequested;
+            std::atomic<uint64_t> m_captured;
+            std::atomic<uint64_t> m_dropped;
+            std::atomic<uint64_t> m_written;
+            std::atomic<uint64_t> m_flushes;
+            std::atomic<bool> m_writeFailed;
+            std::vector<char> m_buffer;
+            size_t m_pendingSamples;
+
+        public:
+            SampleStreamWriter(std::unique_ptr<IByteSink> output, const SampleStreamSettings& settings);
+            SampleStreamWriter(const SampleStreamWriter&) = delete;
+            SampleStreamWriter& operator=(const SampleStreamWriter&) = delete;
+            ~SampleStreamWriter() override;
+
+            void Start();
+
+            // Drains everything still queued, flushes and joins the writer thread.
+            void Stop();
+
+            void OnSample(const Point& point, int64_t timestampUs) override
+            {
+                m_captured.fetch_add(1, std::memory_order_relaxed);
+
+                if (!m_queue.TryPush(StreamSample { timestampUs, point.x, point.y }))
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            SampleStreamStats GetStats() const;
+
+        private:
+            void WriterLoop();
+            void Append(const StreamSample* samples, size_t count);
+            void FlushBuffer();
+            void ResetBuffer();
+    };
+}
+
+#endif
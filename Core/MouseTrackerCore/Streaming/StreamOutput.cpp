@@ -0,0 +1,161 @@
+#include "MouseTrackerCore/Streaming/StreamOutput.h"
+#include <cstdio>
+#include <csignal>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace Mt
+{
+    namespace
+    {
+        class FileByteSink : public IByteSink
+        {
+            private:
+                std::FILE* m_file;
+                bool m_owned;
+
+            public:
+                FileByteSink(std::FILE* file, bool owned)
+                {
+                    m_file = file;
+                    m_owned = owned;
+
+                    // The sink batches itself; stdio buffering would only add a copy.
+                    std::setvbuf(m_file, nullptr, _IONBF, 0);
+                }
+
+                ~FileByteSink() override
+                {
+                    if (m_owned)
+                        std::fclose(m_file);
+                    else
+                        std::fflush(m_file);
+                }
+
+                bool Write(const void* data, size_t size) override
+                {
+                    return std::fwrite(data, 1, size, m_file) == size;
+                }
+
+                bool Flush() override
+                {
+                    return std::fflush(m_file) == 0;
+                }
+        };
+
+#ifdef _WIN32
+        class NamedPipeByteSink : public IByteSink
+        {
+            private:
+                HANDLE m_pipe;
+
+            public:
+                explicit NamedPipeByteSink(HANDLE pipe)
+                {
+                    m_pipe = pipe;
+                }
+
+                ~NamedPipeByteSink() override
+                {
+                    FlushFileBuffers(m_pipe);
+                    DisconnectNamedPipe(m_pipe);
+                    CloseHandle(m_pipe);
+                }
+
+                bool Write(const void* data, size_t size) override
+                {
+                    const char* bytes = static_cast<const char*>(data);
+
+                    while (size > 0)
+                    {
+                        DWORD written = 0;
+
+                        if (!WriteFile(m_pipe, bytes, static_cast<DWORD>(size), &written, NULL))
+                            return false;
+
+                        bytes += written;
+                        size -= written;
+                    }
+
+                    return true;
+                }
+
+                bool Flush() override
+                {
+                    return true;
+                }
+        };
+#endif
+    }
+
+    std::unique_ptr<IByteSink> StreamOutput::Open(const std::string& target, std::string& error)
+    {
+#ifndef _WIN32
+        // A consumer closing its end would otherwise kill the process with
+        // SIGPIPE; ignored, the write fails with EPIPE and is reported.
+        std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+        if (target == "-")
+        {
+#ifdef _WIN32
+            _setmode(_fileno(stdout), _O_BINARY);
+#endif
+            return std::make_unique<FileByteSink>(stdout, false);
+        }
+
+#ifdef _WIN32
+        if (target.rfind("\\\\.\\pipe\\", 0) == 0)
+        {
+            HANDLE pipe = CreateNamedPipeA(target.c_str(), PIPE_ACCESS_OUTBOUND,
+                PIPE_TYPE_BYTE | PIPE_WAIT, 1, 1 << 16, 0, 0, NULL);
+
+            if (pipe == INVALID_HANDLE_VALUE)
+            {
+                error = "Unable to create named pipe " + target;
+
+                return nullptr;
+            }
+
+            if (!ConnectNamedPipe(pipe, NULL) && GetLastError() != ERROR_PIPE_CONNECTED)
+            {
+                CloseHandle(pipe);
+                error = "No client connected to " + target;
+
+                return nullptr;
+            }
+
+            return std::make_unique<NamedPipeByteSink>(pipe);
+        }
+#else
+        struct stat status;
+
+        if (stat(target.c_str(), &status) != 0 && mkfifo(target.c_str(), 0644) != 0)
+        {
+            error = "Unable to create FIFO " + target + ": " + std::strerror(errno);
+
+            return nullptr;
+        }
+#endif
+
+        std::FILE* file = std::fopen(target.c_str(), "wb");
+
+        if (!file)
+        {
+            error = "Unable to open " + target;
+
+            return nullptr;
+        }
+
+        return std::make_unique<FileByteSink>(file, true);
+    }
+}
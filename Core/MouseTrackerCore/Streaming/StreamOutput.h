@@ -0,0 +1,20 @@
+#ifndef __MOUSE_TRACKER_CORE_STREAMOUTPUT__
+#define __MOUSE_TRACKER_CORE_STREAMOUTPUT__
+
+#include "MouseTrackerCore/Streaming/IByteSink.h"
+#include <memory>
+#include <string>
+
+namespace Mt
+{
+    class StreamOutput
+    {
+        public:
+            // "-" is stdout. On Windows "\\.\pipe\name" creates a named pipe server and
+            // waits for a client; on POSIX a missing path is created as a FIFO. Any
+            // other path is opened as a regular file.
+            static std::unique_ptr<IByteSink> Open(const std::string& target, std::string& error);
+    };
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef __MOUSE_TRACKER_CORE_BOUNDEDQUEUE__
+#define __MOUSE_TRACKER_CORE_BOUNDEDQUEUE__
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <cstddef>
+
+namespace Mt
+{
+    // Multi-producer multi-consumer FIFO with a fixed capacity. Push blocks while
+    // full (backpressure), TryPush fails instead and leaves the item with the
+    // caller. After Close() pushes fail and Pop drains the remaining items
+    // before returning false.
+    template<typename T>
+    class BoundedQueue
+    {
+        private:
+            std::deque<T> m_items;
+            size_t m_capacity;
+            size_t m_highWatermark;
+            bool m_closed;
+            mutable std::mutex m_mutex;
+            std::condition_variable m_notEmpty;
+            std::condition_variable m_notFull;
+
+        public:
+            explicit BoundedQueue(size_t capacity)
+            {
+                m_capacity = capacity > 0 ? capacity : 1;
+                m_highWatermark = 0;
+                m_closed = false;
+            }
+
+            bool Push(T item)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_notFull.wait(lock, [this]() { return m_closed || m_items.size() < m_capacity; });
+
+                if (m_closed)
+                    return false;
+
+                Enqueue(std::move(item));
+                lock.unlock();
+                m_notEmpty.notify_one();
+
+                return true;
+            }
+
+            bool TryPush(T&& item)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                if (m_closed || m_items.size() >= m_capacity)
+                    return false;
+
+                Enqueue(std::move(item));
+                lock.unlock();
+                m_notEmpty.notify_one();
+
+                return true;
+            }
+
+            bool Pop(T& item)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_notEmpty.wait(lock, [this]() { return m_closed || !m_items.empty(); });
+
+                if (m_items.empty())
+                    return false;
+
+                item = std::move(m_items.front());
+                m_items.pop_front();
+                lock.unlock();
+                m_notFull.notify_one();
+
+                return true;
+            }
+
+            bool TryPop(T& item)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                if (m_items.empty())
+                    return false;
+
+                item = std::move(m_items.front());
+                m_items.pop_front();
+                lock.unlock();
+                m_notFull.notify_one();
+
+                return true;
+            }
+
+            void Close()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_closed = true;
+                }
+
+                m_notEmpty.notify_all();
+                m_notFull.notify_all();
+            }
+
+            bool IsClosed() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                return m_closed;
+            }
+
+            size_t Size() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                return m_items.size();
+            }
+
+            size_t GetCapacity() const
+            {
+                return m_capacity;
+            }
+
+            size_t GetHighWatermark() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                return m_highWatermark;
+            }
+
+        private:
+            void Enqueue(T item)
+            {
+                m_items.push_back(std::move(item));
+
+                if (m_items.size() > m_highWatermark)
+                    m_highWatermark = m_items.size();
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef __MOUSE_TRACKER_CORE_BYTEBUDGET__
+#define __MOUSE_TRACKER_CORE_BYTEBUDGET__
+
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace Mt
+{
+    // Counting semaphore over bytes. Acquire blocks while the request would push
+    // usage past the limit; a single request larger than the limit is let through
+    // once nothing else is held, so oversized items still make progress.
+    class ByteBudget
+    {
+        private:
+            uint64_t m_limit;
+            uint64_t m_used;
+            uint64_t m_peak;
+            std::mutex m_mutex;
+            std::condition_variable m_released;
+
+        public:
+            explicit ByteBudget(uint64_t limit)
+            {
+                m_limit = limit;
+                m_used = 0;
+                m_peak = 0;
+            }
+
+            void Acquire(uint64_t bytes)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_released.wait(lock, [this, bytes]() { return m_used == 0 || (m_used <= m_limit && bytes <= m_limit - m_used); });
+
+                m_used += bytes;
+
+                if (m_used > m_peak)
+                    m_peak = m_used;
+            }
+
+            void Release(uint64_t bytes)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_used -= bytes;
+                }
+
+                m_released.notify_all();
+            }
+
+            uint64_t GetPeak()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                return m_peak;
+            }
+    };
+}
+
+#endif
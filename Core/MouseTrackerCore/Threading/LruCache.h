@@ -0,0 +1,147 @@
+#ifndef __MOUSE_TRACKER_CORE_LRUCACHE__
+#define __MOUSE_TRACKER_CORE_LRUCACHE__
+
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <cstdint>
+
+namespace Mt
+{
+    struct LruCacheStats
+    {
+        uint64_t Hits = 0;
+        uint64_t Misses = 0;
+        uint64_t Evictions = 0;
+        size_t Entries = 0;
+        size_t Bytes = 0;
+        size_t BudgetBytes = 0;
+    };
+
+    // Thread-safe string-keyed cache of shared immutable values, bounded by the
+    // byte cost the caller declares for each value. Inserting past the budget
+    // evicts the least recently used entries; a value costing more than the
+    // whole budget is not cached. Evicted values stay alive for as long as a
+    // caller still holds them.
+    template<typename T>
+    class LruCache
+    {
+        private:
+            struct Entry
+            {
+                std::string Key;
+                std::shared_ptr<const T> Value;
+                size_t Bytes;
+            };
+
+            std::list<Entry> m_entries;
+            std::unordered_map<std::string, typename std::list<Entry>::iterator> m_lookup;
+            size_t m_budget;
+            size_t m_bytes;
+            uint64_t m_hits;
+            uint64_t m_misses;
+            uint64_t m_evictions;
+            mutable std::mutex m_mutex;
+
+        public:
+            explicit LruCache(size_t budgetBytes)
+            {
+                m_budget = budgetBytes;
+                m_bytes = 0;
+                m_hits = 0;
+                m_misses = 0;
+                m_evictions = 0;
+            }
+
+            LruCache(const LruCache&) = delete;
+            LruCache& operator=(const LruCache&) = delete;
+
+            // Returns null on a miss; a hit becomes the most recently used entry.
+            std::shared_ptr<const T> Get(const std::string& key)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                auto it = m_lookup.find(key);
+
+                if (it == m_lookup.end())
+                {
+                    m_misses++;
+
+                    return nullptr;
+                }
+
+                m_hits++;
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+                return it->second->Value;
+            }
+
+            bool Contains(const std::string& key) const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                return m_lookup.find(key) != m_lookup.end();
+            }
+
+            void Put(const std::string& key, std::shared_ptr<const T> value, size_t bytes)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                Remove(key);
+
+                if (bytes > m_budget)
+                    return;
+
+                while (m_bytes + bytes > m_budget && !m_entries.empty())
+                {
+                    m_evictions++;
+                    Remove(m_entries.back().Key);
+                }
+
+                m_entries.push_front({ key, std::move(value), bytes });
+                m_lookup[key] = m_entries.begin();
+                m_bytes += bytes;
+            }
+
+            void Clear()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                m_entries.clear();
+                m_lookup.clear();
+                m_bytes = 0;
+            }
+
+            LruCacheStats GetStats() const
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                LruCacheStats stats;
+                stats.Hits = m_hits;
+                stats.Misses = m_misses;
+                stats.Evictions = m_evictions;
+                stats.Entries = m_entries.size();
+                stats.Bytes = m_bytes;
+                stats.BudgetBytes = m_budget;
+
+                return stats;
+            }
+
+        private:
+            void Remove(const std::string& key)
+            {
+                auto it = m_lookup.find(key);
+
+                if (it == m_lookup.end())
+                    return;
+
+                m_bytes -= it->second->Bytes;
+                m_entries.erase(it->second);
+                m_lookup.erase(it);
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef __MOUSE_TRACKER_CORE_SPSCRINGBUFFER__
+#define __MOUSE_TRACKER_CORE_SPSCRINGBUFFER__
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+namespace Mt
+{
+    // Wait-free single producer / single consumer ring. The producer side never
+    // blocks or allocates, which makes it safe to feed from the sampling loop.
+    template<typename T>
+    class SpscRingBuffer
+    {
+        private:
+            std::vector<T> m_items;
+            size_t m_mask;
+
+            alignas(64) std::atomic<size_t> m_head;
+            alignas(64) std::atomic<size_t> m_tail;
+
+        public:
+            // Capacity is rounded up to a power of two.
+            explicit SpscRingBuffer(size_t capacity)
+            {
+                size_t size = 2;
+
+                while (size < capacity)
+                    size <<= 1;
+
+                m_items.resize(size);
+                m_mask = size - 1;
+                m_head = 0;
+                m_tail = 0;
+            }
+
+            bool TryPush(const T& item)
+            {
+                size_t head = m_head.load(std::memory_order_relaxed);
+
+                if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+                    return false;
+
+                m_items[head & m_mask] = item;
+                m_head.store(head + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            bool TryPop(T& item)
+            {
+                size_t tail = m_tail.load(std::memory_order_relaxed);
+
+                if (tail == m_head.load(std::memory_order_acquire))
+                    return false;
+
+                item = m_items[tail & m_mask];
+                m_tail.store(tail + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            // Pops up to `maxCount` items into `output`; returns how many were taken.
+            size_t PopBatch(T* output, size_t maxCount)
+            {
+                size_t tail = m_tail.load(std::memory_order_relaxed);
+                size_t available = m_head.load(std::memory_order_acquire) - tail;
+                size_t count = available < maxCount ? available : maxCount;
+
+                for (size_t i = 0; i < count; i++)
+                    output[i] = m_items[(tail + i) & m_mask];
+
+                m_tail.store(tail + count, std::memory_order_release);
+
+                return count;
+            }
+
+            size_t Size() const
+            {
+                return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+            }
+
+            size_t GetCapacity() const
+            {
+                return m_mask + 1;
+            }
+    };
+}
+
+#endif
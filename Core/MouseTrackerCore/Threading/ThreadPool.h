@@ -0,0 +1,102 @@
+#ifndef __MOUSE_TRACKER_CORE_THREADPOOL__
+#define __MOUSE_TRACKER_CORE_THREADPOOL__
+
+#include "MouseTrackerCore/Threading/BoundedQueue.h"
+#include <functional>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+namespace Mt
+{
+    // Fixed set of workers fed through a bounded queue: Submit blocks once
+    // `queueCapacity` tasks are waiting, which bounds the work in flight.
+    class ThreadPool
+    {
+        private:
+            BoundedQueue<std::function<void()>> m_tasks;
+            std::vector<std::thread> m_workers;
+            size_t m_pending;
+            std::mutex m_mutex;
+            std::condition_variable m_idle;
+
+        public:
+            explicit ThreadPool(size_t threadCount = 0, size_t queueCapacity = 0)
+                : m_tasks(queueCapacity > 0 ? queueCapacity : 2 * ResolveThreadCount(threadCount))
+            {
+                m_pending = 0;
+
+                size_t count = ResolveThreadCount(threadCount);
+
+                for (size_t i = 0; i < count; i++)
+                    m_workers.emplace_back([this]() { this->WorkerLoop(); });
+            }
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            ~ThreadPool()
+            {
+                m_tasks.Close();
+
+                for (auto& worker : m_workers)
+                    if (worker.joinable())
+                        worker.join();
+            }
+
+            void Submit(std::function<void()> task)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_pending++;
+                }
+
+                if (!m_tasks.Push(std::move(task)))
+                    Complete();
+            }
+
+            void WaitIdle()
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_idle.wait(lock, [this]() { return m_pending == 0; });
+            }
+
+            size_t GetThreadCount() const
+            {
+                return m_workers.size();
+            }
+
+            static size_t ResolveThreadCount(size_t threadCount)
+            {
+                if (threadCount > 0)
+                    return threadCount;
+
+                return (std::max)(1u, std::thread::hardware_concurrency());
+            }
+
+        private:
+            void WorkerLoop()
+            {
+                std::function<void()> task;
+
+                while (m_tasks.Pop(task))
+                {
+                    task();
+                    task = nullptr;
+                    Complete();
+                }
+            }
+
+            void Complete()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                if (--m_pending == 0)
+                    m_idle.notify_all();
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef __MOUSE_TRACKER_CORE_POINT__
+#define __MOUSE_TRACKER_CORE_POINT__
+
+#include <cstdint>
+
+namespace Mt
+{
+    struct Point
+    {
+        int32_t x;
+        int32_t y;
+    };
+
+    inline bool operator==(const Point& left, const Point& right)
+    {
+        return left.x == right.x && left.y == right.y;
+    }
+
+    inline bool operator!=(const Point& left, const Point& right)
+    {
+        return !(left == right);
+    }
+}
+
+#endif
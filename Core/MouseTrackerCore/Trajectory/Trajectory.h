@@ -0,0 +1,132 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORY__
+#define __MOUSE_TRACKER_CORE_TRAJECTORY__
+
+#include "MouseTrackerCore/Trajectory/Point.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryMetadata.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace Mt
+{
+    class Trajectory
+    {
+        private:
+            std::vector<Point> m_points;
+            std::vector<int64_t> m_timestamps;
+            TrajectoryMetadata m_metadata;
+
+        public:
+            Trajectory() = default;
+
+            explicit Trajectory(std::vector<Point> points)
+            {
+                m_points = std::move(points);
+            }
+
+            void Reserve(size_t count, bool withTimestamps = false)
+            {
+                m_points.reserve(count);
+
+                if (withTimestamps)
+                    m_timestamps.reserve(count);
+            }
+
+            void Add(const Point& point)
+            {
+                m_points.push_back(point);
+            }
+
+            // Timestamps are microseconds relative to TrajectoryMetadata::StartTimeUs.
+            // Either every sample carries one or none does.
+            void Add(const Point& point, int64_t timestampUs)
+            {
+                m_points.push_back(point);
+                m_timestamps.push_back(timestampUs);
+            }
+
+            void Clear()
+            {
+                m_points.clear();
+                m_timestamps.clear();
+            }
+
+            size_t Size() const
+            {
+                return m_points.size();
+            }
+
+            bool Empty() const
+            {
+                return m_points.empty();
+            }
+
+            bool HasTimestamps() const
+            {
+                return !m_timestamps.empty() && m_timestamps.size() == m_points.size();
+            }
+
+            const Point& operator[](size_t index) const
+            {
+                return m_points[index];
+            }
+
+            const Point& Front() const
+            {
+                return m_points.front();
+            }
+
+            const Point& Back() const
+            {
+                return m_points.back();
+            }
+
+            std::vector<Point>::const_iterator begin() const
+            {
+                return m_points.begin();
+            }
+
+            std::vector<Point>::const_iterator end() const
+            {
+                return m_points.end();
+            }
+
+            const std::vector<Point>& GetPoints() const
+            {
+                return m_points;
+            }
+
+            std::vector<Point>& GetPoints()
+            {
+                return m_points;
+            }
+
+            const std::vector<int64_t>& GetTimestamps() const
+            {
+                return m_timestamps;
+            }
+
+            std::vector<int64_t>& GetTimestamps()
+            {
+                return m_timestamps;
+            }
+
+            const TrajectoryMetadata& GetMetadata() const
+            {
+                return m_metadata;
+            }
+
+            TrajectoryMetadata& GetMetadata()
+            {
+                return m_metadata;
+            }
+
+            void SetMetadata(const TrajectoryMetadata& metadata)
+            {
+                m_metadata = metadata;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,182 @@
+#include "MouseTrackerCore/Trajectory/TrajectoryLod.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Mt
+{
+    namespace
+    {
+        uint64_t PackCell(int32_t x, int32_t y)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+        }
+
+        bool TestAndSet(std::vector<uint64_t>& bits, size_t index)
+        {
+            uint64_t bit = uint64_t(1) << (index % 64);
+            bool wasSet = (bits[index / 64] & bit) != 0;
+            bits[index / 64] |= bit;
+
+            return wasSet;
+        }
+    }
+
+    void TrajectoryLod::Build(const TrajectorySpan& trajectory, const LodTransform& transform)
+    {
+        Clear();
+
+        m_sourceSamples = trajectory.Size();
+
+        if (trajectory.Empty())
+            return;
+
+        const int64_t width = (std::max)(transform.Width, 0);
+        const int64_t height = (std::max)(transform.Height, 0);
+        const float markerScale = 1.0f / (std::max)(transform.MarkerSpacing, 1.0f);
+        const int64_t markerWidth = static_cast<int64_t>(std::ceil(width * markerScale));
+        const int64_t markerHeight = static_cast<int64_t>(std::ceil(height * markerScale));
+
+        m_occupied.assign(static_cast<size_t>((markerWidth * markerHeight + 63) / 64), 0);
+        m_neighbourMoves.assign(static_cast<size_t>((width * height * 4 + 63) / 64), 0);
+
+        const Point* points = trajectory.Points;
+        int32_t previousX = 0;
+        int32_t previousY = 0;
+        bool first = true;
+
+        int32_t cellsX[ProjectBlock];
+        int32_t cellsY[ProjectBlock];
+
+        for (size_t offset = 0; offset < trajectory.Size(); offset += ProjectBlock)
+        {
+            size_t count = (std::min)(ProjectBlock, trajectory.Size() - offset);
+            Project(points + offset, count, transform, cellsX, cellsY);
+
+            for (size_t j = 0; j < count; j++)
+            {
+                int32_t cellX = cellsX[j];
+                int32_t cellY = cellsY[j];
+
+                if (!first && cellX == previousX && cellY == previousY)
+                    continue;
+
+                LodVertex centre = { cellX + 0.5f, cellY + 0.5f };
+
+                if (!first && MarkMove(previousX, previousY, cellX, cellY, width, height))
+                {
+                    LodVertex from = { previousX + 0.5f, previousY + 0.5f };
+
+                    // Continue the last strip if it ends at the pixel just
+                    // left, otherwise open one there.
+                    if (m_path.empty() || m_path.back().x != from.x || m_path.back().y != from.y)
+                    {
+                        m_strips.push_back({ m_path.size(), 1 });
+                        m_path.push_back(from);
+                    }
+
+                    m_strips.back().Count++;
+                    m_path.push_back(centre);
+                }
+
+                previousX = cellX;
+                previousY = cellY;
+                first = false;
+
+                // Only samples that change pixel get here, so the marker
+                // square is worked out from the sample again rather than
+                // projected for all of them.
+                const Point& point = points[offset + j];
+                int64_t markerX = static_cast<int64_t>(std::floor((point.x - transform.OriginX) * transform.ScaleX * markerScale));
+                int64_t markerY = static_cast<int64_t>(std::floor((point.y - transform.OriginY) * transform.ScaleY * markerScale));
+                bool inside = markerX >= 0 && markerY >= 0 && markerX < markerWidth && markerY < markerHeight;
+
+                if (!inside || !TestAndSet(m_occupied, static_cast<size_t>(markerY * markerWidth + markerX)))
+                    m_markers.push_back(centre);
+            }
+        }
+
+        m_moves.clear();
+    }
+
+    void TrajectoryLod::Project(const Point* points, size_t count, const LodTransform& transform, int32_t* cellsX, int32_t* cellsY)
+    {
+        const float originX = transform.OriginX;
+        const float originY = transform.OriginY;
+        const float scaleX = transform.ScaleX;
+        const float scaleY = transform.ScaleY;
+
+        // No calls and no branches, so the compiler turns this into vector
+        // code (SSE2 / NEON at the baseline): floor is truncation, minus one
+        // where truncation rounded a negative value up.
+        for (size_t i = 0; i < count; i++)
+        {
+            float x = (points[i].x - originX) * scaleX;
+            float y = (points[i].y - originY) * scaleY;
+            int32_t truncatedX = static_cast<int32_t>(x);
+            int32_t truncatedY = static_cast<int32_t>(y);
+
+            cellsX[i] = truncatedX - (x < static_cast<float>(truncatedX) ? 1 : 0);
+            cellsY[i] = truncatedY - (y < static_cast<float>(truncatedY) ? 1 : 0);
+        }
+    }
+
+    bool TrajectoryLod::GetBounds(const TrajectorySpan& trajectory, Point& min, Point& max)
+    {
+        if (trajectory.Empty())
+            return false;
+
+        const Point* points = trajectory.Points;
+        int32_t minX = points[0].x;
+        int32_t minY = points[0].y;
+        int32_t maxX = minX;
+        int32_t maxY = minY;
+
+        // Plain min / max reductions, vectorised by the compiler.
+        for (size_t i = 1; i < trajectory.Size(); i++)
+        {
+            minX = points[i].x < minX ? points[i].x : minX;
+            minY = points[i].y < minY ? points[i].y : minY;
+            maxX = points[i].x > maxX ? points[i].x : maxX;
+            maxY = points[i].y > maxY ? points[i].y : maxY;
+        }
+
+        min = { minX, minY };
+        max = { maxX, maxY };
+
+        return true;
+    }
+
+    void TrajectoryLod::Clear()
+    {
+        m_path.clear();
+        m_strips.clear();
+        m_markers.clear();
+        m_moves.clear();
+        m_sourceSamples = 0;
+    }
+
+    // True the first time a move between the two pixels is seen, either way.
+    bool TrajectoryLod::MarkMove(int32_t fromX, int32_t fromY, int32_t toX, int32_t toY, int64_t width, int64_t height)
+    {
+        // Order the pair by row, then column; the second pixel of two
+        // neighbours is then right, below left, below or below right.
+        if (toY < fromY || (toY == fromY && toX < fromX))
+        {
+            std::swap(fromX, toX);
+            std::swap(fromY, toY);
+        }
+
+        int64_t dx = static_cast<int64_t>(toX) - fromX;
+        int64_t dy = static_cast<int64_t>(toY) - fromY;
+        bool inside = fromX >= 0 && fromY >= 0 && fromX < width && fromY < height;
+
+        if (inside && dy <= 1 && dx >= -1 && dx <= 1)
+        {
+            int direction = dy == 0 ? 0 : static_cast<int>(dx) + 2;
+
+            return !TestAndSet(m_neighbourMoves, static_cast<size_t>((fromY * width + fromX) * 4 + direction));
+        }
+
+        return m_moves.insert({ PackCell(fromX, fromY), PackCell(toX, toY) }).second;
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYLOD__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYLOD__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <vector>
+#include <unordered_set>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mt
+{
+    struct LodVertex
+    {
+        float x;
+        float y;
+    };
+
+    // Maps samples onto a canvas: canvas = (sample - Origin) * Scale, in pixels.
+    struct LodTransform
+    {
+        float OriginX = 0.0f;
+        float OriginY = 0.0f;
+        float ScaleX = 1.0f;
+        float ScaleY = 1.0f;
+
+        // Canvas size in pixels; samples outside it still draw, only slower.
+        int Width = 0;
+        int Height = 0;
+
+        // Markers are kept one per square of this many pixels; a marker
+        // wider than a pixel hides its neighbours anyway.
+        float MarkerSpacing = 1.0f;
+
+        bool operator==(const LodTransform& other) const
+        {
+            return OriginX == other.OriginX && OriginY == other.OriginY && ScaleX == other.ScaleX && ScaleY == other.ScaleY &&
+                   Width == other.Width && Height == other.Height && MarkerSpacing == other.MarkerSpacing;
+        }
+
+        bool operator!=(const LodTransform& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    // One polyline of the level of detail: Count vertices from Offset.
+    struct LodStrip
+    {
+        size_t Offset;
+        size_t Count;
+    };
+
+    // Level of detail for drawing a trajectory on a canvas. Zoomed out, a
+    // million samples land on a few thousand pixels, and a line per sample
+    // mostly redraws pixels already drawn. Each sample is snapped to the
+    // centre of its pixel, and the path becomes the moves between pixels:
+    // a move already drawn (in either direction) is skipped, which breaks
+    // the path into strips. Every pixel and every move between pixels of
+    // the full path is drawn, nothing else, so the picture matches at pixel
+    // level: a hand resting on a pixel border, which jitters across it
+    // thousands of times, costs one segment. Building is one O(n) pass; the
+    // result is bounded by the pixels the path touches (a few vertices
+    // each), not by the number of samples.
+    class TrajectoryLod
+    {
+        private:
+            struct Move
+            {
+                uint64_t From;
+                uint64_t To;
+
+                bool operator==(const Move& other) const
+                {
+                    return From == other.From && To == other.To;
+                }
+            };
+
+            struct MoveHash
+            {
+                size_t operator()(const Move& move) const
+                {
+                    return std::hash<uint64_t>()(move.From * 0x9E3779B97F4A7C15ull ^ move.To);
+                }
+            };
+
+            // Samples are projected onto pixels a block at a time, in a
+            // vectorised pass, before the moves between them are walked.
+            static constexpr size_t ProjectBlock = 1024;
+
+            std::vector<LodVertex> m_path;
+            std::vector<LodStrip> m_strips;
+            std::vector<LodVertex> m_markers;
+            // Scratch while building: marker squares taken, moves drawn
+            // between neighbouring pixels (4 bits per pixel), other moves.
+            std::vector<uint64_t> m_occupied;
+            std::vector<uint64_t> m_neighbourMoves;
+            std::unordered_set<Move, MoveHash> m_moves;
+            size_t m_sourceSamples = 0;
+
+        public:
+            void Build(const TrajectorySpan& trajectory, const LodTransform& transform);
+
+            void Clear();
+
+            // Canvas coordinates of the strip vertices, strip after strip.
+            const std::vector<LodVertex>& GetPath() const
+            {
+                return m_path;
+            }
+
+            // Polylines to draw, each at least two vertices, in path order.
+            const std::vector<LodStrip>& GetStrips() const
+            {
+                return m_strips;
+            }
+
+            // Canvas coordinates of the sample markers to draw, at pixel centres.
+            const std::vector<LodVertex>& GetMarkers() const
+            {
+                return m_markers;
+            }
+
+            size_t GetSourceSamples() const
+            {
+                return m_sourceSamples;
+            }
+
+            // Smallest and largest coordinates of the samples in one
+            // vectorised pass; false when there are none.
+            static bool GetBounds(const TrajectorySpan& trajectory, Point& min, Point& max);
+
+        private:
+            static void Project(const Point* points, size_t count, const LodTransform& transform, int32_t* cellsX, int32_t* cellsY);
+            bool MarkMove(int32_t fromX, int32_t fromY, int32_t toX, int32_t toY, int64_t width, int64_t height);
+    };
+}
+
+#endif
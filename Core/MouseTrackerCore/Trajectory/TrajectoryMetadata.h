@@ -0,0 +1,21 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYMETADATA__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYMETADATA__
+
+#include <cstdint>
+
+namespace Mt
+{
+    struct TrajectoryMetadata
+    {
+        // Sampling period; 0 when unknown (e.g. loaded from a plain text file).
+        uint32_t PeriodUs = 0;
+
+        // Wall clock time of the first sample, microseconds since the Unix epoch.
+        int64_t StartTimeUs = 0;
+
+        int32_t ScreenWidth = 0;
+        int32_t ScreenHeight = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "MouseTrackerCore/Trajectory/TrajectoryResampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Mt
+{
+    namespace
+    {
+        // Time of sample i: its timestamp, or i sampling periods.
+        int64_t GetSampleTime(const TrajectorySpan& trajectory, size_t index)
+        {
+            return trajectory.HasTimestamps()
+                ? trajectory.Timestamps[index]
+                : static_cast<int64_t>(index) * trajectory.GetMetadata().PeriodUs;
+        }
+
+        bool IsTimed(const TrajectorySpan& trajectory)
+        {
+            return trajectory.HasTimestamps() || trajectory.GetMetadata().PeriodUs > 0;
+        }
+    }
+
+    size_t TrajectoryResampler::GetResampledSize(const TrajectorySpan& trajectory, uint32_t periodUs)
+    {
+        if (trajectory.Empty() || periodUs == 0 || !IsTimed(trajectory))
+            return 0;
+
+        int64_t duration = GetSampleTime(trajectory, trajectory.Size() - 1) - GetSampleTime(trajectory, 0);
+
+        return duration > 0 ? static_cast<size_t>(duration / periodUs) + 1 : 1;
+    }
+
+    size_t TrajectoryResampler::Resample(const TrajectorySpan& trajectory, uint32_t periodUs, Point* points, int64_t* timestamps, size_t capacity)
+    {
+        size_t count = (std::min)(GetResampledSize(trajectory, periodUs), capacity);
+        int64_t start = count > 0 ? GetSampleTime(trajectory, 0) : 0;
+        size_t last = trajectory.Size() - 1;
+        size_t segment = 0;
+
+        for (size_t k = 0; k < count; k++)
+        {
+            int64_t time = start + static_cast<int64_t>(k) * periodUs;
+
+            // Both clocks only move forward, so the segment is found by walking.
+            while (segment < last && GetSampleTime(trajectory, segment + 1) <= time)
+                segment++;
+
+            if (points)
+            {
+                const Point& from = trajectory[segment];
+
+                if (segment == last)
+                {
+                    points[k] = from;
+                }
+                else
+                {
+                    const Point& to = trajectory[segment + 1];
+                    int64_t begin = GetSampleTime(trajectory, segment);
+                    double t = static_cast<double>(time - begin) / (GetSampleTime(trajectory, segment + 1) - begin);
+
+                    points[k].x = static_cast<int32_t>(std::lround(from.x + t * (static_cast<double>(to.x) - from.x)));
+                    points[k].y = static_cast<int32_t>(std::lround(from.y + t * (static_cast<double>(to.y) - from.y)));
+                }
+            }
+
+            if (timestamps)
+                timestamps[k] = time;
+        }
+
+        return count;
+    }
+
+    Trajectory TrajectoryResampler::Resample(const TrajectorySpan& trajectory, uint32_t periodUs)
+    {
+        size_t count = GetResampledSize(trajectory, periodUs);
+
+        Trajectory resampled;
+        resampled.GetPoints().resize(count);
+        resampled.GetTimestamps().resize(count);
+
+        Resample(trajectory, periodUs, resampled.GetPoints().data(), resampled.GetTimestamps().data(), count);
+
+        TrajectoryMetadata metadata = trajectory.GetMetadata();
+        metadata.PeriodUs = periodUs;
+        resampled.SetMetadata(metadata);
+
+        return resampled;
+    }
+}
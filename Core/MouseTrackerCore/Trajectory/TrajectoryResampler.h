@@ -0,0 +1,33 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYRESAMPLER__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYRESAMPLER__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Mt
+{
+    // Resamples a capture onto a uniform clock, e.g. to compare recordings
+    // taken at different rates or with jittery pacing. Sample k lies at the
+    // first timestamp + k * period, up to the last timestamp, with its
+    // position interpolated linearly between the two samples around it and
+    // rounded to the nearest pixel. A capture without timestamps is taken to
+    // be sampled every Metadata.PeriodUs; with neither, nothing is produced.
+    // Timestamps must not decrease.
+    class TrajectoryResampler
+    {
+        public:
+            // Number of samples Resample produces.
+            static size_t GetResampledSize(const TrajectorySpan& trajectory, uint32_t periodUs);
+
+            // Writes up to capacity samples into caller-owned columns (either
+            // may be null) and returns how many were written. Timestamps are
+            // relative, like the input's.
+            static size_t Resample(const TrajectorySpan& trajectory, uint32_t periodUs, Point* points, int64_t* timestamps, size_t capacity);
+
+            // Owning result with timestamps and PeriodUs set to the new period.
+            static Trajectory Resample(const TrajectorySpan& trajectory, uint32_t periodUs);
+    };
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include "MouseTrackerCore/Trajectory/TrajectorySimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Mt
+{
+    namespace
+    {
+        // Sample in (first, last) farthest from the path that would replace
+        // them, the straight segment first -> last, and its squared distance.
+        // The metric is a template parameter so the scan has no branch on it.
+        template<bool UseTime>
+        std::pair<size_t, double> FindFarthest(const TrajectorySpan& trajectory, size_t first, size_t last)
+        {
+            const Point* points = trajectory.Points;
+            const int64_t* timestamps = trajectory.Timestamps;
+
+            const double x = points[first].x;
+            const double y = points[first].y;
+            const double dx = static_cast<double>(points[last].x) - x;
+            const double dy = static_cast<double>(points[last].y) - y;
+            const int64_t start = UseTime ? timestamps[first] : 0;
+            const double span = UseTime ? static_cast<double>(timestamps[last] - start) : dx * dx + dy * dy;
+            const double scale = span > 0.0 ? 1.0 / span : 0.0;
+
+            double farthest = -1.0;
+            size_t split = first;
+
+            for (size_t i = first + 1; i < last; i++)
+            {
+                double px = points[i].x - x;
+                double py = points[i].y - y;
+
+                // Position along the segment: by elapsed time, or by projection.
+                double t = UseTime ? (timestamps[i] - start) * scale : (px * dx + py * dy) * scale;
+                t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+
+                double ex = px - t * dx;
+                double ey = py - t * dy;
+                double distance = ex * ex + ey * ey;
+
+                if (distance > farthest)
+                {
+                    farthest = distance;
+                    split = i;
+                }
+            }
+
+            return { split, farthest };
+        }
+    }
+
+    std::vector<size_t> TrajectorySimplifier::SelectSamples(const TrajectorySpan& trajectory, const SimplifySettings& settings, double* maxError)
+    {
+        const size_t count = trajectory.Size();
+        std::vector<size_t> kept;
+
+        if (maxError)
+            *maxError = 0.0;
+
+        if (!settings.IsEnabled() || count <= 2)
+        {
+            kept.resize(count);
+
+            for (size_t i = 0; i < count; i++)
+                kept[i] = i;
+
+            return kept;
+        }
+
+        const bool useTime = settings.UseTimestamps && trajectory.HasTimestamps();
+        const double tolerance = settings.Tolerance * settings.Tolerance;
+        double worst = 0.0;
+
+        std::vector<uint8_t> keep(count, 0);
+        std::vector<std::pair<size_t, size_t>> pending;
+
+        // Windows start out as kept vertices; see WindowSamples.
+        for (size_t first = 0; first < count - 1; first += WindowSamples)
+        {
+            size_t last = (std::min)(first + WindowSamples, count - 1);
+
+            keep[first] = 1;
+            keep[last] = 1;
+            pending.emplace_back(first, last);
+        }
+
+        while (!pending.empty())
+        {
+            size_t first = pending.back().first;
+            size_t last = pending.back().second;
+            pending.pop_back();
+
+            if (last - first < 2)
+                continue;
+
+            std::pair<size_t, double> found = useTime
+                ? FindFarthest<true>(trajectory, first, last)
+                : FindFarthest<false>(trajectory, first, last);
+
+            size_t split = found.first;
+            double farthest = found.second;
+
+            if (farthest <= tolerance)
+            {
+                worst = (std::max)(worst, farthest);
+
+                continue;
+            }
+
+            keep[split] = 1;
+            pending.emplace_back(first, split);
+            pending.emplace_back(split, last);
+        }
+
+        for (size_t i = 0; i < count; i++)
+            if (keep[i])
+                kept.push_back(i);
+
+        if (maxError)
+            *maxError = std::sqrt(worst);
+
+        return kept;
+    }
+
+    Trajectory TrajectorySimplifier::Simplify(const TrajectorySpan& trajectory, const SimplifySettings& settings, SimplifySummary* summary)
+    {
+        double maxError = 0.0;
+        std::vector<size_t> kept = SelectSamples(trajectory, settings, &maxError);
+        bool timestamps = trajectory.HasTimestamps();
+
+        Trajectory simplified;
+        simplified.Reserve(kept.size(), timestamps);
+        simplified.SetMetadata(trajectory.GetMetadata());
+
+        for (size_t index : kept)
+        {
+            if (timestamps)
+                simplified.Add(trajectory[index], trajectory.Timestamps[index]);
+            else
+                simplified.Add(trajectory[index]);
+        }
+
+        if (summary)
+        {
+            summary->InputSamples = trajectory.Size();
+            summary->OutputSamples = simplified.Size();
+            summary->MaxError = maxError;
+        }
+
+        return simplified;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYSIMPLIFIER__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYSIMPLIFIER__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Mt
+{
+    struct SimplifySettings
+    {
+        // Largest distance in pixels any dropped sample may lie from the
+        // simplified path; 0 keeps every sample.
+        double Tolerance = 0.0;
+
+        // With timestamps, a dropped sample is measured against where the
+        // simplified path is at that sample's time (linear interpolation
+        // between the kept neighbours), not against the nearest point of the
+        // segment. This bounds the position error at every instant, so pauses
+        // and speed changes survive along with the shape.
+        bool UseTimestamps = true;
+
+        bool IsEnabled() const
+        {
+            return Tolerance > 0.0;
+        }
+    };
+
+    struct SimplifySummary
+    {
+        uint64_t InputSamples = 0;
+        uint64_t OutputSamples = 0;
+
+        // Largest error of any dropped sample, in pixels; at most the tolerance.
+        double MaxError = 0.0;
+
+        // Input samples per kept sample.
+        double GetRatio() const
+        {
+            return OutputSamples > 0 ? static_cast<double>(InputSamples) / OutputSamples : 0.0;
+        }
+    };
+
+    // Ramer-Douglas-Peucker with an explicit work stack instead of recursion,
+    // so a million-sample capture cannot overflow the call stack. Each pass
+    // splits a segment at its worst sample. Long smooth arcs split lopsidedly
+    // (a plain run over a 1M-sample capture scanned each sample ~90 times),
+    // so the input is first cut into windows of WindowSamples whose ends are
+    // kept. A sample is then rescanned once per split above it within its
+    // window: about log W times in practice, O(n log W) overall, and never
+    // worse than O(n W). That costs at most one extra vertex per window.
+    // First and last samples are always kept.
+    class TrajectorySimplifier
+    {
+        public:
+            static constexpr size_t WindowSamples = 1024;
+
+            // Indices of the samples to keep, ascending.
+            static std::vector<size_t> SelectSamples(const TrajectorySpan& trajectory, const SimplifySettings& settings, double* maxError = nullptr);
+
+            // The kept samples with their timestamps and the input's metadata.
+            static Trajectory Simplify(const TrajectorySpan& trajectory, const SimplifySettings& settings, SimplifySummary* summary = nullptr);
+    };
+}
+
+#endif
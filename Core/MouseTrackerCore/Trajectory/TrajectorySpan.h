@@ -0,0 +1,102 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYSPAN__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYSPAN__
+
+#include "MouseTrackerCore/Trajectory/Trajectory.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Mt
+{
+    // Non-owning, read-only view of trajectory columns. The columns may live in
+    // a Trajectory or directly in a memory-mapped file; whoever hands out the
+    // span keeps the storage alive.
+    struct TrajectorySpan
+    {
+        const Point* Points = nullptr;
+
+        // Null when the samples carry no timestamps.
+        const int64_t* Timestamps = nullptr;
+
+        size_t Count = 0;
+        TrajectoryMetadata Metadata;
+
+        TrajectorySpan() = default;
+
+        TrajectorySpan(const Point* points, const int64_t* timestamps, size_t count, const TrajectoryMetadata& metadata)
+        {
+            Points = points;
+            Timestamps = timestamps;
+            Count = count;
+            Metadata = metadata;
+        }
+
+        // Implicit so every Trajectory consumer also accepts spans unchanged.
+        TrajectorySpan(const Trajectory& trajectory)
+        {
+            Points = trajectory.GetPoints().data();
+            Timestamps = trajectory.HasTimestamps() ? trajectory.GetTimestamps().data() : nullptr;
+            Count = trajectory.Size();
+            Metadata = trajectory.GetMetadata();
+        }
+
+        size_t Size() const
+        {
+            return Count;
+        }
+
+        bool Empty() const
+        {
+            return Count == 0;
+        }
+
+        bool HasTimestamps() const
+        {
+            return Timestamps != nullptr && Count > 0;
+        }
+
+        const Point& operator[](size_t index) const
+        {
+            return Points[index];
+        }
+
+        const Point& Front() const
+        {
+            return Points[0];
+        }
+
+        const Point& Back() const
+        {
+            return Points[Count - 1];
+        }
+
+        const Point* begin() const
+        {
+            return Points;
+        }
+
+        const Point* end() const
+        {
+            return Points + Count;
+        }
+
+        const TrajectoryMetadata& GetMetadata() const
+        {
+            return Metadata;
+        }
+
+        // Owning copy, for callers that need to modify the samples.
+        Trajectory ToTrajectory() const
+        {
+            Trajectory trajectory(std::vector<Point>(Points, Points + Count));
+
+            if (HasTimestamps())
+                trajectory.GetTimestamps().assign(Timestamps, Timestamps + Count);
+
+            trajectory.SetMetadata(Metadata);
+
+            return trajectory;
+        }
+    };
+}
+
+#endif
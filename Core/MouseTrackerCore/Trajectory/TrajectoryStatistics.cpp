@@ -0,0 +1,54 @@
+#include "MouseTrackerCore/Trajectory/TrajectoryStatistics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Mt
+{
+    TrajectoryStatistics TrajectoryStatistics::Compute(const TrajectorySpan& trajectory)
+    {
+        TrajectoryStatistics statistics;
+        statistics.Samples = trajectory.Size();
+
+        if (trajectory.Empty())
+            return statistics;
+
+        const Point* points = trajectory.Points;
+        const int64_t* timestamps = trajectory.HasTimestamps() ? trajectory.Timestamps : nullptr;
+        const int64_t period = trajectory.GetMetadata().PeriodUs;
+
+        statistics.MinX = statistics.MaxX = points[0].x;
+        statistics.MinY = statistics.MaxY = points[0].y;
+
+        double maxSquaredSpeed = 0.0;
+
+        for (size_t i = 1; i < trajectory.Size(); i++)
+        {
+            statistics.MinX = (std::min)(statistics.MinX, points[i].x);
+            statistics.MinY = (std::min)(statistics.MinY, points[i].y);
+            statistics.MaxX = (std::max)(statistics.MaxX, points[i].x);
+            statistics.MaxY = (std::max)(statistics.MaxY, points[i].y);
+
+            double dx = static_cast<double>(points[i].x) - points[i - 1].x;
+            double dy = static_cast<double>(points[i].y) - points[i - 1].y;
+            double squaredStep = dx * dx + dy * dy;
+            int64_t interval = timestamps ? timestamps[i] - timestamps[i - 1] : period;
+
+            statistics.PathLength += std::sqrt(squaredStep);
+            statistics.MaxIntervalUs = (std::max)(statistics.MaxIntervalUs, interval);
+
+            if (interval > 0)
+                maxSquaredSpeed = (std::max)(maxSquaredSpeed, squaredStep / (static_cast<double>(interval) * interval));
+        }
+
+        statistics.DurationUs = timestamps
+            ? timestamps[trajectory.Size() - 1] - timestamps[0]
+            : static_cast<int64_t>(trajectory.Size() - 1) * period;
+
+        if (statistics.DurationUs > 0)
+            statistics.MeanSpeed = statistics.PathLength * 1e6 / statistics.DurationUs;
+
+        statistics.MaxSpeed = std::sqrt(maxSquaredSpeed) * 1e6;
+
+        return statistics;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef __MOUSE_TRACKER_CORE_TRAJECTORYSTATISTICS__
+#define __MOUSE_TRACKER_CORE_TRAJECTORYSTATISTICS__
+
+#include "MouseTrackerCore/Trajectory/TrajectorySpan.h"
+#include <cstdint>
+
+namespace Mt
+{
+    // Summary of one trajectory in a single pass. Times come from the
+    // timestamps, or from the sampling period when there are none; speeds
+    // are 0 when neither is known.
+    struct TrajectoryStatistics
+    {
+        uint64_t Samples = 0;
+        int64_t DurationUs = 0;
+
+        int32_t MinX = 0;
+        int32_t MinY = 0;
+        int32_t MaxX = 0;
+        int32_t MaxY = 0;
+
+        // Sum of the straight segments between consecutive samples, in pixels.
+        double PathLength = 0.0;
+
+        // Pixels per second: the path length over the duration, and the
+        // fastest single segment.
+        double MeanSpeed = 0.0;
+        double MaxSpeed = 0.0;
+
+        // Longest time between two consecutive samples, e.g. a stalled recorder.
+        int64_t MaxIntervalUs = 0;
+
+        static TrajectoryStatistics Compute(const TrajectorySpan& trajectory);
+    };
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifdef MT_CORE_HAS_C_API
+
+#include "TestFramework.h"
+#include "MtCore.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+
+MT_TEST(CApiRoundTripsEveryCodecThroughCallerBuffers)
+{
+    Mt::Tests::TempDirectory directory("c_api");
+
+    const uint64_t count = 5000;
+    std::vector<int32_t> points(2 * count);
+    std::vector<int64_t> timestamps(count);
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        points[2 * i] = static_cast<int32_t>(i % 1920);
+        points[2 * i + 1] = -static_cast<int32_t>(i / 7);
+        timestamps[i] = static_cast<int64_t>(i) * 1000 + (i % 3) * 100;
+    }
+
+    mt_trajectory_info info = {};
+    info.period_us = 1000;
+    info.start_time_us = 1700000000000000;
+    info.screen_width = 2560;
+
+    MT_CHECK_EQ(mt_api_version(), MT_CORE_API_VERSION);
+
+    for (const char* codec : { "binary", "binary-delta", "binary-predictive", "text" })
+    {
+        std::string filename = directory.File(std::string(codec) + ".crs");
+        bool timed = std::string(codec) != "text";
+
+        MT_CHECK_EQ(mt_write(filename.c_str(), codec, points.data(), timestamps.data(), count, &info), MT_OK);
+
+        mt_trajectory* trajectory = nullptr;
+        MT_CHECK_EQ(mt_open(filename.c_str(), &trajectory), MT_OK);
+
+        mt_trajectory_info loaded;
+        mt_get_info(trajectory, &loaded);
+
+        MT_CHECK_EQ(loaded.samples, count);
+        MT_CHECK_EQ(loaded.has_timestamps, timed ? 1 : 0);
+        MT_CHECK_EQ(loaded.screen_width, timed ? 2560 : 0);
+
+        // Read in place, and copied out in two pieces.
+        std::vector<int32_t> copiedPoints(2 * count);
+        std::vector<int64_t> copiedTimestamps(count);
+
+        MT_CHECK(std::equal(points.begin(), points.end(), mt_get_points(trajectory)));
+        MT_CHECK_EQ(mt_copy_samples(trajectory, 0, 1000, copiedPoints.data(), copiedTimestamps.data()), 1000u);
+        MT_CHECK_EQ(mt_copy_samples(trajectory, 1000, 2 * count, copiedPoints.data() + 2000, copiedTimestamps.data() + 1000), count - 1000);
+        MT_CHECK(copiedPoints == points);
+        MT_CHECK(timed ? copiedTimestamps == timestamps : mt_get_timestamps(trajectory) == nullptr);
+
+        mt_close(trajectory);
+    }
+
+    mt_trajectory* missing = nullptr;
+
+    MT_CHECK_EQ(mt_open(directory.File("missing.crsbin").c_str(), &missing), MT_ERROR);
+    MT_CHECK(missing == nullptr);
+    MT_CHECK(std::string(mt_last_error()).size() > 0);
+    MT_CHECK_EQ(mt_write(directory.File("x.crsbin").c_str(), "no-such-codec", points.data(), nullptr, count, nullptr), MT_ERROR);
+
+    // The kernels run over the caller's columns as they are.
+    uint64_t resampled = mt_resampled_size(timestamps.data(), count, 0, 2000);
+    std::vector<int32_t> resampledPoints(2 * resampled);
+
+    MT_CHECK_EQ(resampled, static_cast<uint64_t>((timestamps.back() - timestamps.front()) / 2000 + 1));
+    MT_CHECK_EQ(mt_resample(points.data(), timestamps.data(), count, 0, 2000, resampledPoints.data(), nullptr, resampled), resampled);
+
+    mt_statistics statistics;
+    mt_compute_statistics(points.data(), timestamps.data(), count, 0, &statistics);
+
+    MT_CHECK_EQ(statistics.samples, count);
+    MT_CHECK_EQ(statistics.max_x, 1919);
+    MT_CHECK_EQ(statistics.min_y, -static_cast<int32_t>((count - 1) / 7));
+    MT_CHECK(statistics.path_length > 0.0);
+}
+
+#endif
@@ -0,0 +1,506 @@
+#include "TestFramework.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryParser.h"
+#include "MouseTrackerCore/Codecs/TextTrajectoryWriter.h"
+#include "MouseTrackerCore/Codecs/PredictiveCoder.h"
+#include "MouseTrackerCore/Codecs/ProgressiveTrajectoryLoader.h"
+#include <sstream>
+#include <fstream>
+#include <cmath>
+#include <climits>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace Mt;
+
+MT_TEST(TextCodecRoundTrip)
+{
+    Tests::TempDirectory directory("text_round_trip");
+    std::string filename = directory.File("trajectory_1.crsdat");
+
+    Trajectory original({ { 0, 0 }, { -15, 20 }, { 1919, 1079 }, { 2147483647, -2147483647 } });
+
+    MT_CHECK(TrajectoryIo::Save(filename, original).Success);
+
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load(filename, loaded);
+
+    MT_CHECK(result.Success);
+    MT_CHECK(result.Warnings.empty());
+    MT_CHECK(loaded.GetPoints() == original.GetPoints());
+}
+
+MT_TEST(TextCodecSkipsMalformedLines)
+{
+    Tests::TempDirectory directory("text_malformed");
+    std::string filename = directory.File("broken.crsdat");
+
+    {
+        std::ofstream file(filename);
+        file << "1;2\n" << "garbage\n" << "a;b\n" << "3;4\n" << ";\n" << "5;6";
+    }
+
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load(filename, loaded);
+
+    MT_CHECK(result.Success);
+    MT_CHECK_EQ(loaded.Size(), 3u);
+    MT_CHECK(loaded.Back() == (Point { 5, 6 }));
+    MT_CHECK_EQ(result.Warnings.size(), 1u);
+    MT_CHECK_EQ(result.Warnings.front(), std::string("2 invalid lines in trajectory file skipped (lines 3, 5); first: a;b"));
+    MT_CHECK_EQ(result.MalformedRecords, 2u);
+}
+
+MT_TEST(TextCodecRejectsTrailingTextButKeepsBlanksAndSigns)
+{
+    Tests::TempDirectory directory("text_trailing");
+    std::string filename = directory.File("trailing.crsdat");
+
+    {
+        std::ofstream file(filename);
+        file << "12;34abc\n" << "7x;8\n" << " +9 ;\t-10 \r\n" << "11;12\n";
+    }
+
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load(filename, loaded);
+
+    MT_CHECK(result.Success);
+    MT_CHECK_EQ(loaded.Size(), 2u);
+    MT_CHECK(loaded[0] == (Point { 9, -10 }));
+    MT_CHECK(loaded[1] == (Point { 11, 12 }));
+    MT_CHECK_EQ(result.MalformedRecords, 2u);
+}
+
+MT_TEST(TextCodecParsesAcrossBlocksAndAggregatesMalformedLines)
+{
+    Tests::TempDirectory directory("text_blocks");
+    std::string filename = directory.File("large.crsdat");
+    size_t expected = 0;
+
+    {
+        std::ofstream file(filename, std::ios::binary);
+
+        // Enough lines to cross several read blocks at arbitrary offsets.
+        for (int i = 0; i < 400000; i++)
+        {
+            if (i % 1000 == 7)
+            {
+                file << i << ";oops\n";
+
+                continue;
+            }
+
+            file << (i % 3 == 0 ? " +" : "") << i << "; " << -i << (i % 2 == 0 ? "\r\n" : "\n");
+            expected++;
+        }
+
+        file << "2147483648;0\n" << "1;2;3\n" << "\n" << "9;9";
+        expected++;
+    }
+
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load(filename, loaded);
+
+    MT_CHECK(result.Success);
+    MT_CHECK_EQ(loaded.Size(), expected);
+    MT_CHECK(loaded[1] == (Point { 1, -1 }));
+    MT_CHECK(loaded.Back() == (Point { 9, 9 }));
+    MT_CHECK_EQ(result.MalformedRecords, 402u);
+    MT_CHECK_EQ(result.Warnings.size(), 1u);
+    MT_CHECK(result.Warnings.front().find("402 invalid lines in trajectory file skipped (lines 8, 1008, 2008,") == 0);
+    MT_CHECK(result.Warnings.front().find(", ... 400002); first: 7;oops") != std::string::npos);
+}
+
+MT_TEST(TextWriterFormatsLikeStreams)
+{
+    Trajectory trajectory;
+    std::ostringstream expected;
+
+    for (int i = 0; i < 7; i++)
+    {
+        Point point { i * 1001 - 3000, i % 2 == 0 ? -2147483647 - 1 : 2147483647 };
+        trajectory.Add(point);
+        expected << point.x << ";" << point.y << "\n";
+    }
+
+    std::ostringstream output;
+    TextTrajectoryWriter writer;
+
+    MT_CHECK(writer.Write(output, trajectory));
+    MT_CHECK_EQ(output.str(), expected.str());
+}
+
+MT_TEST(LoadMissingFileFails)
+{
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load("/nonexistent/dir/missing.crsdat", loaded);
+
+    MT_CHECK(!result.Success);
+    MT_CHECK(!result.Error.empty());
+}
+
+MT_TEST(CodecLookupByExtension)
+{
+    auto& registry = TrajectoryCodecRegistry::GetInstance();
+
+    MT_CHECK_EQ(std::string(registry.GetCodecForFile("a/b/trajectory_3.CRSDAT")->GetName()), "text");
+    MT_CHECK_EQ(TrajectoryCodecRegistry::GetExtension("dir.v2/file"), "");
+    MT_CHECK(registry.GetCodec("text") != nullptr);
+}
+
+namespace
+{
+    Trajectory MakeTimedTrajectory()
+    {
+        Trajectory trajectory;
+        TrajectoryMetadata metadata;
+        metadata.PeriodUs = 1000;
+        metadata.StartTimeUs = 1700000000123456;
+        metadata.ScreenWidth = 2560;
+        metadata.ScreenHeight = 1440;
+        trajectory.SetMetadata(metadata);
+
+        for (int i = 0; i < 1000; i++)
+            trajectory.Add(Point { 100 + i % 37 - (i % 5) * 300, -i * 3 }, i * 1000 + i % 7);
+
+        trajectory.Add(Point { 2147483647, -2147483647 - 1 }, 5000000000);
+
+        return trajectory;
+    }
+
+    void CheckSameTrajectory(const Trajectory& loaded, const Trajectory& original)
+    {
+        MT_CHECK(loaded.GetPoints() == original.GetPoints());
+        MT_CHECK(loaded.GetTimestamps() == original.GetTimestamps());
+        MT_CHECK_EQ(loaded.GetMetadata().PeriodUs, original.GetMetadata().PeriodUs);
+        MT_CHECK_EQ(loaded.GetMetadata().StartTimeUs, original.GetMetadata().StartTimeUs);
+        MT_CHECK_EQ(loaded.GetMetadata().ScreenWidth, original.GetMetadata().ScreenWidth);
+        MT_CHECK_EQ(loaded.GetMetadata().ScreenHeight, original.GetMetadata().ScreenHeight);
+    }
+}
+
+MT_TEST(BinaryCodecRoundTripsBothEncodings)
+{
+    Tests::TempDirectory directory("binary_round_trip");
+    Trajectory original = MakeTimedTrajectory();
+
+    for (const char* codecName : { "binary", "binary-delta", "binary-predictive" })
+    {
+        const ITrajectoryCodec* codec = TrajectoryCodecRegistry::GetInstance().GetCodec(codecName);
+        std::string filename = directory.File(std::string(codecName) + ".crsbin");
+
+        MT_CHECK(codec != nullptr);
+        MT_CHECK(codec->Write(filename, original).Success);
+
+        Trajectory loaded;
+        MT_CHECK(TrajectoryIo::Load(filename, loaded).Success);
+        CheckSameTrajectory(loaded, original);
+    }
+
+    Trajectory untimed({ { 1, 2 }, { 3, 4 } });
+    std::string filename = directory.File("untimed.crsbin");
+
+    MT_CHECK(TrajectoryIo::Save(filename, untimed).Success);
+
+    Trajectory loaded;
+    MT_CHECK(TrajectoryIo::Load(filename, loaded).Success);
+    MT_CHECK(loaded.GetPoints() == untimed.GetPoints());
+    MT_CHECK(!loaded.HasTimestamps());
+}
+
+MT_TEST(PredictiveEncodingRoundTripsExtremesAndContainsDamage)
+{
+    // Several blocks of smooth strokes with jumps, a pause, extreme
+    // coordinates and timestamps that wrap, so every predictor order and
+    // escape width gets used.
+    Trajectory original;
+    uint32_t seed = 99;
+
+    for (int i = 0; i < 100000; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+
+        int x = static_cast<int>(400 * std::sin(i * 0.001)) + (i % 20000 == 0 ? 1500 : 0);
+        int y = (i / 5000) % 2 ? 300 : static_cast<int>(seed >> 29);
+        int64_t time = i * 1000LL + (seed >> 28);
+
+        if (i == 777)
+            original.Add(Point { 2147483647, -2147483647 - 1 }, INT64_MAX);
+        else if (i == 778)
+            original.Add(Point { -2147483647 - 1, 2147483647 }, INT64_MIN);
+        else
+            original.Add(Point { x, y }, time);
+    }
+
+    for (size_t count : { size_t(0), size_t(1), original.Size() })
+    {
+        TrajectorySpan span(original.GetPoints().data(), original.GetTimestamps().data(), count, original.GetMetadata());
+        BinaryTrajectoryHeader header = BinaryTrajectoryCodec::MakeHeader(span, BinaryEncoding::Predictive);
+        std::vector<uint8_t> payload = BinaryTrajectoryCodec::EncodePayload(span, BinaryEncoding::Predictive);
+
+        Trajectory decoded;
+        MT_CHECK(BinaryTrajectoryCodec::DecodePayload(header, payload.data(), payload.size(), decoded).Success);
+        MT_CHECK_EQ(decoded.Size(), count);
+        MT_CHECK(decoded.GetPoints() == span.ToTrajectory().GetPoints());
+        MT_CHECK(decoded.GetTimestamps() == span.ToTrajectory().GetTimestamps());
+    }
+
+    BinaryTrajectoryHeader header = BinaryTrajectoryCodec::MakeHeader(original, BinaryEncoding::Predictive);
+    std::vector<uint8_t> payload = BinaryTrajectoryCodec::EncodePayload(original, BinaryEncoding::Predictive);
+
+    MT_CHECK(payload.size() < BinaryTrajectoryCodec::EncodePayload(original, BinaryEncoding::DeltaVarint).size());
+
+    // Damage in the last block keeps every block before it.
+    std::vector<uint8_t> damaged = payload;
+    damaged[damaged.size() - 40] ^= 0x5A;
+
+    Trajectory decoded;
+    CodecResult result = BinaryTrajectoryCodec::DecodePayload(header, damaged.data(), damaged.size(), decoded);
+
+    MT_CHECK(!result.Success);
+    MT_CHECK_EQ(decoded.Size(), 3 * PredictiveCoder::BlockSamples);
+    MT_CHECK_EQ(decoded.GetTimestamps().size(), decoded.Size());
+    MT_CHECK(decoded[12345] == original[12345]);
+
+    // Truncation anywhere fails cleanly.
+    for (size_t size : { size_t(0), size_t(1), payload.size() / 2, payload.size() - 1 })
+        MT_CHECK(!BinaryTrajectoryCodec::DecodePayload(header, payload.data(), size, decoded).Success);
+}
+
+MT_TEST(PredictiveDecoderFailsOnZeroedStream)
+{
+    Tests::TempDirectory directory("predictive_zeroed");
+    std::string filename = directory.File("trajectory.crsbin");
+
+    Trajectory original;
+
+    for (int i = 0; i < 9000; i++)
+        original.Add(Point { static_cast<int>(300 * std::sin(i * 0.01)), i % 700 }, i * 1000LL);
+
+    MT_CHECK(TrajectoryCodecRegistry::GetInstance().GetCodec("binary-predictive")->Write(filename, original).Success);
+
+    // Zeroed rANS state bytes used to leave the decoder renormalising a zero
+    // state forever; every zeroed window must now fail (or decode) and return.
+    BinaryTrajectoryHeader header = BinaryTrajectoryCodec::MakeHeader(original, BinaryEncoding::Predictive);
+    std::vector<uint8_t> payload = BinaryTrajectoryCodec::EncodePayload(original, BinaryEncoding::Predictive);
+
+    for (size_t offset = 0; offset + 8 <= payload.size(); offset += 3)
+    {
+        std::vector<uint8_t> damaged = payload;
+        std::fill(damaged.begin() + offset, damaged.begin() + offset + 8, 0);
+
+        Trajectory decoded;
+        BinaryTrajectoryCodec::DecodePayload(header, damaged.data(), damaged.size(), decoded);
+        MT_CHECK(decoded.Size() <= original.Size());
+    }
+
+    {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(84);
+        file.write("\0\0\0\0\0\0\0\0", 8);
+    }
+
+    Trajectory loaded;
+    MT_CHECK(!TrajectoryIo::Load(filename, loaded).Success);
+}
+
+MT_TEST(BinaryCodecRejectsTruncatedAndForeignFiles)
+{
+    Tests::TempDirectory directory("binary_rejects");
+    std::string filename = directory.File("trajectory.crsbin");
+
+    MT_CHECK(TrajectoryCodecRegistry::GetInstance().GetCodec("binary-delta")->Write(filename, MakeTimedTrajectory()).Success);
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 3);
+
+    Trajectory loaded;
+    MT_CHECK(!TrajectoryIo::Load(filename, loaded).Success);
+
+    std::ofstream(filename, std::ios::trunc) << "1;2\n3;4\n";
+    MT_CHECK(!TrajectoryIo::Load(filename, loaded).Success);
+
+    BinaryTrajectoryHeader header;
+    header.Version = BinaryTrajectoryHeader::CurrentVersion + 1;
+    MT_CHECK(!header.Validate().empty());
+}
+
+MT_TEST(BinaryCodecRejectsWrappingSampleCount)
+{
+    Tests::TempDirectory directory("binary_wrapping");
+    std::string filename = directory.File("crafted.crsbin");
+
+    // 2^61 + 1 samples of 8 bytes wrap to a payload of 8 bytes, which is
+    // exactly what the 72-byte file holds.
+    BinaryTrajectoryHeader header;
+    header.SampleCount = (uint64_t(1) << 61) + 1;
+    header.PayloadBytes = 8;
+
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write("\0\0\0\0\0\0\0\0", 8);
+    }
+
+    MT_CHECK(!header.Validate().empty());
+    MT_CHECK(!header.FitsIn(72));
+    MT_CHECK_EQ(BinaryTrajectoryHeader::GetFixedPayloadBytes(header.SampleCount, false), UINT64_MAX);
+
+    Trajectory loaded;
+    MT_CHECK(!TrajectoryIo::Load(filename, loaded).Success);
+
+    MappedTrajectory mapped;
+    MT_CHECK(!mapped.Open(filename).Success);
+    MT_CHECK(mapped.GetSpan().Empty());
+
+    // A payload size near 2^64 must not wrap the bounds check either.
+    BinaryTrajectoryHeader delta;
+    delta.Encoding = static_cast<uint8_t>(BinaryEncoding::DeltaVarint);
+    delta.SampleCount = 1;
+    delta.PayloadBytes = UINT64_MAX - 32;
+    MT_CHECK(delta.Validate().empty());
+    MT_CHECK(!delta.FitsIn(72));
+}
+
+MT_TEST(MappedTrajectoryMapsFixedAndDecodesTheRest)
+{
+    Tests::TempDirectory directory("mapped_trajectory");
+    Trajectory original = MakeTimedTrajectory();
+
+    std::string fixedFilename = directory.File("fixed.crsbin");
+    std::string deltaFilename = directory.File("delta.crsbin");
+    std::string textFilename = directory.File("text.crsdat");
+
+    MT_CHECK(TrajectoryCodecRegistry::GetInstance().GetCodec("binary")->Write(fixedFilename, original).Success);
+    MT_CHECK(TrajectoryCodecRegistry::GetInstance().GetCodec("binary-delta")->Write(deltaFilename, original).Success);
+    MT_CHECK(TrajectoryIo::Save(textFilename, original).Success);
+
+    MappedTrajectory fixed;
+    MT_CHECK(fixed.Open(fixedFilename).Success);
+    MT_CHECK(fixed.IsMapped());
+    CheckSameTrajectory(fixed.GetSpan().ToTrajectory(), original);
+
+    MappedTrajectory delta;
+    MT_CHECK(delta.Open(deltaFilename).Success);
+    MT_CHECK(!delta.IsMapped());
+    CheckSameTrajectory(delta.GetSpan().ToTrajectory(), original);
+
+    MappedTrajectory text;
+    MT_CHECK(text.Open(textFilename).Success);
+    MT_CHECK(text.GetSpan().ToTrajectory().GetPoints() == original.GetPoints());
+    MT_CHECK(!text.GetSpan().HasTimestamps());
+
+    // Spans of mapped files save like any trajectory.
+    std::string copyFilename = directory.File("copy.crsbin");
+    MT_CHECK(TrajectoryIo::Save(copyFilename, fixed.GetSpan()).Success);
+
+    Trajectory copy;
+    MT_CHECK(TrajectoryIo::Load(copyFilename, copy).Success);
+    CheckSameTrajectory(copy, original);
+
+    std::filesystem::resize_file(deltaFilename, 70);
+    MT_CHECK(!delta.Open(deltaFilename).Success);
+    MT_CHECK(delta.GetSpan().Empty());
+
+    MT_CHECK(!delta.Open(directory.File("missing.crsbin")).Success);
+}
+
+MT_TEST(ProgressiveLoaderPublishesPartsAndCancels)
+{
+    Tests::TempDirectory directory("progressive_load");
+    std::string textFilename = directory.File("large.crsdat");
+    std::string packedFilename = directory.File("packed.crsbin");
+    std::string smallFilename = directory.File("small.crsdat");
+
+    Trajectory large;
+
+    for (int i = 0; i < 1000000; i++)
+        large.Add(Point { i % 1920, i / 1000 }, i * 1000LL);
+
+    MT_CHECK(TrajectoryIo::Save(textFilename, large).Success);
+    MT_CHECK(TrajectoryCodecRegistry::GetInstance().GetCodec("binary-predictive")->Write(packedFilename, large).Success);
+    MT_CHECK(TrajectoryIo::Save(smallFilename, Trajectory({ { 1, 2 }, { 3, 4 } })).Success);
+
+    std::mutex mutex;
+    std::vector<size_t> partials;
+    std::vector<bool> partialTimestamps;
+    std::vector<std::string> loaded;
+    std::shared_ptr<const MappedTrajectory> last;
+    std::atomic<bool> slow { false };
+
+    ProgressiveLoadSettings settings;
+    settings.FirstPublishSamples = 1000;
+    settings.PublishInterval = std::chrono::milliseconds(0);
+
+    settings.OnPartial = [&](std::shared_ptr<const MappedTrajectory> trajectory)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            partials.push_back(trajectory->GetSpan().Size());
+            partialTimestamps.push_back(trajectory->GetSpan().HasTimestamps());
+        }
+
+        if (slow)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    };
+
+    settings.OnLoaded = [&](const std::string& filename, std::shared_ptr<const MappedTrajectory> trajectory, const CodecResult& result)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        MT_CHECK(result.Success);
+        loaded.push_back(filename);
+        last = std::move(trajectory);
+    };
+
+    ProgressiveTrajectoryLoader loader(settings);
+
+    // Text and predictive both show growing prefixes before the whole file.
+    for (const std::string& filename : { textFilename, packedFilename })
+    {
+        partials.clear();
+        partialTimestamps.clear();
+        loader.Load(filename);
+        loader.Wait();
+
+        MT_CHECK(partials.size() >= 2);
+        MT_CHECK(std::is_sorted(partials.begin(), partials.end()));
+        MT_CHECK(partials.back() < large.Size());
+        MT_CHECK_EQ(loaded.back(), filename);
+        MT_CHECK(last->GetSpan().ToTrajectory().GetPoints() == large.GetPoints());
+        MT_CHECK(!loader.GetProgress().Active);
+        MT_CHECK_EQ(loader.GetProgress().Samples, large.Size());
+    }
+
+    // Predictive blocks carry their timestamps along.
+    MT_CHECK(partialTimestamps.front());
+    MT_CHECK(last->GetSpan().HasTimestamps());
+
+    // A second load cancels the first; nothing of the first gets out after that.
+    slow = true;
+    loaded.clear();
+    partials.clear();
+    loader.Load(textFilename);
+
+    while (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!partials.empty())
+            break;
+    }
+
+    loader.Load(smallFilename);
+    loader.Wait();
+
+    MT_CHECK_EQ(loaded.size(), 1u);
+    MT_CHECK_EQ(loaded.front(), smallFilename);
+    MT_CHECK_EQ(last->GetSpan().Size(), 2u);
+
+    loader.Load(textFilename);
+    loader.Cancel();
+    loader.Wait();
+
+    MT_CHECK_EQ(loaded.size(), 1u);
+    MT_CHECK(!loader.GetProgress().Active);
+}
@@ -0,0 +1,668 @@
+#include "TestFramework.h"
+#include "MouseTrackerCore/Dataset/DirectoryProcessor.h"
+#include "MouseTrackerCore/Dataset/DatasetManifest.h"
+#include "MouseTrackerCore/Dataset/DatasetBrowser.h"
+#include "MouseTrackerCore/Dataset/TrajectoryDataset.h"
+#include "MouseTrackerCore/Dataset/NumpyExporter.h"
+#include "MouseTrackerCore/Dataset/NumpyWriter.h"
+#include "MouseTrackerCore/Codecs/Crc32.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchiveWriter.h"
+#include "MouseTrackerCore/Storage/TrajectoryWriteService.h"
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <cstring>
+
+using namespace Mt;
+
+namespace
+{
+    // Watcher events arrive on another thread; gives them up to two seconds.
+    template<typename Predicate>
+    bool WaitFor(Predicate predicate)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        return true;
+    }
+
+    void WriteSampleTree(const Tests::TempDirectory& directory)
+    {
+        std::filesystem::create_directories(directory.GetPath() / "in" / "nested");
+
+        for (int i = 0; i < 8; i++)
+        {
+            Trajectory trajectory({ { i, i }, { i + 1, i + 2 }, { i + 3, i + 5 } });
+            std::string relative = (i % 2 == 0 ? "in/trajectory_" : "in/nested/trajectory_") + std::to_string(i) + ".crsdat";
+
+            TrajectoryIo::Save(directory.File(relative), trajectory);
+        }
+
+        std::ofstream(directory.File("in/notes.txt")) << "not a trajectory";
+        std::ofstream(directory.File("in/nested/broken.crsdat")) << "1;2\nx;y\n3;4\n";
+    }
+
+    std::string ReadFile(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    template<typename T>
+    T ReadLittleEndian(const std::string& bytes, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+
+        return value;
+    }
+}
+
+MT_TEST(DirectoryProcessorValidatesTree)
+{
+    Tests::TempDirectory directory("dataset_validate");
+    WriteSampleTree(directory);
+
+    DirectoryProcessSettings settings;
+    settings.InputDirectory = directory.File("in");
+    settings.Threads = 3;
+
+    DirectoryProcessSummary summary = DirectoryProcessor::Run(settings);
+
+    MT_CHECK_EQ(summary.FilesProcessed, 9u);
+    MT_CHECK_EQ(summary.FilesFailed, 0u);
+    MT_CHECK_EQ(summary.FilesWithWarnings, 1u);
+    MT_CHECK_EQ(summary.MalformedRecords, 1u);
+    MT_CHECK_EQ(summary.Samples, 26u);
+    MT_CHECK_EQ(summary.BytesWritten, 0u);
+}
+
+MT_TEST(DirectoryProcessorConvertMirrorsTree)
+{
+    Tests::TempDirectory directory("dataset_convert");
+    WriteSampleTree(directory);
+
+    DirectoryProcessSettings settings;
+    settings.Action = ProcessAction::Convert;
+    settings.InputDirectory = directory.File("in");
+    settings.OutputDirectory = directory.File("out");
+    settings.MaxInFlightBytes = 16;
+
+    DirectoryProcessSummary summary = DirectoryProcessor::Run(settings);
+
+    MT_CHECK_EQ(summary.FilesFailed, 0u);
+    MT_CHECK(summary.PeakInFlightBytes <= 64u);
+
+    Trajectory loaded;
+    MT_CHECK(TrajectoryIo::Load(directory.File("out/nested/trajectory_3.crsdat"), loaded).Success);
+    MT_CHECK_EQ(loaded.Size(), 3u);
+    MT_CHECK(loaded[2] == Point({ 6, 8 }));
+    MT_CHECK(!std::filesystem::exists(directory.File("out/notes.txt")));
+}
+
+MT_TEST(DirectoryProcessorKeepsSameStemOutputsApart)
+{
+    Tests::TempDirectory directory("dataset_convert_stems");
+    std::filesystem::create_directories(directory.GetPath() / "in");
+
+    Trajectory timed;
+
+    for (int i = 0; i < 10000; i++)
+        timed.Add(Point { i % 100, i / 100 }, i * 1000LL);
+
+    TrajectoryIo::Save(directory.File("in/a.crsdat"), Trajectory({ { 1, 2 } }));
+    MT_CHECK(TrajectoryCodecRegistry::GetInstance().GetCodec("binary-delta")->Write(directory.File("in/a.crsbin"), timed).Success);
+
+    DirectoryProcessSettings settings;
+    settings.Action = ProcessAction::Convert;
+    settings.InputDirectory = directory.File("in");
+    settings.OutputDirectory = directory.File("out");
+    settings.TargetCodec = "text";
+    settings.MaxInFlightBytes = 1;
+
+    DirectoryProcessSummary summary = DirectoryProcessor::Run(settings);
+
+    MT_CHECK_EQ(summary.FilesProcessed, 2u);
+    MT_CHECK_EQ(summary.FilesFailed, 0u);
+
+    // The delta file is charged its decoded columns, not its few bytes on disk.
+    MT_CHECK(summary.PeakInFlightBytes >= 10000u * 16u);
+    MT_CHECK(std::filesystem::file_size(directory.File("in/a.crsbin")) < 10000u * 16u);
+
+    Trajectory first;
+    Trajectory second;
+    bool plainIsText = TrajectoryIo::Load(directory.File("out/a.crsdat"), first).Success;
+    bool renamedExists = TrajectoryIo::Load(directory.File("out/a.crsbin.crsdat"), second).Success ||
+                         TrajectoryIo::Load(directory.File("out/a.crsdat.crsdat"), second).Success;
+
+    MT_CHECK(plainIsText && renamedExists);
+    MT_CHECK_EQ(first.Size() + second.Size(), 10001u);
+}
+
+MT_TEST(DirectoryProcessorExpandsArchives)
+{
+    Tests::TempDirectory directory("dataset_archive");
+    std::filesystem::create_directories(directory.GetPath() / "in");
+
+    TrajectoryArchiveWriter writer;
+    MT_CHECK(writer.Open(directory.File("in/session.crsarc")).Success);
+
+    for (int i = 0; i < 4; i++)
+        writer.Append(Trajectory({ { i, i }, { i, i + 1 } }));
+
+    writer.Close();
+
+    DirectoryProcessSettings settings;
+    settings.Action = ProcessAction::Convert;
+    settings.InputDirectory = directory.File("in");
+    settings.OutputDirectory = directory.File("out");
+    settings.TargetCodec = "binary";
+
+    DirectoryProcessSummary summary = DirectoryProcessor::Run(settings);
+
+    MT_CHECK_EQ(summary.FilesProcessed, 1u);
+    MT_CHECK_EQ(summary.Samples, 8u);
+
+    Trajectory loaded;
+    MT_CHECK(TrajectoryIo::Load(directory.File("out/session/entry_3.crsbin"), loaded).Success);
+    MT_CHECK(loaded[1] == Point({ 3, 4 }));
+}
+
+MT_TEST(DirectoryProcessorClaimsArchiveEntriesAndSkipsItsOutput)
+{
+    Tests::TempDirectory directory("dataset_archive_claims");
+    std::filesystem::create_directories(directory.GetPath() / "in" / "session");
+
+    TrajectoryArchiveWriter writer;
+    MT_CHECK(writer.Open(directory.File("in/session.crsarc")).Success);
+    writer.Append(Trajectory({ { 1, 1 } }));
+    writer.Append(Trajectory({ { 2, 2 } }));
+    writer.Close();
+
+    // Converts to the same name as archive entry 1. Whichever is scanned
+    // second renames itself (a file) or fails (an archive), never overwrites.
+    TrajectoryIo::Save(directory.File("in/session/entry_1.crsdat"), Trajectory({ { 3, 3 } }));
+
+    DirectoryProcessSettings settings;
+    settings.Action = ProcessAction::Convert;
+    settings.InputDirectory = directory.File("in");
+    settings.OutputDirectory = directory.File("in/out");
+    settings.TargetCodec = "binary";
+
+    DirectoryProcessSummary summary = DirectoryProcessor::Run(settings);
+    Trajectory loaded;
+
+    MT_CHECK_EQ(summary.FilesProcessed + summary.FilesFailed, 2u);
+    MT_CHECK(TrajectoryIo::Load(directory.File("in/out/session/entry_1.crsbin"), loaded).Success);
+
+    if (summary.FilesFailed == 0)
+        MT_CHECK(loaded[0] == Point({ 2, 2 }) && std::filesystem::exists(directory.File("in/out/session/entry_1.crsdat.crsbin")));
+    else
+        MT_CHECK(loaded[0] == Point({ 3, 3 }) && !std::filesystem::exists(directory.File("in/out/session/entry_0.crsbin")));
+
+    // The output lies inside the input, but a second run does not read it back.
+    summary = DirectoryProcessor::Run(settings);
+
+    MT_CHECK_EQ(summary.FilesProcessed + summary.FilesFailed, 2u);
+}
+
+MT_TEST(DirectoryProcessorReportsMissingInput)
+{
+    DirectoryProcessSettings settings;
+    settings.InputDirectory = (std::filesystem::temp_directory_path() / "mt_core_tests_missing_dir").string();
+
+    DirectoryProcessSummary summary = DirectoryProcessor::Run(settings);
+
+    MT_CHECK_EQ(summary.FilesProcessed, 0u);
+    MT_CHECK(!summary.Errors.empty());
+}
+
+MT_TEST(ConvertAndWriteServiceSimplify)
+{
+    Tests::TempDirectory directory("dataset_simplify");
+    std::filesystem::create_directories(directory.GetPath() / "in");
+
+    Trajectory line;
+
+    for (int i = 0; i < 500; i++)
+        line.Add(Point { i, i / 2 }, i * 1000);
+
+    MT_CHECK(TrajectoryIo::Save(directory.File("in/line.crsbin"), line).Success);
+
+    DirectoryProcessSettings settings;
+    settings.Action = ProcessAction::Convert;
+    settings.InputDirectory = directory.File("in");
+    settings.OutputDirectory = directory.File("out");
+    settings.TargetCodec = "binary";
+    settings.Simplify.Tolerance = 1.0;
+
+    DirectoryProcessSummary summary = DirectoryProcessor::Run(settings);
+
+    MT_CHECK_EQ(summary.FilesFailed, 0u);
+    MT_CHECK_EQ(summary.Samples, 500u);
+    MT_CHECK(summary.SamplesWritten >= 2u && summary.SamplesWritten < 50u);
+    MT_CHECK(summary.GetCompressionRatio() > 10.0);
+
+    Trajectory loaded;
+    MT_CHECK(TrajectoryIo::Load(directory.File("out/line.crsbin"), loaded).Success);
+    MT_CHECK_EQ(loaded.Size(), summary.SamplesWritten);
+    MT_CHECK(loaded.Back() == (Point { 499, 249 }));
+    MT_CHECK_EQ(loaded.GetTimestamps().back(), 499000);
+
+    TrajectoryWriteStats stats;
+
+    {
+        TrajectoryWriteService service;
+        auto shared = std::make_shared<const MappedTrajectory>(Trajectory(line));
+
+        MT_CHECK(service.Submit(TrajectoryWriteJob(directory.File("saved.crsbin"), shared, settings.Simplify)));
+        service.Drain();
+
+        stats = service.GetStats();
+        MT_CHECK_EQ(shared->GetSpan().Size(), 500u);
+    }
+
+    MT_CHECK_EQ(stats.SamplesSubmitted, 500u);
+    MT_CHECK_EQ(stats.SamplesWritten, summary.SamplesWritten);
+    MT_CHECK_EQ(DatasetManifest::ReadEntries(directory.GetPath().string())[0].SampleCount, summary.SamplesWritten);
+}
+
+MT_TEST(ManifestParsesIndexedNames)
+{
+    std::string baseFilename;
+    int index = 0;
+
+    MT_CHECK(DatasetManifest::ParseIndexedName("mouse_trajectory_12.crsdat", baseFilename, index));
+    MT_CHECK_EQ(baseFilename, std::string("mouse_trajectory"));
+    MT_CHECK_EQ(index, 12);
+
+    MT_CHECK(!DatasetManifest::ParseIndexedName("trajectory.crsdat", baseFilename, index));
+    MT_CHECK(!DatasetManifest::ParseIndexedName("trajectory_.crsdat", baseFilename, index));
+    MT_CHECK(!DatasetManifest::ParseIndexedName("trajectory_1a.crsbin", baseFilename, index));
+}
+
+MT_TEST(ManifestIsRebuiltOnceAndReservesFreshIndices)
+{
+    Tests::TempDirectory directory("dataset_manifest");
+    std::filesystem::create_directories(directory.GetPath());
+
+    for (int i : { 1, 2, 5 })
+        TrajectoryIo::Save(directory.File("run_" + std::to_string(i) + ".crsdat"), Trajectory({ { i, i } }));
+
+    DatasetManifest manifest;
+    MT_CHECK(manifest.Open(directory.GetPath().string()));
+    MT_CHECK_EQ(manifest.GetCount(), 3u);
+    MT_CHECK_EQ(manifest.PeekIndex("run"), 6);
+    MT_CHECK_EQ(manifest.PeekIndex("other"), 1);
+    MT_CHECK(std::filesystem::exists(directory.File(DatasetManifest::Filename)));
+
+    // Copied in after the manifest was written: skipped, not overwritten.
+    TrajectoryIo::Save(directory.File("run_6.crsdat"), Trajectory({ { 6, 6 } }));
+
+    MT_CHECK_EQ(manifest.ReserveIndex("run", ".crsdat"), 7);
+    MT_CHECK_EQ(manifest.ReserveIndex("run", ".crsdat"), 8);
+    MT_CHECK_EQ(manifest.ReserveIndex("other", ".crsbin"), 1);
+
+    // Reopening an unchanged directory reads the manifest without listing
+    // it: a name only the manifest knows stays known, also after Watch.
+    std::ofstream(directory.File(DatasetManifest::Filename), std::ios::app) << "ghost_4.crsdat;;;;;;\n";
+    std::filesystem::last_write_time(directory.GetPath(), std::filesystem::last_write_time(directory.File(DatasetManifest::Filename)) - std::chrono::seconds(10));
+
+    DatasetManifest reopened;
+    MT_CHECK(reopened.Open(directory.GetPath().string()));
+    MT_CHECK_EQ(reopened.PeekIndex("ghost"), 5);
+    MT_CHECK_EQ(reopened.GetCount(), 4u);
+
+    if (DirectoryWatcher::IsSupported())
+    {
+        MT_CHECK(reopened.Watch());
+        MT_CHECK_EQ(reopened.GetCount(), 4u);
+    }
+
+    // Files removed or copied in while nobody watched make the manifest
+    // stale, and the next Open completes it from the directory.
+    std::filesystem::remove(directory.File("run_5.crsdat"));
+    std::filesystem::last_write_time(directory.GetPath(), std::filesystem::last_write_time(directory.File(DatasetManifest::Filename)) + std::chrono::seconds(10));
+
+    DatasetManifest stale;
+    MT_CHECK(stale.Open(directory.GetPath().string()));
+    MT_CHECK(stale.GetNames() == std::vector<std::string>({ "run_1.crsdat", "run_2.crsdat", "run_6.crsdat" }));
+    MT_CHECK_EQ(stale.PeekIndex("run"), 7);
+}
+
+MT_TEST(WriteServiceAppendsManifestLines)
+{
+    Tests::TempDirectory directory("dataset_manifest_service");
+
+    {
+        TrajectoryWriteService service;
+
+        MT_CHECK(service.Submit(directory.File("run_1.crsdat"), Trajectory({ { 1, 2 }, { 5, -3 } })));
+        MT_CHECK(service.Submit(directory.File("run_2.crsbin"), Trajectory({ { 0, 0 } })));
+    }
+
+    std::vector<ManifestEntry> entries = DatasetManifest::ReadEntries(directory.GetPath().string());
+
+    MT_CHECK_EQ(entries.size(), 2u);
+    MT_CHECK_EQ(entries[0].Name, std::string("run_1.crsdat"));
+    MT_CHECK_EQ(entries[0].SampleCount, 2u);
+    MT_CHECK_EQ(entries[0].MinY, -3);
+    MT_CHECK_EQ(entries[0].MaxX, 5);
+
+    DatasetManifest manifest;
+    MT_CHECK(manifest.Open(directory.GetPath().string()));
+    MT_CHECK_EQ(manifest.PeekIndex("run"), 3);
+}
+
+MT_TEST(ManifestFollowsDirectoryChanges)
+{
+    if (!DirectoryWatcher::IsSupported())
+        return;
+
+    Tests::TempDirectory directory("dataset_manifest_watch");
+    std::filesystem::create_directories(directory.GetPath());
+    TrajectoryIo::Save(directory.File("run_1.crsdat"), Trajectory({ { 1, 1 } }));
+
+    DatasetManifest manifest;
+    MT_CHECK(manifest.Open(directory.GetPath().string()));
+    MT_CHECK(manifest.Watch());
+    MT_CHECK_EQ(manifest.GetCount(), 1u);
+
+    TrajectoryIo::Save(directory.File("run_9.crsbin"), Trajectory({ { 9, 9 } }));
+    std::ofstream(directory.File("notes.txt")) << "ignored";
+
+    MT_CHECK(WaitFor([&]() { return manifest.PeekIndex("run") == 10; }));
+    MT_CHECK_EQ(manifest.GetCount(), 2u);
+
+    std::filesystem::rename(directory.File("run_1.crsdat"), directory.File("moved_3.crsdat"));
+    MT_CHECK(WaitFor([&]() { return manifest.PeekIndex("moved") == 4; }));
+
+    std::filesystem::remove(directory.File("run_9.crsbin"));
+    MT_CHECK(WaitFor([&]() { return manifest.GetCount() == 1; }));
+
+    // Removing the highest number does not hand it out again.
+    MT_CHECK_EQ(manifest.PeekIndex("run"), 10);
+    MT_CHECK(manifest.GetNames() == std::vector<std::string>({ "moved_3.crsdat" }));
+}
+
+MT_TEST(DatasetBrowserLoadsThumbnailsInBackground)
+{
+    Tests::TempDirectory directory("dataset_browser");
+
+    {
+        TrajectoryWriteService service;
+
+        for (int i = 1; i <= 5; i++)
+        {
+            Trajectory trajectory;
+
+            for (int j = 0; j <= 1000; j++)
+                trajectory.Add({ j, i * j });
+
+            service.Submit(directory.File("run_" + std::to_string(i) + ".crsbin"), std::move(trajectory));
+        }
+    }
+
+    DatasetBrowserSettings settings;
+    settings.ThumbnailPoints = 11;
+
+    DatasetBrowser browser(settings);
+    MT_CHECK(browser.Open(directory.GetPath().string()).Success);
+    MT_CHECK_EQ(browser.GetCount(), 5u);
+
+    // Summaries come from the manifest, before anything is decoded.
+    DatasetItem item = browser.GetItem(2);
+    MT_CHECK_EQ(item.Name, std::string("run_3.crsbin"));
+    MT_CHECK(item.HasSummary);
+    MT_CHECK_EQ(item.Summary.SampleCount, 1001u);
+    MT_CHECK_EQ(item.Summary.MaxY, 3000);
+
+    std::shared_ptr<const DatasetThumbnail> thumbnail;
+    MT_CHECK(WaitFor([&]() { return (thumbnail = browser.GetThumbnail(2)) != nullptr; }));
+    MT_CHECK_EQ(thumbnail->Points.size(), 11u);
+    MT_CHECK(thumbnail->Points.back() == Point({ 1000, 3000 }));
+
+    // The thumbnail load kept the trajectory for opening the row.
+    auto trajectory = browser.GetTrajectory(2);
+    MT_CHECK(trajectory != nullptr);
+    MT_CHECK_EQ(trajectory->GetSpan().Size(), 1001u);
+    MT_CHECK_EQ(browser.GetStats().Loaded, 1u);
+}
+
+MT_TEST(DatasetBrowserListsArchiveEntries)
+{
+    Tests::TempDirectory directory("dataset_browser_archive");
+    std::filesystem::create_directories(directory.GetPath());
+
+    TrajectoryArchiveWriter writer;
+    MT_CHECK(writer.Open(directory.File("session.crsarc")).Success);
+
+    for (int i = 0; i < 3; i++)
+        writer.Append(Trajectory({ { i, i }, { i + 10, i + 20 } }));
+
+    writer.Close();
+
+    DatasetBrowser browser;
+    MT_CHECK(browser.Open(directory.File("session.crsarc")).Success);
+    MT_CHECK(browser.IsArchive());
+    MT_CHECK_EQ(browser.GetCount(), 3u);
+    MT_CHECK_EQ(browser.GetItem(1).Summary.MaxY, 21);
+
+    std::shared_ptr<const MappedTrajectory> trajectory;
+    MT_CHECK(WaitFor([&]() { return (trajectory = browser.GetTrajectory(2)) != nullptr; }));
+    MT_CHECK(trajectory->GetSpan()[1] == Point({ 12, 22 }));
+
+    MT_CHECK(!browser.Open(directory.File("missing")).Success);
+    MT_CHECK_EQ(browser.GetCount(), 0u);
+}
+
+MT_TEST(DatasetLoadsTreeIntoOneArena)
+{
+    Tests::TempDirectory directory("dataset_arena");
+    WriteSampleTree(directory);
+
+    TrajectoryArchiveWriter writer;
+    MT_CHECK(writer.Open(directory.File("in/session.crsarc")).Success);
+    writer.Append(Trajectory({ { 7, 7 } }));
+    writer.Append(Trajectory({ { 8, 8 }, { 9, 9 } }));
+    writer.Close();
+
+    std::ofstream(directory.File("in/nested/garbage.crsbin")) << "not binary";
+
+    DatasetLoadSettings settings;
+    settings.InputDirectory = directory.File("in");
+    settings.Threads = 3;
+
+    TrajectoryDataset dataset;
+    DatasetLoadSummary summary = dataset.Load(settings);
+
+    MT_CHECK_EQ(summary.Files, 10u);
+    MT_CHECK_EQ(summary.FilesFailed, 1u);
+    MT_CHECK_EQ(summary.Errors.size(), 1u);
+    MT_CHECK_EQ(summary.Trajectories, 11u);
+    MT_CHECK_EQ(summary.Samples, 29u);
+    MT_CHECK_EQ(dataset.GetOffsets().size(), 12u);
+    MT_CHECK_EQ(dataset.GetOffsets().back(), 29u);
+
+    // Sorted by path: nested/ comes first, archive entries keep their order.
+    MT_CHECK_EQ(dataset.GetName(0), std::string("nested/broken.crsdat"));
+    MT_CHECK_EQ(dataset.GetName(5), std::string("session.crsarc#0"));
+    MT_CHECK(dataset.GetSpan(6)[1] == Point({ 9, 9 }));
+    MT_CHECK(dataset.GetSpan(7)[2] == Point({ 3, 5 }));
+    MT_CHECK_EQ(dataset.GetSpan(1).Points + 3, dataset.GetSpan(2).Points);
+
+    // The text files have no timestamps, so the column is dropped for all.
+    MT_CHECK(!dataset.HasTimestamps());
+
+    // A single archive is a dataset of its own.
+    settings.InputDirectory = directory.File("in/session.crsarc");
+    summary = dataset.Load(settings);
+
+    MT_CHECK_EQ(summary.Trajectories, 2u);
+    MT_CHECK_EQ(dataset.GetName(1), std::string("session.crsarc#1"));
+}
+
+MT_TEST(DatasetKeepsTimestampsWhenAllHaveThem)
+{
+    Tests::TempDirectory directory("dataset_arena_timestamps");
+    std::filesystem::create_directories(directory.GetPath());
+
+    // Every encoding decodes in place into its slice of the arena.
+    const char* codecs[] = { "binary", "binary-delta", "binary-predictive", "binary" };
+
+    for (int i = 0; i < 4; i++)
+    {
+        Trajectory trajectory;
+        trajectory.Add({ i, 0 }, 1000 * i);
+        trajectory.Add({ i, 1 }, 1000 * i + 1);
+        TrajectoryCodecRegistry::GetInstance().GetCodec(codecs[i])->Write(directory.File("run_" + std::to_string(i) + ".crsbin"), trajectory);
+    }
+
+    // A payload cut short fails its file without disturbing the others.
+    std::string truncated = ReadFile(directory.File("run_2.crsbin"));
+    std::ofstream(directory.File("run_4.crsbin"), std::ios::binary) << truncated.substr(0, truncated.size() - 4);
+
+    DatasetLoadSettings settings;
+    settings.InputDirectory = directory.GetPath().string();
+    settings.Threads = 2;
+
+    TrajectoryDataset dataset;
+    DatasetLoadSummary summary = dataset.Load(settings);
+
+    MT_CHECK_EQ(summary.FilesFailed, 1u);
+    MT_CHECK_EQ(summary.Samples, 8u);
+    MT_CHECK(dataset.HasTimestamps());
+    MT_CHECK(dataset.GetSpan(2)[1] == Point({ 2, 1 }));
+    MT_CHECK_EQ(dataset.GetSpan(3).Timestamps[1], 3001);
+    MT_CHECK_EQ(dataset.GetTimestamps().size(), 8u);
+}
+
+MT_TEST(NumpyHeaderIsPaddedTo64Bytes)
+{
+    std::string header = NumpyWriter::MakeHeader("<i4", { 3, 2 });
+
+    MT_CHECK_EQ(header.size() % 64, 0u);
+    MT_CHECK_EQ(header.substr(0, 6), std::string("\x93NUMPY"));
+    MT_CHECK_EQ(header.back(), '\n');
+    MT_CHECK_EQ(ReadLittleEndian<uint16_t>(header, 8), header.size() - 10);
+    MT_CHECK(header.find("'shape': (3, 2)") != std::string::npos);
+    MT_CHECK(NumpyWriter::MakeHeader("<i8", { 5 }).find("'shape': (5,)") != std::string::npos);
+}
+
+MT_TEST(NumpyResampleInterpolatesByTimeOrIndex)
+{
+    float output[10];
+
+    NumpyExporter::Resample(Trajectory({ { 0, 0 }, { 10, 0 }, { 20, 4 } }), 5, output);
+
+    MT_CHECK_EQ(output[2], 5.0f);
+    MT_CHECK_EQ(output[6], 15.0f);
+    MT_CHECK_EQ(output[7], 2.0f);
+    MT_CHECK_EQ(output[8], 20.0f);
+
+    Trajectory timed;
+    timed.Add({ 0, 0 }, 0);
+    timed.Add({ 10, 0 }, 1000);
+    timed.Add({ 100, 0 }, 10000);
+
+    NumpyExporter::Resample(timed, 3, output);
+
+    MT_CHECK_EQ(output[0], 0.0f);
+    MT_CHECK_EQ(output[2], 50.0f);
+    MT_CHECK_EQ(output[4], 100.0f);
+
+    NumpyExporter::Resample(Trajectory(), 2, output);
+
+    MT_CHECK_EQ(output[3], 0.0f);
+}
+
+MT_TEST(NumpyExportWritesRaggedArrays)
+{
+    Tests::TempDirectory directory("numpy_ragged");
+    WriteSampleTree(directory);
+
+    DatasetLoadSettings loadSettings;
+    loadSettings.InputDirectory = directory.File("in");
+
+    TrajectoryDataset dataset;
+    dataset.Load(loadSettings);
+
+    NumpyExportSettings settings;
+    settings.OutputPath = directory.File("out");
+
+    NumpyExportSummary summary;
+    MT_CHECK(NumpyExporter::Export(dataset, settings, &summary).Success);
+    MT_CHECK_EQ(summary.Trajectories, 9u);
+
+    std::string points = ReadFile(directory.File("out/points.npy"));
+    std::string offsets = ReadFile(directory.File("out/offsets.npy"));
+    size_t pointsHeader = 10 + ReadLittleEndian<uint16_t>(points, 8);
+    size_t offsetsHeader = 10 + ReadLittleEndian<uint16_t>(offsets, 8);
+
+    MT_CHECK(points.find("'descr': '<i4'") != std::string::npos);
+    MT_CHECK(points.find("'shape': (26, 2)") != std::string::npos);
+    MT_CHECK_EQ(points.size() - pointsHeader, 26 * sizeof(Point));
+    MT_CHECK_EQ(ReadLittleEndian<int32_t>(points, pointsHeader + 8 * 25 + 4), dataset.GetPoints().back().y);
+    MT_CHECK_EQ(ReadLittleEndian<int64_t>(offsets, offsetsHeader + 8 * 9), 26);
+    MT_CHECK(std::filesystem::exists(directory.File("out/names.npy")));
+    MT_CHECK(std::filesystem::exists(directory.File("out/metadata.npy")));
+    MT_CHECK(!std::filesystem::exists(directory.File("out/timestamps.npy")));
+}
+
+MT_TEST(NumpyExportWritesStoredZipArchive)
+{
+    Tests::TempDirectory directory("numpy_npz");
+    WriteSampleTree(directory);
+
+    DatasetLoadSettings loadSettings;
+    loadSettings.InputDirectory = directory.File("in");
+
+    TrajectoryDataset dataset;
+    dataset.Load(loadSettings);
+
+    NumpyExportSettings settings;
+    settings.OutputPath = directory.File("dataset.npz");
+    settings.Layout = NumpyLayout::Resampled;
+    settings.Length = 16;
+    settings.Threads = 2;
+
+    MT_CHECK(NumpyExporter::Export(dataset, settings).Success);
+
+    // Walks the local headers: every member is stored and its CRC matches.
+    std::string archive = ReadFile(settings.OutputPath);
+    std::vector<std::string> members;
+    size_t position = 0;
+
+    while (ReadLittleEndian<uint32_t>(archive, position) == 0x04034B50)
+    {
+        uint32_t crc = ReadLittleEndian<uint32_t>(archive, position + 14);
+        uint32_t size = ReadLittleEndian<uint32_t>(archive, position + 18);
+        uint16_t nameLength = ReadLittleEndian<uint16_t>(archive, position + 26);
+        uint16_t extraLength = ReadLittleEndian<uint16_t>(archive, position + 28);
+        size_t data = position + 30 + nameLength + extraLength;
+
+        MT_CHECK_EQ(ReadLittleEndian<uint16_t>(archive, position + 8), 0);
+        MT_CHECK_EQ(Crc32::Compute(archive.data() + data, size), crc);
+
+        members.push_back(archive.substr(position + 30, nameLength));
+        position = data + size;
+    }
+
+    MT_CHECK_EQ(members.size(), 4u);
+    MT_CHECK_EQ(members[0], std::string("points.npy"));
+    MT_CHECK_EQ(members[1], std::string("lengths.npy"));
+    MT_CHECK_EQ(ReadLittleEndian<uint32_t>(archive, position), 0x02014B50u);
+    MT_CHECK_EQ(ReadLittleEndian<uint16_t>(archive, archive.size() - 12), 4);
+    MT_CHECK(archive.find("'shape': (9, 16, 2)") != std::string::npos);
+}
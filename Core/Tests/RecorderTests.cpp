@@ -0,0 +1,109 @@
+#include "TestFramework.h"
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Recording/ScriptedCursorSource.h"
+#include "MouseTrackerCore/Recording/BusyWaitPacer.h"
+#include "MouseTrackerCore/Recording/CaptureBenchmark.h"
+#include <algorithm>
+
+using namespace Mt;
+
+namespace
+{
+    TrajectoryRecorder CreateRecorder(std::vector<Point> path)
+    {
+        return TrajectoryRecorder
+        (
+            std::make_unique<ScriptedCursorSource>(std::move(path)),
+            std::make_unique<BusyWaitPacer>()
+        );
+    }
+}
+
+MT_TEST(RecordPointsReturnsRequestedCount)
+{
+    TrajectoryRecorder recorder = CreateRecorder({ { 1, 1 }, { 2, 2 }, { 3, 3 } });
+
+    Trajectory trajectory = recorder.RecordPoints(5, 1);
+
+    MT_CHECK_EQ(trajectory.Size(), 5u);
+    MT_CHECK(trajectory[0] == (Point { 1, 1 }));
+    MT_CHECK(trajectory[4] == (Point { 3, 3 }));
+    MT_CHECK_EQ(trajectory.GetMetadata().PeriodUs, 1000u);
+    MT_CHECK_EQ(trajectory.GetMetadata().ScreenWidth, 1920);
+}
+
+MT_TEST(RecordPointsTimestampsFollowPeriod)
+{
+    TrajectoryRecorder recorder = CreateRecorder({ { 0, 0 } });
+    recorder.SetRecordTimestamps(true);
+
+    Trajectory trajectory = recorder.RecordPoints(10, 1);
+
+    MT_CHECK(trajectory.HasTimestamps());
+    MT_CHECK_EQ(trajectory.GetTimestamps().front(), 0);
+
+    for (size_t i = 1; i < trajectory.Size(); i++)
+        MT_CHECK(trajectory.GetTimestamps()[i] >= static_cast<int64_t>(i) * 1000);
+}
+
+MT_TEST(RecordTrajectoryWaitsForMovementAndStopsWhenIdle)
+{
+    TrajectoryRecorder recorder = CreateRecorder({ { 5, 5 }, { 5, 5 }, { 5, 5 }, { 6, 5 }, { 7, 6 }, { 8, 8 } });
+
+    Trajectory trajectory = recorder.RecordTrajectory(3, 1);
+
+    MT_CHECK(trajectory[0] == (Point { 5, 5 }));
+    MT_CHECK(trajectory[1] == (Point { 6, 5 }));
+    MT_CHECK(trajectory.Back() == (Point { 8, 8 }));
+
+    // Initial point, the first move, two more moves, then idle samples until
+    // 3 ms pass; a preempted pacer may skip some of those, so expect at least one.
+    MT_CHECK(trajectory.Size() >= 5u);
+}
+
+MT_TEST(RecordContinuousStopsAfterEndDelay)
+{
+    TrajectoryRecorder recorder = CreateRecorder({ { 0, 0 }, { 1, 0 }, { 2, 0 } });
+
+    Trajectory trajectory = recorder.RecordContinuous(2, 1);
+
+    MT_CHECK(trajectory[0] == (Point { 0, 0 }));
+    MT_CHECK(trajectory.Back() == (Point { 2, 0 }));
+    MT_CHECK(trajectory.Size() >= 5u);
+}
+
+MT_TEST(RequestStopEndsRecording)
+{
+    TrajectoryRecorder recorder = CreateRecorder({ { 0, 0 } });
+    recorder.RequestStop();
+
+    Trajectory trajectory = recorder.RecordTrajectory(1000, 1);
+
+    MT_CHECK_EQ(trajectory.Size(), 1u);
+
+    recorder.ResetStop();
+    MT_CHECK_EQ(recorder.RecordPoints(3, 1).Size(), 3u);
+}
+
+MT_TEST(CaptureBenchmarkReportsEveryStrategy)
+{
+    ScriptedCursorSource source({ { 0, 0 } });
+    std::vector<CaptureBenchmarkResult> results;
+
+    for (auto strategy : SamplePacerFactory::GetAvailableStrategies())
+        results.push_back(CaptureBenchmark::Run(strategy, source, 20, 1));
+
+    for (const auto& result : results)
+    {
+        MT_CHECK(result.AchievedRateHz > 0.0);
+        MT_CHECK(result.ElapsedUs >= 19000.0);
+        MT_CHECK(result.JitterP50Us <= result.JitterP99Us);
+        MT_CHECK(result.JitterP99Us <= result.JitterMaxUs);
+    }
+
+    std::string csv = CaptureBenchmark::ToCsv(results);
+    std::string json = CaptureBenchmark::ToJson(results, source.GetName());
+
+    MT_CHECK_EQ(static_cast<size_t>(std::count(csv.begin(), csv.end(), '\n')), results.size() + 1);
+    MT_CHECK(json.find("\"strategy\": \"busy\"") != std::string::npos);
+}
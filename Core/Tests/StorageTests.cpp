@@ -0,0 +1,669 @@
+#include "TestFramework.h"
+#include "MouseTrackerCore/Storage/TrajectoryWriteService.h"
+#include "MouseTrackerCore/Storage/ChunkedTrajectoryWriter.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchiveWriter.h"
+#include "MouseTrackerCore/Storage/TrajectoryRecovery.h"
+#include "MouseTrackerCore/Storage/TrajectoryStore.h"
+#include "MouseTrackerCore/Codecs/XxHash64.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Recording/ScriptedCursorSource.h"
+#include "MouseTrackerCore/Recording/BusyWaitPacer.h"
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+
+using namespace Mt;
+
+MT_TEST(WriteServiceWritesEveryJobOnce)
+{
+    Tests::TempDirectory directory("storage_write");
+    std::atomic<int> completed { 0 };
+
+    TrajectoryWriteSettings settings;
+    settings.QueueCapacity = 4;
+    settings.OnCompleted = [&](const std::string&, const CodecResult& result)
+    {
+        if (result.Success)
+            completed++;
+    };
+
+    TrajectoryWriteService service(settings);
+
+    for (int i = 0; i < 20; i++)
+    {
+        std::string extension = i % 2 == 0 ? ".crsdat" : ".crsbin";
+        MT_CHECK(service.Submit(directory.File("nested/run_" + std::to_string(i) + extension), Trajectory({ { i, i }, { i + 1, -i } })));
+    }
+
+    service.Shutdown();
+
+    TrajectoryWriteStats stats = service.GetStats();
+    MT_CHECK_EQ(stats.Submitted, 20u);
+    MT_CHECK_EQ(stats.Written, 20u);
+    MT_CHECK_EQ(stats.Failed, 0u);
+    MT_CHECK_EQ(stats.Pending, 0u);
+    MT_CHECK(stats.QueueHighWatermark <= 4u);
+    MT_CHECK(stats.BytesWritten > 0u);
+    MT_CHECK_EQ(completed.load(), 20);
+
+    Trajectory loaded;
+    MT_CHECK(TrajectoryIo::Load(directory.File("nested/run_7.crsbin"), loaded).Success);
+    MT_CHECK_EQ(loaded.Size(), 2u);
+    MT_CHECK_EQ(loaded[1].y, -7);
+    MT_CHECK(!std::filesystem::exists(directory.File("nested/run_7.crsbin.part")));
+
+    MT_CHECK(!service.Submit(directory.File("late.crsdat"), Trajectory({ { 1, 1 } })));
+    MT_CHECK_EQ(service.GetStats().Rejected, 1u);
+}
+
+MT_TEST(WriteServiceReportsEachJobOnItsOwn)
+{
+    Tests::TempDirectory directory("storage_job_result");
+    std::atomic<bool> released { false };
+
+    TrajectoryWriteSettings settings;
+    settings.SyncToDisk = false;
+    settings.OnCompleted = [&](const std::string& filename, const CodecResult&)
+    {
+        if (filename.find("later") != std::string::npos)
+            while (!released)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+
+    TrajectoryWriteService service(settings);
+
+    Trajectory line;
+
+    for (int i = 0; i < 200; i++)
+        line.Add(Point { i, 0 }, i * 1000);
+
+    SimplifySettings simplify;
+    simplify.Tolerance = 1.0;
+
+    std::promise<TrajectoryJobResult> done;
+    std::future<TrajectoryJobResult> result = done.get_future();
+    auto shared = std::make_shared<const MappedTrajectory>(std::move(line));
+
+    MT_CHECK(service.Submit(TrajectoryWriteJob(directory.File("mine.crsbin"), shared, simplify,
+        [&done](const TrajectoryJobResult& jobResult) { done.set_value(jobResult); })));
+    MT_CHECK(service.Submit(directory.File("later.crsdat"), Trajectory({ { 1, 1 }, { 2, 2 }, { 3, 3 } })));
+
+    // The job submitted after ours is still held by the writer, yet ours reports.
+    TrajectoryJobResult mine = result.get();
+
+    MT_CHECK(mine.Result.Success);
+    MT_CHECK_EQ(mine.SamplesSubmitted, 200u);
+    MT_CHECK_EQ(mine.SamplesWritten, 2u);
+    MT_CHECK(service.GetStats().Pending >= 1u);
+
+    released = true;
+    service.Drain();
+
+    MT_CHECK_EQ(service.GetStats().SamplesSubmitted, 203u);
+}
+
+MT_TEST(WriteServiceBlocksWhenQueueIsFull)
+{
+    Tests::TempDirectory directory("storage_backpressure");
+    std::atomic<bool> released { false };
+
+    TrajectoryWriteSettings settings;
+    settings.QueueCapacity = 1;
+    settings.SyncToDisk = false;
+    settings.OnCompleted = [&](const std::string&, const CodecResult&)
+    {
+        while (!released)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+
+    TrajectoryWriteService service(settings);
+
+    std::thread releaser([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        released = true;
+    });
+
+    // The writer holds at most one job and the queue one more, so a third must wait.
+    for (int i = 0; i < 3; i++)
+        MT_CHECK(service.Submit(directory.File("run_" + std::to_string(i) + ".crsdat"), Trajectory({ { i, i } })));
+
+    service.Drain();
+    releaser.join();
+
+    TrajectoryWriteStats stats = service.GetStats();
+    MT_CHECK(stats.BlockedSubmits >= 1u);
+    MT_CHECK(stats.BlockedUs > 0u);
+    MT_CHECK_EQ(stats.Written, 3u);
+    MT_CHECK_EQ(stats.Pending, 0u);
+}
+
+MT_TEST(ChunkedRecordingStreamsToDisk)
+{
+    Tests::TempDirectory directory("storage_chunked");
+    std::string filename = directory.File("session.crsbin");
+
+    TrajectoryRecorder recorder(std::make_unique<ScriptedCursorSource>(std::vector<Point> { { 1, 2 }, { 3, 4 }, { 5, 6 } }), std::make_unique<BusyWaitPacer>());
+
+    ChunkedRecordingSettings settings;
+    settings.ChunkSamples = 64;
+    settings.SyncToDisk = false;
+
+    ChunkedTrajectoryWriter writer(settings);
+    MT_CHECK(writer.Open(filename, recorder.DescribeCapture(1)).Success);
+
+    MT_CHECK_EQ(recorder.Stream(writer, 300, 1), 300);
+    writer.Stop();
+
+    ChunkedRecordingStats stats = writer.GetStats();
+    MT_CHECK_EQ(stats.Written, 300u);
+    MT_CHECK_EQ(stats.Dropped, 0u);
+    MT_CHECK(stats.Chunks >= 5u);
+    MT_CHECK(!stats.WriteFailed);
+
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load(filename, loaded);
+
+    MT_CHECK(result.Success);
+    MT_CHECK(result.Warnings.empty());
+    MT_CHECK_EQ(loaded.Size(), 300u);
+    MT_CHECK(loaded.HasTimestamps());
+    MT_CHECK(loaded[299] == (Point { 5, 6 }));
+    MT_CHECK_EQ(loaded.GetMetadata().PeriodUs, 1000u);
+    MT_CHECK_EQ(loaded.GetMetadata().ScreenWidth, 1920);
+}
+
+MT_TEST(ChunkedRecordingLoadsUpToTornChunk)
+{
+    Tests::TempDirectory directory("storage_torn");
+    std::string filename = directory.File("torn.crsbin");
+
+    ChunkedRecordingSettings settings;
+    settings.ChunkSamples = 100;
+    settings.MaxLatencyUs = 60000000;
+    settings.SyncToDisk = false;
+
+    {
+        ChunkedTrajectoryWriter writer(settings);
+        MT_CHECK(writer.Open(filename, TrajectoryMetadata()).Success);
+
+        for (int i = 0; i < 1000; i++)
+            writer.OnSample(Point { i, -i }, i * 1000);
+
+        writer.Stop();
+        MT_CHECK_EQ(writer.GetStats().Chunks, 10u);
+    }
+
+    // A crash mid-write leaves the last chunk short and the header totals unset.
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 7);
+
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        BinaryTrajectoryHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.SampleCount = 0;
+        header.PayloadBytes = 0;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load(filename, loaded);
+
+    MT_CHECK(result.Success);
+    MT_CHECK_EQ(result.MalformedRecords, 1u);
+    MT_CHECK_EQ(result.Warnings.size(), 1u);
+    MT_CHECK_EQ(loaded.Size(), 900u);
+    MT_CHECK(loaded[899] == (Point { 899, -899 }));
+    MT_CHECK_EQ(loaded.GetTimestamps()[899], 899000);
+
+    MappedTrajectory mapped;
+    MT_CHECK(mapped.Open(filename).Success);
+    MT_CHECK_EQ(mapped.GetSpan().Size(), 900u);
+}
+
+MT_TEST(ChunkedRecordingSkipsCorruptChunks)
+{
+    Tests::TempDirectory directory("storage_corrupt");
+    std::string filename = directory.File("corrupt.crsbin");
+
+    ChunkedRecordingSettings settings;
+    settings.ChunkSamples = 100;
+    settings.MaxLatencyUs = 60000000;
+    settings.SyncToDisk = false;
+
+    {
+        ChunkedTrajectoryWriter writer(settings);
+        MT_CHECK(writer.Open(filename, TrajectoryMetadata()).Success);
+
+        for (int i = 0; i < 1000; i++)
+            writer.OnSample(Point { i, -i }, i * 1000);
+
+        writer.Stop();
+    }
+
+    BinaryTrajectoryHeader header;
+    size_t chunkBytes = sizeof(BinaryChunkHeader) + 100 * (sizeof(Point) + sizeof(int64_t));
+
+    // One flipped bit in chunk 3's columns, and chunk 6's frame overwritten.
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        MT_CHECK(header.HasChunkChecksums());
+
+        char byte;
+        std::streamoff flipped = header.HeaderSize + 3 * chunkBytes + sizeof(BinaryChunkHeader) + 500;
+        file.seekg(flipped);
+        file.get(byte);
+        file.seekp(flipped);
+        file.put(static_cast<char>(byte ^ 0x10));
+
+        file.seekp(header.HeaderSize + 6 * chunkBytes);
+        file.write("garbage!garbage!", sizeof(BinaryChunkHeader));
+    }
+
+    Trajectory loaded;
+    CodecResult result = TrajectoryIo::Load(filename, loaded);
+
+    MT_CHECK(result.Success);
+    MT_CHECK_EQ(result.Warnings.size(), 1u);
+    MT_CHECK_EQ(result.MalformedRecords, 2u);
+    MT_CHECK_EQ(loaded.Size(), 800u);
+    MT_CHECK(loaded[299] == (Point { 299, -299 }));
+    MT_CHECK(loaded[300] == (Point { 400, -400 }));
+    MT_CHECK(loaded[500] == (Point { 700, -700 }));
+    MT_CHECK_EQ(loaded.GetTimestamps()[500], 700000);
+
+    TrajectoryVerifyReport report = TrajectoryRecovery::Verify(filename);
+
+    MT_CHECK(!report.IsIntact());
+    MT_CHECK(report.Checksummed);
+    MT_CHECK_EQ(report.Chunks.Chunks, 8u);
+    MT_CHECK_EQ(report.Chunks.CorruptChunks, 1u);
+    MT_CHECK_EQ(report.Chunks.LostSamples, 100u);
+    MT_CHECK_EQ(report.Chunks.SkippedBytes, static_cast<uint64_t>(chunkBytes));
+    MT_CHECK_EQ(report.Chunks.TrailingBytes, 0u);
+    MT_CHECK_EQ(report.Chunks.FirstDamageOffset, static_cast<uint64_t>(3 * chunkBytes));
+    MT_CHECK_EQ(report.Samples, 800u);
+
+    std::string recovered = directory.File("recovered.crsbin");
+    MT_CHECK(TrajectoryRecovery::Recover(filename, recovered).Success);
+    MT_CHECK(!TrajectoryRecovery::Recover(filename, filename).Success);
+
+    TrajectoryVerifyReport clean = TrajectoryRecovery::Verify(recovered);
+    MT_CHECK(clean.IsIntact());
+    MT_CHECK_EQ(clean.Samples, 800u);
+
+    Trajectory salvaged;
+    MT_CHECK(TrajectoryIo::Load(recovered, salvaged).Success);
+    MT_CHECK_EQ(salvaged.Size(), 800u);
+    MT_CHECK(salvaged[500] == (Point { 700, -700 }));
+    MT_CHECK_EQ(salvaged.GetTimestamps()[500], 700000);
+}
+
+MT_TEST(VerifyReportsTruncatedFiles)
+{
+    Tests::TempDirectory directory("storage_verify");
+    std::string binary = directory.File("cut.crsbin");
+    std::string text = directory.File("cut.txt");
+
+    Trajectory trajectory;
+
+    for (int i = 0; i < 100; i++)
+        trajectory.Add(Point { i, i * 2 });
+
+    MT_CHECK(BinaryTrajectoryCodec(BinaryEncoding::Fixed).Write(binary, trajectory).Success);
+    MT_CHECK(TrajectoryRecovery::Verify(binary).IsIntact());
+
+    std::filesystem::resize_file(binary, std::filesystem::file_size(binary) - 3 * sizeof(Point) - 1);
+
+    TrajectoryVerifyReport report = TrajectoryRecovery::Verify(binary);
+
+    MT_CHECK(!report.IsIntact());
+    MT_CHECK_EQ(report.MissingBytes, 3 * sizeof(Point) + 1);
+    MT_CHECK_EQ(report.Samples, 96u);
+    MT_CHECK_EQ(report.ExpectedSamples, 100u);
+
+    std::string recovered = directory.File("recovered.crsbin");
+    MT_CHECK(TrajectoryRecovery::Recover(binary, recovered).Success);
+
+    Trajectory salvaged;
+    MT_CHECK(TrajectoryIo::Load(recovered, salvaged).Success);
+    MT_CHECK_EQ(salvaged.Size(), 96u);
+    MT_CHECK(salvaged[95] == (Point { 95, 190 }));
+
+    {
+        std::ofstream file(text, std::ios::binary);
+        file << "1;2\n3;4\n5;6";
+    }
+
+    report = TrajectoryRecovery::Verify(text);
+
+    MT_CHECK(!report.IsIntact());
+    MT_CHECK(report.UnterminatedLastLine);
+    MT_CHECK_EQ(report.Samples, 3u);
+    MT_CHECK(!TrajectoryRecovery::Verify(directory.File("missing.txt")).Error.empty());
+}
+
+MT_TEST(ArchiveReadsEntriesById)
+{
+    Tests::TempDirectory directory("storage_archive");
+    std::string filename = directory.File("captures.crsarc");
+
+    {
+        TrajectoryArchiveWriter writer;
+        MT_CHECK(writer.Open(filename).Success);
+
+        for (int i = 0; i < 3; i++)
+        {
+            Trajectory trajectory({ { i, 10 }, { i + 5, -2 }, { i - 1, 4 } });
+            trajectory.GetMetadata().PeriodUs = 1000;
+
+            uint64_t id = 0;
+            MT_CHECK(writer.Append(trajectory, &id).Success);
+            MT_CHECK_EQ(id, static_cast<uint64_t>(i));
+        }
+
+        MT_CHECK(writer.Close().Success);
+    }
+
+    // Reopening appends after the existing entries.
+    {
+        TrajectoryArchiveWriter writer(BinaryEncoding::Fixed);
+        MT_CHECK(writer.Open(filename).Success);
+        MT_CHECK_EQ(writer.GetCount(), 3u);
+        MT_CHECK(writer.Append(Trajectory({ { 7, 7 } })).Success);
+        MT_CHECK(writer.Close().Success);
+    }
+
+    TrajectoryArchive archive;
+    CodecResult result = archive.Open(filename);
+
+    MT_CHECK(result.Success);
+    MT_CHECK(!archive.IsRecovered());
+    MT_CHECK_EQ(archive.GetCount(), 4u);
+
+    const ArchiveIndexEntry& entry = archive.GetEntry(1);
+    MT_CHECK_EQ(entry.SampleCount, 3u);
+    MT_CHECK_EQ(entry.MinX, 0);
+    MT_CHECK_EQ(entry.MaxX, 6);
+    MT_CHECK_EQ(entry.MinY, -2);
+    MT_CHECK_EQ(entry.MaxY, 10);
+    MT_CHECK_EQ(entry.DurationUs, 2000);
+
+    Trajectory loaded;
+    MT_CHECK(archive.Read(1, loaded).Success);
+    MT_CHECK_EQ(loaded.Size(), 3u);
+    MT_CHECK(loaded[1] == (Point { 6, -2 }));
+
+    MT_CHECK(archive.Read(3, loaded).Success);
+    MT_CHECK(loaded[0] == (Point { 7, 7 }));
+    MT_CHECK(!archive.Read(4, loaded).Success);
+}
+
+MT_TEST(ArchiveAppendsWhileAViewerHoldsIt)
+{
+    Tests::TempDirectory directory("storage_archive_viewed");
+    std::string filename = directory.File("viewed.crsarc");
+
+    {
+        TrajectoryArchiveWriter writer;
+        MT_CHECK(writer.Open(filename).Success);
+
+        for (int i = 0; i < 3; i++)
+            MT_CHECK(writer.Append(Trajectory({ { i, i }, { i, i + 1 } })).Success);
+
+        MT_CHECK(writer.Close().Success);
+    }
+
+    TrajectoryArchive viewer;
+    MT_CHECK(viewer.Open(filename).Success);
+
+    TrajectoryArchiveWriter writer;
+    MT_CHECK(writer.Open(filename).Success);
+    MT_CHECK(writer.Append(Trajectory({ { 9, 9 } })).Success);
+
+    // Mid-session the old index is stale, so a reader scans rather than trusting it.
+    TrajectoryArchive during;
+    MT_CHECK(during.Open(filename).Success);
+    MT_CHECK(during.IsRecovered());
+    MT_CHECK_EQ(during.GetCount(), 4u);
+    during.Close();
+
+    MT_CHECK(writer.Close().Success);
+
+    Trajectory first;
+    MT_CHECK(viewer.Read(0, first).Success);
+    MT_CHECK(first[1] == (Point { 0, 1 }));
+    viewer.Close();
+
+    TrajectoryArchive archive;
+    MT_CHECK(archive.Open(filename).Success);
+    MT_CHECK(!archive.IsRecovered());
+    MT_CHECK_EQ(archive.GetCount(), 4u);
+    MT_CHECK_EQ(std::filesystem::file_size(filename), archive.GetEntriesEnd() + 4 * sizeof(ArchiveIndexEntry) + sizeof(ArchiveFooter));
+
+    Trajectory last;
+    MT_CHECK(archive.Read(3, last).Success);
+    MT_CHECK(last[0] == (Point { 9, 9 }));
+}
+
+MT_TEST(ArchiveRejectsEntryWithWrappingPayloadSize)
+{
+    Tests::TempDirectory directory("storage_archive_wrapping");
+    std::string filename = directory.File("hostile.crsarc");
+
+    {
+        TrajectoryArchiveWriter writer;
+        MT_CHECK(writer.Open(filename).Success);
+        MT_CHECK(writer.Append(Trajectory({ { 1, 2 }, { 3, 4 } })).Success);
+        MT_CHECK(writer.Close().Success);
+    }
+
+    // HeaderSize + PayloadBytes wraps to 24 bytes, well within the file.
+    uint64_t payloadBytes = UINT64_MAX - sizeof(BinaryTrajectoryHeader) + 25;
+
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(ArchiveHeader) + offsetof(BinaryTrajectoryHeader, PayloadBytes));
+        file.write(reinterpret_cast<const char*>(&payloadBytes), sizeof(payloadBytes));
+    }
+
+    TrajectoryArchive archive;
+    MT_CHECK(archive.Open(filename).Success);
+    MT_CHECK_EQ(archive.GetCount(), 1u);
+
+    Trajectory entry;
+    MT_CHECK(!archive.Read(0, entry).Success);
+
+    // Without an index the scan must stop at the entry, not decode it.
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - sizeof(ArchiveFooter));
+    MT_CHECK(archive.Open(filename).Success);
+    MT_CHECK(archive.IsRecovered());
+    MT_CHECK_EQ(archive.GetCount(), 0u);
+}
+
+MT_TEST(ArchiveWithoutFooterIsRecovered)
+{
+    Tests::TempDirectory directory("storage_archive_recover");
+    std::string filename = directory.File("live.crsarc");
+    std::string snapshot = directory.File("crashed.crsarc");
+
+    TrajectoryArchiveWriter writer;
+    MT_CHECK(writer.Open(filename).Success);
+
+    for (int i = 0; i < 5; i++)
+        MT_CHECK(writer.Append(Trajectory({ { i, i }, { i, i + 1 } })).Success);
+
+    // What a killed writer leaves behind: entries, no index.
+    std::filesystem::copy_file(filename, snapshot);
+    writer.Close();
+
+    TrajectoryArchive archive;
+    CodecResult result = archive.Open(snapshot);
+
+    MT_CHECK(result.Success);
+    MT_CHECK(archive.IsRecovered());
+    MT_CHECK_EQ(result.Warnings.size(), 1u);
+    MT_CHECK_EQ(archive.GetCount(), 5u);
+    MT_CHECK_EQ(archive.GetEntry(4).MaxY, 5);
+
+    Trajectory loaded;
+    MT_CHECK(archive.Read(4, loaded).Success);
+    MT_CHECK(loaded[1] == (Point { 4, 5 }));
+}
+
+MT_TEST(WriteServiceAppendsToArchive)
+{
+    Tests::TempDirectory directory("storage_archive_service");
+    std::string filename = directory.File("runs/session.crsarc");
+
+    {
+        TrajectoryWriteSettings settings;
+        settings.SyncToDisk = false;
+
+        TrajectoryWriteService service(settings);
+
+        for (int i = 0; i < 10; i++)
+            MT_CHECK(service.Submit(filename, Trajectory({ { i, 0 }, { 0, i } })));
+
+        service.Shutdown();
+        MT_CHECK_EQ(service.GetStats().Written, 10u);
+    }
+
+    TrajectoryArchive archive;
+    MT_CHECK(archive.Open(filename).Success);
+    MT_CHECK(!archive.IsRecovered());
+    MT_CHECK_EQ(archive.GetCount(), 10u);
+    MT_CHECK_EQ(archive.GetEntry(9).MaxX, 9);
+}
+
+MT_TEST(XxHash64MatchesReferenceInAnySplit)
+{
+    uint8_t bytes[768];
+
+    for (size_t i = 0; i < sizeof(bytes); i++)
+        bytes[i] = static_cast<uint8_t>(i);
+
+    MT_CHECK_EQ(XxHash64::Compute("", 0), 0xEF46DB3751D8E999ull);
+    MT_CHECK_EQ(XxHash64::Compute("abc", 3), 0x44BC2CF5AD770999ull);
+    MT_CHECK_EQ(XxHash64::Compute(bytes, sizeof(bytes)), 0x8E03C838C596036Full);
+    MT_CHECK_EQ(XxHash64::Compute(bytes, sizeof(bytes), 7), 0xB1E10F6C5294CD6Bull);
+
+    XxHash64 pieces;
+
+    for (size_t i = 0; i < sizeof(bytes); i += 13)
+        pieces.Update(bytes + i, std::min<size_t>(13, sizeof(bytes) - i));
+
+    MT_CHECK_EQ(pieces.Digest(), 0x8E03C838C596036Full);
+}
+
+MT_TEST(StoreKeepsEachTrajectoryOnceUnderManyNames)
+{
+    Tests::TempDirectory directory("storage_store");
+    std::string storeDirectory = directory.File("store");
+
+    Trajectory first;
+    Trajectory second;
+
+    for (int i = 0; i < 3000; i++)
+    {
+        first.Add(Point { i, 2 * i }, i * 1000);
+        second.Add(Point { i, 2 * i + (i == 2999 ? 1 : 0) }, i * 1000);
+    }
+
+    {
+        TrajectoryStore store;
+        bool duplicate = true;
+
+        MT_CHECK(store.Open(storeDirectory).Success);
+        MT_CHECK(store.Put("a.crsbin", first, &duplicate).Success);
+        MT_CHECK(!duplicate);
+        MT_CHECK(store.Put("copy/a.crsbin", first, &duplicate).Success);
+        MT_CHECK(duplicate);
+        MT_CHECK(store.Put("b.crsbin", second, &duplicate).Success);
+        MT_CHECK(!duplicate);
+        MT_CHECK(!store.Put("bad;name", first).Success);
+        MT_CHECK_EQ(store.GetObjectId("a.crsbin"), store.GetObjectId("copy/a.crsbin"));
+        MT_CHECK(store.GetObjectId("a.crsbin") != store.GetObjectId("b.crsbin"));
+
+        // Repointing a name moves its samples from one object to the other.
+        MT_CHECK(store.Put("copy/a.crsbin", second).Success);
+
+        TrajectoryStoreStats stats = store.GetStats();
+
+        MT_CHECK_EQ(stats.References, 3u);
+        MT_CHECK_EQ(stats.Objects, 2u);
+        MT_CHECK_EQ(stats.ReferencedSamples, 9000u);
+        MT_CHECK_EQ(stats.StoredSamples, 6000u);
+        MT_CHECK(std::abs(stats.GetDedupRatio() - 1.5) < 1e-9);
+    }
+
+    // The logs rebuild the same state.
+    TrajectoryStore reopened;
+    Trajectory loaded;
+
+    MT_CHECK(reopened.Open(storeDirectory).Success);
+    MT_CHECK_EQ(reopened.GetStats().ReferencedSamples, 9000u);
+    MT_CHECK_EQ(reopened.GetNames().size(), 3u);
+    MT_CHECK(reopened.Get("copy/a.crsbin", loaded).Success);
+    MT_CHECK(loaded.GetPoints() == second.GetPoints());
+    MT_CHECK(loaded.GetTimestamps() == second.GetTimestamps());
+    MT_CHECK(!reopened.Get("missing", loaded).Success);
+
+    // A folder and its copy ingest as one set of objects; the store is skipped.
+    std::string input = directory.File("input");
+    std::filesystem::create_directories(input + "/copy");
+    MT_CHECK(TrajectoryIo::Save(input + "/one.crsbin", first).Success);
+    MT_CHECK(TrajectoryIo::Save(input + "/two.crsdat", second).Success);
+    std::filesystem::copy(input + "/one.crsbin", input + "/copy/one.crsbin");
+    std::filesystem::copy(input + "/two.crsdat", input + "/copy/two.crsdat");
+
+    TrajectoryStore ingested;
+    MT_CHECK(ingested.Open(input + "/store").Success);
+
+    StoreIngestSummary summary = ingested.Ingest(input, 2);
+
+    MT_CHECK_EQ(summary.Files, 4u);
+    MT_CHECK_EQ(summary.Failed, 0u);
+    MT_CHECK_EQ(summary.Duplicates, 2u);
+    MT_CHECK_EQ(ingested.GetStats().Objects, 2u);
+    MT_CHECK(ingested.Contains("copy/two.crsdat"));
+    MT_CHECK(std::abs(ingested.GetStats().GetDedupRatio() - 2.0) < 1e-9);
+
+    // Threads putting the same samples at once still store them once.
+    TrajectoryStore concurrent;
+    MT_CHECK(concurrent.Open(directory.File("concurrent")).Success);
+
+    std::atomic<int> shared { 0 };
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&, i]()
+        {
+            bool duplicate = false;
+
+            if (concurrent.Put("same_" + std::to_string(i), first, &duplicate).Success && duplicate)
+                shared++;
+
+            concurrent.Put("own_" + std::to_string(i), Trajectory({ { i, i } }));
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    MT_CHECK_EQ(shared.load(), 3);
+    MT_CHECK_EQ(concurrent.GetStats().Objects, 5u);
+    MT_CHECK_EQ(concurrent.GetStats().References, 8u);
+}
@@ -0,0 +1,172 @@
+#include "TestFramework.h"
+#include "MouseTrackerCore/Streaming/SampleStreamWriter.h"
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Recording/ScriptedCursorSource.h"
+#include "MouseTrackerCore/Recording/BusyWaitPacer.h"
+#include <cstring>
+#include <string>
+#include <thread>
+#include <chrono>
+
+using namespace Mt;
+
+namespace
+{
+    class MemoryByteSink : public IByteSink
+    {
+        private:
+            std::string* m_data;
+            int m_writeDelayMs;
+
+        public:
+            MemoryByteSink(std::string* data, int writeDelayMs = 0)
+            {
+                m_data = data;
+                m_writeDelayMs = writeDelayMs;
+            }
+
+            bool Write(const void* data, size_t size) override
+            {
+                if (m_writeDelayMs > 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(m_writeDelayMs));
+
+                m_data->append(static_cast<const char*>(data), size);
+
+                return true;
+            }
+
+            bool Flush() override
+            {
+                return true;
+            }
+    };
+
+    // A consumer that has closed its end: every write fails.
+    class ClosedByteSink : public IByteSink
+    {
+        public:
+            bool Write(const void*, size_t) override
+            {
+                return false;
+            }
+
+            bool Flush() override
+            {
+                return false;
+            }
+    };
+}
+
+MT_TEST(SpscRingBufferDropsWhenFull)
+{
+    SpscRingBuffer<int> ring(4);
+
+    for (int i = 0; i < 4; i++)
+        MT_CHECK(ring.TryPush(i));
+
+    MT_CHECK(!ring.TryPush(4));
+
+    int values[8];
+    MT_CHECK_EQ(ring.PopBatch(values, 8), 4u);
+    MT_CHECK_EQ(values[3], 3);
+    MT_CHECK(ring.TryPush(5));
+}
+
+MT_TEST(TextStreamMatchesCrsdatLines)
+{
+    std::string data;
+    SampleStreamSettings settings;
+    SampleStreamWriter writer(std::make_unique<MemoryByteSink>(&data), settings);
+
+    writer.Start();
+    writer.OnSample({ 10, -20 }, 0);
+    writer.OnSample({ 11, 21 }, 1000);
+    writer.Stop();
+
+    MT_CHECK_EQ(data, std::string("10;-20\n11;21\n"));
+    MT_CHECK_EQ(writer.GetStats().Written, 2u);
+    MT_CHECK_EQ(writer.GetStats().Dropped, 0u);
+}
+
+MT_TEST(BinaryStreamFramesSamples)
+{
+    std::string data;
+    SampleStreamSettings settings;
+    settings.Framing = StreamFraming::Binary;
+    SampleStreamWriter writer(std::make_unique<MemoryByteSink>(&data), settings);
+
+    TrajectoryRecorder recorder(std::make_unique<ScriptedCursorSource>(std::vector<Point> { { 1, 2 }, { 3, 4 } }),
+        std::make_unique<BusyWaitPacer>());
+
+    writer.Start();
+    MT_CHECK_EQ(recorder.Stream(writer, 50, 1), 50);
+    writer.Stop();
+
+    size_t offset = 0;
+    uint64_t samples = 0;
+    StreamSample last = {};
+
+    while (offset + sizeof(StreamFrameHeader) <= data.size())
+    {
+        StreamFrameHeader header;
+        std::memcpy(&header, data.data() + offset, sizeof(header));
+        MT_CHECK_EQ(header.Magic, StreamFrameMagic);
+
+        offset += sizeof(header);
+        std::memcpy(&last, data.data() + offset + (header.SampleCount - 1) * sizeof(StreamSample), sizeof(StreamSample));
+        offset += header.SampleCount * sizeof(StreamSample);
+        samples += header.SampleCount;
+    }
+
+    MT_CHECK_EQ(offset, data.size());
+    MT_CHECK_EQ(samples, 50u);
+    MT_CHECK_EQ(last.X, 3);
+    MT_CHECK(last.TimestampUs >= 49000);
+}
+
+MT_TEST(SlowConsumerCausesCountedDrops)
+{
+    std::string data;
+    SampleStreamSettings settings;
+    settings.QueueCapacity = 8;
+    settings.MaxLatencyUs = 0;
+    SampleStreamWriter writer(std::make_unique<MemoryByteSink>(&data, 20), settings);
+
+    writer.Start();
+
+    for (int i = 0; i < 1000; i++)
+        writer.OnSample({ i, i }, i);
+
+    writer.Stop();
+
+    SampleStreamStats stats = writer.GetStats();
+
+    MT_CHECK_EQ(stats.Captured, 1000u);
+    MT_CHECK(stats.Dropped > 0);
+    MT_CHECK_EQ(stats.Written + stats.Dropped, 1000u);
+}
+
+MT_TEST(WriteFailureStopsUnlimitedStream)
+{
+    TrajectoryRecorder recorder(std::make_unique<ScriptedCursorSource>(std::vector<Point> { { 1, 2 }, { 3, 4 } }), std::make_unique<BusyWaitPacer>());
+
+    int failures = 0;
+    SampleStreamSettings settings;
+    settings.MaxLatencyUs = 0;
+    settings.OnWriteFailed = [&recorder, &failures]()
+    {
+        failures++;
+        recorder.RequestStop();
+    };
+
+    SampleStreamWriter writer(std::make_unique<ClosedByteSink>(), settings);
+
+    writer.Start();
+    int64_t samples = recorder.Stream(writer, 0, 1);
+    writer.Stop();
+
+    MT_CHECK(samples > 0);
+    MT_CHECK_EQ(failures, 1);
+    MT_CHECK(writer.GetStats().WriteFailed);
+    MT_CHECK_EQ(writer.GetStats().Written, 0u);
+}
@@ -0,0 +1,92 @@
+#ifndef __MOUSE_TRACKER_CORE_TESTFRAMEWORK__
+#define __MOUSE_TRACKER_CORE_TESTFRAMEWORK__
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+namespace Mt::Tests
+{
+    struct TestCase
+    {
+        const char* Name;
+        std::function<void()> Body;
+    };
+
+    inline std::vector<TestCase>& GetTestCases()
+    {
+        static std::vector<TestCase> testCases;
+
+        return testCases;
+    }
+
+    inline int& GetFailureCount()
+    {
+        static int failures = 0;
+
+        return failures;
+    }
+
+    struct TestRegistration
+    {
+        TestRegistration(const char* name, std::function<void()> body)
+        {
+            GetTestCases().push_back(TestCase { name, std::move(body) });
+        }
+    };
+
+    // Scratch directory under the system temp dir, removed on destruction.
+    class TempDirectory
+    {
+        private:
+            std::filesystem::path m_path;
+
+        public:
+            explicit TempDirectory(const std::string& name)
+            {
+                m_path = std::filesystem::temp_directory_path() / ("mt_core_tests_" + name);
+                std::filesystem::remove_all(m_path);
+                std::filesystem::create_directories(m_path);
+            }
+
+            ~TempDirectory()
+            {
+                std::error_code error;
+                std::filesystem::remove_all(m_path, error);
+            }
+
+            std::string File(const std::string& name) const
+            {
+                return (m_path / name).string();
+            }
+
+            const std::filesystem::path& GetPath() const
+            {
+                return m_path;
+            }
+    };
+}
+
+#define MT_TEST_CONCAT_INNER(a, b) a##b
+#define MT_TEST_CONCAT(a, b) MT_TEST_CONCAT_INNER(a, b)
+
+#define MT_TEST(name) \
+    static void name(); \
+    static ::Mt::Tests::TestRegistration MT_TEST_CONCAT(s_registration_, name)(#name, name); \
+    static void name()
+
+#define MT_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::printf("  %s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ::Mt::Tests::GetFailureCount()++; \
+        } \
+    } while (0)
+
+#define MT_CHECK_EQ(left, right) MT_CHECK((left) == (right))
+
+#endif
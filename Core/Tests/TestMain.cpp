@@ -0,0 +1,24 @@
+#include "TestFramework.h"
+
+int main()
+{
+    int failedTests = 0;
+
+    for (const auto& testCase : Mt::Tests::GetTestCases())
+    {
+        int failuresBefore = Mt::Tests::GetFailureCount();
+
+        testCase.Body();
+
+        bool passed = Mt::Tests::GetFailureCount() == failuresBefore;
+
+        if (!passed)
+            failedTests++;
+
+        std::printf("[%s] %s\n", passed ? "PASS" : "FAIL", testCase.Name);
+    }
+
+    std::printf("%zu tests, %d failed\n", Mt::Tests::GetTestCases().size(), failedTests);
+
+    return failedTests == 0 ? 0 : 1;
+}
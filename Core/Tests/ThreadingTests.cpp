@@ -0,0 +1,101 @@
+#include "TestFramework.h"
+#include "MouseTrackerCore/Threading/BoundedQueue.h"
+#include "MouseTrackerCore/Threading/ThreadPool.h"
+#include "MouseTrackerCore/Threading/ByteBudget.h"
+#include "MouseTrackerCore/Threading/LruCache.h"
+#include <atomic>
+#include <thread>
+
+using namespace Mt;
+
+MT_TEST(BoundedQueueRespectsCapacity)
+{
+    BoundedQueue<int> queue(2);
+
+    MT_CHECK(queue.TryPush(1));
+    MT_CHECK(queue.TryPush(2));
+    MT_CHECK(!queue.TryPush(3));
+    MT_CHECK_EQ(queue.GetHighWatermark(), 2u);
+
+    int value = 0;
+    MT_CHECK(queue.TryPop(value));
+    MT_CHECK_EQ(value, 1);
+}
+
+MT_TEST(BoundedQueueDrainsAfterClose)
+{
+    BoundedQueue<int> queue(4);
+    int sum = 0;
+
+    std::thread consumer([&]()
+    {
+        int value = 0;
+
+        while (queue.Pop(value))
+            sum += value;
+    });
+
+    for (int i = 1; i <= 100; i++)
+        queue.Push(i);
+
+    queue.Close();
+    consumer.join();
+
+    MT_CHECK_EQ(sum, 5050);
+    MT_CHECK(!queue.Push(1));
+}
+
+MT_TEST(ThreadPoolRunsEveryTask)
+{
+    ThreadPool pool(4, 2);
+    std::atomic<int> sum { 0 };
+
+    for (int i = 1; i <= 100; i++)
+        pool.Submit([&sum, i]() { sum += i; });
+
+    pool.WaitIdle();
+
+    MT_CHECK_EQ(sum.load(), 5050);
+    MT_CHECK_EQ(pool.GetThreadCount(), 4u);
+}
+
+MT_TEST(ByteBudgetAdmitsOversizedRequestAlone)
+{
+    ByteBudget budget(100);
+
+    budget.Acquire(60);
+    budget.Release(60);
+    budget.Acquire(500);
+    budget.Release(500);
+
+    MT_CHECK_EQ(budget.GetPeak(), 500u);
+}
+
+MT_TEST(LruCacheEvictsLeastRecentlyUsed)
+{
+    LruCache<int> cache(100);
+
+    cache.Put("a", std::make_shared<int>(1), 40);
+    cache.Put("b", std::make_shared<int>(2), 40);
+    MT_CHECK_EQ(*cache.Get("a"), 1);
+
+    cache.Put("c", std::make_shared<int>(3), 40);
+
+    MT_CHECK(cache.Get("b") == nullptr);
+    MT_CHECK(cache.Contains("a"));
+    MT_CHECK(cache.Contains("c"));
+
+    auto held = cache.Get("a");
+    cache.Put("large", std::make_shared<int>(4), 101);
+    cache.Put("d", std::make_shared<int>(5), 90);
+
+    MT_CHECK(!cache.Contains("large"));
+    MT_CHECK(!cache.Contains("a"));
+    MT_CHECK_EQ(*held, 1);
+
+    LruCacheStats stats = cache.GetStats();
+    MT_CHECK_EQ(stats.Entries, 1u);
+    MT_CHECK_EQ(stats.Bytes, 90u);
+    MT_CHECK_EQ(stats.Evictions, 3u);
+    MT_CHECK_EQ(stats.Misses, 1u);
+}
@@ -0,0 +1,305 @@
+#include "TestFramework.h"
+#include "MouseTrackerCore/Trajectory/TrajectorySimplifier.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryResampler.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryStatistics.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryLod.h"
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <set>
+#include <vector>
+
+using namespace Mt;
+
+namespace
+{
+    // Largest distance of any input sample to the simplified polyline, the
+    // slow way: against every segment, or at its own time.
+    double MeasureError(const Trajectory& input, const Trajectory& simplified, bool timed)
+    {
+        double worst = 0.0;
+        size_t segment = 0;
+
+        for (size_t i = 0; i < input.Size(); i++)
+        {
+            double best = 1e300;
+
+            for (size_t s = 0; s + 1 < simplified.Size(); s++)
+            {
+                const Point& a = simplified[s];
+                const Point& b = simplified[s + 1];
+                double dx = b.x - a.x;
+                double dy = b.y - a.y;
+                double t = 0.0;
+
+                if (timed)
+                {
+                    // Only the segment spanning the sample's time counts.
+                    int64_t time = input.GetTimestamps()[i];
+
+                    while (segment + 2 < simplified.Size() && simplified.GetTimestamps()[segment + 1] < time)
+                        segment++;
+
+                    if (s != segment)
+                        continue;
+
+                    int64_t span = simplified.GetTimestamps()[s + 1] - simplified.GetTimestamps()[s];
+                    t = span > 0 ? static_cast<double>(time - simplified.GetTimestamps()[s]) / span : 0.0;
+                }
+                else if (dx != 0.0 || dy != 0.0)
+                {
+                    t = ((input[i].x - a.x) * dx + (input[i].y - a.y) * dy) / (dx * dx + dy * dy);
+                }
+
+                t = std::min(std::max(t, 0.0), 1.0);
+                best = std::min(best, std::hypot(input[i].x - (a.x + t * dx), input[i].y - (a.y + t * dy)));
+            }
+
+            worst = std::max(worst, best);
+        }
+
+        return worst;
+    }
+
+    // A jittery hand-drawn-like path: slow curves, pauses and a straight run.
+    Trajectory MakeWobblyPath(size_t count)
+    {
+        Trajectory trajectory;
+        uint32_t seed = 12345;
+        int64_t time = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+
+            double angle = i * 0.002;
+            int x = static_cast<int>(std::lround(800 * std::cos(angle) + i * 0.05)) + static_cast<int>(seed >> 31);
+            int y = static_cast<int>(std::lround(500 * std::sin(angle * 3)));
+
+            time += (i % 5000 < 200) ? 20000 : 1000;
+            trajectory.Add(Point { x, y }, time);
+        }
+
+        return trajectory;
+    }
+}
+
+MT_TEST(SimplifierKeepsEndpointsAndCorners)
+{
+    Trajectory line;
+
+    for (int i = 0; i <= 1000; i++)
+        line.Add(Point { i, 2 * i }, i * 1000);
+
+    SimplifySettings settings;
+    settings.Tolerance = 0.5;
+
+    SimplifySummary summary;
+    Trajectory simplified = TrajectorySimplifier::Simplify(line, settings, &summary);
+
+    MT_CHECK_EQ(simplified.Size(), 2u);
+    MT_CHECK(simplified[1] == (Point { 1000, 2000 }));
+    MT_CHECK_EQ(simplified.GetTimestamps()[1], 1000000);
+    MT_CHECK_EQ(summary.InputSamples, 1001u);
+    MT_CHECK(summary.GetRatio() > 500.0);
+
+    // An L: the corner has to stay, the rest of each leg goes.
+    Trajectory corner;
+
+    for (int i = 0; i <= 100; i++)
+        corner.Add(Point { i, 0 });
+
+    for (int i = 1; i <= 100; i++)
+        corner.Add(Point { 100, i });
+
+    std::vector<size_t> kept = TrajectorySimplifier::SelectSamples(corner, settings);
+
+    MT_CHECK_EQ(kept.size(), 3u);
+    MT_CHECK_EQ(kept[1], 100u);
+
+    // Disabled keeps everything.
+    MT_CHECK_EQ(TrajectorySimplifier::SelectSamples(corner, SimplifySettings()).size(), corner.Size());
+}
+
+MT_TEST(SimplifierStaysWithinToleranceAndKeepsPauses)
+{
+    Trajectory path = MakeWobblyPath(20000);
+
+    for (bool timed : { false, true })
+    {
+        SimplifySettings settings;
+        settings.Tolerance = 2.0;
+        settings.UseTimestamps = timed;
+
+        SimplifySummary summary;
+        Trajectory simplified = TrajectorySimplifier::Simplify(path, settings, &summary);
+
+        MT_CHECK(simplified.Size() < path.Size() / 4);
+        MT_CHECK(summary.MaxError <= 2.0);
+        MT_CHECK(MeasureError(path, simplified, timed) <= 2.0 + 1e-9);
+    }
+
+    // A pause in the middle of a straight move only survives the timed metric.
+    Trajectory paused;
+
+    for (int i = 0; i < 100; i++)
+        paused.Add(Point { i, 0 }, i * 1000);
+
+    for (int i = 100; i < 200; i++)
+        paused.Add(Point { i, 0 }, 1000000 + i * 1000);
+
+    SimplifySettings spatial;
+    spatial.Tolerance = 1.0;
+    spatial.UseTimestamps = false;
+
+    SimplifySettings timed = spatial;
+    timed.UseTimestamps = true;
+
+    MT_CHECK_EQ(TrajectorySimplifier::SelectSamples(paused, spatial).size(), 2u);
+    MT_CHECK_EQ(TrajectorySimplifier::SelectSamples(paused, timed).size(), 4u);
+}
+
+MT_TEST(ResamplerInterpolatesOntoUniformClock)
+{
+    // Jittery 1 kHz pacing with a 10 ms stall, resampled to 2 ms.
+    Trajectory input;
+    input.Add(Point { 0, 0 }, 100);
+    input.Add(Point { 10, -10 }, 1100);
+    input.Add(Point { 20, -20 }, 2300);
+    input.Add(Point { 120, -20 }, 12300);
+    input.GetMetadata().ScreenWidth = 1920;
+
+    Trajectory resampled = TrajectoryResampler::Resample(input, 2000);
+
+    MT_CHECK_EQ(resampled.Size(), 7u);
+    MT_CHECK_EQ(resampled.GetMetadata().PeriodUs, 2000u);
+    MT_CHECK_EQ(resampled.GetMetadata().ScreenWidth, 1920);
+    MT_CHECK_EQ(resampled.GetTimestamps().front(), 100);
+    MT_CHECK_EQ(resampled.GetTimestamps().back(), 12100);
+    MT_CHECK(resampled[0] == (Point { 0, 0 }));
+    MT_CHECK(resampled[1] == (Point { 18, -18 }));
+    MT_CHECK(resampled[2] == (Point { 38, -20 }));
+    MT_CHECK(resampled[6] == (Point { 118, -20 }));
+
+    // Without timestamps the sampling period is the clock; without either, nothing.
+    Trajectory untimed(std::vector<Point> { { 0, 0 }, { 4, 8 }, { 8, 16 } });
+    MT_CHECK_EQ(TrajectoryResampler::GetResampledSize(untimed, 500), 0u);
+
+    untimed.GetMetadata().PeriodUs = 1000;
+
+    Point points[8];
+    MT_CHECK_EQ(TrajectoryResampler::GetResampledSize(untimed, 500), 5u);
+    MT_CHECK_EQ(TrajectoryResampler::Resample(untimed, 500, points, nullptr, 3), 3u);
+    MT_CHECK(points[1] == (Point { 2, 4 }));
+    MT_CHECK(points[2] == (Point { 4, 8 }));
+}
+
+MT_TEST(StatisticsSummarizeTrajectory)
+{
+    Trajectory trajectory;
+    trajectory.Add(Point { 0, 0 }, 0);
+    trajectory.Add(Point { 3, 4 }, 1000);
+    trajectory.Add(Point { 3, 4 }, 6000);
+    trajectory.Add(Point { -3, 12 }, 8000);
+
+    TrajectoryStatistics statistics = TrajectoryStatistics::Compute(trajectory);
+
+    MT_CHECK_EQ(statistics.Samples, 4u);
+    MT_CHECK_EQ(statistics.DurationUs, 8000);
+    MT_CHECK_EQ(statistics.MinX, -3);
+    MT_CHECK_EQ(statistics.MaxY, 12);
+    MT_CHECK(std::abs(statistics.PathLength - 15.0) < 1e-9);
+    MT_CHECK(std::abs(statistics.MeanSpeed - 1875.0) < 1e-9);
+    MT_CHECK(std::abs(statistics.MaxSpeed - 5000.0) < 1e-9);
+    MT_CHECK_EQ(statistics.MaxIntervalUs, 5000);
+
+    Trajectory untimed(std::vector<Point> { { 0, 0 }, { 3, 4 } });
+
+    MT_CHECK_EQ(TrajectoryStatistics::Compute(untimed).MeanSpeed, 0.0);
+    MT_CHECK_EQ(TrajectoryStatistics::Compute(Trajectory()).Samples, 0u);
+}
+
+MT_TEST(LodDrawsEveryPixelMoveOnce)
+{
+    // A 100k-sample random walk drawn at a tenth of its size: most steps
+    // stay inside a pixel, and the rest keep crossing the same borders.
+    Trajectory walk;
+    uint32_t state = 12345;
+    Point point = { 500, 500 };
+
+    for (int i = 0; i < 100000; i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        point.x = (std::clamp)(point.x + static_cast<int32_t>((state >> 8) % 5) - 2, 0, 999);
+        point.y = (std::clamp)(point.y + static_cast<int32_t>((state >> 16) % 5) - 2, 0, 999);
+        walk.Add(point);
+    }
+
+    LodTransform transform;
+    transform.ScaleX = transform.ScaleY = 0.1f;
+    transform.Width = transform.Height = 100;
+
+    TrajectoryLod lod;
+    lod.Build(walk, transform);
+
+    using Cell = std::pair<int, int>;
+
+    auto cellOf = [](float x, float y)
+    {
+        return Cell(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)));
+    };
+
+    // Moves between pixels of the full path, either direction, and of the strips.
+    std::set<std::pair<Cell, Cell>> expected;
+    std::set<std::pair<Cell, Cell>> drawn;
+    size_t segments = 0;
+
+    for (size_t i = 1; i < walk.Size(); i++)
+    {
+        Cell from = cellOf(walk[i - 1].x * 0.1f, walk[i - 1].y * 0.1f);
+        Cell to = cellOf(walk[i].x * 0.1f, walk[i].y * 0.1f);
+
+        if (from != to)
+            expected.insert({ (std::min)(from, to), (std::max)(from, to) });
+    }
+
+    for (const LodStrip& strip : lod.GetStrips())
+    {
+        MT_CHECK(strip.Count >= 2);
+
+        for (size_t i = strip.Offset + 1; i < strip.Offset + strip.Count; i++)
+        {
+            Cell from = cellOf(lod.GetPath()[i - 1].x, lod.GetPath()[i - 1].y);
+            Cell to = cellOf(lod.GetPath()[i].x, lod.GetPath()[i].y);
+
+            drawn.insert({ (std::min)(from, to), (std::max)(from, to) });
+            segments++;
+        }
+    }
+
+    Point min;
+    Point max;
+    MT_CHECK(TrajectoryLod::GetBounds(walk, min, max));
+    MT_CHECK_EQ(min.x, std::min_element(walk.begin(), walk.end(), [](const Point& l, const Point& r) { return l.x < r.x; })->x);
+    MT_CHECK_EQ(max.y, std::max_element(walk.begin(), walk.end(), [](const Point& l, const Point& r) { return l.y < r.y; })->y);
+    MT_CHECK(!TrajectoryLod::GetBounds(Trajectory(), min, max));
+
+    MT_CHECK_EQ(lod.GetSourceSamples(), walk.Size());
+    MT_CHECK(drawn == expected);
+    MT_CHECK_EQ(segments, expected.size());
+    MT_CHECK(lod.GetPath().size() < walk.Size() / 10);
+    MT_CHECK(lod.GetMarkers().size() <= 100u * 100u);
+
+    // At full size every sample is its own pixel and nothing is dropped.
+    Trajectory sparse(std::vector<Point> { { 0, 0 }, { 5, 0 }, { 5, 5 }, { 5, 5 }, { -3, 2 } });
+    transform.ScaleX = transform.ScaleY = 1.0f;
+    lod.Build(sparse, transform);
+
+    MT_CHECK_EQ(lod.GetStrips().size(), 1u);
+    MT_CHECK_EQ(lod.GetPath().size(), 4u);
+    MT_CHECK_EQ(lod.GetPath()[3].x, -2.5f);
+    MT_CHECK_EQ(lod.GetMarkers().size(), 4u);
+
+    lod.Build(Trajectory(), transform);
+    MT_CHECK(lod.GetPath().empty() && lod.GetMarkers().empty());
+}
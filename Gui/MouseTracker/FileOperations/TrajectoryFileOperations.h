@@ -5,7 +5,14 @@
 #include "FileOperations/WinApiFileOperations.h"
 #include "View/ViewRegistry.h"
 #include "Loggers/Logger.h"
-#include <fstream>
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Storage/TrajectoryWriteService.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Trajectory/TrajectorySimplifier.h"
+#include <memory>
+#include <mutex>
+#include <future>
 
 namespace Mt
 {
@@ -26,9 +33,9 @@ namespace Mt
                     return;
                 }
 
-                const auto& trajectory = trajectoryView->GetTrajectory();
+                auto trajectory = trajectoryView->GetTrajectory();
 
-                if (trajectory.empty())
+                if (!trajectory || trajectory->GetSpan().Empty())
                 {
                     Logger::GetInstance().Warning("No trajectory data to save");
 
@@ -38,27 +45,24 @@ namespace Mt
                 std::string filename = WinApiFileOperations::SaveFileDialog
                 (
                     "",
-                    {{ "Trajectory Files (.crsdat)", "*.crsdat" }, { "All Files", "*.*" }}
+                    GetSaveFilters()
                 );
 
                 if (filename.empty())
                     return;
 
-                std::ofstream file(filename);
+                // Same single writer as background saves, so archives are appended in
+                // order; only this save is waited for, not saves queued after it.
+                std::promise<TrajectoryJobResult> done;
+                std::future<TrajectoryJobResult> result = done.get_future();
 
-                if (file.is_open())
-                {
-                    for (const auto& point : trajectory)
-                        file << point.x << ";" << point.y << "\n";
+                if (!SubmitWrite(std::move(trajectory), std::move(filename), [&done](const TrajectoryJobResult& jobResult) { done.set_value(jobResult); }))
+                    return;
 
-                    file.close();
+                TrajectoryJobResult saved = result.get();
 
-                    Logger::GetInstance().InfoF("Trajectory saved to: %s", filename.c_str());
-                }
-                else
-                {
-                    Logger::GetInstance().ErrorF("Failed to save trajectory to: %s", filename.c_str());
-                }
+                if (saved.Result.Success)
+                    LogSimplification(saved.SamplesSubmitted, saved.SamplesWritten);
             }
 
             static void LoadTrajectoryWindowsCtx()
@@ -78,49 +82,24 @@ namespace Mt
                 std::string filename = WinApiFileOperations::OpenFileDialog
                 (
                     "",
-                    {{ "Trajectory Files (.crsdat)", "*.crsdat" }, { "All Files", "*.*" }}
+                    GetOpenFilters()
                 );
 
                 if (filename.empty())
                     return;
 
-                std::vector<POINT> trajectory;
-                std::ifstream file(filename);
-                std::string line;
-
-                if (file.is_open())
+                if (TrajectoryArchive::IsArchive(filename))
                 {
-                    while (std::getline(file, line))
-                    {
-                        size_t delimiter = line.find(';');
-
-                        if (delimiter != std::string::npos)
-                        {
-                            try
-                            {
-                                POINT point;
-                                point.x = std::stoi(line.substr(0, delimiter));
-                                point.y = std::stoi(line.substr(delimiter + 1));
-                                trajectory.push_back(point);
-                            }
-                            catch (const std::exception& e)
-                            {
-                                Logger::GetInstance().WarningF("Invalid line in trajectory file: %s", line.c_str());
-                            }
-                        }
-                    }
-
-                    file.close();
+                    if (auto archive = ReadArchive(filename))
+                        trajectoryView->SetArchive(archive);
 
-                    trajectoryView->SetTrajectory(trajectory);
-
-                    Logger::GetInstance().InfoF("Trajectory loaded from: %s (%zu points)", 
-                                            filename.c_str(), trajectory.size());
-                }
-                else
-                {
-                    Logger::GetInstance().ErrorF("Failed to load trajectory from: %s", filename.c_str());
+                    return;
                 }
+
+                auto trajectory = std::make_shared<MappedTrajectory>();
+
+                if (ReadTrajectory(filename, *trajectory))
+                    trajectoryView->SetTrajectory(trajectory);
             }
 
             static void SaveTrajectoryWindowsCtxAsync()
@@ -137,9 +116,9 @@ namespace Mt
                     return;
                 }
 
-                const auto& trajectory = trajectoryView->GetTrajectory();
+                auto trajectory = trajectoryView->GetTrajectory();
 
-                if (trajectory.empty())
+                if (!trajectory || trajectory->GetSpan().Empty())
                 {
                     Logger::GetInstance().Warning("No trajectory data to save");
 
@@ -149,156 +128,222 @@ namespace Mt
                 std::string filename = WinApiFileOperations::SaveFileDialog
                 (
                     "",
-                    {{ "Trajectory Files (.crsdat)", "*.crsdat" }, { "All Files", "*.*" }}
+                    GetSaveFilters()
                 );
 
                 if (filename.empty())
                     return;
 
-                std::vector<POINT> trajectoryCopy = trajectory;
-
-                std::thread([trajectoryCopy, filename]()
-                {
-                    try
-                    {
-                        std::ofstream file(filename);
-
-                        if (file.is_open())
-                        {
-                            for (const auto& point : trajectoryCopy)
-                                file << point.x << ";" << point.y << "\n";
-
-                            file.close();
-
-                            Logger::GetInstance().InfoF("Trajectory saved to: %s", filename.c_str());
-                        }
-                        else
-                        {
-                            Logger::GetInstance().ErrorF("Failed to save trajectory to: %s", filename.c_str());
-                        }
-                    }
-                    catch (const std::exception& e)
-                    {
-                        Logger::GetInstance().ErrorF("Async save error: %s", e.what());
-                    }
-                }).detach();
+                // The shared trajectory is immutable, so the writer needs no copy.
+                SubmitWrite(std::move(trajectory), std::move(filename));
             }
 
+            // Files load progressively in the view (which shows progress and
+            // can cancel); archives only read their index, so open right away.
             static void LoadTrajectoryWindowsCtxAsync()
             {
+                auto* trajectoryView = dynamic_cast<TrajectoryView*>
+                (
+                    ViewRegistry::GetInstance().GetView("TrajectoryView")
+                );
+
+                if (!trajectoryView)
+                {
+                    Logger::GetInstance().Error("Trajectory view not found");
+
+                    return;
+                }
+
                 std::string filename = WinApiFileOperations::OpenFileDialog
                 (
                     "",
-                    {{ "Trajectory Files (.crsdat)", "*.crsdat" }, { "All Files", "*.*" }}
+                    GetOpenFilters()
                 );
 
                 if (filename.empty())
                     return;
 
-                std::thread([filename]()
+                if (TrajectoryArchive::IsArchive(filename))
                 {
-                    try
+                    if (auto archive = ReadArchive(filename))
+                        trajectoryView->SetArchive(archive);
+
+                    return;
+                }
+
+                trajectoryView->LoadTrajectoryAsync(filename);
+            }
+
+            // Every later save keeps only the samples needed to stay within the
+            // tolerance; the trajectory on screen is not touched. Off by default.
+            static void SetSimplifySettings(const SimplifySettings& settings)
+            {
+                std::lock_guard<std::mutex> lock(GetSimplifyMutex());
+                GetSimplifySettingsStorage() = settings;
+            }
+
+            static SimplifySettings GetSimplifySettings()
+            {
+                std::lock_guard<std::mutex> lock(GetSimplifyMutex());
+
+                return GetSimplifySettingsStorage();
+            }
+
+            // Only formats that store timestamps can keep timing through a save;
+            // archives hold binary entries, so they do.
+            static bool KeepsTiming(const std::string& filename)
+            {
+                return TrajectoryIo::KeepsTimestamps(filename) || TrajectoryArchive::IsArchive(filename);
+            }
+
+            // Queued on the shared writer, which creates the directory. Blocks the
+            // recording thread only if the writer is a full queue behind.
+            static void SaveTrajectoryAsync(std::shared_ptr<const MappedTrajectory> trajectory, std::string filename)
+            {
+                if (!trajectory || trajectory->GetSpan().Empty())
+                    return;
+
+                SubmitWrite(std::move(trajectory), std::move(filename));
+            }
+
+            // Writes every queued save before the application exits.
+            static void Shutdown()
+            {
+                auto& service = GetWriteService();
+                service.Shutdown();
+
+                TrajectoryWriteStats stats = service.GetStats();
+
+                Logger::GetInstance().InfoF("Trajectory writer: %llu written, %llu failed, max queued %zu/%zu, %llu blocked saves (%.1f ms)",
+                    static_cast<unsigned long long>(stats.Written), static_cast<unsigned long long>(stats.Failed),
+                    stats.QueueHighWatermark, stats.QueueCapacity,
+                    static_cast<unsigned long long>(stats.BlockedSubmits), stats.BlockedUs / 1000.0);
+
+                LogSimplification(stats.SamplesSubmitted, stats.SamplesWritten);
+            }
+
+        private:
+            static std::vector<std::pair<std::string, std::string>> GetOpenFilters()
+            {
+                return
+                {
+                    { "Trajectory Files (.crsdat, .crsbin, .crsarc)", "*.crsdat;*.crsbin;*.crsarc" },
+                    { "All Files", "*.*" }
+                };
+            }
+
+            // The extension typed by the user picks the codec; text stays the default.
+            static std::vector<std::pair<std::string, std::string>> GetSaveFilters()
+            {
+                return
+                {
+                    { "Text Trajectory (.crsdat)", "*.crsdat" },
+                    { "Binary Trajectory (.crsbin)", "*.crsbin" },
+                    { "Append to Archive (.crsarc)", "*.crsarc" },
+                    { "All Files", "*.*" }
+                };
+            }
+
+            static TrajectoryWriteService& GetWriteService()
+            {
+                static TrajectoryWriteService service([]()
+                {
+                    TrajectoryWriteSettings settings;
+
+                    settings.OnCompleted = [](const std::string& filename, const CodecResult& result)
                     {
-                        std::vector<POINT> trajectory;
-                        std::ifstream file(filename);
-                        std::string line;
-
-                        if (file.is_open())
-                        {
-                            while (std::getline(file, line))
-                            {
-                                size_t delimiter = line.find(';');
-
-                                if (delimiter != std::string::npos)
-                                {
-                                    try
-                                    {
-                                        POINT point;
-                                        point.x = std::stoi(line.substr(0, delimiter));
-                                        point.y = std::stoi(line.substr(delimiter + 1));
-                                        trajectory.push_back(point);
-                                    }
-                                    catch (const std::exception& e)
-                                    {
-                                        Logger::GetInstance().WarningF("Invalid line in trajectory file: %s", line.c_str());
-                                    }
-                                }
-                            }
-                            
-                            file.close();
-
-                            auto* trajectoryView = dynamic_cast<TrajectoryView*>
-                            (
-                                ViewRegistry::GetInstance().GetView("TrajectoryView")
-                            );
-                            
-                            if (trajectoryView)
-                                trajectoryView->SetTrajectory(trajectory);
-
-                            Logger::GetInstance().InfoF("Trajectory loaded from: %s (%zu points)", 
-                                                    filename.c_str(), trajectory.size());
-                        }
+                        if (result.Success)
+                            Logger::GetInstance().InfoF("Trajectory saved to: %s", filename.c_str());
                         else
-                        {
-                            Logger::GetInstance().ErrorF("Failed to load trajectory from: %s", filename.c_str());
-                        }
-                    }
-                    catch (const std::exception& e)
-                    {
-                        Logger::GetInstance().ErrorF("Async load error: %s", e.what());
-                    }
-                }).detach();
+                            Logger::GetInstance().ErrorF("Failed to save trajectory to: %s (%s)", filename.c_str(), result.Error.c_str());
+                    };
+
+                    return settings;
+                }());
+
+                return service;
             }
 
-            static void SaveTrajectory(const std::vector<POINT>& trajectory, std::string outputDirectory, std::string filename)
+            static std::mutex& GetSimplifyMutex()
             {
-                if (trajectory.empty())
-                    return;
+                static std::mutex mutex;
+
+                return mutex;
+            }
 
-                WinApiFileOperations::CreateDirectoryRecursive(outputDirectory);
+            static SimplifySettings& GetSimplifySettingsStorage()
+            {
+                static SimplifySettings settings;
+
+                return settings;
+            }
 
-                std::ofstream file(filename);
+            // Simplification runs on the writer thread, so the saving thread
+            // (often the recorder) does not wait for it.
+            static bool SubmitWrite(std::shared_ptr<const MappedTrajectory> trajectory, std::string filename, TrajectoryJobCallback onCompleted = TrajectoryJobCallback())
+            {
+                std::string name = filename;
+                SimplifySettings simplify = GetSimplifySettings();
 
-                if (file.is_open())
+                if (simplify.IsEnabled() && simplify.UseTimestamps && trajectory->GetSpan().HasTimestamps() && !KeepsTiming(name))
+                    Logger::GetInstance().WarningF("%s stores no timestamps, the timing kept by simplification is lost", name.c_str());
+
+                if (!GetWriteService().Submit(TrajectoryWriteJob(std::move(filename), std::move(trajectory), simplify, std::move(onCompleted))))
                 {
-                    for (const auto& point : trajectory)
-                        file << point.x << ";" << point.y << "\n";
-                    
-                    file.close();
-                    
-                    Logger::GetInstance().InfoF("Trajectory saved to: %s", filename.c_str());
+                    Logger::GetInstance().ErrorF("Trajectory writer is shut down, %s not saved", name.c_str());
+
+                    return false;
                 }
-                else
+
+                return true;
+            }
+
+            static void LogSimplification(uint64_t submitted, uint64_t written)
+            {
+                if (written > 0 && written < submitted)
+                    Logger::GetInstance().InfoF("Simplified %llu -> %llu samples (%.1fx)",
+                        static_cast<unsigned long long>(submitted), static_cast<unsigned long long>(written),
+                        static_cast<double>(submitted) / written);
+            }
+
+            static std::shared_ptr<const TrajectoryArchive> ReadArchive(const std::string& filename)
+            {
+                auto archive = std::make_shared<TrajectoryArchive>();
+                CodecResult result = archive->Open(filename);
+
+                for (const auto& warning : result.Warnings)
+                    Logger::GetInstance().Warning(warning);
+
+                if (!result.Success)
                 {
-                    Logger::GetInstance().ErrorF("Failed to save trajectory to: %s", filename.c_str());
+                    Logger::GetInstance().ErrorF("Failed to open archive: %s (%s)", filename.c_str(), result.Error.c_str());
+
+                    return nullptr;
                 }
+
+                Logger::GetInstance().InfoF("Archive opened: %s (%zu trajectories)", filename.c_str(), archive->GetCount());
+
+                return archive;
             }
 
-            static void SaveTrajectoryAsync(const std::vector<POINT>& trajectory, std::string outputDirectory, std::string filename)
+            static bool ReadTrajectory(const std::string& filename, MappedTrajectory& trajectory)
             {
-                if (trajectory.empty())
-                    return;
-                
-                std::thread([trajectory, outputDirectory, filename]()
+                CodecResult result = trajectory.Open(filename);
+
+                for (const auto& warning : result.Warnings)
+                    Logger::GetInstance().Warning(warning);
+
+                if (!result.Success)
                 {
-                    WinApiFileOperations::CreateDirectoryRecursive(outputDirectory);
+                    Logger::GetInstance().ErrorF("Failed to load trajectory from: %s", filename.c_str());
+
+                    return false;
+                }
 
-                    std::ofstream file(filename);
+                Logger::GetInstance().InfoF("Trajectory loaded from: %s (%zu points%s)", 
+                                        filename.c_str(), trajectory.GetSpan().Size(), trajectory.IsMapped() ? ", mapped" : "");
 
-                    if (file.is_open())
-                    {
-                        for (const auto& point : trajectory)
-                            file << point.x << ";" << point.y << "\n";
-                        
-                        file.close();
-                        
-                        Logger::GetInstance().InfoF("Trajectory saved to: %s", filename.c_str());
-                    }
-                    else
-                    {
-                        Logger::GetInstance().ErrorF("Failed to save trajectory to: %s", filename.c_str());
-                    }
-                }).detach();
+                return true;
             }
     };
 }
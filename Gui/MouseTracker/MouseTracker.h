@@ -7,6 +7,7 @@
 #include "View/Views/ConsoleView.h"
 #include "View/Views/TrajectoryView.h"
 #include "View/Views/MouseTrackerView.h"
+#include "View/Views/DatasetBrowserView.h"
 #include "Loggers/Logger.h"
 #include "Loggers/ImGuiConsoleLogPolicy.h"
 #include "Loggers/FileLogPolicy.h"
@@ -38,6 +39,7 @@ namespace Mt
                 registry.RegisterView<ConsoleView>("Console", "Views", "Console");
                 registry.RegisterView<TrajectoryView>("TrajectoryView", "Views", "Trajectory");
                 registry.RegisterView<MouseTrackerView>("MouseTrackerView", "Views", "Mouse Tracker");
+                registry.RegisterView<DatasetBrowserView>("DatasetBrowserView", "Views", "Dataset Browser");
 
                 m_viewMenu = std::make_unique<ViewMenu>(&registry.GetInstance());
 
@@ -55,6 +57,9 @@ namespace Mt
                 if (trajectoryView && mouseTrackerView)
                     mouseTrackerView->SetTrajectoryView(trajectoryView);
 
+                if (auto* datasetBrowserView = dynamic_cast<DatasetBrowserView*>(registry.GetView("DatasetBrowserView")))
+                    datasetBrowserView->SetTrajectoryView(trajectoryView);
+
                 Logger::GetInstance().Debug("Mouse Tracker initialized");
             }
 
@@ -79,6 +84,7 @@ namespace Mt
             void Shutdown()
             {
                 WinApiHotkeyManager::GetInstance().StopListening();
+                TrajectoryFileOperations::Shutdown();
                 Logger::GetInstance().Info("Mouse Tracker shutting down");
             }
             
@@ -0,0 +1,358 @@
+#ifndef __MOUSE_TRACKER_IMGUI_DATASETBROWSERVIEW__
+#define __MOUSE_TRACKER_IMGUI_DATASETBROWSERVIEW__
+
+#include "View/IView.h"
+#include "View/Views/TrajectoryView.h"
+#include "FileOperations/WinApiFileOperations.h"
+#include "Loggers/Logger.h"
+#include "MouseTrackerCore/Dataset/DatasetBrowser.h"
+#include "MouseTrackerCore/Dataset/NumpyExporter.h"
+#include "MouseTrackerCore/Dataset/NumpyWriter.h"
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "imgui.h"
+
+namespace Mt
+{
+    // Lists every trajectory of a directory or archive. Only the rows on
+    // screen are touched each frame (ImGuiListClipper); their thumbnails and
+    // the selected trajectory load on the browser's background threads, so a
+    // row without data yet just shows a placeholder until a later frame.
+    class DatasetBrowserView : public IView
+    {
+        private:
+            DatasetBrowser m_browser;
+            TrajectoryView* m_trajectoryView;
+            std::string m_displayName;
+            std::string m_path;
+            int m_selected;
+            bool m_selectionShown;
+            float m_rowHeight;
+            int m_exportLayout;
+            int m_exportLength;
+
+            // Shared with the export thread, which may outlive a frame.
+            std::shared_ptr<std::atomic<bool>> m_exporting;
+
+        public:
+            DatasetBrowserView()
+            {
+                m_displayName = "Dataset Browser";
+                m_path = ".";
+                m_trajectoryView = nullptr;
+                m_selected = -1;
+                m_selectionShown = true;
+                m_rowHeight = 40.0f;
+                m_exportLayout = 0;
+                m_exportLength = 128;
+                m_exporting = std::make_shared<std::atomic<bool>>(false);
+                Visible = false;
+            }
+
+            void SetTrajectoryView(TrajectoryView* trajectoryView)
+            {
+                m_trajectoryView = trajectoryView;
+            }
+
+            void Open(const std::string& path)
+            {
+                m_path = path;
+                m_selected = -1;
+
+                CodecResult result = m_browser.Open(path);
+
+                if (!result.Success)
+                {
+                    Logger::GetInstance().ErrorF("Failed to open dataset %s: %s", path.c_str(), result.Error.c_str());
+
+                    return;
+                }
+
+                Logger::GetInstance().InfoF("Dataset opened: %s (%zu trajectories)", path.c_str(), m_browser.GetCount());
+            }
+
+            void Draw() override
+            {
+                if (!Visible)
+                    return;
+
+                ImGui::Begin(GetDisplayName().c_str(), &Visible);
+
+                if (m_browser.Refresh() && m_selected >= static_cast<int>(m_browser.GetCount()))
+                    m_selected = -1;
+
+                DrawSourceControls();
+                DrawExportControls();
+                ImGui::Separator();
+                DrawItemTable();
+                ShowSelection();
+
+                ImGui::End();
+            }
+
+            const std::string& GetType() const override
+            {
+                static std::string type = "DatasetBrowserView";
+
+                return type;
+            }
+
+            const std::string& GetCategory() const override
+            {
+                static std::string category = "Views";
+
+                return category;
+            }
+
+            const std::string& GetDisplayName() const override
+            {
+                return m_displayName;
+            }
+
+        private:
+            void DrawSourceControls()
+            {
+                char buffer[256] = "";
+                strncpy(buffer, m_path.c_str(), IM_ARRAYSIZE(buffer) - 1);
+                buffer[IM_ARRAYSIZE(buffer) - 1] = '\0';
+
+                ImGui::SetNextItemWidth(300);
+
+                if (ImGui::InputText("Dataset", buffer, IM_ARRAYSIZE(buffer), ImGuiInputTextFlags_EnterReturnsTrue))
+                    Open(buffer);
+                else
+                    m_path = buffer;
+
+                ImGui::SameLine();
+
+                if (ImGui::Button("Folder..."))
+                {
+                    std::string selected = WinApiFileOperations::SelectFolderDialog(m_path);
+
+                    if (!selected.empty())
+                        Open(selected);
+                }
+
+                ImGui::SameLine();
+
+                if (ImGui::Button("Archive..."))
+                {
+                    std::string selected = WinApiFileOperations::OpenFileDialog("", { { "Trajectory Archive (.crsarc)", "*.crsarc" } });
+
+                    if (!selected.empty())
+                        Open(selected);
+                }
+
+                DatasetBrowserStats stats = m_browser.GetStats();
+
+                ImGui::Text("%zu trajectories | cache %.1f / %.0f MiB, %zu loaded | thumbnails %zu | %zu queued",
+                    stats.Items, stats.Trajectories.Bytes / 1048576.0, stats.Trajectories.BudgetBytes / 1048576.0,
+                    stats.Trajectories.Entries, stats.Thumbnails.Entries, stats.Pending);
+            }
+
+            void DrawExportControls()
+            {
+                ImGui::SetNextItemWidth(120);
+                ImGui::Combo("Layout", &m_exportLayout, "Ragged\0Resampled\0");
+
+                if (m_exportLayout == 1)
+                {
+                    ImGui::SameLine();
+                    ImGui::SetNextItemWidth(100);
+
+                    if (ImGui::InputInt("Length", &m_exportLength))
+                        m_exportLength = (std::max)(2, m_exportLength);
+                }
+
+                ImGui::SameLine();
+
+                if (*m_exporting)
+                {
+                    ImGui::TextDisabled("Exporting...");
+
+                    return;
+                }
+
+                if (ImGui::Button("Export NumPy...") && !m_browser.GetPath().empty())
+                {
+                    std::string filename = WinApiFileOperations::SaveFileDialog("", { { "NumPy Archive (.npz)", "*.npz" } });
+
+                    if (filename.empty())
+                        return;
+
+                    if (!NumpyWriter::IsArchivePath(filename))
+                        filename += ".npz";
+
+                    NumpyExportSettings settings;
+                    settings.OutputPath = filename;
+                    settings.Layout = m_exportLayout == 0 ? NumpyLayout::Ragged : NumpyLayout::Resampled;
+                    settings.Length = static_cast<size_t>(m_exportLength);
+
+                    StartExport(m_browser.GetPath(), settings);
+                }
+            }
+
+            // Loads the whole dataset into an arena and writes it on a worker
+            // thread; the browser keeps scrolling meanwhile.
+            void StartExport(const std::string& source, const NumpyExportSettings& settings)
+            {
+                auto exporting = m_exporting;
+                *exporting = true;
+
+                std::thread([source, settings, exporting]()
+                {
+                    try
+                    {
+                        DatasetLoadSettings loadSettings;
+                        loadSettings.InputDirectory = source;
+
+                        TrajectoryDataset dataset;
+                        DatasetLoadSummary loaded = dataset.Load(loadSettings);
+
+                        for (const auto& error : loaded.Errors)
+                            Logger::GetInstance().Warning(error);
+
+                        NumpyExportSummary summary;
+                        CodecResult result = NumpyExporter::Export(dataset, settings, &summary);
+
+                        if (result.Success)
+                            Logger::GetInstance().InfoF("Exported %llu trajectories to %s (%.1f MB)", static_cast<unsigned long long>(summary.Trajectories),
+                                settings.OutputPath.c_str(), summary.BytesWritten / 1048576.0);
+                        else
+                            Logger::GetInstance().ErrorF("Export to %s failed: %s", settings.OutputPath.c_str(), result.Error.c_str());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        Logger::GetInstance().ErrorF("Export error: %s", e.what());
+                    }
+
+                    *exporting = false;
+                }).detach();
+            }
+
+            void DrawItemTable()
+            {
+                ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable;
+
+                if (!ImGui::BeginTable("DatasetItems", 5, flags))
+                    return;
+
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Preview", ImGuiTableColumnFlags_WidthFixed, m_rowHeight * 2.0f);
+                ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Points", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+                ImGui::TableSetupColumn("Duration", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+                ImGui::TableSetupColumn("Bounds", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+                ImGui::TableHeadersRow();
+
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(m_browser.GetCount()), m_rowHeight);
+
+                while (clipper.Step())
+                {
+                    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                    {
+                        DatasetItem item = m_browser.GetItem(static_cast<size_t>(row));
+                        std::shared_ptr<const DatasetThumbnail> thumbnail = m_browser.GetThumbnail(static_cast<size_t>(row));
+
+                        if (thumbnail && thumbnail->Error.empty())
+                        {
+                            item.HasSummary = true;
+                            item.Summary = thumbnail->Summary;
+                        }
+
+                        ImGui::TableNextRow(ImGuiTableRowFlags_None, m_rowHeight);
+                        ImGui::TableNextColumn();
+
+                        DrawThumbnail(thumbnail.get());
+
+                        ImGui::TableNextColumn();
+                        ImGui::PushID(row);
+
+                        if (ImGui::Selectable(item.Name.c_str(), m_selected == row, ImGuiSelectableFlags_SpanAllColumns, ImVec2(0, m_rowHeight)))
+                        {
+                            m_selected = row;
+                            m_selectionShown = false;
+                        }
+
+                        ImGui::PopID();
+
+                        if (thumbnail && !thumbnail->Error.empty() && ImGui::IsItemHovered())
+                            ImGui::SetTooltip("%s", thumbnail->Error.c_str());
+
+                        ImGui::TableNextColumn();
+
+                        if (item.HasSummary)
+                            ImGui::Text("%llu", static_cast<unsigned long long>(item.Summary.SampleCount));
+
+                        ImGui::TableNextColumn();
+
+                        if (item.HasSummary)
+                            ImGui::Text("%.0f ms", item.Summary.DurationUs / 1000.0);
+
+                        ImGui::TableNextColumn();
+
+                        if (item.HasSummary)
+                            ImGui::Text("(%d, %d)-(%d, %d)", item.Summary.MinX, item.Summary.MinY, item.Summary.MaxX, item.Summary.MaxY);
+                    }
+                }
+
+                ImGui::EndTable();
+            }
+
+            void DrawThumbnail(const DatasetThumbnail* thumbnail)
+            {
+                ImVec2 size(m_rowHeight * 2.0f, m_rowHeight);
+                ImVec2 origin = ImGui::GetCursorScreenPos();
+                ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+                ImGui::Dummy(size);
+
+                if (!thumbnail)
+                {
+                    drawList->AddText(ImVec2(origin.x + 4.0f, origin.y + 4.0f), IM_COL32(128, 128, 128, 255), "...");
+
+                    return;
+                }
+
+                if (thumbnail->Points.size() < 2)
+                    return;
+
+                const ArchiveIndexEntry& bounds = thumbnail->Summary;
+                float scaleX = (size.x - 4.0f) / static_cast<float>((std::max)(1, bounds.MaxX - bounds.MinX));
+                float scaleY = (size.y - 4.0f) / static_cast<float>((std::max)(1, bounds.MaxY - bounds.MinY));
+                float scale = (std::min)(scaleX, scaleY);
+
+                ImVec2 previous;
+
+                for (size_t i = 0; i < thumbnail->Points.size(); i++)
+                {
+                    const Point& point = thumbnail->Points[i];
+                    ImVec2 current(origin.x + 2.0f + (point.x - bounds.MinX) * scale, origin.y + 2.0f + (point.y - bounds.MinY) * scale);
+
+                    if (i > 0)
+                        drawList->AddLine(previous, current, IM_COL32(0, 204, 255, 255), 1.0f);
+
+                    previous = current;
+                }
+            }
+
+            // The selected trajectory is handed to the trajectory view once it has loaded.
+            void ShowSelection()
+            {
+                if (m_selectionShown || m_selected < 0 || !m_trajectoryView)
+                    return;
+
+                if (auto trajectory = m_browser.GetTrajectory(static_cast<size_t>(m_selected)))
+                {
+                    m_trajectoryView->SetTrajectory(trajectory);
+                    m_selectionShown = true;
+                }
+            }
+    };
+}
+
+#endif
@@ -2,7 +2,10 @@
 #define __MOUSE_TRACKER_IMGUI_MOUSETRACKERVIEW__
 
 #include "View/IView.h"
-#include "TrajectoryRecorder.h"
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Storage/ChunkedTrajectoryWriter.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Dataset/DatasetManifest.h"
 #include "TrajectoryView.h"
 #include "FileOperations/WinApiFileOperations.h"
 #include "FileOperations/TrajectoryFileOperations.h"
@@ -15,6 +18,8 @@
 #include <map>
 #include <filesystem>
 #include <future>
+#include <algorithm>
+#include <iterator>
 
 namespace Mt
 {
@@ -32,7 +37,10 @@ namespace Mt
             
             std::string m_outputDirectory;
             std::string m_baseFilename;
-            int m_fileCounter;
+            std::string m_fileExtension;
+            DatasetManifest m_manifest;
+            float m_simplifyTolerance;
+            bool m_simplifyTimed;
             
             std::atomic<bool> m_isRecording;
             std::atomic<bool> m_shouldStop;
@@ -58,7 +66,9 @@ namespace Mt
                 m_recordingMode = RecordingMode::Continuous;
                 m_outputDirectory = ".";
                 m_baseFilename = "trajectory";
-                m_fileCounter = 1;
+                m_fileExtension = ".crsdat";
+                m_simplifyTolerance = 0.0f;
+                m_simplifyTimed = true;
                 m_isRecording = false;
                 m_trajectoryView = nullptr;
                 m_hotkeysEnabled = false;
@@ -69,7 +79,7 @@ namespace Mt
                 InitializeHotkeyPresets();
                 m_currentHotkey = "Ctrl + R";
 
-                UpdateNextFileCounter();
+                OpenManifest();
                 RegisterHotkeys();
 
                 m_recordingThread = std::thread([this]() { this->RecordingWorker(); });
@@ -115,6 +125,8 @@ namespace Mt
 
                 m_isRecording = true;
                 m_shouldStop = false;
+                m_recorder.ResetStop();
+                m_recorder.SetRecordTimestamps(TrajectoryFileOperations::KeepsTiming(m_fileExtension));
                 
                 if (m_onRecordingStart)
                     m_onRecordingStart();
@@ -130,6 +142,7 @@ namespace Mt
 
                 m_shouldStop = true;
                 m_isRecording = false;
+                m_recorder.RequestStop();
                 
                 if (m_onRecordingStop)
                     m_onRecordingStop();
@@ -331,7 +344,10 @@ namespace Mt
                 strncpy(buffer, m_outputDirectory.c_str(), IM_ARRAYSIZE(buffer) - 1);
                 buffer[IM_ARRAYSIZE(buffer) - 1] = '\0';
 
-                if (ImGui::InputText("Output Directory", buffer, IM_ARRAYSIZE(buffer)))
+                ImGui::InputText("Output Directory", buffer, IM_ARRAYSIZE(buffer));
+
+                // The manifest is reloaded once editing ends, not on every keystroke.
+                if (ImGui::IsItemDeactivatedAfterEdit())
                     directoryChanged = true;
 
                 m_outputDirectory = std::string(buffer);
@@ -349,23 +365,77 @@ namespace Mt
                     }
                 }
 
-                bool filenameChanged = false;
-
                 ImGui::SetNextItemWidth(200);
 
                 strncpy(buffer, m_baseFilename.c_str(), IM_ARRAYSIZE(buffer) - 1);
                 buffer[IM_ARRAYSIZE(buffer) - 1] = '\0';
 
-                if (ImGui::InputText("Base Filename", buffer, IM_ARRAYSIZE(buffer)))
-                    filenameChanged = true;
+                ImGui::InputText("Base Filename", buffer, IM_ARRAYSIZE(buffer));
 
                 m_baseFilename = std::string(buffer);
 
-                if (directoryChanged || filenameChanged)
-                    UpdateNextFileCounter();
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(90);
+
+                static const char* extensions[] = { ".crsdat", ".crsbin", TrajectoryArchive::Extension };
+                int format = static_cast<int>(std::find(std::begin(extensions), std::end(extensions), m_fileExtension) - std::begin(extensions)) % 3;
+
+                if (ImGui::Combo("Format", &format, "Text\0Binary\0Archive\0"))
+                    m_fileExtension = extensions[format];
+
+                if (directoryChanged)
+                    OpenManifest();
                 
                 ImGui::SameLine();
-                ImGui::Text("Next: %s_%d.crsdat", m_baseFilename.c_str(), m_fileCounter);
+
+                if (TrajectoryArchive::IsArchive(m_fileExtension))
+                    ImGui::Text("Appending to: %s%s", m_baseFilename.c_str(), m_fileExtension.c_str());
+                else
+                    ImGui::Text("Next: %s_%d%s", m_baseFilename.c_str(), m_manifest.PeekIndex(m_baseFilename), m_fileExtension.c_str());
+
+                DrawSimplifySettings();
+            }
+
+            // Error-bounded simplification on save; 0 px keeps every sample.
+            void DrawSimplifySettings()
+            {
+                bool changed = false;
+
+                ImGui::SetNextItemWidth(120);
+
+                if (ImGui::InputFloat("Simplify (px)", &m_simplifyTolerance, 0.5f, 1.0f, "%.1f"))
+                {
+                    m_simplifyTolerance = std::max(m_simplifyTolerance, 0.0f);
+                    changed = true;
+                }
+
+                ImGui::SameLine();
+
+                // Text recordings carry no timestamps, so there is no timing to keep.
+                if (TrajectoryFileOperations::KeepsTiming(m_fileExtension))
+                {
+                    if (ImGui::Checkbox("Keep timing", &m_simplifyTimed))
+                        changed = true;
+
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("Measure the error at each sample's own time, so pauses and speed changes are kept");
+                }
+                else
+                {
+                    ImGui::TextDisabled("Keep timing");
+
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("Text files store no timestamps; choose Binary or Archive to keep timing");
+                }
+
+                if (changed)
+                {
+                    SimplifySettings settings;
+                    settings.Tolerance = m_simplifyTolerance;
+                    settings.UseTimestamps = m_simplifyTimed;
+
+                    TrajectoryFileOperations::SetSimplifySettings(settings);
+                }
             }
 
             void DrawHotkeySettings()
@@ -420,27 +490,77 @@ namespace Mt
                 }
             }
 
+            // Appends the capture to its file chunk by chunk while it runs, so a
+            // crash keeps everything up to the last chunk. A capture stopped by
+            // the user is kept, as it is already on disk.
+            void RecordPointsToDisk()
+            {
+                std::string filename = ReserveOutputFilename();
+
+                WinApiFileOperations::CreateDirectoryRecursive(m_outputDirectory);
+
+                ChunkedTrajectoryWriter writer;
+                CodecResult result = writer.Open(filename, m_recorder.DescribeCapture(m_delta));
+
+                if (!result.Success)
+                {
+                    Logger::GetInstance().ErrorF("Failed to start recording: %s", result.Error.c_str());
+
+                    return;
+                }
+
+                m_recorder.Stream(writer, m_count, m_delta);
+                writer.Stop();
+
+                ChunkedRecordingStats stats = writer.GetStats();
+
+                if (stats.WriteFailed)
+                    Logger::GetInstance().ErrorF("Failed to save trajectory to: %s", filename.c_str());
+                else
+                    Logger::GetInstance().InfoF("Trajectory saved to: %s (%llu samples, %llu chunks, %llu dropped)", filename.c_str(),
+                        static_cast<unsigned long long>(stats.Written), static_cast<unsigned long long>(stats.Chunks),
+                        static_cast<unsigned long long>(stats.Dropped));
+
+                auto recorded = std::make_shared<MappedTrajectory>();
+
+                if (!recorded->Open(filename).Success)
+                    return;
+
+                DatasetManifest::Append(filename, recorded->GetSpan());
+
+                if (m_trajectoryView)
+                    m_trajectoryView->SetTrajectory(recorded);
+            }
+
             void RecordingThread()
             {
                 try
                 {
-                    std::vector<POINT> trajectory;
+                    Trajectory trajectory;
                     
                     switch (m_recordingMode)
                     {
                         case RecordingMode::Standard:
-                            trajectory = m_recorder.StartReadCursorRoutineTscCpuWait(m_count, m_delta);
+                            if (m_fileExtension == ".crsbin")
+                            {
+                                RecordPointsToDisk();
+                                StopRecording();
 
-                            if (!trajectory.empty() && !m_shouldStop)
+                                break;
+                            }
+
+                            trajectory = m_recorder.RecordPoints(m_count, m_delta);
+
+                            if (!trajectory.Empty() && !m_shouldStop)
                             {
+                                auto recorded = std::make_shared<const MappedTrajectory>(std::move(trajectory));
+
                                 if (m_trajectoryView)
-                                    m_trajectoryView->SetTrajectory(trajectory);
+                                    m_trajectoryView->SetTrajectory(recorded);
 
-                                std::string filename = m_outputDirectory + "\\" + m_baseFilename + "_" + 
-                                    std::to_string(m_fileCounter) + ".crsdat";
+                                std::string filename = ReserveOutputFilename();
 
-                                TrajectoryFileOperations::SaveTrajectoryAsync(trajectory, m_outputDirectory, filename);
-                                m_fileCounter++;
+                                TrajectoryFileOperations::SaveTrajectoryAsync(recorded, filename);
                             }
 
                             StopRecording();
@@ -450,18 +570,18 @@ namespace Mt
                         case RecordingMode::Continuous:
                             while (m_isRecording && !m_shouldStop)
                             {
-                                trajectory = m_recorder.StartReadMouseTrajectoryRoutineTscCpuWait(m_endDelay, m_delta);
+                                trajectory = m_recorder.RecordTrajectory(m_endDelay, m_delta);
 
-                                if (!trajectory.empty() && !m_shouldStop)
+                                if (!trajectory.Empty() && !m_shouldStop)
                                 {
+                                    auto recorded = std::make_shared<const MappedTrajectory>(std::move(trajectory));
+
                                     if (m_trajectoryView)
-                                        m_trajectoryView->SetTrajectory(trajectory);
+                                        m_trajectoryView->SetTrajectory(recorded);
 
-                                    std::string filename = m_outputDirectory + "\\" + m_baseFilename + "_" + 
-                                    std::to_string(m_fileCounter) + ".crsdat";
+                                    std::string filename = ReserveOutputFilename();
 
-                                    TrajectoryFileOperations::SaveTrajectoryAsync(trajectory, m_outputDirectory, filename);
-                                    m_fileCounter++;
+                                    TrajectoryFileOperations::SaveTrajectoryAsync(recorded, filename);
                                 }
                             }
                                 
@@ -480,38 +600,36 @@ namespace Mt
                 m_isRecording = false;
             }
 
-            void UpdateNextFileCounter()
+            // Archive captures all go to one file in the output directory, one
+            // entry each; numbered files take the manifest's next free index.
+            std::string ReserveOutputFilename()
             {
-                if (!WinApiFileOperations::DirectoryExists(m_outputDirectory))
-                {
-                    m_fileCounter = 1;
+                if (TrajectoryArchive::IsArchive(m_fileExtension))
+                    return m_outputDirectory + "\\" + m_baseFilename + m_fileExtension;
 
-                    return;
-                }
+                if (m_manifest.GetDirectory() != m_outputDirectory)
+                    OpenManifest();
 
-                m_fileCounter = 1;
-                std::string pattern = m_baseFilename + "_*.crsdat";
-                
-                try
-                {
-                    for (const auto& entry : std::filesystem::directory_iterator(m_outputDirectory))
-                    {
-                        if (entry.is_regular_file())
-                        {
-                            std::string filename = entry.path().filename().string();
-                            
-                            if (filename.find(m_baseFilename + "_") == 0)
-                            {
-                                m_fileCounter++;
-                            }
-                        }
-                    }
-                }
-                catch (const std::exception& e)
+                // A directory that did not exist when it was chosen is watched from its first save.
+                if (!m_manifest.IsWatching())
                 {
-                    Logger::GetInstance().WarningF("Error scanning directory: %s", e.what());
-                    m_fileCounter = 1;
+                    WinApiFileOperations::CreateDirectoryRecursive(m_outputDirectory);
+                    m_manifest.Watch();
                 }
+
+                int index = m_manifest.ReserveIndex(m_baseFilename, m_fileExtension);
+
+                return m_outputDirectory + "\\" + m_baseFilename + "_" + std::to_string(index) + m_fileExtension;
+            }
+
+            // Only a directory change touches the disk; afterwards the watcher
+            // keeps the counter right when files are moved in or deleted.
+            void OpenManifest()
+            {
+                if (!m_manifest.Open(m_outputDirectory))
+                    Logger::GetInstance().WarningF("Unable to read manifest of %s", m_outputDirectory.c_str());
+
+                m_manifest.Watch();
             }
     };
 }
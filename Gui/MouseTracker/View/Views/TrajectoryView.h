@@ -2,8 +2,15 @@
 #define __MOUSE_TRACKER_IMGUI_TRAJECTORYVIEW__
 
 #include "View/IView.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Codecs/ProgressiveTrajectoryLoader.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Trajectory/TrajectoryLod.h"
+#include "Loggers/Logger.h"
 #include <vector>
-#include <windows.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #include "imgui.h"
 
 namespace Mt
@@ -11,7 +18,14 @@ namespace Mt
     class TrajectoryView : public IView
     {
         private:
-            std::vector<POINT> m_trajectoryPoints;
+            // Shared so recordings, loaders and savers hand the samples around
+            // without copying; mapped files stay mapped while referenced here.
+            std::shared_ptr<const MappedTrajectory> m_trajectory;
+            mutable std::mutex m_trajectoryMutex;
+
+            // Set while browsing an archive; entries are decoded one at a time.
+            std::shared_ptr<const TrajectoryArchive> m_archive;
+            int m_archiveEntry;
             std::string m_displayName;
             bool m_showTable;
             bool m_showGraph;
@@ -22,6 +36,32 @@ namespace Mt
             int m_screenWidth;
             int m_screenHeight;
 
+            // What the graph draws, rebuilt only when the trajectory, the
+            // canvas size, the resolution or the point radius changes. Weak,
+            // so a cleared trajectory is not kept alive by the graph.
+            static constexpr size_t MaxPolylinePoints = 8192;
+            TrajectoryLod m_lod;
+            std::weak_ptr<const MappedTrajectory> m_lodSource;
+            LodTransform m_lodTransform;
+
+            // The level of detail in screen coordinates, redone only when it
+            // is rebuilt or the canvas moves, so an idle frame only submits it.
+            std::vector<ImVec2> m_screenPath;
+            std::vector<ImVec2> m_screenMarkers;
+            ImVec2 m_screenStart;
+            ImVec2 m_screenEnd;
+            ImVec2 m_screenOrigin;
+            bool m_screenValid;
+
+            Point m_boundsMin;
+            float m_boundsWidth;
+            float m_boundsHeight;
+            int m_boundsScreenWidth;
+            int m_boundsScreenHeight;
+
+            // Last member, so it is stopped before anything its callbacks touch.
+            std::unique_ptr<ProgressiveTrajectoryLoader> m_loader;
+
         public:
             TrajectoryView() 
             {
@@ -34,21 +74,85 @@ namespace Mt
                 m_pointColor = ImVec4(1.0f, 0.0f, 0.0f, 0.7f);
                 m_screenWidth = 1920;
                 m_screenHeight = 1080;
+                m_archiveEntry = 0;
+                m_boundsMin = {0, 0};
+                m_boundsWidth = 1.0f;
+                m_boundsHeight = 1.0f;
+                m_boundsScreenWidth = 0;
+                m_boundsScreenHeight = 0;
+                m_screenValid = false;
+
+                ProgressiveLoadSettings settings;
+                settings.OnPartial = [this](std::shared_ptr<const MappedTrajectory> trajectory) { ShowTrajectory(std::move(trajectory)); };
+                settings.OnLoaded = [this](const std::string& filename, std::shared_ptr<const MappedTrajectory> trajectory, const CodecResult& result)
+                {
+                    OnLoaded(filename, std::move(trajectory), result);
+                };
+
+                m_loader = std::make_unique<ProgressiveTrajectoryLoader>(std::move(settings));
+            }
+
+            void SetTrajectory(Trajectory trajectory)
+            {
+                SetTrajectory(std::make_shared<const MappedTrajectory>(std::move(trajectory)));
+            }
+
+            // Replaces whatever is shown, cancelling a load still in progress.
+            void SetTrajectory(std::shared_ptr<const MappedTrajectory> trajectory)
+            {
+                m_loader->Cancel();
+                ShowTrajectory(std::move(trajectory));
+            }
+
+            // Loads in the background, showing the part decoded so far as it
+            // grows; anything else shown in the view cancels it.
+            void LoadTrajectoryAsync(const std::string& filename)
+            {
+                m_loader->Load(filename);
+            }
+
+            void CancelLoad()
+            {
+                m_loader->Cancel();
             }
 
-            void SetTrajectory(const std::vector<POINT>& points)
+            // Shows one entry of the archive and lets the user step through the rest.
+            void SetArchive(std::shared_ptr<const TrajectoryArchive> archive, size_t entry = 0)
             {
-                m_trajectoryPoints = points;
+                m_loader->Cancel();
+
+                Trajectory trajectory;
+
+                if (archive && entry < archive->GetCount())
+                {
+                    CodecResult result = archive->Read(entry, trajectory);
+
+                    if (!result.Success)
+                        Logger::GetInstance().ErrorF("Failed to read archive entry %zu: %s", entry, result.Error.c_str());
+                }
+
+                std::lock_guard<std::mutex> lock(m_trajectoryMutex);
+
+                m_trajectory = std::make_shared<const MappedTrajectory>(std::move(trajectory));
+                m_archive = std::move(archive);
+                m_archiveEntry = static_cast<int>(entry);
             }
 
             void ClearTrajectory()
             {
-                m_trajectoryPoints.clear();
+                m_loader->Cancel();
+
+                std::lock_guard<std::mutex> lock(m_trajectoryMutex);
+
+                m_trajectory.reset();
+                m_archive.reset();
             }
 
-            const std::vector<POINT>& GetTrajectory() const
+            std::shared_ptr<const MappedTrajectory> GetTrajectory() const
             {
-                return m_trajectoryPoints;
+                std::lock_guard<std::mutex> lock(m_trajectoryMutex);
+
+                return m_trajectory;
             }
 
             void Draw() override
@@ -56,9 +160,20 @@ namespace Mt
                 if (!Visible)
                     return;
 
-                ImGui::Begin(GetDisplayName().c_str(), &Visible);
+                // Collapsed or docked out of sight: nothing to lay out or draw.
+                if (!ImGui::Begin(GetDisplayName().c_str(), &Visible))
+                {
+                    ImGui::End();
+
+                    return;
+                }
+
+                // Held for the whole frame so a concurrent SetTrajectory cannot
+                // unmap the columns being drawn.
+                std::shared_ptr<const MappedTrajectory> source = GetTrajectory();
+                TrajectorySpan trajectory = source ? source->GetSpan() : TrajectorySpan();
 
-                DrawControls();
+                DrawControls(trajectory);
                 ImGui::Separator();
 
                 if (m_showTable && m_showGraph)
@@ -66,24 +181,24 @@ namespace Mt
                     float tableWidth = ImGui::GetContentRegionAvail().x * 0.4f;
                     
                     ImGui::BeginChild("TableRegion", ImVec2(tableWidth, 0), true);
-                    DrawPointTable();
+                    DrawPointTable(trajectory);
                     ImGui::EndChild();
                     
                     ImGui::SameLine();
                     
                     ImGui::BeginChild("GraphRegion", ImVec2(0, 0), true);
-                    DrawTrajectoryGraph();
+                    DrawTrajectoryGraph(source, trajectory);
                     ImGui::EndChild();
                 }
 
                 else if (m_showTable)
                 {
-                    DrawPointTable();
+                    DrawPointTable(trajectory);
                 }
 
                 else if (m_showGraph)
                 {
-                    DrawTrajectoryGraph();
+                    DrawTrajectoryGraph(source, trajectory);
                 }
 
                 ImGui::End();
@@ -109,13 +224,45 @@ namespace Mt
             }
 
         private:
-            void DrawControls()
+            void ShowTrajectory(std::shared_ptr<const MappedTrajectory> trajectory)
+            {
+                std::lock_guard<std::mutex> lock(m_trajectoryMutex);
+
+                m_trajectory = std::move(trajectory);
+                m_archive.reset();
+            }
+
+            // A failed load keeps showing the part that decoded before the error.
+            void OnLoaded(const std::string& filename, std::shared_ptr<const MappedTrajectory> trajectory, const CodecResult& result)
+            {
+                for (const auto& warning : result.Warnings)
+                    Logger::GetInstance().Warning(warning);
+
+                if (!trajectory->GetSpan().Empty() || result.Success)
+                    ShowTrajectory(trajectory);
+
+                if (!result.Success)
+                {
+                    Logger::GetInstance().ErrorF("Failed to load trajectory from: %s (%s)", filename.c_str(), result.Error.c_str());
+
+                    return;
+                }
+
+                Logger::GetInstance().InfoF("Trajectory loaded from: %s (%zu points%s)",
+                                        filename.c_str(), trajectory->GetSpan().Size(), trajectory->IsMapped() ? ", mapped" : "");
+            }
+
+            void DrawControls(const TrajectorySpan& trajectory)
             {
-                ImGui::Text("Points: %zu", m_trajectoryPoints.size());
+                ImGui::Text("Points: %zu", trajectory.Size());
                 ImGui::SameLine();
+
+                DrawLoadProgress();
                 
                 if (ImGui::Button("Clear"))
                     ClearTrajectory();
+
+                DrawArchiveControls();
                     
                 ImGui::SameLine();
                 ImGui::Checkbox("Show Table", &m_showTable);
@@ -143,7 +290,55 @@ namespace Mt
                 }
             }
 
-            void DrawPointTable()
+            void DrawLoadProgress()
+            {
+                TrajectoryLoadProgress progress = m_loader->GetProgress();
+
+                if (!progress.Active)
+                    return;
+
+                std::string overlay = std::to_string(progress.BytesDone >> 20) + " / " + std::to_string(progress.BytesTotal >> 20) + " MB";
+
+                ImGui::ProgressBar(static_cast<float>(progress.GetFraction()), ImVec2(160, 0), overlay.c_str());
+                ImGui::SameLine();
+
+                if (ImGui::Button("Cancel Load"))
+                    CancelLoad();
+
+                ImGui::SameLine();
+            }
+
+            void DrawArchiveControls()
+            {
+                std::shared_ptr<const TrajectoryArchive> archive;
+                int entry = 0;
+
+                {
+                    std::lock_guard<std::mutex> lock(m_trajectoryMutex);
+
+                    archive = m_archive;
+                    entry = m_archiveEntry;
+                }
+
+                if (!archive || archive->GetCount() == 0)
+                    return;
+
+                int count = static_cast<int>(archive->GetCount());
+
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(100);
+
+                if (ImGui::InputInt("Entry", &entry))
+                    SetArchive(archive, static_cast<size_t>((std::clamp)(entry, 0, count - 1)));
+
+                const ArchiveIndexEntry& summary = archive->GetEntry(static_cast<size_t>((std::clamp)(entry, 0, count - 1)));
+
+                ImGui::SameLine();
+                ImGui::Text("of %d, %.0f ms, (%d, %d)-(%d, %d)", count, summary.DurationUs / 1000.0,
+                    summary.MinX, summary.MinY, summary.MaxX, summary.MaxY);
+            }
+
+            void DrawPointTable(const TrajectorySpan& trajectory)
             {
                 if (ImGui::BeginTable("TrajectoryPoints", 3, 
                     ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | 
@@ -155,7 +350,7 @@ namespace Mt
                     ImGui::TableHeadersRow();
 
                     int displayStart = 0;
-                    int displayEnd = static_cast<int>(m_trajectoryPoints.size());
+                    int displayEnd = static_cast<int>(trajectory.Size());
                     
                     ImGuiListClipper clipper;
                     clipper.Begin(displayEnd - displayStart);
@@ -169,7 +364,7 @@ namespace Mt
                             if (index >= displayEnd)
                                 break;
 
-                            const POINT& point = m_trajectoryPoints[index];
+                            const Point& point = trajectory[index];
                             
                             ImGui::TableNextRow();
                             ImGui::TableNextColumn();
@@ -185,9 +380,9 @@ namespace Mt
                 }
             }
 
-            void DrawTrajectoryGraph()
+            void DrawTrajectoryGraph(const std::shared_ptr<const MappedTrajectory>& source, const TrajectorySpan& trajectory)
             {
-                if (m_trajectoryPoints.empty())
+                if (trajectory.Empty())
                 {
                     ImGui::Text("No trajectory data available");
 
@@ -203,33 +398,17 @@ namespace Mt
                     canvasSize.y = 50.0f;
 
                 ImVec2 canvasPosition = ImGui::GetCursorScreenPos();
-                
-                POINT minPoint = {0, 0};
-                POINT maxPoint = {m_screenWidth, m_screenHeight};
 
-                int padding = 50;
-
-                minPoint.x -= padding;
-                minPoint.y -= padding;
-                maxPoint.x += padding;
-                maxPoint.y += padding;
-                
-                for (const auto& point : m_trajectoryPoints)
+                // Scrolled out of the window: keep the layout, skip the work.
+                if (!ImGui::IsRectVisible(canvasSize))
                 {
-                    minPoint.x = (std::min)(minPoint.x, point.x);
-                    minPoint.y = (std::min)(minPoint.y, point.y);
-                    maxPoint.x = (std::max)(maxPoint.x, point.x);
-                    maxPoint.y = (std::max)(maxPoint.y, point.y);
-                }
+                    ImGui::Dummy(canvasSize);
 
-                float width = static_cast<float>(maxPoint.x - minPoint.x);
-                float height = static_cast<float>(maxPoint.y - minPoint.y);
-                
-                if (width <= 0)
-                    width = 1.0f;
+                    return;
+                }
 
-                if (height <= 0)
-                    height = 1.0f;
+                UpdateLod(source, trajectory, canvasSize);
+                UpdateScreenGeometry(trajectory, canvasPosition);
 
                 ImDrawList* drawList = ImGui::GetWindowDrawList();
 
@@ -240,57 +419,120 @@ namespace Mt
                     IM_COL32(255, 255, 255, 255)
                 );
 
-                for (size_t i = 1; i < m_trajectoryPoints.size(); i++)
+                for (const LodStrip& strip : m_lod.GetStrips())
                 {
-                    const POINT& previous = m_trajectoryPoints[i - 1];
-                    const POINT& current = m_trajectoryPoints[i];
-
-                    ImVec2 previousPosition = WorldToScreen(previous, minPoint, width, height, canvasPosition, canvasSize);
-                    ImVec2 currentPosition = WorldToScreen(current, minPoint, width, height, canvasPosition, canvasSize);
-
-                    drawList->AddLine
-                    (
-                        previousPosition,
-                        currentPosition, 
-                        ImColor(m_lineColor),
-                        2.0f
-                    );
-
-                    if (m_pointRadius > 0)
+                    // Pieces of at most MaxPolylinePoints, overlapping by one,
+                    // keep each call within 16-bit draw list indices.
+                    for (size_t first = 0; first + 1 < strip.Count; first += MaxPolylinePoints - 1)
                     {
-                        drawList->AddCircleFilled
+                        size_t count = (std::min)(MaxPolylinePoints, strip.Count - first);
+
+                        drawList->AddPolyline
                         (
-                            currentPosition,
-                            m_pointRadius,
-                            ImColor(m_pointColor)
+                            &m_screenPath[strip.Offset + first],
+                            static_cast<int>(count),
+                            ImColor(m_lineColor),
+                            ImDrawFlags_None,
+                            2.0f
                         );
                     }
                 }
 
-                if (!m_trajectoryPoints.empty())
+                if (m_pointRadius > 0)
                 {
-                    ImVec2 startPosition = WorldToScreen(m_trajectoryPoints.front(), minPoint, width, height, canvasPosition, canvasSize);
-                    drawList->AddCircleFilled(startPosition, m_pointRadius * 1.5f, IM_COL32(0, 255, 0, 255));
+                    ImU32 pointColor = ImColor(m_pointColor);
 
-                    ImVec2 endPosition = WorldToScreen(m_trajectoryPoints.back(), minPoint, width, height, canvasPosition, canvasSize);
-                    drawList->AddCircleFilled(endPosition, m_pointRadius * 1.5f, IM_COL32(255, 0, 0, 255));
+                    for (const ImVec2& marker : m_screenMarkers)
+                        drawList->AddCircleFilled(marker, m_pointRadius, pointColor);
                 }
 
+                drawList->AddCircleFilled(m_screenStart, m_pointRadius * 1.5f, IM_COL32(0, 255, 0, 255));
+                drawList->AddCircleFilled(m_screenEnd, m_pointRadius * 1.5f, IM_COL32(255, 0, 0, 255));
+
                 ImGui::Dummy(canvasSize);
             }
 
-            ImVec2 WorldToScreen
-            (
-                const POINT& worldPoint,
-                const POINT& minPoint, 
-                float width,
-                float height,
-                const ImVec2& canvasPosition,
-                const ImVec2& canvasSize
-            )
+            // Rebuilds the level of detail if the trajectory or anything that
+            // moves samples between pixels changed since the last frame.
+            void UpdateLod(const std::shared_ptr<const MappedTrajectory>& source, const TrajectorySpan& trajectory, const ImVec2& canvasSize)
+            {
+                bool sourceChanged = m_lodSource.lock() != source;
+
+                if (sourceChanged || m_boundsScreenWidth != m_screenWidth || m_boundsScreenHeight != m_screenHeight)
+                {
+                    Point minPoint = {0, 0};
+                    Point maxPoint = {m_screenWidth, m_screenHeight};
+
+                    int padding = 50;
+
+                    minPoint.x -= padding;
+                    minPoint.y -= padding;
+                    maxPoint.x += padding;
+                    maxPoint.y += padding;
+
+                    Point trajectoryMin;
+                    Point trajectoryMax;
+
+                    if (TrajectoryLod::GetBounds(trajectory, trajectoryMin, trajectoryMax))
+                    {
+                        minPoint.x = (std::min)(minPoint.x, trajectoryMin.x);
+                        minPoint.y = (std::min)(minPoint.y, trajectoryMin.y);
+                        maxPoint.x = (std::max)(maxPoint.x, trajectoryMax.x);
+                        maxPoint.y = (std::max)(maxPoint.y, trajectoryMax.y);
+                    }
+
+                    m_boundsMin = minPoint;
+                    m_boundsWidth = (std::max)(static_cast<float>(maxPoint.x - minPoint.x), 1.0f);
+                    m_boundsHeight = (std::max)(static_cast<float>(maxPoint.y - minPoint.y), 1.0f);
+                    m_boundsScreenWidth = m_screenWidth;
+                    m_boundsScreenHeight = m_screenHeight;
+                }
+
+                LodTransform transform;
+                transform.OriginX = static_cast<float>(m_boundsMin.x);
+                transform.OriginY = static_cast<float>(m_boundsMin.y);
+                transform.ScaleX = canvasSize.x / m_boundsWidth;
+                transform.ScaleY = canvasSize.y / m_boundsHeight;
+                transform.Width = static_cast<int>(canvasSize.x);
+                transform.Height = static_cast<int>(canvasSize.y);
+                transform.MarkerSpacing = m_pointRadius;
+
+                if (!sourceChanged && transform == m_lodTransform)
+                    return;
+
+                m_lod.Build(trajectory, transform);
+                m_lodSource = source;
+                m_lodTransform = transform;
+                m_screenValid = false;
+            }
+
+            void UpdateScreenGeometry(const TrajectorySpan& trajectory, const ImVec2& canvasPosition)
+            {
+                if (m_screenValid && m_screenOrigin.x == canvasPosition.x && m_screenOrigin.y == canvasPosition.y)
+                    return;
+
+                const std::vector<LodVertex>& path = m_lod.GetPath();
+                const std::vector<LodVertex>& markers = m_lod.GetMarkers();
+
+                m_screenPath.resize(path.size());
+                m_screenMarkers.resize(markers.size());
+
+                for (size_t i = 0; i < path.size(); i++)
+                    m_screenPath[i] = ImVec2(canvasPosition.x + path[i].x, canvasPosition.y + path[i].y);
+
+                for (size_t i = 0; i < markers.size(); i++)
+                    m_screenMarkers[i] = ImVec2(canvasPosition.x + markers[i].x, canvasPosition.y + markers[i].y);
+
+                m_screenStart = WorldToScreen(trajectory.Front(), canvasPosition);
+                m_screenEnd = WorldToScreen(trajectory.Back(), canvasPosition);
+                m_screenOrigin = canvasPosition;
+                m_screenValid = true;
+            }
+
+            ImVec2 WorldToScreen(const Point& worldPoint, const ImVec2& canvasPosition) const
             {
-                float x = ((worldPoint.x - minPoint.x) / width) * canvasSize.x;
-                float y = ((worldPoint.y - minPoint.y) / height) * canvasSize.y;
+                float x = (worldPoint.x - m_lodTransform.OriginX) * m_lodTransform.ScaleX;
+                float y = (worldPoint.y - m_lodTransform.OriginY) * m_lodTransform.ScaleY;
                 
                 return ImVec2(canvasPosition.x + x, canvasPosition.y + y);
             }
@@ -4,6 +4,7 @@ import os
 import matplotlib
 import glob
 import tkinter as tk
+import mtcore
 
 def get_tkinter_paths():
     """Find path Tcl/Tk"""
@@ -95,6 +96,12 @@ def main():
         cmd.append(f"--add-binary={tk_dll};.")
 
     cmd.append(f"--add-data={mpl_data_dir};matplotlib/mpl-data")
+
+    # Bundled next to the script, where mtcore.py looks first; without it the
+    # executable falls back to the Python readers.
+    if mtcore.available():
+        print(f"Native core: {mtcore.library_path()}")
+        cmd.append(f"--add-binary={mtcore.library_path()};.")
     
     print("Building with command:", " ".join(cmd))
     PyInstaller.__main__.run(cmd)
@@ -0,0 +1,212 @@
+"""ctypes bindings of libmtcore, the C ABI of the C++ core (Core/CApi/MtCore.h).
+
+Readers, writers, resampling and statistics run the same native code as the
+C++ tools. Columns come back as NumPy arrays: points int32 (count, 2),
+timestamps int64 microseconds or None. Arrays passed in are handed to the
+library as they are when already C-contiguous with those dtypes.
+
+The library is looked up in MT_CORE_LIBRARY, next to this file, in the usual
+build directories and then on the system library path; available() says
+whether it was found.
+"""
+
+import ctypes
+import ctypes.util
+import glob
+import os
+import sys
+import numpy as np
+
+MT_OK = 0
+
+class TrajectoryInfo(ctypes.Structure):
+    _fields_ = [('samples', ctypes.c_uint64), ('has_timestamps', ctypes.c_int32), ('period_us', ctypes.c_uint32),
+        ('start_time_us', ctypes.c_int64), ('screen_width', ctypes.c_int32), ('screen_height', ctypes.c_int32)]
+
+class Statistics(ctypes.Structure):
+    _fields_ = [('samples', ctypes.c_uint64), ('duration_us', ctypes.c_int64), ('min_x', ctypes.c_int32), ('min_y', ctypes.c_int32),
+        ('max_x', ctypes.c_int32), ('max_y', ctypes.c_int32), ('path_length', ctypes.c_double), ('mean_speed', ctypes.c_double),
+        ('max_speed', ctypes.c_double), ('max_interval_us', ctypes.c_int64)]
+
+_POINTS = ctypes.POINTER(ctypes.c_int32)
+_TIMESTAMPS = ctypes.POINTER(ctypes.c_int64)
+_HANDLE = ctypes.c_void_p
+
+_SIGNATURES = {
+    'mt_api_version': (ctypes.c_int, []),
+    'mt_last_error': (ctypes.c_char_p, []),
+    'mt_open': (ctypes.c_int, [ctypes.c_char_p, ctypes.POINTER(_HANDLE)]),
+    'mt_open_archive_entry': (ctypes.c_int, [ctypes.c_char_p, ctypes.c_uint64, ctypes.POINTER(_HANDLE)]),
+    'mt_close': (None, [_HANDLE]),
+    'mt_get_info': (None, [_HANDLE, ctypes.POINTER(TrajectoryInfo)]),
+    'mt_copy_samples': (ctypes.c_uint64, [_HANDLE, ctypes.c_uint64, ctypes.c_uint64, _POINTS, _TIMESTAMPS]),
+    'mt_write': (ctypes.c_int, [ctypes.c_char_p, ctypes.c_char_p, _POINTS, _TIMESTAMPS, ctypes.c_uint64, ctypes.POINTER(TrajectoryInfo)]),
+    'mt_resampled_size': (ctypes.c_uint64, [_TIMESTAMPS, ctypes.c_uint64, ctypes.c_uint32, ctypes.c_uint32]),
+    'mt_resample': (ctypes.c_uint64, [_POINTS, _TIMESTAMPS, ctypes.c_uint64, ctypes.c_uint32, ctypes.c_uint32, _POINTS, _TIMESTAMPS, ctypes.c_uint64]),
+    'mt_compute_statistics': (None, [_POINTS, _TIMESTAMPS, ctypes.c_uint64, ctypes.c_uint32, ctypes.POINTER(Statistics)]),
+}
+
+_library = None
+
+def _candidates():
+    if os.environ.get('MT_CORE_LIBRARY'):
+        yield os.environ['MT_CORE_LIBRARY']
+
+    names = ['mtcore.dll'] if sys.platform == 'win32' else ['libmtcore.dylib'] if sys.platform == 'darwin' else ['libmtcore.so']
+    here = os.path.dirname(os.path.abspath(__file__))
+    root = os.path.dirname(here)
+
+    for name in names:
+        yield os.path.join(here, name)
+
+        for build in sorted(glob.glob(os.path.join(root, '*build*', 'Core', 'CApi', '**', name), recursive=True)):
+            yield build
+
+    found = ctypes.util.find_library('mtcore')
+
+    if found:
+        yield found
+
+def _load():
+    global _library
+
+    if _library is not None:
+        return _library or None
+
+    _library = False
+
+    for candidate in _candidates():
+        try:
+            library = ctypes.CDLL(candidate)
+        except OSError:
+            continue
+
+        for name, (result, arguments) in _SIGNATURES.items():
+            function = getattr(library, name)
+            function.restype = result
+            function.argtypes = arguments
+
+        _library = library
+        break
+
+    return _library or None
+
+def available():
+    return _load() is not None
+
+def library_path():
+    """Path of the loaded library, or None."""
+    library = _load()
+
+    return library._name if library is not None else None
+
+def _require():
+    library = _load()
+
+    if library is None:
+        raise OSError('libmtcore not found (build it with CMake or set MT_CORE_LIBRARY)')
+
+    return library
+
+def _check(library, status):
+    if status != MT_OK:
+        raise ValueError(library.mt_last_error().decode(errors='replace'))
+
+def _points(points):
+    points = np.ascontiguousarray(points, dtype=np.int32)
+
+    if points.ndim != 2 or points.shape[1] != 2:
+        raise ValueError('points must have shape (count, 2)')
+
+    return points
+
+def _timestamps(timestamps, count):
+    if timestamps is None:
+        return None
+
+    timestamps = np.ascontiguousarray(timestamps, dtype=np.int64)
+
+    if timestamps.shape != (count,):
+        raise ValueError('timestamps must have one value per point')
+
+    return timestamps
+
+def _pointer(array, kind):
+    return array.ctypes.data_as(kind) if array is not None else None
+
+def read_trajectory(filename, entry=None):
+    """Any trajectory file, or entry `entry` of a .crsarc archive.
+
+    Returns (points, timestamps, metadata), copied once by the library from
+    the decoded (or mapped) columns, with no Python-side parsing or conversion.
+    """
+    library = _require()
+    handle = _HANDLE()
+    path = os.fsencode(filename)
+
+    if entry is None:
+        _check(library, library.mt_open(path, ctypes.byref(handle)))
+    else:
+        _check(library, library.mt_open_archive_entry(path, entry, ctypes.byref(handle)))
+
+    try:
+        info = TrajectoryInfo()
+        library.mt_get_info(handle, ctypes.byref(info))
+
+        points = np.empty((info.samples, 2), dtype=np.int32)
+        timestamps = np.empty(info.samples, dtype=np.int64) if info.has_timestamps else None
+
+        library.mt_copy_samples(handle, 0, info.samples, _pointer(points, _POINTS), _pointer(timestamps, _TIMESTAMPS))
+    finally:
+        library.mt_close(handle)
+
+    metadata = {
+        'period_us': info.period_us,
+        'start_time_us': info.start_time_us,
+        'screen_width': info.screen_width,
+        'screen_height': info.screen_height
+    }
+
+    return points, timestamps, metadata
+
+def write_trajectory(filename, points, timestamps=None, metadata=None, codec=None):
+    """Writes with the codec named (e.g. 'binary-predictive') or picked from the extension."""
+    library = _require()
+    metadata = metadata or {}
+    points = _points(points)
+    timestamps = _timestamps(timestamps, len(points))
+
+    info = TrajectoryInfo(len(points), timestamps is not None, metadata.get('period_us', 0), metadata.get('start_time_us', 0),
+        metadata.get('screen_width', 0), metadata.get('screen_height', 0))
+
+    _check(library, library.mt_write(os.fsencode(filename), codec.encode() if codec else None,
+        _pointer(points, _POINTS), _pointer(timestamps, _TIMESTAMPS), len(points), ctypes.byref(info)))
+
+def resample(points, timestamps, period_us, source_period_us=0):
+    """Positions every period_us, linearly interpolated; returns (points, timestamps).
+
+    Without timestamps the input is taken to be sampled every source_period_us.
+    """
+    library = _require()
+    points = _points(points)
+    timestamps = _timestamps(timestamps, len(points))
+    count = library.mt_resampled_size(_pointer(timestamps, _TIMESTAMPS), len(points), source_period_us, period_us)
+
+    resampled_points = np.empty((count, 2), dtype=np.int32)
+    resampled_timestamps = np.empty(count, dtype=np.int64)
+
+    library.mt_resample(_pointer(points, _POINTS), _pointer(timestamps, _TIMESTAMPS), len(points), source_period_us, period_us,
+        _pointer(resampled_points, _POINTS), _pointer(resampled_timestamps, _TIMESTAMPS), count)
+
+    return resampled_points, resampled_timestamps
+
+def statistics(points, timestamps=None, period_us=0):
+    """Samples, duration, bounds, path length and speeds (px/s) as a dict."""
+    library = _require()
+    points = _points(points)
+    timestamps = _timestamps(timestamps, len(points))
+    result = Statistics()
+
+    library.mt_compute_statistics(_pointer(points, _POINTS), _pointer(timestamps, _TIMESTAMPS), len(points), period_us, ctypes.byref(result))
+
+    return {name: getattr(result, name) for name, _ in Statistics._fields_}
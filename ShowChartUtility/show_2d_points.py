@@ -2,23 +2,41 @@ import matplotlib.pyplot as plt
 import argparse
 import os
 import numpy as np
+import struct
 import tkinter
 import sys
+import zlib
+import mtcore
 
 if getattr(sys, 'frozen', False):
     import matplotlib
     matplotlib.use('TkAgg')
 
-def main():
-    parser = argparse.ArgumentParser(description='2d plot from file \"[x;y\nx;y...]')
-    parser.add_argument('filename', type=str, help='Input file (format: x;y)')
-    parser.add_argument('--delta', type=float, default=1.0, help='Sampling interval in milliseconds (default: 1.0 ms)')
-    parser.add_argument('--save', action='store_true', help='Save plot without showing')
-    args = parser.parse_args()
+BINARY_MAGIC = 0x4A52544D
+BINARY_VERSION = 1
+BINARY_HEADER = struct.Struct('<IHHIB3xIiiIqQQ8x')
+FLAG_HAS_TIMESTAMPS = 1
+FLAG_CHUNK_CHECKSUMS = 2
+ENCODING_FIXED = 0
+ENCODING_DELTA_VARINT = 1
+ENCODING_CHUNKED = 2
+ENCODING_PREDICTIVE = 3
+RANS_SCALE_BITS = 12
+RANS_LOWER_BOUND = 1 << 23
+PREDICTIVE_DIRECT_SYMBOLS = 192
+CHUNK_MAGIC = 0x4B43544D
+CHUNK_HEADER = struct.Struct('<IIII')
+ARCHIVE_MAGIC = 0x5241544D
+ARCHIVE_FOOTER_MAGIC = 0x5841544D
+ARCHIVE_HEADER = struct.Struct('<IHHIIqQ')
+ARCHIVE_FOOTER = struct.Struct('<IIQQQ')
+ARCHIVE_INDEX = np.dtype([('offset', '<u8'), ('length', '<u8'), ('samples', '<u8'), ('duration_us', '<i8'),
+    ('min_x', '<i4'), ('min_y', '<i4'), ('max_x', '<i4'), ('max_y', '<i4')])
 
+def read_text_trajectory(filename):
     x, y = [], []
 
-    with open(args.filename, 'r') as f:
+    with open(filename, 'r') as f:
         for line in f:
             if ';' in line:
                 parts = line.strip().split(';')
@@ -29,10 +47,356 @@ def main():
                     except ValueError:
                         continue
 
-    if not x:
+    return np.array(x, dtype=np.int64), np.array(y, dtype=np.int64), None, {}
+
+def decode_delta_varints(payload, count):
+    data = np.frombuffer(payload, dtype=np.uint8)
+    ends = np.flatnonzero(data < 0x80)
+
+    if len(ends) < count:
+        raise ValueError('Truncated payload')
+
+    ends = ends[:count]
+    starts = np.concatenate(([0], ends[:-1] + 1))
+    lengths = ends - starts + 1
+    shifts = (np.arange(ends[-1] + 1) - np.repeat(starts, lengths)) * 7
+    parts = (data[:ends[-1] + 1] & 0x7F).astype(np.uint64) << shifts.astype(np.uint64)
+    values = np.bitwise_or.reduceat(parts, starts)
+    deltas = (values >> np.uint64(1)).astype(np.int64) ^ -(values & np.uint64(1)).astype(np.int64)
+
+    return deltas
+
+def decode_chunks(payload, has_timestamps, checksummed):
+    xs, ys, ts = [], [], []
+    position = 0
+    corrupt = 0
+    sample_bytes = 16 if has_timestamps else 8
+
+    while len(payload) - position >= CHUNK_HEADER.size:
+        magic, count, chunk_bytes, checksum = CHUNK_HEADER.unpack_from(payload, position)
+        start = position + CHUNK_HEADER.size
+
+        # A torn last chunk (recording cut short) ends the data.
+        if magic != CHUNK_MAGIC or chunk_bytes != count * sample_bytes or start + chunk_bytes > len(payload):
+            break
+
+        # A chunk failing its CRC-32 is skipped; the rest of the recording still loads.
+        if checksummed and zlib.crc32(payload[start:start + chunk_bytes]) != checksum:
+            corrupt += 1
+            position = start + chunk_bytes
+            continue
+
+        points = np.frombuffer(payload, dtype='<i4', count=2 * count, offset=start).reshape(count, 2)
+        xs.append(points[:, 0])
+        ys.append(points[:, 1])
+
+        if has_timestamps:
+            ts.append(np.frombuffer(payload, dtype='<i8', count=count, offset=start + 8 * count))
+
+        position = start + chunk_bytes
+
+    if corrupt:
+        print(f'Warning: {corrupt} corrupt chunks skipped', file=sys.stderr)
+
+    if position < len(payload):
+        print(f'Warning: recording truncated, {len(payload) - position} bytes ignored', file=sys.stderr)
+
+    x = np.concatenate(xs).astype(np.int64) if xs else np.zeros(0, dtype=np.int64)
+    y = np.concatenate(ys).astype(np.int64) if ys else np.zeros(0, dtype=np.int64)
+    t = (np.concatenate(ts) if ts else np.zeros(0, dtype=np.int64)) if has_timestamps else None
+
+    return x, y, t
+
+def read_varint(data, position):
+    value, shift = 0, 0
+
+    while position < len(data):
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+
+        if byte < 0x80:
+            return value, position
+
+    raise ValueError('Truncated payload')
+
+def decode_predictive_column(payload, position, count, history):
+    order = payload[position]
+    used, position = read_varint(payload, position + 1)
+    frequencies, starts, slots = [0] * 256, [0] * 256, bytearray()
+    symbol = 0
+
+    for _ in range(used):
+        gap, position = read_varint(payload, position)
+        frequency, position = read_varint(payload, position)
+        symbol += gap
+        frequencies[symbol], starts[symbol] = frequency + 1, len(slots)
+        slots += bytes([symbol]) * (frequency + 1)
+        symbol += 1
+
+    coded_bytes, position = read_varint(payload, position)
+    coded = payload[position:position + coded_bytes]
+    raw_bytes, position = read_varint(payload, position + coded_bytes)
+    raw = payload[position:position + raw_bytes] + bytes(8)
+    position += raw_bytes
+
+    if order not in (1, 2, 3) or len(slots) != 1 << RANS_SCALE_BITS or len(coded) < 4:
+        raise ValueError('Corrupt predictive block')
+
+    # rANS decode of the residual symbols; large residuals continue in the raw bits.
+    state, cursor, raw_position = int.from_bytes(coded[:4], 'big'), 4, 0
+    a, b, c = history
+    values = []
+
+    for _ in range(count):
+        slot = state & ((1 << RANS_SCALE_BITS) - 1)
+        symbol = slots[slot]
+        state = frequencies[symbol] * (state >> RANS_SCALE_BITS) + slot - starts[symbol]
+
+        while state < RANS_LOWER_BOUND and cursor < len(coded):
+            state = (state << 8) | coded[cursor]
+            cursor += 1
+
+        residual = symbol
+
+        if symbol >= PREDICTIVE_DIRECT_SYMBOLS:
+            width = symbol - (PREDICTIVE_DIRECT_SYMBOLS - 8) - 1
+            first = raw_position >> 3
+            bits = int.from_bytes(raw[first:first + 9], 'little') >> (raw_position & 7)
+            residual = (1 << width) | (bits & ((1 << width) - 1))
+            raw_position += width
+
+        prediction = a if order == 1 else (2 * a - b if order == 2 else 3 * a - 3 * b + c)
+        a, b, c = (prediction + ((residual >> 1) ^ -(residual & 1))) & 0xFFFFFFFFFFFFFFFF, a, b
+        values.append(a)
+
+    if state != RANS_LOWER_BOUND or cursor != len(coded):
+        raise ValueError('Corrupt predictive block')
+
+    history[:] = [a, b, c]
+
+    return np.array(values, dtype=np.uint64).view(np.int64), position
+
+def decode_predictive(payload, count, has_timestamps):
+    block_samples, position = read_varint(payload, 0)
+    histories = [[0, 0, 0] for _ in range(3 if has_timestamps else 2)]
+    columns = [[] for _ in histories]
+
+    for first in range(0, count, max(block_samples, 1)):
+        for column, history in zip(columns, histories):
+            values, position = decode_predictive_column(payload, position, min(block_samples, count - first), history)
+            column.append(values)
+
+    joined = [np.concatenate(column) if column else np.zeros(0, dtype=np.int64) for column in columns]
+
+    return joined[0], joined[1], joined[2] if has_timestamps else None
+
+def read_binary_trajectory(filename):
+    with open(filename, 'rb') as f:
+        return parse_binary_trajectory(f.read())
+
+def parse_binary_trajectory(data):
+    if len(data) < BINARY_HEADER.size:
+        raise ValueError('Truncated header')
+
+    (magic, version, header_size, flags, encoding, period_us, screen_width, screen_height,
+        _, start_time_us, count, payload_bytes) = BINARY_HEADER.unpack_from(data)
+
+    if magic != BINARY_MAGIC or version > BINARY_VERSION:
+        raise ValueError('Unsupported binary trajectory file')
+
+    # Chunked recordings extend to the end of the file, even while still being written.
+    if encoding == ENCODING_CHUNKED:
+        payload = data[header_size:]
+    else:
+        payload = data[header_size:header_size + payload_bytes]
+
+        if len(payload) != payload_bytes:
+            raise ValueError('Truncated payload')
+
+    has_timestamps = bool(flags & FLAG_HAS_TIMESTAMPS)
+    t = None
+
+    if encoding == ENCODING_FIXED:
+        points = np.frombuffer(payload, dtype='<i4', count=2 * count).reshape(count, 2)
+        x, y = points[:, 0].astype(np.int64), points[:, 1].astype(np.int64)
+
+        if has_timestamps:
+            t = np.frombuffer(payload, dtype='<i8', count=count, offset=8 * count).copy()
+    elif encoding == ENCODING_DELTA_VARINT:
+        columns = decode_delta_varints(payload, count * (3 if has_timestamps else 2))
+        x = np.cumsum(columns[0:2 * count:2])
+        y = np.cumsum(columns[1:2 * count:2])
+
+        if has_timestamps:
+            t = np.cumsum(columns[2 * count:])
+    elif encoding == ENCODING_CHUNKED:
+        x, y, t = decode_chunks(payload, has_timestamps, bool(flags & FLAG_CHUNK_CHECKSUMS))
+    elif encoding == ENCODING_PREDICTIVE:
+        x, y, t = decode_predictive(payload, count, has_timestamps)
+    else:
+        raise ValueError(f'Unknown encoding {encoding}')
+
+    metadata = {
+        'period_us': period_us,
+        'start_time_us': start_time_us,
+        'screen_width': screen_width,
+        'screen_height': screen_height
+    }
+
+    return x, y, t, metadata
+
+def write_binary_trajectory(filename, x, y, t=None, metadata=None):
+    metadata = metadata or {}
+    count = len(x)
+    payload = np.column_stack((x, y)).astype('<i4').tobytes()
+    flags = 0
+
+    if t is not None:
+        payload += np.asarray(t).astype('<i8').tobytes()
+        flags |= FLAG_HAS_TIMESTAMPS
+
+    header = BINARY_HEADER.pack(BINARY_MAGIC, BINARY_VERSION, BINARY_HEADER.size, flags, ENCODING_FIXED,
+        metadata.get('period_us', 0), metadata.get('screen_width', 0), metadata.get('screen_height', 0), 0,
+        metadata.get('start_time_us', 0), count, len(payload))
+
+    with open(filename, 'wb') as f:
+        f.write(header)
+        f.write(payload)
+
+def write_text_trajectory(filename, x, y):
+    with open(filename, 'w') as f:
+        for px, py in zip(x, y):
+            f.write(f'{px};{py}\n')
+
+def read_archive_index(data):
+    magic, _, header_size, _, _, _, _ = ARCHIVE_HEADER.unpack_from(data)
+
+    if magic != ARCHIVE_MAGIC:
+        raise ValueError('Not a trajectory archive')
+
+    footer_magic, _, index_offset, count, _ = ARCHIVE_FOOTER.unpack_from(data, len(data) - ARCHIVE_FOOTER.size)
+
+    if footer_magic != ARCHIVE_FOOTER_MAGIC:
+        raise ValueError('Archive has no index yet (its writer is still open or was killed)')
+
+    return np.frombuffer(data, dtype=ARCHIVE_INDEX, count=count, offset=index_offset)
+
+def read_archive_entry(filename, entry):
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    index = read_archive_index(data)
+
+    if not 0 <= entry < len(index):
+        raise ValueError(f'No entry {entry}, the archive has {len(index)}')
+
+    offset, length = int(index[entry]['offset']), int(index[entry]['length'])
+
+    return parse_binary_trajectory(data[offset:offset + length])
+
+def read_numpy_export(path, entry):
+    # A MouseTrackerT export: one .npz, or a directory of .npy files (memory-mapped).
+    if os.path.isdir(path):
+        arrays = {os.path.splitext(name)[0]: np.load(os.path.join(path, name), mmap_mode='r')
+            for name in os.listdir(path) if name.endswith('.npy')}
+    else:
+        arrays = np.load(path)
+
+    count = len(arrays['metadata'])
+
+    if not 0 <= entry < count:
+        raise ValueError(f'No entry {entry}, the export has {count}')
+
+    t = None
+
+    if 'offsets' in arrays:
+        start, end = int(arrays['offsets'][entry]), int(arrays['offsets'][entry + 1])
+        points = np.asarray(arrays['points'][start:end], dtype=np.int64)
+
+        if 'timestamps' in arrays:
+            t = np.asarray(arrays['timestamps'][start:end])
+    else:
+        points = np.asarray(arrays['points'][entry])
+
+    period_us, start_time_us, screen_width, screen_height = (int(value) for value in arrays['metadata'][entry])
+    metadata = {
+        'period_us': period_us,
+        'start_time_us': start_time_us,
+        'screen_width': screen_width,
+        'screen_height': screen_height
+    }
+
+    return points[:, 0], points[:, 1], t, metadata
+
+def is_binary_trajectory(filename):
+    with open(filename, 'rb') as f:
+        magic = f.read(4)
+
+    return len(magic) == 4 and struct.unpack('<I', magic)[0] == BINARY_MAGIC
+
+def read_native_trajectory(filename, entry):
+    points, t, metadata = mtcore.read_trajectory(filename, entry)
+
+    return points[:, 0], points[:, 1], t, metadata
+
+def read_trajectory(filename, entry=0):
+    is_archive = os.path.splitext(filename)[1].lower() == '.crsarc'
+
+    if os.path.splitext(filename)[1].lower() == '.npz' or os.path.isdir(filename):
+        return read_numpy_export(filename, entry)
+
+    # The native readers when libmtcore is around; the Python ones below are the fallback.
+    if mtcore.available():
+        return read_native_trajectory(filename, entry if is_archive else None)
+
+    if is_archive:
+        return read_archive_entry(filename, entry)
+
+    if is_binary_trajectory(filename):
+        return read_binary_trajectory(filename)
+
+    return read_text_trajectory(filename)
+
+def main():
+    parser = argparse.ArgumentParser(description='2d plot from a trajectory file (.crsdat \"x;y\" text or .crsbin binary)')
+    parser.add_argument('filename', type=str, help='Input file (.crsdat: x;y lines, .crsbin: binary)')
+    parser.add_argument('--delta', type=float, default=None, help='Sampling interval in milliseconds (default: from a binary header, else 1.0 ms)')
+    parser.add_argument('--save', action='store_true', help='Save plot without showing')
+    parser.add_argument('--entry', type=int, default=0, help='Entry id when the input is a .crsarc archive or a NumPy export (.npz or .npy directory)')
+    parser.add_argument('--export', type=str, default=None, help='Write the trajectory to this file (.crsbin or .crsdat) and exit')
+    args = parser.parse_args()
+
+    try:
+        x, y, t, metadata = read_trajectory(args.filename, args.entry)
+    except ValueError as e:
+        print(f"Invalid file format: {e}")
+
+        return
+
+    if args.export:
+        if mtcore.available():
+            mtcore.write_trajectory(args.export, np.column_stack((x, y)), t, metadata)
+        elif os.path.splitext(args.export)[1].lower() == '.crsbin':
+            write_binary_trajectory(args.export, x, y, t, metadata)
+        else:
+            write_text_trajectory(args.export, x, y)
+
+        print(f"Trajectory written to: {args.export}")
+
+        return
+
+    if not len(x):
         print("Invalid file format")
         
         return
+
+    if args.delta is None:
+        args.delta = metadata.get('period_us', 0) / 1000.0 or 1.0
+
+    screen_width = metadata.get('screen_width') or 1920
+    screen_height = metadata.get('screen_height') or 1080
     
     time_ms = np.arange(len(x)) * args.delta
 
@@ -41,8 +405,8 @@ def main():
     #plt.subplot(2, 1, 1)
     plt.plot(x, y, 'b-', alpha=0.7, label='Path')
     plt.plot(x, y, 'ro', markersize=2, alpha=0.3, label='Points')
-    plt.xlim(0, 1920)
-    plt.ylim(1080, 0)
+    plt.xlim(0, screen_width)
+    plt.ylim(screen_height, 0)
     plt.title(f'Cursor Movement Path (Sampling: {args.delta} ms)')
     plt.xlabel('X Position')
     plt.ylabel('Y Position')
@@ -0,0 +1,175 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_ARCHIVECOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_ARCHIVECOMMAND__
+
+#include "Commands/CommandLine.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchiveWriter.h"
+#include "MouseTrackerCore/Dataset/DirectoryProcessor.h"
+#include "MouseTrackerCore/Codecs/MappedTrajectory.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+
+inline void PrintArchiveUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " pack <input_dir> <archive.crsarc> [binary|binary-delta|binary-predictive]" << std::endl;
+    std::cout << "       " << programName << " list <archive.crsarc>" << std::endl;
+    std::cout << "       " << programName << " extract <archive.crsarc> <id> <output_file>" << std::endl;
+}
+
+inline bool OpenArchive(Mt::TrajectoryArchive& archive, const std::string& filename)
+{
+    Mt::CodecResult result = archive.Open(filename);
+
+    for (const auto& warning : result.Warnings)
+        std::cout << "Warning: " << warning << std::endl;
+
+    if (!result.Success)
+        std::cout << result.Error << std::endl;
+
+    return result.Success;
+}
+
+// Appends every trajectory file under a directory, in path order, to an archive.
+inline int PackArchive(const std::string& inputDirectory, const std::string& archiveName, Mt::BinaryEncoding encoding)
+{
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+
+    for (std::filesystem::recursive_directory_iterator it(inputDirectory, error), end; !error && it != end; it.increment(error))
+        if (it->is_regular_file() && !Mt::TrajectoryArchive::IsArchive(it->path().string()) && Mt::DirectoryProcessor::IsTrajectoryFile(it->path().string()))
+            files.push_back(it->path());
+
+    if (error)
+    {
+        std::cout << "Unable to read " << inputDirectory << ": " << error.message() << std::endl;
+
+        return -2;
+    }
+
+    std::sort(files.begin(), files.end());
+
+    Mt::TrajectoryArchiveWriter writer(encoding);
+
+    if (!EnsureParentDirectory(archiveName) || !writer.Open(archiveName).Success)
+    {
+        std::cout << "Unable to open file " << archiveName << "." << std::endl;
+
+        return -2;
+    }
+
+    size_t failed = 0;
+
+    for (const auto& file : files)
+    {
+        Mt::MappedTrajectory trajectory;
+        Mt::CodecResult result = trajectory.Open(file.string());
+
+        if (result.Success)
+            result = writer.Append(trajectory.GetSpan());
+
+        if (!result.Success)
+        {
+            failed++;
+            std::cout << "Skipped " << file.string() << ": " << result.Error << std::endl;
+        }
+    }
+
+    size_t count = writer.GetCount();
+
+    if (!writer.Close().Success)
+    {
+        std::cout << "Unable to write index of " << archiveName << "." << std::endl;
+
+        return -2;
+    }
+
+    std::cout << "Packed " << files.size() - failed << " files into " << archiveName << " (" << count << " entries, "
+        << std::filesystem::file_size(archiveName, error) << " bytes), " << failed << " skipped" << std::endl;
+
+    return failed == 0 ? 0 : -2;
+}
+
+inline int ListArchive(const std::string& archiveName)
+{
+    Mt::TrajectoryArchive archive;
+
+    if (!OpenArchive(archive, archiveName))
+        return -2;
+
+    std::cout << "id;samples;duration_ms;min_x;min_y;max_x;max_y;bytes" << std::endl;
+
+    for (size_t id = 0; id < archive.GetCount(); id++)
+    {
+        const Mt::ArchiveIndexEntry& entry = archive.GetEntry(id);
+
+        std::cout << id << ";" << entry.SampleCount << ";" << entry.DurationUs / 1000 << ";"
+            << entry.MinX << ";" << entry.MinY << ";" << entry.MaxX << ";" << entry.MaxY << ";" << entry.Length << std::endl;
+    }
+
+    return 0;
+}
+
+inline int ExtractArchiveEntry(const std::string& archiveName, size_t id, const std::string& outputName)
+{
+    Mt::TrajectoryArchive archive;
+
+    if (!OpenArchive(archive, archiveName))
+        return -2;
+
+    Mt::Trajectory trajectory;
+    Mt::CodecResult result = archive.Read(id, trajectory);
+
+    if (result.Success)
+        result = Mt::TrajectoryIo::Save(outputName, trajectory);
+
+    if (!result.Success)
+    {
+        std::cout << result.Error << std::endl;
+
+        return -2;
+    }
+
+    std::cout << "Extracted entry " << id << " (" << trajectory.Size() << " points) to " << outputName << std::endl;
+
+    return 0;
+}
+
+inline int ArchiveCommand(int argc, char* argv[])
+{
+    std::string action = argc > 1 ? argv[1] : "";
+
+    if (action == "pack" && (argc == 4 || argc == 5))
+    {
+        std::string format = argc == 5 ? argv[4] : "binary-delta";
+        Mt::BinaryEncoding encoding = Mt::BinaryEncoding::DeltaVarint;
+
+        if (format == "binary")
+            encoding = Mt::BinaryEncoding::Fixed;
+        else if (format == "binary-predictive")
+            encoding = Mt::BinaryEncoding::Predictive;
+        else if (format != "binary-delta")
+        {
+            PrintArchiveUsage(argv[0]);
+
+            return -1;
+        }
+
+        return PackArchive(argv[2], argv[3], encoding);
+    }
+
+    if (action == "list" && argc == 3)
+        return ListArchive(argv[2]);
+
+    if (action == "extract" && argc == 5)
+        return ExtractArchiveEntry(argv[2], std::stoul(argv[3]), argv[4]);
+
+    PrintArchiveUsage(argv[0]);
+
+    return -1;
+}
+
+#endif
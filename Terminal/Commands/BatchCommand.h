@@ -0,0 +1,157 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_BATCHCOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_BATCHCOMMAND__
+
+#include "Commands/CommandLine.h"
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Storage/TrajectoryWriteService.h"
+#include "MouseTrackerCore/Storage/TrajectoryArchive.h"
+#include "MouseTrackerCore/Dataset/DatasetManifest.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+inline void PrintBatchUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " <points|trajectory> <count|delay> <base_filename> <delta> <captures|seconds s>." << std::endl;
+}
+
+// Records many trajectories in one process. Each capture is handed to a background
+// writer through a bounded queue so the next capture starts right away; the
+// recorder only blocks if the writer falls a full queue behind.
+inline int RecordBatch(int argc, char* argv[])
+{
+    if (argc != 6)
+    {
+        PrintBatchUsage(argv[0]);
+
+        return -1;
+    }
+
+    std::string mode = argv[1];
+    int value = std::stoi(argv[2]);
+    std::string baseFilename = argv[3];
+
+    // An archive base collects every capture as one entry of a single file.
+    std::string archiveName = Mt::TrajectoryArchive::IsArchive(baseFilename) ? baseFilename : "";
+    std::string extension = SplitTrajectoryExtension(baseFilename);
+    int delta = std::stoi(argv[4]);
+    std::string limit = argv[5];
+
+    if (mode != "points" && mode != "trajectory")
+    {
+        PrintBatchUsage(argv[0]);
+
+        return -1;
+    }
+
+    bool limitByDuration = !limit.empty() && limit.back() == 's';
+    int captureLimit = limitByDuration ? 0 : std::stoi(limit);
+    auto duration = std::chrono::seconds(limitByDuration ? std::stoi(limit.substr(0, limit.size() - 1)) : 0);
+
+    Mt::TrajectoryRecorder recorder;
+
+    if (!recorder.HasSource())
+    {
+        std::cout << "No cursor source available on this system." << std::endl;
+
+        return -3;
+    }
+
+    recorder.SetRecordTimestamps(!archiveName.empty() || Mt::TrajectoryIo::KeepsTimestamps(MakeNumberedFilename(baseFilename, 1, extension)));
+
+    if (!EnsureParentDirectory(baseFilename))
+    {
+        std::cout << "Unable to create directory for " << baseFilename << "." << std::endl;
+
+        return -2;
+    }
+
+    Mt::TrajectoryWriteSettings writeSettings;
+
+    writeSettings.OnCompleted = [](const std::string& filename, const Mt::CodecResult& result)
+    {
+        if (!result.Success)
+            std::cout << "Unable to write file " << filename << ": " << result.Error << std::endl;
+    };
+
+    Mt::TrajectoryWriteService writer(writeSettings);
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + duration;
+
+    std::mutex watchdogMutex;
+    std::condition_variable watchdogCV;
+    bool finished = false;
+    std::thread watchdog;
+
+    if (limitByDuration)
+    {
+        watchdog = std::thread([&]()
+        {
+            std::unique_lock<std::mutex> lock(watchdogMutex);
+
+            if (!watchdogCV.wait_until(lock, deadline, [&]() { return finished; }))
+                recorder.RequestStop();
+        });
+    }
+
+    // Numbers come from the directory's manifest, so reruns never overwrite and
+    // never rescan the directory.
+    std::filesystem::path basePath(baseFilename);
+    std::string baseName = basePath.filename().string();
+    Mt::DatasetManifest manifest;
+
+    if (archiveName.empty())
+        manifest.Open(basePath.parent_path().empty() ? "." : basePath.parent_path().string());
+
+    int captures = 0;
+
+    std::cout << "Batch: " << mode << ", " << (archiveName.empty() ? "first file " + MakeNumberedFilename(baseFilename, manifest.PeekIndex(baseName), extension) : "archive " + archiveName) << std::endl;
+
+    while (limitByDuration ? std::chrono::steady_clock::now() < deadline : captures < captureLimit)
+    {
+        Mt::Trajectory trajectory = mode == "points"
+            ? recorder.RecordPoints(value, delta)
+            : recorder.RecordTrajectory(value, delta);
+
+        // A capture cut short by the duration limit is incomplete; drop it.
+        if (recorder.IsStopRequested() || trajectory.Empty())
+            break;
+
+        std::string filename = archiveName.empty() ? MakeNumberedFilename(baseFilename, manifest.ReserveIndex(baseName, extension), extension) : archiveName;
+
+        std::cout << "Captured " << filename << " (" << trajectory.Size() << " points)" << std::endl;
+
+        writer.Submit(std::move(filename), std::move(trajectory));
+        captures++;
+    }
+
+    if (watchdog.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(watchdogMutex);
+            finished = true;
+        }
+
+        watchdogCV.notify_one();
+        watchdog.join();
+    }
+
+    writer.Shutdown();
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Mt::TrajectoryWriteStats stats = writer.GetStats();
+
+    std::cout << "Captures: " << captures << ", written: " << stats.Written << ", failed: " << stats.Failed
+        << ", max queued: " << stats.QueueHighWatermark << "/" << stats.QueueCapacity
+        << ", blocked: " << stats.BlockedSubmits << " (" << stats.BlockedUs / 1000.0 << " ms)"
+        << ", elapsed: " << elapsed << " s" << std::endl;
+
+    return stats.Failed == 0 ? 0 : -2;
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_BENCHCOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_BENCHCOMMAND__
+
+#include "MouseTrackerCore/Recording/CaptureBenchmark.h"
+#include "MouseTrackerCore/Recording/ScriptedCursorSource.h"
+#include "MouseTrackerCore/Platform/CursorSourceFactory.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+inline void PrintBenchUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " <count> <delta> [table|json|csv] [output|-] [strategy,...|all]." << std::endl;
+}
+
+// In-process replacement for TrackTimeCmd.bat / TrackTimePs.bat: timing is taken
+// per sample inside the recorder instead of around the whole process.
+inline int BenchCapture(int argc, char* argv[])
+{
+    if (argc < 3 || argc > 6)
+    {
+        PrintBenchUsage(argv[0]);
+
+        return -1;
+    }
+
+    long long count = std::stoll(argv[1]);
+    int delta = std::stoi(argv[2]);
+    std::string format = argc > 3 ? argv[3] : "table";
+    std::string output = argc > 4 ? argv[4] : "-";
+    std::string strategyList = argc > 5 ? argv[5] : "all";
+
+    if (format != "table" && format != "json" && format != "csv")
+    {
+        PrintBenchUsage(argv[0]);
+
+        return -1;
+    }
+
+    std::vector<Mt::PacingStrategy> strategies;
+
+    if (strategyList == "all")
+    {
+        strategies = Mt::SamplePacerFactory::GetAvailableStrategies();
+    }
+    else
+    {
+        std::stringstream stream(strategyList);
+        std::string name;
+
+        while (std::getline(stream, name, ','))
+        {
+            Mt::PacingStrategy strategy;
+
+            if (!Mt::SamplePacerFactory::Parse(name, strategy) || !Mt::SamplePacerFactory::Create(strategy))
+            {
+                std::cerr << "Unknown or unavailable strategy: " << name << std::endl;
+
+                return -1;
+            }
+
+            strategies.push_back(strategy);
+        }
+    }
+
+    std::unique_ptr<Mt::ICursorSource> source = Mt::CursorSourceFactory::CreateDefault();
+
+    if (!source)
+    {
+        // Pacing is what is being measured; a scripted source keeps headless runs useful.
+        std::cerr << "No cursor source available, using a scripted source." << std::endl;
+        source = std::make_unique<Mt::ScriptedCursorSource>(std::vector<Mt::Point> { { 0, 0 } });
+    }
+
+    std::vector<Mt::CaptureBenchmarkResult> results;
+
+    for (auto strategy : strategies)
+    {
+        std::cerr << "Running " << Mt::SamplePacerFactory::ToString(strategy) << "..." << std::endl;
+        results.push_back(Mt::CaptureBenchmark::Run(strategy, *source, count, delta));
+    }
+
+    std::string report;
+
+    if (format == "json")
+        report = Mt::CaptureBenchmark::ToJson(results, source->GetName());
+    else if (format == "csv")
+        report = Mt::CaptureBenchmark::ToCsv(results);
+    else
+        report = Mt::CaptureBenchmark::ToTable(results);
+
+    if (output == "-")
+    {
+        std::cout << report;
+
+        return 0;
+    }
+
+    std::ofstream file(output);
+
+    if (!file.is_open())
+    {
+        std::cout << "Unable to open file " << output << "." << std::endl;
+
+        return -2;
+    }
+
+    file << report;
+
+    return 0;
+}
+
+#endif
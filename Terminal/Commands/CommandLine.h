@@ -0,0 +1,60 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_COMMANDLINE__
+#define __MOUSE_TRACKER_TERMINAL_COMMANDLINE__
+
+#include <string>
+#include <vector>
+#include <filesystem>
+#include "MouseTrackerCore/Codecs/TrajectoryCodecRegistry.h"
+
+// Drops the mode argument so every command sees argv[0] followed by its own parameters.
+inline int RunWithShiftedArguments(int (*command)(int, char*[]), int argc, char* argv[])
+{
+    int newArgc = argc - 1;
+    std::vector<char*> newArgv(newArgc + 1, nullptr);
+
+    newArgv[0] = argv[0];
+
+    for (int i = 1; i < newArgc; i++)
+        newArgv[i] = argv[i + 1];
+
+    return command(newArgc, newArgv.data());
+}
+
+inline std::string MakeNumberedFilename(const std::string& baseFilename, int index, const std::string& extension = ".crsdat")
+{
+    return baseFilename + "_" + std::to_string(index) + extension;
+}
+
+// Splits a trailing codec extension off a base filename ("runs/capture.crsbin"
+// -> "runs/capture", ".crsbin"); without one the text format is used.
+inline std::string SplitTrajectoryExtension(std::string& baseFilename)
+{
+    std::string extension = Mt::TrajectoryCodecRegistry::GetExtension(baseFilename);
+
+    for (const auto& codec : Mt::TrajectoryCodecRegistry::GetInstance().GetCodecs())
+    {
+        if (extension == codec->GetExtension())
+        {
+            baseFilename.resize(baseFilename.size() - extension.size());
+
+            return extension;
+        }
+    }
+
+    return ".crsdat";
+}
+
+inline bool EnsureParentDirectory(const std::string& filename)
+{
+    std::filesystem::path parent = std::filesystem::path(filename).parent_path();
+
+    if (parent.empty())
+        return true;
+
+    std::error_code error;
+    std::filesystem::create_directories(parent, error);
+
+    return !error;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_EXPORTCOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_EXPORTCOMMAND__
+
+#include "MouseTrackerCore/Dataset/TrajectoryDataset.h"
+#include "MouseTrackerCore/Dataset/NumpyExporter.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+inline void PrintExportUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " export <input_dir|archive> <output.npz|output_dir> [ragged|resampled] [length] [threads]" << std::endl;
+}
+
+// Loads a directory (or one archive) into a dataset arena and writes it as
+// NumPy arrays for Python, without any text in between.
+inline int ExportDataset(int argc, char* argv[])
+{
+    if (argc < 3 || argc > 6)
+    {
+        PrintExportUsage(argv[0]);
+
+        return -1;
+    }
+
+    Mt::NumpyExportSettings exportSettings;
+    exportSettings.OutputPath = argv[2];
+
+    if (argc >= 4 && !Mt::NumpyExporter::ParseLayout(argv[3], exportSettings.Layout))
+    {
+        std::cout << "Unknown layout: " << argv[3] << " (ragged or resampled)" << std::endl;
+
+        return -1;
+    }
+
+    if (argc >= 5)
+        exportSettings.Length = std::stoul(argv[4]);
+
+    Mt::DatasetLoadSettings loadSettings;
+    loadSettings.InputDirectory = argv[1];
+
+    if (argc == 6)
+        loadSettings.Threads = exportSettings.Threads = std::stoul(argv[5]);
+
+    Mt::TrajectoryDataset dataset;
+    Mt::DatasetLoadSummary loadSummary = dataset.Load(loadSettings);
+
+    for (const auto& error : loadSummary.Errors)
+        std::cout << "Error: " << error << std::endl;
+
+    Mt::NumpyExportSummary exportSummary;
+    Mt::CodecResult result = Mt::NumpyExporter::Export(dataset, exportSettings, &exportSummary);
+
+    if (!result.Success)
+    {
+        std::cout << "Export failed: " << result.Error << std::endl;
+
+        return -2;
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "Loaded: " << loadSummary.Files << " files (" << loadSummary.FilesFailed << " failed), "
+        << loadSummary.Trajectories << " trajectories, " << loadSummary.Samples << " samples in " << loadSummary.ElapsedSeconds << " s" << std::endl
+        << "Exported: " << exportSettings.OutputPath << " ("
+        << (exportSettings.Layout == Mt::NumpyLayout::Ragged ? "ragged" : "resampled to " + std::to_string(exportSettings.Length)) << "), "
+        << exportSummary.BytesWritten / (1024.0 * 1024.0) << " MB in " << exportSummary.ElapsedSeconds << " s" << std::endl;
+
+    return loadSummary.FilesFailed == 0 && loadSummary.Errors.empty() ? 0 : -2;
+}
+
+#endif
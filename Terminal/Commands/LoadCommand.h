@@ -0,0 +1,70 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_LOADCOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_LOADCOMMAND__
+
+#include "MouseTrackerCore/Dataset/TrajectoryDataset.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cmath>
+
+inline void PrintLoadUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " load <input_dir> [threads]" << std::endl;
+}
+
+// Loads a whole directory into one arena, reports load throughput and times a
+// sweep over every sample (total path length) as an example analysis kernel.
+inline int LoadDataset(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        PrintLoadUsage(argv[0]);
+
+        return -1;
+    }
+
+    Mt::DatasetLoadSettings settings;
+    settings.InputDirectory = argv[1];
+
+    if (argc == 3)
+        settings.Threads = std::stoul(argv[2]);
+
+    Mt::TrajectoryDataset dataset;
+    Mt::DatasetLoadSummary summary = dataset.Load(settings);
+
+    for (const auto& error : summary.Errors)
+        std::cout << "Error: " << error << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+
+    const auto& points = dataset.GetPoints();
+    const auto& offsets = dataset.GetOffsets();
+    double pathLength = 0.0;
+
+    for (size_t i = 0; i < dataset.GetCount(); i++)
+    {
+        for (uint64_t j = offsets[i] + 1; j < offsets[i + 1]; j++)
+        {
+            double dx = points[j].x - points[j - 1].x;
+            double dy = points[j].y - points[j - 1].y;
+            pathLength += std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    double sweepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "Files: " << summary.Files << " ok, " << summary.FilesFailed << " failed, "
+        << summary.Trajectories << " trajectories, " << summary.Samples << " samples"
+        << (dataset.HasTimestamps() ? " with timestamps" : "") << std::endl
+        << "Load: " << summary.BytesRead / (1024.0 * 1024.0) << " MB in " << summary.ElapsedSeconds << " s on " << summary.Threads << " threads, "
+        << summary.GetMegabytesPerSecond() << " MB/s, " << summary.GetSamplesPerSecond() / 1e6 << " M samples/s" << std::endl
+        << "Arena: " << summary.ArenaBytes / (1024.0 * 1024.0) << " MB" << std::endl
+        << "Sweep: path length " << pathLength << " px in " << sweepSeconds * 1000.0 << " ms, "
+        << (sweepSeconds > 0.0 ? summary.Samples / sweepSeconds / 1e6 : 0.0) << " M samples/s" << std::endl;
+
+    return summary.FilesFailed == 0 && summary.Errors.empty() ? 0 : -2;
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_PROCESSCOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_PROCESSCOMMAND__
+
+#include "MouseTrackerCore/Dataset/DirectoryProcessor.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+inline void PrintProcessUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " validate <input_dir> [threads]" << std::endl;
+    std::cout << "       " << programName << " convert <input_dir> <output_dir> <format> [threads]" << std::endl;
+    std::cout << "       " << programName << " simplify <input_dir> <output_dir> <format> <tolerance_px> [timed|spatial] [threads]" << std::endl;
+}
+
+inline void PrintDirectoryProgress(const Mt::DirectoryProcessProgress& progress)
+{
+    std::cerr << "\r" << progress.FilesDone << "/" << progress.FilesFound << (progress.Scanning ? "+" : "")
+        << " files, " << std::fixed << std::setprecision(1) << progress.BytesRead / (1024.0 * 1024.0) << " MB, "
+        << progress.ElapsedSeconds << " s" << std::flush;
+}
+
+inline int ProcessDirectory(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        PrintProcessUsage(argv[0]);
+
+        return -1;
+    }
+
+    Mt::DirectoryProcessSettings settings;
+    std::string action = argv[1];
+    settings.InputDirectory = argv[2];
+
+    if (action == "validate" && argc <= 4)
+    {
+        settings.Action = Mt::ProcessAction::Validate;
+
+        if (argc == 4)
+            settings.Threads = std::stoul(argv[3]);
+    }
+    else if (action == "convert" && (argc == 5 || argc == 6))
+    {
+        settings.Action = Mt::ProcessAction::Convert;
+        settings.OutputDirectory = argv[3];
+        settings.TargetCodec = argv[4];
+
+        if (argc == 6)
+            settings.Threads = std::stoul(argv[5]);
+    }
+    else if (action == "simplify" && argc >= 6 && argc <= 8)
+    {
+        // Convert, keeping only what the simplifier needs to stay within the tolerance.
+        settings.Action = Mt::ProcessAction::Convert;
+        settings.OutputDirectory = argv[3];
+        settings.TargetCodec = argv[4];
+        settings.Simplify.Tolerance = std::stod(argv[5]);
+
+        if (argc >= 7)
+        {
+            std::string metric = argv[6];
+
+            if (metric != "timed" && metric != "spatial")
+            {
+                PrintProcessUsage(argv[0]);
+
+                return -1;
+            }
+
+            settings.Simplify.UseTimestamps = metric == "timed";
+        }
+
+        if (argc == 8)
+            settings.Threads = std::stoul(argv[7]);
+
+        if (!settings.Simplify.IsEnabled())
+        {
+            std::cout << "Tolerance must be positive" << std::endl;
+
+            return -1;
+        }
+    }
+    else
+    {
+        PrintProcessUsage(argv[0]);
+
+        return -1;
+    }
+
+    Mt::DirectoryProcessSummary summary = Mt::DirectoryProcessor::Run(settings, PrintDirectoryProgress);
+
+    std::cerr << std::endl;
+
+    for (const auto& error : summary.Errors)
+        std::cout << "Error: " << error << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "Files: " << summary.FilesProcessed << " ok, " << summary.FilesFailed << " failed, "
+        << summary.FilesWithWarnings << " with malformed records (" << summary.MalformedRecords << " total)" << std::endl
+        << "Samples: " << summary.Samples << ", read: " << summary.BytesRead / (1024.0 * 1024.0) << " MB"
+        << ", written: " << summary.BytesWritten / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    if (settings.Simplify.IsEnabled())
+        std::cout << "Simplified: " << summary.Samples << " -> " << summary.SamplesWritten << " samples ("
+            << summary.GetCompressionRatio() << "x) within " << settings.Simplify.Tolerance << " px"
+            << (settings.Simplify.UseTimestamps ? " (timed where files have timestamps)" : " (spatial)") << std::endl;
+
+    std::cout
+        << "Throughput: " << summary.GetFilesPerSecond() << " files/s, " << summary.GetMegabytesPerSecond() << " MB/s"
+        << " over " << summary.ElapsedSeconds << " s on " << summary.Threads << " threads"
+        << ", peak in flight " << summary.PeakInFlightBytes / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    return summary.FilesFailed == 0 && summary.Errors.empty() ? 0 : -2;
+}
+
+#endif
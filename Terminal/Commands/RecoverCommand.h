@@ -0,0 +1,74 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_RECOVERCOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_RECOVERCOMMAND__
+
+#include "MouseTrackerCore/Storage/TrajectoryRecovery.h"
+#include <iostream>
+#include <string>
+
+inline void PrintVerifyUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " verify <file> [file...]" << std::endl;
+}
+
+inline void PrintRecoverUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " recover <input> <output>" << std::endl;
+}
+
+// Checks each file end to end (chunk checksums, truncation, malformed lines)
+// and prints one line per file; fails when any file is damaged.
+inline int VerifyFiles(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintVerifyUsage(argv[0]);
+
+        return -1;
+    }
+
+    int damaged = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        Mt::TrajectoryVerifyReport report = Mt::TrajectoryRecovery::Verify(argv[i]);
+
+        std::cout << argv[i] << ": " << (report.Format.empty() ? "" : report.Format + ", ") << report.Describe() << std::endl;
+
+        if (!report.IsIntact())
+            damaged++;
+    }
+
+    if (argc > 2)
+        std::cout << "Verified: " << argc - 1 << " files, " << damaged << " damaged" << std::endl;
+
+    return damaged == 0 ? 0 : -2;
+}
+
+// Writes every intact sample (or archive entry) of a damaged file to a new one.
+inline int RecoverFile(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        PrintRecoverUsage(argv[0]);
+
+        return -1;
+    }
+
+    Mt::TrajectoryVerifyReport report;
+    Mt::CodecResult result = Mt::TrajectoryRecovery::Recover(argv[1], argv[2], &report);
+
+    std::cout << argv[1] << ": " << (report.Format.empty() ? "" : report.Format + ", ") << report.Describe() << std::endl;
+
+    if (!result.Success)
+    {
+        std::cout << "Recovery failed: " << result.Error << std::endl;
+
+        return -2;
+    }
+
+    std::cout << "Recovered: " << report.Samples << " samples into " << argv[2] << std::endl;
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_STORECOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_STORECOMMAND__
+
+#include "MouseTrackerCore/Storage/TrajectoryStore.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+inline void PrintStoreUsage(const std::string& programName)
+{
+    std::cout << "Usage: " << programName << " ingest <store_dir> <input_dir> [threads]" << std::endl;
+    std::cout << "       " << programName << " list <store_dir>" << std::endl;
+    std::cout << "       " << programName << " get <store_dir> <name> <output_file>" << std::endl;
+}
+
+inline bool OpenStore(Mt::TrajectoryStore& store, const std::string& directory)
+{
+    Mt::CodecResult result = store.Open(directory);
+
+    for (const auto& warning : result.Warnings)
+        std::cout << "Warning: " << warning << std::endl;
+
+    if (!result.Success)
+        std::cout << result.Error << std::endl;
+
+    return result.Success;
+}
+
+inline void PrintStoreStats(const Mt::TrajectoryStoreStats& stats)
+{
+    std::cout << std::fixed << std::setprecision(2)
+        << "Store: " << stats.References << " names, " << stats.Objects << " unique trajectories, "
+        << stats.ReferencedSamples << " samples referenced, " << stats.StoredSamples << " stored ("
+        << stats.StoredBytes / (1024.0 * 1024.0) << " MB), dedup ratio " << stats.GetDedupRatio() << "x" << std::endl;
+}
+
+inline int IngestIntoStore(const std::string& storeDirectory, const std::string& inputDirectory, size_t threads)
+{
+    Mt::TrajectoryStore store;
+
+    if (!OpenStore(store, storeDirectory))
+        return -2;
+
+    Mt::StoreIngestSummary summary = store.Ingest(inputDirectory, threads);
+
+    for (const auto& error : summary.Errors)
+        std::cout << "Error: " << error << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "Ingested: " << summary.Files - summary.Failed << " files (" << summary.Duplicates << " duplicates), "
+        << summary.Failed << " failed, " << summary.Samples << " samples" << std::endl
+        << "Read: " << summary.BytesRead / (1024.0 * 1024.0) << " MB in " << summary.ElapsedSeconds << " s on " << summary.Threads << " threads, "
+        << summary.GetMegabytesPerSecond() << " MB/s; hashing " << summary.GetHashMegabytesPerSecond() << " MB/s per thread" << std::endl;
+
+    PrintStoreStats(store.GetStats());
+
+    return summary.Failed == 0 && summary.Errors.empty() ? 0 : -2;
+}
+
+inline int ListStore(const std::string& storeDirectory)
+{
+    Mt::TrajectoryStore store;
+
+    if (!OpenStore(store, storeDirectory))
+        return -2;
+
+    std::cout << "name;object" << std::endl;
+
+    for (const auto& name : store.GetNames())
+        std::cout << name << ";" << store.GetObjectId(name) << std::endl;
+
+    PrintStoreStats(store.GetStats());
+
+    return 0;
+}
+
+inline int GetFromStore(const std::string& storeDirectory, const std::string& name, const std::string& outputName)
+{
+    Mt::TrajectoryStore store;
+
+    if (!OpenStore(store, storeDirectory))
+        return -2;
+
+    Mt::Trajectory trajectory;
+    Mt::CodecResult result = store.Get(name, trajectory);
+
+    if (result.Success)
+        result = Mt::TrajectoryIo::Save(outputName, trajectory);
+
+    if (!result.Success)
+    {
+        std::cout << result.Error << std::endl;
+
+        return -2;
+    }
+
+    std::cout << "Wrote " << name << " (" << trajectory.Size() << " points) to " << outputName << std::endl;
+
+    return 0;
+}
+
+inline int StoreCommand(int argc, char* argv[])
+{
+    std::string action = argc > 1 ? argv[1] : "";
+
+    if (action == "ingest" && (argc == 4 || argc == 5))
+        return IngestIntoStore(argv[2], argv[3], argc == 5 ? std::stoul(argv[4]) : 0);
+
+    if (action == "list" && argc == 3)
+        return ListStore(argv[2]);
+
+    if (action == "get" && argc == 5)
+        return GetFromStore(argv[2], argv[3], argv[4]);
+
+    PrintStoreUsage(argv[0]);
+
+    return -1;
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef __MOUSE_TRACKER_TERMINAL_STREAMCOMMAND__
+#define __MOUSE_TRACKER_TERMINAL_STREAMCOMMAND__
+
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Streaming/SampleStreamWriter.h"
+#include "MouseTrackerCore/Streaming/StreamOutput.h"
+#include <iostream>
+#include <string>
+#include <csignal>
+
+inline Mt::TrajectoryRecorder* g_streamingRecorder = nullptr;
+
+inline void StopStreamingOnSignal(int)
+{
+    if (g_streamingRecorder)
+        g_streamingRecorder->RequestStop();
+}
+
+inline void PrintStreamUsage(const std::string& programName)
+{
+    std::cerr << "Usage: " << programName << " <text|binary> <target> <delta> [count] [latency_ms]." << std::endl;
+}
+
+// Samples go to stdout ("-") or a named pipe while they are captured. Diagnostics
+// go to stderr so they never mix with the data stream.
+inline int StreamCursor(int argc, char* argv[])
+{
+    if (argc < 4 || argc > 6)
+    {
+        PrintStreamUsage(argv[0]);
+
+        return -1;
+    }
+
+    Mt::SampleStreamSettings settings;
+    std::string framing = argv[1];
+    std::string target = argv[2];
+    int delta = std::stoi(argv[3]);
+    long long count = argc > 4 ? std::stoll(argv[4]) : 0;
+
+    if (argc > 5)
+        settings.MaxLatencyUs = std::stoll(argv[5]) * 1000;
+
+    if (framing == "text")
+        settings.Framing = Mt::StreamFraming::Text;
+    else if (framing == "binary")
+        settings.Framing = Mt::StreamFraming::Binary;
+    else
+    {
+        PrintStreamUsage(argv[0]);
+
+        return -1;
+    }
+
+    Mt::TrajectoryRecorder recorder;
+
+    if (!recorder.HasSource())
+    {
+        std::cerr << "No cursor source available on this system." << std::endl;
+
+        return -3;
+    }
+
+    std::string error;
+    auto output = Mt::StreamOutput::Open(target, error);
+
+    if (!output)
+    {
+        std::cerr << error << "." << std::endl;
+
+        return -2;
+    }
+
+    // Once the consumer is gone there is nowhere to put samples, so sampling
+    // stops rather than running on until count (or forever with count 0).
+    settings.OnWriteFailed = [&recorder]() { recorder.RequestStop(); };
+
+    Mt::SampleStreamWriter writer(std::move(output), settings);
+
+    g_streamingRecorder = &recorder;
+    std::signal(SIGINT, StopStreamingOnSignal);
+
+    writer.Start();
+    recorder.Stream(writer, count, delta);
+    writer.Stop();
+
+    std::signal(SIGINT, SIG_DFL);
+    g_streamingRecorder = nullptr;
+
+    Mt::SampleStreamStats stats = writer.GetStats();
+
+    std::cerr << "Captured: " << stats.Captured << ", written: " << stats.Written << ", dropped: " << stats.Dropped
+        << ", flushes: " << stats.Flushes << std::endl;
+
+    if (stats.WriteFailed)
+    {
+        std::cerr << "Output closed by consumer." << std::endl;
+
+        return -2;
+    }
+
+    return 0;
+}
+
+#endif
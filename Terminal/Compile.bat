@@ -1,3 +1,5 @@
 @echo off
 
-cl.exe /EHsc main.cpp /Fe:MouseTrackerT /O2
+cmake -S . -B build -DMT_CORE_BUILD_TESTS=OFF
+cmake --build build --config Release
+copy /Y build\Release\MouseTrackerT.exe MouseTrackerT.exe
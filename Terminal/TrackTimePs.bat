@@ -7,6 +7,6 @@ set delta=%~3
 
 set mouse_tracker_t="MouseTrackerT.exe"
 
-powershell -command "Write-Host $PWD; Set-Location '%CD%'; $start = [System.Diagnostics.Stopwatch]::StartNew(); & $PWD/%mouse_tracker_t% 'points' %count% '%base_filename%_query.crsdat' %delta%; $elapsed = $start.ElapsedMilliseconds; Write-Host 'Real duration:' $elapsed 'ms'"
+powershell -command "Set-Location '%CD%'; & $PWD/%mouse_tracker_t% bench %count% %delta% csv '%base_filename%_bench.csv'; Import-Csv '%base_filename%_bench.csv' | Format-Table strategy, elapsed_us, rate_hz, drift_us, jitter_p99_us, cpu_load"
 
-endlocal
\ No newline at end of file
+endlocal
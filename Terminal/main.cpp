@@ -1,214 +1,70 @@
-#pragma comment(lib, "user32.lib")
-#pragma comment(lib, "winmm.lib")
-#define NOMINMAX
-
 #include <iostream>
 #include <string>
-#include <vector>
-#include <thread>
-#include <windows.h>
-#include <fstream>
-#include <profileapi.h>
-#include <algorithm>
-
-std::vector<POINT> StartReadMouseTrajectoryRoutineTscCpuWait(int delay, int delta = 1)
+#include "MouseTrackerCore/Recording/TrajectoryRecorder.h"
+#include "MouseTrackerCore/Codecs/TrajectoryIo.h"
+#include "MouseTrackerCore/Storage/ChunkedTrajectoryWriter.h"
+#include "Commands/CommandLine.h"
+#include "Commands/BatchCommand.h"
+#include "Commands/StreamCommand.h"
+#include "Commands/BenchCommand.h"
+#include "Commands/ProcessCommand.h"
+#include "Commands/ArchiveCommand.h"
+#include "Commands/LoadCommand.h"
+#include "Commands/ExportCommand.h"
+#include "Commands/RecoverCommand.h"
+#include "Commands/StoreCommand.h"
+
+bool SaveTrajectory(const Mt::Trajectory& trajectory, const std::string& filename)
 {
-    std::vector<POINT> points;
-
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
-
-    TIMECAPS tc;
-    timeGetDevCaps(&tc, sizeof(TIMECAPS));
-
-    UINT targetResolution = std::min(std::max(tc.wPeriodMin, 1u), tc.wPeriodMax);
-    timeBeginPeriod(targetResolution);
-
-    LARGE_INTEGER frequency;
-    QueryPerformanceFrequency(&frequency);
-
-    const double ticksPerMs = static_cast<double>(frequency.QuadPart) / 1000.0;
-    const long long targetTickCount = static_cast<long long>(ticksPerMs * delta);
-
-    LARGE_INTEGER startTime;
-    QueryPerformanceCounter(&startTime);
-
-    POINT point;
-    GetCursorPos(&point);
-    points.push_back(point);
-
-    LARGE_INTEGER now;
-    POINT initialPoint = point;
-
-    while (true)
-    {
-        QueryPerformanceCounter(&startTime);
-
-        GetCursorPos(&point);
-        points.push_back(point);
-
-        if (initialPoint.x != point.x || initialPoint.y != point.y)
-        {
-            points.push_back(point);
-
-            break;
-        }
-
-        QueryPerformanceCounter(&now);
+    Mt::CodecResult result = Mt::TrajectoryIo::Save(filename, trajectory);
 
-        while ((now.QuadPart - startTime.QuadPart) < targetTickCount)
-            QueryPerformanceCounter(&now);
-    }
-
-    POINT lastPoint = point;
-    LARGE_INTEGER lastMoveTime = startTime;
-
-    while (true)
+    if (!result.Success)
     {
-        QueryPerformanceCounter(&startTime);
-
-        GetCursorPos(&point);
-        points.push_back(point);
-
-        if (point.x == lastPoint.x && point.y == lastPoint.y)
-        {
-            long long elapsedTicks = startTime.QuadPart - lastMoveTime.QuadPart;
-            double elapsedMs = static_cast<double>(elapsedTicks) / ticksPerMs;
-
-            if (elapsedMs >= delay)
-                break;
-        }
-        else
-        {
-            lastPoint = point;
-            lastMoveTime = startTime;
-        }
-
-        QueryPerformanceCounter(&now);
+        std::cout << "Unable to open file " << filename << "." << std::endl;
 
-        while ((now.QuadPart - startTime.QuadPart) < targetTickCount)
-            QueryPerformanceCounter(&now);
+        return false;
     }
 
-    timeEndPeriod(targetResolution);
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL);
-
-    return points;
+    return true;
 }
 
-std::vector<POINT> StartReadCursorRoutineTscCpuWait(int count, int delta = 1)
+// Binary point captures are appended to disk in chunks while recording, so
+// a long run holds no more than one chunk in memory and survives a crash.
+bool StreamPointsToFile(Mt::TrajectoryRecorder& recorder, int count, int delta, const std::string& filename)
 {
-    std::vector<POINT> points;
-    points.reserve(count);
-
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
-
-    TIMECAPS tc;
-    timeGetDevCaps(&tc, sizeof(TIMECAPS));
-
-    UINT targetResolution = std::min(std::max(tc.wPeriodMin, 1u), tc.wPeriodMax);
-    timeBeginPeriod(targetResolution);
-
-    LARGE_INTEGER frequency;
-    QueryPerformanceFrequency(&frequency);
-
-    const double ticksPerMs = static_cast<double>(frequency.QuadPart) / 1000.0;
-    const long long targetTickCount = static_cast<long long>(ticksPerMs * delta);
-
-    // LARGE_INTEGER calibratingStart;
-    // LARGE_INTEGER calibratingEnd;
+    Mt::ChunkedTrajectoryWriter writer;
+    Mt::CodecResult result = writer.Open(filename, recorder.DescribeCapture(delta));
 
-    // QueryPerformanceCounter(&calibratingStart);
-    // Sleep(1);
-    // QueryPerformanceCounter(&calibratingEnd);
-
-    // const long long sleepOverhead = calibratingEnd.QuadPart - calibratingStart.QuadPart - static_cast<long long>(ticksPerMs);
-
-    for (int i = 0; i < count; i++)
+    if (!result.Success)
     {
-        LARGE_INTEGER startTime;
-        QueryPerformanceCounter(&startTime);
-
-        POINT point;
-        GetCursorPos(&point);
-        points.push_back(point);
-
-        LARGE_INTEGER now;
-        QueryPerformanceCounter(&now);
+        std::cout << "Unable to open file " << filename << "." << std::endl;
 
-        while ((now.QuadPart - startTime.QuadPart) < targetTickCount)
-            QueryPerformanceCounter(&now);
+        return false;
     }
 
-    timeEndPeriod(targetResolution);
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL);
-
-    return points;
-}
-
-std::vector<POINT> StartReadCursorRoutineTimerWindowsEx(int count, int delta = 1)
-{
-    std::vector<POINT> points;
-    points.reserve(count);
-
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+    recorder.Stream(writer, count, delta);
+    writer.Stop();
 
-    TIMECAPS tc;
-    timeGetDevCaps(&tc, sizeof(TIMECAPS));
+    Mt::ChunkedRecordingStats stats = writer.GetStats();
 
-    UINT timerResolution = std::min(std::max(tc.wPeriodMin, 1u), tc.wPeriodMax);
-    timeBeginPeriod(timerResolution);
+    std::cout << "Written: " << stats.Written << " samples in " << stats.Chunks << " chunks, dropped: " << stats.Dropped << std::endl;
 
-    LARGE_INTEGER freq;
-    QueryPerformanceFrequency(&freq);
+    if (stats.WriteFailed)
+        std::cout << "Write failed for " << filename << "." << std::endl;
 
-    using clock = std::chrono::high_resolution_clock;
-    LARGE_INTEGER dueTime;
-
-    HANDLE hTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
-
-    auto recordStart = clock::now();
-    POINT point;
-    GetCursorPos(&point);
-    points.push_back(point);
-    dueTime.QuadPart = -static_cast<LONGLONG>(0);
-    long long recordElapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - recordStart).count();
-    int a = 0;
-    a++;
-    a++;
-    long long recordSleepTime = std::max((delta * 1000 - recordElapsed - a) * 10, 0LL);
-    SetWaitableTimer(hTimer, &dueTime, 0, NULL, NULL, 0);
-    WaitForSingleObject(hTimer, INFINITE);
-    auto recordEnd = clock::now();
-    long long dt = std::chrono::duration_cast<std::chrono::microseconds>(recordEnd - recordStart).count();
+    return !stats.WriteFailed;
+}
 
-    for (int i = 0; i < count; i++)
+bool EnsureCursorSource(const Mt::TrajectoryRecorder& recorder)
+{
+    if (!recorder.HasSource())
     {
-        auto startTime = clock::now();
-
-        POINT point;
-        GetCursorPos(&point);
-        points.push_back(point);
+        std::cout << "No cursor source available on this system." << std::endl;
 
-        long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - startTime).count();
-
-        if (delta * 1000 > elapsed)
-        {
-            //Timer dt 100ns
-            dueTime.QuadPart = -static_cast<LONGLONG>((delta * 1000 - elapsed - dt) * 10);
-
-            SetWaitableTimer(hTimer, &dueTime, 0, NULL, NULL, 0);
-
-            WaitForSingleObject(hTimer, INFINITE);
-        }
+        return false;
     }
 
-    CloseHandle(hTimer);
-
-    timeEndPeriod(timerResolution);
-
-    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL);
-
-    return points;
+    return true;
 }
 
 int ReadCursorPoints(int argc, char* argv[])
@@ -237,23 +93,20 @@ int ReadCursorPoints(int argc, char* argv[])
     std::cout << "Record count: " << count << std::endl;
     std::cout << "Filename: " << filename << std::endl;
 
-    std::vector<POINT> cursorPoints = StartReadCursorRoutineTscCpuWait(count, delta);
+    Mt::TrajectoryRecorder recorder;
 
-    std::ofstream file;
+    if (!EnsureCursorSource(recorder))
+        return -3;
 
-    file.open(filename);
+    if (Mt::TrajectoryCodecRegistry::GetExtension(filename) == ".crsbin")
+        return StreamPointsToFile(recorder, count, delta, filename) ? 0 : -2;
 
-    if (!file.is_open())
-    {
-        std::cout << "Unable to open file " << filename << "." << std::endl;
-
-        return -2;
-    }
+    recorder.SetRecordTimestamps(Mt::TrajectoryIo::KeepsTimestamps(filename));
 
-    for (const auto& point : cursorPoints)
-        file << point.x << ";" << point.y << "\n";
+    Mt::Trajectory cursorPoints = recorder.RecordPoints(count, delta);
 
-    file.close();
+    if (!SaveTrajectory(cursorPoints, filename))
+        return -2;
 
     return 0;
 }
@@ -280,26 +133,20 @@ int ReadMouseTrajectory(int argc, char* argv[])
         filename = std::string(argv[2]);
         delta = std::stoi(argv[3]);
     }
-    
-    std::vector<POINT> cursorPoints = StartReadMouseTrajectoryRoutineTscCpuWait(delay, delta);
 
-    std::ofstream file;
-
-    std::cout << "Filename: " << filename << std::endl;
+    Mt::TrajectoryRecorder recorder;
 
-    file.open(filename);
+    if (!EnsureCursorSource(recorder))
+        return -3;
 
-    if (!file.is_open())
-    {
-        std::cout << "Unable to open file " << filename << "." << std::endl;
+    recorder.SetRecordTimestamps(Mt::TrajectoryIo::KeepsTimestamps(filename));
 
-        return -2;
-    }
+    Mt::Trajectory cursorPoints = recorder.RecordTrajectory(delay, delta);
 
-    for (const auto& point : cursorPoints)
-        file << point.x << ";" << point.y << "\n";
+    std::cout << "Filename: " << filename << std::endl;
 
-    file.close();
+    if (!SaveTrajectory(cursorPoints, filename))
+        return -2;
 
     return 0;
 }
@@ -312,16 +159,61 @@ void PrintUsage(const std::string& programName)
     std::cout << "               Usage: " << programName << " points <count> <filename> <delta>" << std::endl;
     std::cout << "  trajectory - Record mouse trajectory until idle" << std::endl;
     std::cout << "               Usage: " << programName << " trajectory <delay> <filename> <delta>" << std::endl;
+    std::cout << "  batch      - Record many points/trajectory captures in one process" << std::endl;
+    std::cout << "               Usage: " << programName << " batch <points|trajectory> <count|delay> <base_filename> <delta> <captures|seconds s>" << std::endl;
+    std::cout << "  stream     - Write samples to stdout or a named pipe while capturing" << std::endl;
+    std::cout << "               Usage: " << programName << " stream <text|binary> <target> <delta> [count] [latency_ms]" << std::endl;
+    std::cout << "  bench      - Measure rate, drift, jitter and CPU time of each capture strategy" << std::endl;
+    std::cout << "               Usage: " << programName << " bench <count> <delta> [table|json|csv] [output|-] [strategy,...|all]" << std::endl;
+    std::cout << "  validate   - Check every trajectory file under a directory, in parallel" << std::endl;
+    std::cout << "               Usage: " << programName << " validate <input_dir> [threads]" << std::endl;
+    std::cout << "  convert    - Re-encode every trajectory file under a directory into another tree, in parallel" << std::endl;
+    std::cout << "               Usage: " << programName << " convert <input_dir> <output_dir> <format> [threads]" << std::endl;
+    std::cout << "  simplify   - Convert a directory, dropping samples that lie within a tolerance of the simplified path (Douglas-Peucker)" << std::endl;
+    std::cout << "               Usage: " << programName << " simplify <input_dir> <output_dir> <format> <tolerance_px> [timed|spatial] [threads]" << std::endl;
+    std::cout << "  archive    - Pack many trajectories into one indexed .crsarc file, list it or extract an entry" << std::endl;
+    std::cout << "               Usage: " << programName << " archive <pack <input_dir> <archive> [format]|list <archive>|extract <archive> <id> <output>>" << std::endl;
+    std::cout << "  load       - Load every trajectory under a directory into one arena, in parallel, and report throughput" << std::endl;
+    std::cout << "               Usage: " << programName << " load <input_dir> [threads]" << std::endl;
+    std::cout << "  export     - Write a directory or archive of trajectories as NumPy arrays (.npz or a directory of .npy)" << std::endl;
+    std::cout << "               Usage: " << programName << " export <input_dir|archive> <output.npz|output_dir> [ragged|resampled] [length] [threads]" << std::endl;
+    std::cout << "  verify     - Check trajectory files and archives for corrupt chunks, truncation and malformed lines" << std::endl;
+    std::cout << "               Usage: " << programName << " verify <file> [file...]" << std::endl;
+    std::cout << "  recover    - Copy every intact sample (or archive entry) of a damaged file into a new file" << std::endl;
+    std::cout << "               Usage: " << programName << " recover <input> <output>" << std::endl;
+    std::cout << "  store      - Keep every distinct trajectory once (content hashed), under any number of names, and report the dedup ratio" << std::endl;
+    std::cout << "               Usage: " << programName << " store <ingest <store_dir> <input_dir> [threads]|list <store_dir>|get <store_dir> <name> <output>>" << std::endl;
     std::cout << std::endl;
     std::cout << "Parameters:" << std::endl;
     std::cout << "  count    - Number of points to record (for points mode)" << std::endl;
     std::cout << "  delay    - Idle time in ms to stop recording (for trajectory mode)" << std::endl;
-    std::cout << "  filename - Output filename" << std::endl;
+    std::cout << "  filename - Output file; .crsdat is x;y text, .crsbin is binary with timestamps and metadata" << std::endl;
+    std::cout << "             (points mode appends .crsbin captures to disk in chunks while recording)" << std::endl;
+    std::cout << "             .crsarc archives are read by validate / convert (entry N becomes <archive>/entry_N)" << std::endl;
+    std::cout << "             and, as a batch base filename, collect every capture in one file" << std::endl;
     std::cout << "  delta    - Time between samples in ms (default: 1)" << std::endl;
+    std::cout << "  target   - '-' for stdout, a FIFO path, or \\\\.\\pipe\\name on Windows (for stream mode)" << std::endl;
+    std::cout << "  strategy - busy, sleep, hybrid, timer (Windows only) (for bench mode)" << std::endl;
+    std::cout << "  format   - Codec name: text, binary (fixed width), binary-delta (delta varint) or binary-predictive" << std::endl;
+    std::cout << "             (smallest, for archival; decodes at hundreds of MB/s), for convert mode" << std::endl;
+    std::cout << "  layout   - ragged: points (S, 2) int32 + offsets (N + 1); resampled: points (N, length, 2) float32 (for export mode)" << std::endl;
+    std::cout << "  metric   - timed (default): error measured at each sample's own time, so speed is kept; spatial: distance to the path only (for simplify mode)" << std::endl;
+    std::cout << "  captures - Number of captures to record (for batch mode), or a duration like 60s" << std::endl;
     std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "  " << programName << " points 1000 points.txt 1" << std::endl;
     std::cout << "  " << programName << " trajectory 500 trajectory.txt 1" << std::endl;
+    std::cout << "  " << programName << " trajectory 500 trajectory.crsbin 1" << std::endl;
+    std::cout << "  " << programName << " batch trajectory 500 out/trajectory 1 100" << std::endl;
+    std::cout << "  " << programName << " batch points 1000 out/points.crsbin 1 60s" << std::endl;
+    std::cout << "  " << programName << " stream binary - 1 0 5" << std::endl;
+    std::cout << "  " << programName << " bench 10000 1 json bench.json" << std::endl;
+    std::cout << "  " << programName << " convert captures/ packed/ binary-delta 8" << std::endl;
+    std::cout << "  " << programName << " archive pack captures/ captures.crsarc binary-predictive" << std::endl;
+    std::cout << "  " << programName << " simplify captures/ archived/ binary-delta 1.5" << std::endl;
+    std::cout << "  " << programName << " export captures/ captures.npz resampled 256" << std::endl;
+    std::cout << "  " << programName << " recover crashed.crsbin salvaged.crsbin" << std::endl;
+    std::cout << "  " << programName << " store ingest store/ captures/" << std::endl;
 }
 
 int main(int argc, char* argv[])
@@ -336,36 +228,40 @@ int main(int argc, char* argv[])
     std::string mode = argv[1];
 
     if (mode == "points")
-    {
-        int newArgc = argc - 1;
-        char** newArgv = new char*[newArgc + 1];
-        
-        newArgv[0] = argv[0];
-        
-        for (int i = 1; i < newArgc; i++)
-            newArgv[i] = argv[i + 1];
-        
-        int result = ReadCursorPoints(newArgc, newArgv);
-        delete[] newArgv;
-
-        return result;
-    }
+        return RunWithShiftedArguments(ReadCursorPoints, argc, argv);
 
     else if (mode == "trajectory")
-    {
-        int newArgc = argc - 1;
-        char** newArgv = new char*[newArgc + 1];
-        
-        newArgv[0] = argv[0];
-        
-        for (int i = 1; i < newArgc; i++)
-            newArgv[i] = argv[i + 1];
-        
-        int result = ReadMouseTrajectory(newArgc, newArgv);
-        delete[] newArgv;
-
-        return result;
-    }
+        return RunWithShiftedArguments(ReadMouseTrajectory, argc, argv);
+
+    else if (mode == "batch")
+        return RunWithShiftedArguments(RecordBatch, argc, argv);
+
+    else if (mode == "stream")
+        return RunWithShiftedArguments(StreamCursor, argc, argv);
+
+    else if (mode == "bench")
+        return RunWithShiftedArguments(BenchCapture, argc, argv);
+
+    else if (mode == "validate" || mode == "convert" || mode == "simplify")
+        return ProcessDirectory(argc, argv);
+
+    else if (mode == "archive")
+        return RunWithShiftedArguments(ArchiveCommand, argc, argv);
+
+    else if (mode == "load")
+        return RunWithShiftedArguments(LoadDataset, argc, argv);
+
+    else if (mode == "export")
+        return RunWithShiftedArguments(ExportDataset, argc, argv);
+
+    else if (mode == "verify")
+        return RunWithShiftedArguments(VerifyFiles, argc, argv);
+
+    else if (mode == "recover")
+        return RunWithShiftedArguments(RecoverFile, argc, argv);
+
+    else if (mode == "store")
+        return RunWithShiftedArguments(StoreCommand, argc, argv);
 
     else
     {